@@ -39,6 +39,7 @@ Date: 04/03/2019
 #include "HelloWorldScene.h"
 #include "scenes/MSQ_MainMenu.h" //Main menu scene
 #include "scenes/MSQ_GameplayScene.h" // the gameplay scene
+#include "TextureAtlas.h" // the tile, enemy, and weapon atlases
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -137,6 +138,9 @@ bool AppDelegate::applicationDidFinishLaunching() {
     }
 
     register_all_packages();
+
+	// the tile, enemy, and weapon images are loaded from their atlases (see tools/pack_atlases.py), so that they don't have to be opened one at a time when an area is made.
+	OOP::TextureAtlas::loadAtlases();
 	
     // create a scene. it's an autorelease object
 	auto _scene = MSQ_GameplayScene::createScene(); // creates a gameplay scene
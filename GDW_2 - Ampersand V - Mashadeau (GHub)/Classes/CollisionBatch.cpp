@@ -0,0 +1,268 @@
+#include "CollisionBatch.h"
+
+#include <algorithm>
+#include <math.h>
+
+// the vector instructions that can be used. AVX checks eight shapes at a time, and SSE2 checks four (SSE2 is always there on x64).
+// any shapes left over (and every shape, if neither is available) are checked one at a time with the same math, so the results are the same no matter which one is used.
+// these are prefilters: they hit everything the single checks in umath hit, and sometimes more, so a hit still needs the full check.
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MSQ_BATCH_AVX
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MSQ_BATCH_SSE2
+#endif
+
+// removes all of the boxes.
+void umath::BoxBatch::clear()
+{
+	minX.clear();
+	minY.clear();
+	maxX.clear();
+	maxY.clear();
+}
+
+// adds a box.
+void umath::BoxBatch::add(const cocos2d::Vec2 & min, const cocos2d::Vec2 & max)
+{
+	minX.push_back(min.x);
+	minY.push_back(min.y);
+	maxX.push_back(max.x);
+	maxY.push_back(max.y);
+}
+
+// gets the amount of boxes.
+unsigned int umath::BoxBatch::size() const { return (unsigned int)minX.size(); }
+
+// removes all of the circles.
+void umath::CircleBatch::clear()
+{
+	x.clear();
+	y.clear();
+	radius.clear();
+}
+
+// adds a circle.
+void umath::CircleBatch::add(const cocos2d::Vec2 & centre, const float radius)
+{
+	x.push_back(centre.x);
+	y.push_back(centre.y);
+	this->radius.push_back(radius);
+}
+
+// gets the amount of circles.
+unsigned int umath::CircleBatch::size() const { return (unsigned int)x.size(); }
+
+// gets how many shapes a batch call checks, starting at 'first'.
+static unsigned int batchCount(unsigned int size, unsigned int first) { return (first >= size) ? 0 : std::min(size - first, umath::BATCH_SIZE); }
+
+// checks a box against a single packed box.
+static bool aabbHit(float minX, float minY, float maxX, float maxY, float bMinX, float bMinY, float bMaxX, float bMaxY)
+{
+	return !(maxX < bMinX || bMaxX < minX || maxY < bMinY || bMaxY < minY);
+}
+
+// checks a circle against a single packed box. This is the same math as Rect::intersectsCircle(), with the box's origin at its minimum.
+static bool aabbCircleHit(float x, float y, float radius, float bMinX, float bMinY, float bMaxX, float bMaxY)
+{
+	float w = (bMaxX - bMinX) / 2; // half of the box's size.
+	float h = (bMaxY - bMinY) / 2;
+
+	float dx = fabsf(x - (bMinX + w)); // the distance from the circle to the middle of the box.
+	float dy = fabsf(y - (bMinY + h));
+
+	if (dx > radius + w || dy > radius + h) // too far away on one of the axes.
+		return false;
+
+	dx = fabsf(x - bMinX - w);
+	dy = fabsf(y - bMinY - h);
+
+	if (dx <= w || dy <= h) // the circle is beside one of the box's sides.
+		return true;
+
+	return (dx - w) * (dx - w) + (dy - h) * (dy - h) <= radius * radius; // the circle is by one of the box's corners.
+}
+
+// checks a circle against a single packed circle. umath::circleCollision() rounds the distance down, so circles up to a unit past touching count; the reach is a unit longer to cover them.
+static bool circleHit(float x, float y, float radius, float cX, float cY, float cRadius)
+{
+	return (cX - x) * (cX - x) + (cY - y) * (cY - y) <= (radius + cRadius + 1.0F) * (radius + cRadius + 1.0F);
+}
+
+// checks a box against the packed boxes.
+unsigned int umath::aabbCollisionBatch(const cocos2d::Vec2 & min, const cocos2d::Vec2 & max, const umath::BoxBatch & boxes, unsigned int first)
+{
+	const unsigned int COUNT = batchCount(boxes.size(), first);
+	unsigned int hits = 0; // the mask of the boxes that were hit.
+	unsigned int i = 0;
+
+	if (COUNT == 0)
+		return 0;
+
+	const float * bMinX = boxes.minX.data() + first;
+	const float * bMinY = boxes.minY.data() + first;
+	const float * bMaxX = boxes.maxX.data() + first;
+	const float * bMaxY = boxes.maxY.data() + first;
+
+	// the comparisons are 'not less than', so that they work out the same as the single check (!(a < b || ...)), even for NaNs.
+#ifdef MSQ_BATCH_AVX
+	const __m256 MIN_X8 = _mm256_set1_ps(min.x), MIN_Y8 = _mm256_set1_ps(min.y), MAX_X8 = _mm256_set1_ps(max.x), MAX_Y8 = _mm256_set1_ps(max.y);
+
+	for (; i + 8 <= COUNT; i += 8)
+	{
+		__m256 hit = _mm256_and_ps(_mm256_cmp_ps(MAX_X8, _mm256_loadu_ps(bMinX + i), _CMP_NLT_UQ), _mm256_cmp_ps(_mm256_loadu_ps(bMaxX + i), MIN_X8, _CMP_NLT_UQ));
+		hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(MAX_Y8, _mm256_loadu_ps(bMinY + i), _CMP_NLT_UQ), _mm256_cmp_ps(_mm256_loadu_ps(bMaxY + i), MIN_Y8, _CMP_NLT_UQ)));
+
+		hits |= (unsigned int)_mm256_movemask_ps(hit) << i;
+	}
+#endif
+
+#ifdef MSQ_BATCH_SSE2
+	const __m128 MIN_X4 = _mm_set1_ps(min.x), MIN_Y4 = _mm_set1_ps(min.y), MAX_X4 = _mm_set1_ps(max.x), MAX_Y4 = _mm_set1_ps(max.y);
+
+	for (; i + 4 <= COUNT; i += 4)
+	{
+		__m128 hit = _mm_and_ps(_mm_cmpnlt_ps(MAX_X4, _mm_loadu_ps(bMinX + i)), _mm_cmpnlt_ps(_mm_loadu_ps(bMaxX + i), MIN_X4));
+		hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(MAX_Y4, _mm_loadu_ps(bMinY + i)), _mm_cmpnlt_ps(_mm_loadu_ps(bMaxY + i), MIN_Y4)));
+
+		hits |= (unsigned int)_mm_movemask_ps(hit) << i;
+	}
+#endif
+
+	for (; i < COUNT; i++)
+	{
+		if (aabbHit(min.x, min.y, max.x, max.y, bMinX[i], bMinY[i], bMaxX[i], bMaxY[i]))
+			hits |= 1U << i;
+	}
+
+	return hits;
+}
+
+// checks a circle against the packed boxes.
+unsigned int umath::aabbCircleCollisionBatch(const cocos2d::Vec2 & centre, const float radius, const umath::BoxBatch & boxes, unsigned int first)
+{
+	const unsigned int COUNT = batchCount(boxes.size(), first);
+	unsigned int hits = 0; // the mask of the boxes that were hit.
+	unsigned int i = 0;
+
+	if (COUNT == 0)
+		return 0;
+
+	const float * bMinX = boxes.minX.data() + first;
+	const float * bMinY = boxes.minY.data() + first;
+	const float * bMaxX = boxes.maxX.data() + first;
+	const float * bMaxY = boxes.maxY.data() + first;
+
+	// the early out and the two side checks are all worked out, and then combined; a lane passes if it isn't too far away, and it's either beside a side or close enough to a corner.
+	// the distances are made positive by clearing their sign bits.
+#ifdef MSQ_BATCH_AVX
+	const __m256 X8 = _mm256_set1_ps(centre.x), Y8 = _mm256_set1_ps(centre.y), RADIUS8 = _mm256_set1_ps(radius), RADIUS_SQ8 = _mm256_set1_ps(radius * radius);
+	const __m256 HALF8 = _mm256_set1_ps(0.5F), SIGN8 = _mm256_set1_ps(-0.0F);
+
+	for (; i + 8 <= COUNT; i += 8)
+	{
+		__m256 minX = _mm256_loadu_ps(bMinX + i), minY = _mm256_loadu_ps(bMinY + i);
+		__m256 w = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(bMaxX + i), minX), HALF8);
+		__m256 h = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(bMaxY + i), minY), HALF8);
+
+		__m256 dx = _mm256_andnot_ps(SIGN8, _mm256_sub_ps(X8, _mm256_add_ps(minX, w)));
+		__m256 dy = _mm256_andnot_ps(SIGN8, _mm256_sub_ps(Y8, _mm256_add_ps(minY, h)));
+		__m256 near = _mm256_and_ps(_mm256_cmp_ps(dx, _mm256_add_ps(RADIUS8, w), _CMP_NGT_UQ), _mm256_cmp_ps(dy, _mm256_add_ps(RADIUS8, h), _CMP_NGT_UQ));
+
+		dx = _mm256_andnot_ps(SIGN8, _mm256_sub_ps(_mm256_sub_ps(X8, minX), w));
+		dy = _mm256_andnot_ps(SIGN8, _mm256_sub_ps(_mm256_sub_ps(Y8, minY), h));
+		__m256 cornerX = _mm256_sub_ps(dx, w), cornerY = _mm256_sub_ps(dy, h);
+		__m256 corner = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(cornerX, cornerX), _mm256_mul_ps(cornerY, cornerY)), RADIUS_SQ8, _CMP_LE_OQ);
+		__m256 inside = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(dx, w, _CMP_LE_OQ), _mm256_cmp_ps(dy, h, _CMP_LE_OQ)), corner);
+
+		hits |= (unsigned int)_mm256_movemask_ps(_mm256_and_ps(near, inside)) << i;
+	}
+#endif
+
+#ifdef MSQ_BATCH_SSE2
+	const __m128 X4 = _mm_set1_ps(centre.x), Y4 = _mm_set1_ps(centre.y), RADIUS4 = _mm_set1_ps(radius), RADIUS_SQ4 = _mm_set1_ps(radius * radius);
+	const __m128 HALF4 = _mm_set1_ps(0.5F), SIGN4 = _mm_set1_ps(-0.0F);
+
+	for (; i + 4 <= COUNT; i += 4)
+	{
+		__m128 minX = _mm_loadu_ps(bMinX + i), minY = _mm_loadu_ps(bMinY + i);
+		__m128 w = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(bMaxX + i), minX), HALF4);
+		__m128 h = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(bMaxY + i), minY), HALF4);
+
+		__m128 dx = _mm_andnot_ps(SIGN4, _mm_sub_ps(X4, _mm_add_ps(minX, w)));
+		__m128 dy = _mm_andnot_ps(SIGN4, _mm_sub_ps(Y4, _mm_add_ps(minY, h)));
+		__m128 near = _mm_and_ps(_mm_cmpngt_ps(dx, _mm_add_ps(RADIUS4, w)), _mm_cmpngt_ps(dy, _mm_add_ps(RADIUS4, h)));
+
+		dx = _mm_andnot_ps(SIGN4, _mm_sub_ps(_mm_sub_ps(X4, minX), w));
+		dy = _mm_andnot_ps(SIGN4, _mm_sub_ps(_mm_sub_ps(Y4, minY), h));
+		__m128 cornerX = _mm_sub_ps(dx, w), cornerY = _mm_sub_ps(dy, h);
+		__m128 corner = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(cornerX, cornerX), _mm_mul_ps(cornerY, cornerY)), RADIUS_SQ4);
+		__m128 inside = _mm_or_ps(_mm_or_ps(_mm_cmple_ps(dx, w), _mm_cmple_ps(dy, h)), corner);
+
+		hits |= (unsigned int)_mm_movemask_ps(_mm_and_ps(near, inside)) << i;
+	}
+#endif
+
+	for (; i < COUNT; i++)
+	{
+		if (aabbCircleHit(centre.x, centre.y, radius, bMinX[i], bMinY[i], bMaxX[i], bMaxY[i]))
+			hits |= 1U << i;
+	}
+
+	return hits;
+}
+
+// checks a circle against the packed circles.
+unsigned int umath::circleCollisionBatch(const cocos2d::Vec2 & centre, const float radius, const umath::CircleBatch & circles, unsigned int first)
+{
+	const unsigned int COUNT = batchCount(circles.size(), first);
+	unsigned int hits = 0; // the mask of the circles that were hit.
+	unsigned int i = 0;
+
+	if (COUNT == 0)
+		return 0;
+
+	const float * cX = circles.x.data() + first;
+	const float * cY = circles.y.data() + first;
+	const float * cRadius = circles.radius.data() + first;
+
+	// the squared distances are compared, so no square roots are needed. The reach has the extra unit from circleHit() added to it.
+#ifdef MSQ_BATCH_AVX
+	const __m256 X8 = _mm256_set1_ps(centre.x), Y8 = _mm256_set1_ps(centre.y), RADIUS8 = _mm256_set1_ps(radius + 1.0F);
+
+	for (; i + 8 <= COUNT; i += 8)
+	{
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(cX + i), X8);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(cY + i), Y8);
+		__m256 reach = _mm256_add_ps(RADIUS8, _mm256_loadu_ps(cRadius + i));
+		__m256 hit = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(reach, reach), _CMP_LE_OQ);
+
+		hits |= (unsigned int)_mm256_movemask_ps(hit) << i;
+	}
+#endif
+
+#ifdef MSQ_BATCH_SSE2
+	const __m128 X4 = _mm_set1_ps(centre.x), Y4 = _mm_set1_ps(centre.y), RADIUS4 = _mm_set1_ps(radius + 1.0F);
+
+	for (; i + 4 <= COUNT; i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(cX + i), X4);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(cY + i), Y4);
+		__m128 reach = _mm_add_ps(RADIUS4, _mm_loadu_ps(cRadius + i));
+		__m128 hit = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(reach, reach));
+
+		hits |= (unsigned int)_mm_movemask_ps(hit) << i;
+	}
+#endif
+
+	for (; i < COUNT; i++)
+	{
+		if (circleHit(centre.x, centre.y, radius, cX[i], cY[i], cRadius[i]))
+			hits |= 1U << i;
+	}
+
+	return hits;
+}
@@ -0,0 +1,60 @@
+// collision prefilters between one shape and a whole set of other shapes at once. The other shapes are packed into arrays (one per value), so that four or eight of them can be
+// checked with each instruction. SSE2 and AVX are used if the compiler has them turned on; otherwise each shape is checked on its own.
+// the checks are conservative: they hit everything the matching check in umath hits, but can hit more, so anything they hit still needs the full check.
+#pragma once
+
+#include "cocos2d.h"
+#include <vector>
+
+namespace umath
+{
+	// the most shapes that can be checked in one call. Each shape gets a bit in the returned mask.
+	const unsigned int BATCH_SIZE = 32;
+
+	// a set of axis-aligned boxes, stored as one array per value.
+	struct BoxBatch
+	{
+		// removes all of the boxes. The arrays keep their capacity, so refilling them doesn't allocate.
+		void clear();
+
+		// adds a box, using its minimum and maximum.
+		void add(const cocos2d::Vec2 & min, const cocos2d::Vec2 & max);
+
+		// gets the amount of boxes.
+		unsigned int size() const;
+
+		std::vector<float> minX;
+		std::vector<float> minY;
+		std::vector<float> maxX;
+		std::vector<float> maxY;
+	};
+
+	// a set of circles, stored as one array per value.
+	struct CircleBatch
+	{
+		// removes all of the circles. The arrays keep their capacity.
+		void clear();
+
+		// adds a circle.
+		void add(const cocos2d::Vec2 & centre, const float radius);
+
+		// gets the amount of circles.
+		unsigned int size() const;
+
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> radius;
+	};
+
+	/*
+	 * checks a box against the boxes in the batch, starting at 'first'. Up to BATCH_SIZE boxes are checked (fewer if the batch runs out).
+	 * bit 'i' of the result is set if the box collides with box (first + i). Touching counts as a collision, the same as OOP::WorldShape::collision(), but unlike umath::aabbCollision().
+	*/
+	unsigned int aabbCollisionBatch(const cocos2d::Vec2 & min, const cocos2d::Vec2 & max, const umath::BoxBatch & boxes, unsigned int first);
+
+	// checks a circle against the boxes in the batch, starting at 'first'. This uses the same math as umath::aabbCircleCollision() (i.e. Rect::intersectsCircle()).
+	unsigned int aabbCircleCollisionBatch(const cocos2d::Vec2 & centre, const float radius, const umath::BoxBatch & boxes, unsigned int first);
+
+	// checks a circle against the circles in the batch, starting at 'first'. umath::circleCollision() rounds the distance down, so this reaches a unit further to hit everything it does.
+	unsigned int circleCollisionBatch(const cocos2d::Vec2 & centre, const float radius, const umath::CircleBatch & circles, unsigned int first);
+}
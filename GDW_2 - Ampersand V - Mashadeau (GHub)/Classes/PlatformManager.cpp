@@ -9,21 +9,21 @@
 OOP::Platform::Platform(cocos2d::Vec2 startPoint, cocos2d::Vec2 endPoint) 
 	: m_Square(new OOP::PrimitiveSquare(startPoint - (startPoint + endPoint) / 2, endPoint - (startPoint + endPoint) / 2))
 {
-	m_Square->getPrimitive()->setPosition((startPoint + endPoint) / 2); // saves the position of the square.
+	m_Square->setPosition((startPoint + endPoint) / 2); // saves the position of the square.
 }
 
 // creates a platform and initalizes the m_Square object using a position (based on sprite centre), width, and height.  This also saves the postiion of the platform.
-OOP::Platform::Platform(cocos2d::Vec2 position, float width, float height) : m_Square(new OOP::PrimitiveSquare(cocos2d::Vec2(0.0F, 0.0F), width, height)) { m_Square->getPrimitive()->setPosition(position); }
+OOP::Platform::Platform(cocos2d::Vec2 position, float width, float height) : m_Square(new OOP::PrimitiveSquare(cocos2d::Vec2(0.0F, 0.0F), width, height)) { m_Square->setPosition(position); }
 
 // creates a platform and initalizes m_Square with a position (based on sprite centre), and a side length. This also saves the postiion of the platform.
-OOP::Platform::Platform(cocos2d::Vec2 position, float sideLength) : m_Square(new OOP::PrimitiveSquare(cocos2d::Vec2(0.0F, 0.0F), sideLength)) { m_Square->getPrimitive()->setPosition(position); }
+OOP::Platform::Platform(cocos2d::Vec2 position, float sideLength) : m_Square(new OOP::PrimitiveSquare(cocos2d::Vec2(0.0F, 0.0F), sideLength)) { m_Square->setPosition(position); }
 
 OOP::Platform::~Platform() {}
 
 OOP::PrimitiveSquare * OOP::Platform::getSquarePrimitive() { return m_Square; } // returns the square primitive
 
 // returns the position of the platform.
-cocos2d::Vec2 OOP::Platform::getPosition() { return m_Square->getPrimitive()->getPosition(); }
+cocos2d::Vec2 OOP::Platform::getPosition() { return m_Square->getPosition(); }
 
 
 // Vertically Moving Platform
@@ -37,7 +37,7 @@ void OOP::VerticalMovingPlatform::setPosition(cocos2d::Vec2 position)
 	STARTING_POS += offset; // proportionally moves the starting position.
 	ENDING_POS += offset; // proportionally moves the ending position.
 
-	getSquarePrimitive()->getPrimitive()->setPosition(position); // sets the position of the vertical platform
+	getSquarePrimitive()->setPosition(position); // sets the position of the vertical platform
 }
 
 // Question 3: toString for vertical moving platform
@@ -54,7 +54,7 @@ void OOP::VerticalMovingPlatform::update(float deltaTime)
 	short int direc = (moveUp == true) ? 1 : -1; // saves whether the platform is moving up or down.
 
 	// sets and saves the platform's new position, as well as moving the platform graphic.
-	getSquarePrimitive()->getPrimitive()->setPosition(getPosition() + cocos2d::Vec2(0.0F, 100.0F) * SPEED * deltaTime * direc);
+	getSquarePrimitive()->setPosition(getPosition() + cocos2d::Vec2(0.0F, 100.0F) * SPEED * deltaTime * direc);
 
 	if (getPosition().y >= ENDING_POS.y) // If the ending position is met, or has been surpassed.
 		moveUp = false; // becomes false so that the platform will now move down.
@@ -76,7 +76,7 @@ void OOP::HorizontallyMovingPlatform::setPosition(cocos2d::Vec2 position)
 	STARTING_POS += offset; // proportionally moves the starting position.
 	ENDING_POS += offset; // proportionally moves the ending position.
 
-	getSquarePrimitive()->getPrimitive()->setPosition(position); // sets the position of the vertical platform
+	getSquarePrimitive()->setPosition(position); // sets the position of the vertical platform
 }
 
 // Question 3: toString for horizontal moving platform
@@ -93,7 +93,7 @@ void OOP::HorizontallyMovingPlatform::update(float deltaTime)
 	short int direc = (moveRight == true) ? 1 : -1; // saves whether the platform is moving right or left.
 
 	// sets and saves the platform's new position, as well as moving the platform graphic.
-	getSquarePrimitive()->getPrimitive()->setPosition(getPosition() + cocos2d::Vec2(100.0F, 0.0F) * SPEED * deltaTime * direc);
+	getSquarePrimitive()->setPosition(getPosition() + cocos2d::Vec2(100.0F, 0.0F) * SPEED * deltaTime * direc);
 
 	if (getPosition().x >= ENDING_POS.x) // If the ending position is met, or has been surpassed.
 		moveRight = false; // becomes false so that the platform will now move left.
@@ -111,18 +111,18 @@ OOP::RotatingPlatform::RotatingPlatform(cocos2d::Vec2 position, float width, flo
 {
 	// In order for rotations to work properly, the shape needs to be placed at (0, 0), and the drawNode position needs to be set to the place where the graphic should actually be drawn.
 	// This allows the centre of the graphic to be the origin of the drawNode, and thus allow the shape to rotate around its centre. This is the only one of the platforms that works like this.
-	getSquarePrimitive()->getPrimitive()->setPosition(position);
+	getSquarePrimitive()->setPosition(position);
 }
 
 // Question 4: a position setter for the rotating platform
-void OOP::RotatingPlatform::setPosition(cocos2d::Vec2 position) { getSquarePrimitive()->getPrimitive()->setPosition(position); }
+void OOP::RotatingPlatform::setPosition(cocos2d::Vec2 position) { getSquarePrimitive()->setPosition(position); }
 
 // Question 3: toString() for a rotating platform
 std::string OOP::RotatingPlatform::toString()
 {
 	// gets most of the current conditions.
 	std::string tempString = "Position: (" + std::to_string(getPosition().x) + ", " + std::to_string(getPosition().y) +
-		") | Rotation Factor (Degrees): " + std::to_string(getSquarePrimitive()->getPrimitive()->getRotation()) +
+		") | Rotation Factor (Degrees): " + std::to_string(getSquarePrimitive()->getRotation()) +
 		" | Direction: ";
 
 	tempString += (CLOCKWISE) ? "Clockwise" : "Counter-Clockwise"; // gets the final condition, being whether the platform is spinning clockwise or not.
@@ -133,7 +133,7 @@ std::string OOP::RotatingPlatform::toString()
 void OOP::RotatingPlatform::update(float deltaTime) 
 {
 	int rDirec = (CLOCKWISE) ? 1 : -1; // sets the rotation direction based on whether the platform rotates clockwise or not.
-	getSquarePrimitive()->getPrimitive()->setRotation(getSquarePrimitive()->getPrimitive()->getRotation() + 10.0 * SPEED * deltaTime * rDirec);
+	getSquarePrimitive()->setRotation(getSquarePrimitive()->getRotation() + 10.0F * SPEED * deltaTime * rDirec);
 }
 
 
@@ -152,7 +152,7 @@ void OOP::PlatformManager::Subtract(Platform * platform) { *this -= platform; }
 void OOP::PlatformManager::operator+=(Platform * platform) // operator +; adds a platform object to the vector
 {
 	// check to see if the passed platform exists in the vector. If it doesn't, add it in.
-	for each(Platform * vecPlatform in m_Platforms)
+	for (Platform * vecPlatform : m_Platforms)
 	{
 		if (vecPlatform == platform) // returns void if the platformer exists in the vector
 			return;
@@ -191,7 +191,7 @@ cocos2d::DrawNode * OOP::PlatformManager::Generate() // populates platform vecto
 	cocos2d::DrawNode * tileNode(cocos2d::DrawNode::create());
 
 	for (int i = 0; i < m_Platforms.size(); i++)
-		tileNode->addChild(m_Platforms.at(i)->getSquarePrimitive()->getPrimitive()); // adds the square to the drawNode.
+		m_Platforms.at(i)->getSquarePrimitive()->setParent(tileNode); // adds the square to the drawNode.
 
 
 	return tileNode; // returns a pointer to the draw node so that it can be added to the scene.
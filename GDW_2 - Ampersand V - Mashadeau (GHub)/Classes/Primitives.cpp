@@ -6,29 +6,125 @@
 
 
 ///// GENERAL PRIMITIVE //////////////////////////////////////////////////////////////////////////
-OOP::Primitive::Primitive(const short int ID) : m_Node(cocos2d::DrawNode::create()), ID(ID)
+unsigned int OOP::Primitive::drawNodeCount = 0; // the amount of primitive drawNodes that exist.
+
+// the drawNode is no longer made here. It's only made once the primitive needs to be drawn.
+OOP::Primitive::Primitive(const short int ID, const cocos2d::Color4F colour) : m_Colour(colour), ID(ID)
 { 
-	m_Node->setGlobalZOrder(10.1F); // since primitives are treated as collision shapes, they have the global z order of  10.1F.
-	m_Node->setVisible(false); // hides the draw node from view.
+}
+
+// copies the geometry of the primitive, but not the drawNode or parent.
+OOP::Primitive::Primitive(const OOP::Primitive & prim)
+	: tag(prim.tag), active(prim.active), m_GlobalZOrder(prim.m_GlobalZOrder), m_Position(prim.m_Position), m_Rotation(prim.m_Rotation), m_Colour(prim.m_Colour), ID(prim.ID)
+{
 }
 
 // releases the drawNode. This was originally done in every destructor, but now only happens here.
-OOP::Primitive::~Primitive() { /*m_Node->release();*/ m_Node->removeFromParent(); }
+OOP::Primitive::~Primitive()
+{
+	if (m_Node == nullptr) // there's nothing to release.
+		return;
+
+	m_Node->removeFromParent();
+	m_Node->release(); // the drawNode is retained when it's made, so it needs to be released.
+	drawNodeCount--;
+}
+
+// returns the primitive. The drawNode is made if it doesn't exist yet.
+cocos2d::DrawNode * OOP::Primitive::getPrimitive()
+{
+	if (m_Node != nullptr)
+		return m_Node;
+
+	m_Node = cocos2d::DrawNode::create();
+	m_Node->retain(); // the drawNode may not have a parent, so it's retained so that it doesn't get released automatically.
+	drawNodeCount++;
+
+	draw(); // draws the shape into the drawNode.
+
+	m_Node->setGlobalZOrder(m_GlobalZOrder);
+	m_Node->setVisible(false); // hides the draw node from view.
+	(active) ? m_Node->setOpacity(255.0F) : m_Node->setOpacity(127.5);
+	updateNode();
+
+	if (m_Parent != nullptr) // adds the drawNode to the primitive's parent.
+		m_Parent->addChild(m_Node);
+
+	return m_Node;
+}
 
-// returns the primitive.
-cocos2d::DrawNode * OOP::Primitive::getPrimitive() const { return m_Node; }
+// returns 'true' if the drawNode has been made.
+bool OOP::Primitive::hasDrawNode() const { return m_Node != nullptr; }
 
-// gets the position of the drawNode.
-cocos2d::Vec2 OOP::Primitive::getPosition() const { return m_Node->getPosition(); }
+// gets the amount of drawNodes that exist.
+unsigned int OOP::Primitive::getDrawNodeCount() { return drawNodeCount; }
 
-// gets the visibility of the m_Node
-bool OOP::Primitive::isVisible() const { return m_Node->isVisible(); }
+// gets the position of the primitive.
+cocos2d::Vec2 OOP::Primitive::getPosition() const { return m_Position; }
 
-// sets the visibility of the collision shape.
-void OOP::Primitive::setVisible(bool visible) { m_Node->setVisible(visible); }
+// gets the rotation of the primitive.
+float OOP::Primitive::getRotation() const { return m_Rotation; }
+
+// sets the rotation of the primitive, and rotates the drawNode if there is one.
+void OOP::Primitive::setRotation(float rotation)
+{
+	m_Rotation = rotation;
+	updateNode();
+}
+
+// gets the parent of the primitive.
+cocos2d::Node * OOP::Primitive::getParent() const { return m_Parent; }
+
+// sets the parent of the primitive. If there's a drawNode, it's moved over to the new parent.
+void OOP::Primitive::setParent(cocos2d::Node * parent)
+{
+	if (m_Node != nullptr && m_Parent != parent)
+	{
+		m_Node->removeFromParent();
+
+		if (parent != nullptr)
+			parent->addChild(m_Node);
+	}
+
+	m_Parent = parent;
+}
+
+// removes the primitive from its parent.
+void OOP::Primitive::removeFromParent() { setParent(nullptr); }
+
+// sets the global z order of the primitive.
+void OOP::Primitive::setGlobalZOrder(float globalZOrder)
+{
+	m_GlobalZOrder = globalZOrder;
+
+	if (m_Node != nullptr)
+		m_Node->setGlobalZOrder(globalZOrder);
+}
+
+// gets the visibility of the m_Node. Primitives without a drawNode are never visible.
+bool OOP::Primitive::isVisible() const { return m_Node != nullptr && m_Node->isVisible(); }
+
+// sets the visibility of the collision shape. The drawNode is only made if the primitive is being made visible.
+void OOP::Primitive::setVisible(bool visible)
+{
+	if (visible)
+		getPrimitive()->setVisible(true);
+	else if (m_Node != nullptr)
+		m_Node->setVisible(false);
+}
 
 // toggles the visibility of the collision shape.
-void OOP::Primitive::setVisible() { setVisible(!m_Node->isVisible()); }
+void OOP::Primitive::setVisible() { setVisible(!isVisible()); }
+
+// moves and rotates the drawNode so that it matches the primitive.
+void OOP::Primitive::updateNode()
+{
+	if (m_Node == nullptr)
+		return;
+
+	m_Node->setPosition(m_Position);
+	m_Node->setRotation(m_Rotation);
+}
 
 // gets the tag for the primitive.
 int OOP::Primitive::getTag() const { return tag; }
@@ -46,7 +142,8 @@ bool OOP::Primitive::isActive() const { return active; }
 void OOP::Primitive::setActive(bool active)
 {
 	// if the primitive activity is being turned on, then opacity is set for 100%. Opacity is out of 255.
-	(active) ? m_Node->setOpacity(255.0F) : m_Node->setOpacity(127.5);
+	if (m_Node != nullptr)
+		(active) ? m_Node->setOpacity(255.0F) : m_Node->setOpacity(127.5);
 
 	this->active = active;
 }
@@ -69,10 +166,11 @@ void OOP::Primitive::setActive() { setActive(!active); }
 */
 short int OOP::Primitive::getId() { return ID; }
 
-// collision between two active primitives.
+// collision between two active primitives. The primitives are turned into world shapes where they are (with no offset), so they use the same checks as OOP::WorldShape::collision().
 bool OOP::Primitive::collision(OOP::Primitive * p1, OOP::Primitive * p2)
 {
-	bool col = false;
+	OOP::WorldShape s1; // the primitives as shapes.
+	OOP::WorldShape s2;
 
 	if (p1 == nullptr || p2 == nullptr) // returns false of at least one of these are null.
 		return false;
@@ -80,81 +178,221 @@ bool OOP::Primitive::collision(OOP::Primitive * p1, OOP::Primitive * p2)
 	if (!p1->isActive() || !p2->isActive()) // returns false if at least one of these are inactive.
 		return false;
 
-	if (p1->getId() == 1 && p2->getId() == 1) // AABB and AABB
+	if (!p1->getWorldShape(cocos2d::Vec2(0.0F, 0.0F), s1) || !p2->getWorldShape(cocos2d::Vec2(0.0F, 0.0F), s2)) // lines and grids don't have shapes, so they can't collide with anything.
+		return false;
+
+	return OOP::WorldShape::collision(s1, s2);
+}
+
+// gets the primitive in world space, offset by the provided amount.
+bool OOP::Primitive::getWorldShape(const cocos2d::Vec2 & offset, OOP::WorldShape & shape) const
+{
+	cocos2d::Vec2 pos = offset + m_Position; // the position of the primitive in world space.
+
+	shape.id = ID;
+	shape.source = this;
+
+	switch (ID)
 	{
-		return umath::aabbCollision(&(((OOP::PrimitiveSquare *)p1)->getRect()), &(((OOP::PrimitiveSquare *)p2)->getRect()));
+	case 1: // Square (AABB)
+		shape.aabb.min = pos - cocos2d::Vec2(((OOP::PrimitiveSquare *)this)->m_WIDTH / 2, ((OOP::PrimitiveSquare *)this)->m_HEIGHT / 2);
+		shape.aabb.max = pos + cocos2d::Vec2(((OOP::PrimitiveSquare *)this)->m_WIDTH / 2, ((OOP::PrimitiveSquare *)this)->m_HEIGHT / 2);
+		return true;
+
+	case 2: // Square (OBB)
+		shape.obb.centre = pos;
+		shape.obb.size = cocos2d::Vec2(((OOP::PrimitiveOrientedSquare *)this)->m_WIDTH, ((OOP::PrimitiveOrientedSquare *)this)->m_HEIGHT);
+		shape.obb.theta = ((OOP::PrimitiveOrientedSquare *)this)->getRotationInRadians();
+		shape.obb.cosTheta = cosf(shape.obb.theta);
+		shape.obb.sinTheta = sinf(shape.obb.theta);
+		return true;
+
+	case 3: // Circle
+		shape.circle.centre = pos;
+		shape.circle.radius = ((OOP::PrimitiveCircle *)this)->m_RADIUS;
+		return true;
+
+	case 5: // Capsule; the circle positions are stored in the same space as the drawNode's position.
+		shape.capsule.start = offset + ((OOP::PrimitiveCapsule *)this)->getCirclePosition1();
+		shape.capsule.end = offset + ((OOP::PrimitiveCapsule *)this)->getCirclePosition2();
+		shape.capsule.radius = ((OOP::PrimitiveCapsule *)this)->m_RADIUS;
+		return true;
 	}
-	else if (p1->getId() == 2 && p2->getId() == 2) // OBB-OBB
+
+	return false;
+}
+
+///// WORLD SHAPE ////////////////////////////////////////////////////////////////////////
+// collision between two world shapes. None of these checks allocate anything.
+bool OOP::WorldShape::collision(const OOP::WorldShape & s1, const OOP::WorldShape & s2)
+{
+	cocos2d::Rect rect; // the rect used for the AABB - Circle check, which is done through cocos2d.
+	OOP::OBB box1; // the boxes used for the checks that treat an AABB as an OBB.
+	OOP::OBB box2;
+
+	if (s1.id > s2.id) // each pair is only handled one way around, so the shapes are swapped so that the lower id comes first.
+		return collision(s2, s1);
+
+	if (s1.id == 1 && s2.id == 1) // AABB - AABB
+	{
+		// same check as Rect::intersectsRect(), so touching counts as a collision.
+		return !(s1.aabb.max.x < s2.aabb.min.x || s2.aabb.max.x < s1.aabb.min.x || s1.aabb.max.y < s2.aabb.min.y || s2.aabb.max.y < s1.aabb.min.y);
+	}
+	else if (s1.id == 1 && s2.id == 3) // AABB - Circle
+	{
+		rect = cocos2d::Rect(s1.aabb.min, cocos2d::Size(s1.aabb.max.x - s1.aabb.min.x, s1.aabb.max.y - s1.aabb.min.y));
+
+		return umath::aabbCircleCollision(rect, s2.circle.centre, s2.circle.radius);
+	}
+	else if (s1.id == 3 && s2.id == 3) // Circle - Circle
 	{
-		return umath::obbCollision(((OOP::PrimitiveOrientedSquare *)p1)->getRect(), ((OOP::PrimitiveOrientedSquare *)p1)->getRotationInRadians(),
-								  ((OOP::PrimitiveOrientedSquare *)p2)->getRect(), ((OOP::PrimitiveOrientedSquare *)p2)->getRotationInRadians(),
-								  false);
+		return umath::circleCollision(s1.circle.centre, s1.circle.radius, s2.circle.centre, s2.circle.radius);
 	}
-	else if (p1->getId() == 3 && p2->getId() == 3) // circle-circle
+	else if (s1.id == 3 && s2.id == 5) // Circle - Capsule
 	{
-		return umath::circleCollision(p1->getPosition(), ((OOP::PrimitiveCircle *)p1)->m_RADIUS, p2->getPosition(), ((OOP::PrimitiveCircle *)p2)->m_RADIUS);
+		return umath::capsuleCircleCollision(s2.capsule.start, s2.capsule.end, s2.capsule.radius, s1.circle.centre, s1.circle.radius);
 	}
-	else if (p1->getId() == 5 && p2->getId() == 5) // capsule-capsule
+	else if (s1.id == 5 && s2.id == 5) // Capsule - Capsule
 	{
+		return umath::capsuleCollision(s1.capsule.start, s1.capsule.end, s1.capsule.radius, s2.capsule.start, s2.capsule.end, s2.capsule.radius);
+	}
+	else if (s1.id == 2 && s2.id == 3) // OBB - Circle
+	{
+		return umath::obbCircleCollision(s1.obb.centre, s1.obb.size / 2, s1.obb.cosTheta, s1.obb.sinTheta, s2.circle.centre, s2.circle.radius);
+	}
+	else if ((s1.id == 1 || s1.id == 2) && s2.id == 2) // AABB - OBB, and OBB - OBB
+	{
+		box1 = s1.getBox();
+		box2 = s2.getBox();
 
-		// Proper checks
-		col = collision(((OOP::PrimitiveCapsule *)p1)->getCircle1(), ((OOP::PrimitiveCapsule *)p2)->getCircle1()); // p1 circ1 and p2 circ1
-		if (col == true)
-			return col;
+		return umath::obbCollision(box1.centre, box1.size / 2, box1.cosTheta, box1.sinTheta, box2.centre, box2.size / 2, box2.cosTheta, box2.sinTheta);
+	}
+	else if ((s1.id == 1 || s1.id == 2) && s2.id == 5) // AABB - Capsule, and OBB - Capsule
+	{
+		box1 = s1.getBox();
+
+		return umath::capsuleObbCollision(s2.capsule.start, s2.capsule.end, s2.capsule.radius, box1.centre, box1.size / 2, box1.cosTheta, box1.sinTheta);
+	}
 
-		col = collision(((OOP::PrimitiveCapsule *)p1)->getCircle1(), ((OOP::PrimitiveCapsule *)p2)->getCircle2());// p1 circ1 and p2 circ2
-		if (col == true)
-			return col;
+	return false;
+}
 
-		col = collision(((OOP::PrimitiveCapsule *)p1)->getCircle2(), ((OOP::PrimitiveCapsule *)p2)->getCircle1()); // p1 circ2 and p2 circ1
-		if (col == true)
-			return col;
+// collision between two world shapes, with the contact.
+bool OOP::WorldShape::collision(const OOP::WorldShape & s1, const OOP::WorldShape & s2, OOP::Contact & contact)
+{
+	OOP::OBB box; // the box, for the checks that treat an AABB as an OBB.
+	OOP::OBB box2;
+	bool col = false;
 
-		col = collision(((OOP::PrimitiveCapsule *)p1)->getCircle2(), ((OOP::PrimitiveCapsule *)p2)->getCircle2());// p1 circ2 and p2 circ2
-		if (col == true)
-			return col;
+	if (s1.id > s2.id) // the shapes are swapped so that the lower id comes first, and then the normal is flipped back.
+	{
+		col = collision(s2, s1, contact);
 
-		col = collision(((OOP::PrimitiveCapsule *)p1)->getOrientedRect(), ((OOP::PrimitiveCapsule *)p2)->getOrientedRect()); // p1 oriented rect and p2 oriented rect
+		if (col)
+			contact.normal = -contact.normal;
 
+		return col;
 	}
-	else if ((p1->getId() == 1 && p2->getId() == 2) || (p1->getId() == 2 || p2->getId() == 1)) // AABB and OBB (or OBB and AABB) - converts AABB to OBB.
+
+	// the checks that push the second shape out of the first one have their normals flipped.
+	if ((s1.id == 1 || s1.id == 2) && (s2.id == 1 || s2.id == 2)) // AABB - AABB, AABB - OBB, and OBB - OBB
 	{
-		if (p1->getId() == 2 || p2->getId() == 1) // swaps the primitives for the collision check.
-			return collision(p2, p1);
+		box = s1.getBox();
+		box2 = s2.getBox();
 
-		return umath::obbCollision(((OOP::PrimitiveSquare *)p1)->getRect(), 0.0F, ((OOP::PrimitiveOrientedSquare *)p2)->getRect(), ((OOP::PrimitiveOrientedSquare *)p2)->getRotationInRadians(), false);
+		return umath::obbContact(box.centre, box.size / 2, box.cosTheta, box.sinTheta, box2.centre, box2.size / 2, box2.cosTheta, box2.sinTheta, contact.normal, contact.depth);
+	}
+	else if ((s1.id == 1 || s1.id == 2) && s2.id == 3) // AABB - Circle, and OBB - Circle
+	{
+		box = s1.getBox();
+		col = umath::circleObbContact(s2.circle.centre, s2.circle.radius, box.centre, box.size / 2, box.cosTheta, box.sinTheta, contact.normal, contact.depth);
+	}
+	else if ((s1.id == 1 || s1.id == 2) && s2.id == 5) // AABB - Capsule, and OBB - Capsule
+	{
+		box = s1.getBox();
+		col = umath::capsuleObbContact(s2.capsule.start, s2.capsule.end, s2.capsule.radius, box.centre, box.size / 2, box.cosTheta, box.sinTheta, contact.normal, contact.depth);
+	}
+	else if (s1.id == 3 && s2.id == 3) // Circle - Circle
+	{
+		return umath::circleContact(s1.circle.centre, s1.circle.radius, s2.circle.centre, s2.circle.radius, contact.normal, contact.depth);
+	}
+	else if (s1.id == 3 && s2.id == 5) // Circle - Capsule
+	{
+		col = umath::capsuleCircleContact(s2.capsule.start, s2.capsule.end, s2.capsule.radius, s1.circle.centre, s1.circle.radius, contact.normal, contact.depth);
 	}
-	else if ((p1->getId() == 1 && p2->getId() == 3) || (p1->getId() == 3 || p2->getId() == 1)) // AABB and circle
+	else if (s1.id == 5 && s2.id == 5) // Capsule - Capsule
 	{
-		if (p1->getId() == 3 || p2->getId() == 1) // swaps the primitives for the collision check.
-			return collision(p2, p1);
+		return umath::capsuleContact(s1.capsule.start, s1.capsule.end, s1.capsule.radius, s2.capsule.start, s2.capsule.end, s2.capsule.radius, contact.normal, contact.depth);
+	}
+
+	if (col)
+		contact.normal = -contact.normal;
+
+	return col;
+}
 
-		return umath::aabbCircleCollision(((OOP::PrimitiveSquare *)p1)->getRect(), p2->getPosition(), ((OOP::PrimitiveCircle *)p2)->m_RADIUS);
+// gets a box surrounding the shape.
+OOP::AABB OOP::WorldShape::getBounds() const
+{
+	OOP::AABB bounds;
+	cocos2d::Vec2 extents; // half of the size of the box.
 
+	switch (id)
+	{
+	case 1: // AABB
+		return aabb;
+
+	case 2: // OBB; the extents of a rotated box are found by projecting its half size onto both axes.
+		extents.x = (fabsf(obb.cosTheta) * obb.size.x + fabsf(obb.sinTheta) * obb.size.y) / 2;
+		extents.y = (fabsf(obb.sinTheta) * obb.size.x + fabsf(obb.cosTheta) * obb.size.y) / 2;
+		bounds.min = obb.centre - extents;
+		bounds.max = obb.centre + extents;
+		break;
+
+	case 3: // circle
+		bounds.min = circle.centre - cocos2d::Vec2(circle.radius, circle.radius);
+		bounds.max = circle.centre + cocos2d::Vec2(circle.radius, circle.radius);
+		break;
+
+	case 5: // capsule
+		bounds.min = cocos2d::Vec2(std::min(capsule.start.x, capsule.end.x), std::min(capsule.start.y, capsule.end.y)) - cocos2d::Vec2(capsule.radius, capsule.radius);
+		bounds.max = cocos2d::Vec2(std::max(capsule.start.x, capsule.end.x), std::max(capsule.start.y, capsule.end.y)) + cocos2d::Vec2(capsule.radius, capsule.radius);
+		break;
 	}
 
-	return false;
+	return bounds;
 }
 
+// gets the shape as an oriented box.
+OOP::OBB OOP::WorldShape::getBox() const
+{
+	OOP::OBB box;
+
+	if (id == 2)
+		return obb;
 
+	box.centre = (aabb.min + aabb.max) / 2;
+	box.size = aabb.max - aabb.min;
+	box.theta = 0.0F;
+	box.cosTheta = 1.0F;
+	box.sinTheta = 0.0F;
+
+	return box;
+}
 
 ///// SQUARE /////////////////////////////////////////////////////////////////////////////
-// initalization of the DrawNode (Square)
+// initalization of the square. The drawNode is made later if the square needs to be drawn.
 OOP::PrimitiveSquare::PrimitiveSquare(const cocos2d::Vec2 &a_StartPosition, const cocos2d::Vec2 &a_EndPosition, const cocos2d::Color4F colour) 
-	: Primitive(1), /*m_Node(cocos2d::DrawNode::create()),*/ m_WIDTH(abs((a_EndPosition - a_StartPosition).x)), m_HEIGHT(abs((a_EndPosition - a_StartPosition).y))
+	: Primitive(1, colour), m_WIDTH(abs((a_EndPosition - a_StartPosition).x)), m_HEIGHT(abs((a_EndPosition - a_StartPosition).y))
 {
-	// draws the rectangle
-	m_Node->drawRect(cocos2d::Vec2(0.0F, 0.0F) - cocos2d::Vec2(m_WIDTH / 2, m_HEIGHT / 2), cocos2d::Vec2(0.0F, 0.0F) + cocos2d::Vec2(m_WIDTH / 2, m_HEIGHT / 2), colour);
-	m_Node->setPosition((a_StartPosition + a_EndPosition) / 2); // sets the position to be the middle of the two corners of the quadrilateral.
+	m_Position = (a_StartPosition + a_EndPosition) / 2; // sets the position to be the middle of the two corners of the quadrilateral.
 }
 
 // creates a rect based on a position, length, and width provided by the user. This is based on the middle of the rect.
 OOP::PrimitiveSquare::PrimitiveSquare(const cocos2d::Vec2 position, const float width, const float height, const cocos2d::Color4F colour)
-	: Primitive(1), /*m_Node(cocos2d::DrawNode::create()),*/ m_WIDTH(width), m_HEIGHT(height)
+	: Primitive(1, colour), m_WIDTH(width), m_HEIGHT(height)
 {
-	// draws the rectangle at location (0, 0).
-	m_Node->drawRect(cocos2d::Vec2(0.0F, 0.0F) - cocos2d::Vec2(width / 2, height / 2), cocos2d::Vec2(0.0F, 0.0F) + cocos2d::Vec2(width / 2, height / 2), colour);
-	m_Node->setPosition(position); // sets the position of the node to be where the rectangle should be.
+	m_Position = position; // sets the position of the rectangle.
 }
 
 // creates a rect based on a given position and side length; this is guaranteed to be a square. This is based on the middle of the square.
@@ -164,16 +402,23 @@ OOP::PrimitiveSquare::PrimitiveSquare(const cocos2d::Vec2 position, const float
 OOP::PrimitiveSquare::~PrimitiveSquare() { /*m_Node->release();*/ }
 
 // Question 4: returns the square primitive
-cocos2d::DrawNode * OOP::PrimitiveSquare::getPrimitive() const { return m_Node; }
+cocos2d::DrawNode * OOP::PrimitiveSquare::getPrimitive() { return Primitive::getPrimitive(); }
 
 // sets the position of the primitive.
 void OOP::PrimitiveSquare::setPosition(cocos2d::Vec2 position)
 {
-	m_Node->setPosition(position); // changes the node's position.
+	m_Position = position;
+	updateNode(); // changes the node's position.
 }
 
 // returns the rectangle object representing the primitive graphic.
-cocos2d::Rect OOP::PrimitiveSquare::getRect() const { return cocos2d::Rect(m_Node->getPositionX() - m_WIDTH / 2, m_Node->getPositionY() - m_HEIGHT / 2, m_WIDTH, m_HEIGHT); }
+cocos2d::Rect OOP::PrimitiveSquare::getRect() const { return cocos2d::Rect(m_Position.x - m_WIDTH / 2, m_Position.y - m_HEIGHT / 2, m_WIDTH, m_HEIGHT); }
+
+// draws the rectangle at location (0, 0).
+void OOP::PrimitiveSquare::draw()
+{
+	m_Node->drawRect(cocos2d::Vec2(0.0F, 0.0F) - cocos2d::Vec2(m_WIDTH / 2, m_HEIGHT / 2), cocos2d::Vec2(0.0F, 0.0F) + cocos2d::Vec2(m_WIDTH / 2, m_HEIGHT / 2), m_Colour);
+}
 
 ///// ORIENTED SQUARE ////////////////////////////////////////////////////////////////////
 // bases on start and end position. This reuses a different function.
@@ -188,7 +433,7 @@ OOP::PrimitiveOrientedSquare::PrimitiveOrientedSquare(const cocos2d::Vec2 & posi
 	if (inDegrees == false) // if the angle is in radians, it is converted into degrees.
 		rotation = umath::radiansToDegrees(rotation);
 
-	m_Node->setRotation(rotation); // rotates the drawNode.
+	m_Rotation = rotation; // rotates the square.
 }
 
 // creates a primitive oriented square out of a regular primitive square.
@@ -196,27 +441,30 @@ OOP::PrimitiveOrientedSquare::PrimitiveOrientedSquare(const OOP::PrimitiveSquare
 	: PrimitiveSquare(sqrPrim)
 {
 	ID = 2;
-	m_Node->setRotation(0.0F);
+	m_Rotation = 0.0F;
 }
 
 // gets the rotation factor in degrees. This is inherently how the rotation factor is stored.
-float OOP::PrimitiveOrientedSquare::getRotationInDegrees() const { return m_Node->getRotation(); }
+float OOP::PrimitiveOrientedSquare::getRotationInDegrees() const { return m_Rotation; }
 
 // sets the rotation factor of the primitive using degrees. // sets the rotation factor for the primitive. 
-void OOP::PrimitiveOrientedSquare::setRotationInDegrees(float rotation)  { m_Node->setRotation(rotation); }
+void OOP::PrimitiveOrientedSquare::setRotationInDegrees(float rotation)
+{
+	m_Rotation = rotation;
+	updateNode();
+}
 
 // gets rthe rotation of the primitive in radians
-float OOP::PrimitiveOrientedSquare::getRotationInRadians() const { return umath::degreesToRadians(m_Node->getRotation()); }
+float OOP::PrimitiveOrientedSquare::getRotationInRadians() const { return umath::degreesToRadians(m_Rotation); }
 
 // sets the rotation of the primitive in radians
-void OOP::PrimitiveOrientedSquare::setRotationInRadians(float rotation) { m_Node->setRotation(umath::radiansToDegrees(rotation)); }
+void OOP::PrimitiveOrientedSquare::setRotationInRadians(float rotation) { setRotationInDegrees(umath::radiansToDegrees(rotation)); }
 
 ///// CIRCLE /////////////////////////////////////////////////////////////////////////////
-// initalizes the drawNode
-OOP::PrimitiveCircle::PrimitiveCircle(cocos2d::Vec2 location, float radius, const cocos2d::Color4F colour) : Primitive(3), /*m_Node(cocos2d::DrawNode::create()),*/ m_RADIUS(abs(radius))
+// initalizes the circle
+OOP::PrimitiveCircle::PrimitiveCircle(cocos2d::Vec2 location, float radius, const cocos2d::Color4F colour) : Primitive(3, colour), m_RADIUS(abs(radius))
 {
-	m_Node->drawCircle(cocos2d::Vec2(0.0F, 0.0F), abs(radius), 20.0F, 30, false, cocos2d::Color4F(0.0, 0.0F, 1.0F, 1.0F)); // draws the circle at location (0, 0).
-	m_Node->setPosition(location); // moves the circle to where it shoudld be.
+	m_Position = location; // moves the circle to where it shoudld be.
 }
 
 OOP::PrimitiveCircle::~PrimitiveCircle() { /*m_Node->release();*/ }
@@ -224,19 +472,24 @@ OOP::PrimitiveCircle::~PrimitiveCircle() { /*m_Node->release();*/ }
 // sets the position of the primitive.
 void OOP::PrimitiveCircle::setPosition(cocos2d::Vec2 position)
 {
-	m_Node->setPosition(position); // changes the position of the draw node.
+	m_Position = position;
+	updateNode(); // changes the position of the draw node.
+}
+
+// draws the circle at location (0, 0).
+void OOP::PrimitiveCircle::draw()
+{
+	m_Node->drawCircle(cocos2d::Vec2(0.0F, 0.0F), m_RADIUS, 20.0F, 30, false, cocos2d::Color4F(0.0, 0.0F, 1.0F, 1.0F));
 }
 
 
 ///// LINE ///////////////////////////////////////////////////////////////////////////////
-// initalization of the DrawNode (Line)
+// initalization of the line
 OOP::PrimitiveLine::PrimitiveLine(cocos2d::Vec2 startingPoint, cocos2d::Vec2 endingPoint, const cocos2d::Color4F colour)
-	: Primitive(4), /*m_Node(cocos2d::DrawNode::create()),*/ m_DISTANCE(cocos2d::Vec2(endingPoint - startingPoint)),
+	: Primitive(4, colour), m_DISTANCE(cocos2d::Vec2(endingPoint - startingPoint)),
 	m_LENGTH (sqrt(pow((endingPoint - startingPoint).x, 2) + pow((endingPoint - startingPoint).y, 2)))
 {
-	// draws the line with its centre at position (0.0F, 0.0F).
-	m_Node->drawLine(cocos2d::Vec2(0.0F - abs(m_DISTANCE.x / 2), 0.0F - abs(m_DISTANCE.y / 2)), cocos2d::Vec2(0.0F + abs(m_DISTANCE.x / 2), 0.0F + abs(m_DISTANCE.y / 2)), colour);
-	m_Node->setPosition((startingPoint + endingPoint) / 2); // sets the position of the node to where the shape should be.
+	m_Position = (startingPoint + endingPoint) / 2; // sets the position of the line to where the shape should be.
 }
 
 
@@ -245,25 +498,36 @@ OOP::PrimitiveLine::~PrimitiveLine() { /*m_Node->release();*/ }
 // sets the position of the primitive.
 void OOP::PrimitiveLine::setPosition(cocos2d::Vec2 position)
 {
-	m_Node->setPosition(position); // sets the position of the node.
+	m_Position = position;
+	updateNode(); // sets the position of the node.
 }
 
 // gets the rotation factor in degrees. This is inherently how the rotation factor is stored.
-float OOP::PrimitiveLine::getRotationInDegrees() const { return m_Node->getRotation(); }
+float OOP::PrimitiveLine::getRotationInDegrees() const { return m_Rotation; }
 
 // sets the rotation factor of the primitive using degrees. // sets the rotation factor for the primitive. 
-void OOP::PrimitiveLine::setRotationInDegrees(float rotation) { m_Node->setRotation(rotation); }
+void OOP::PrimitiveLine::setRotationInDegrees(float rotation)
+{
+	m_Rotation = rotation;
+	updateNode();
+}
 
 // gets rthe rotation of the primitive in radians
-float OOP::PrimitiveLine::getRotationInRadians() const { return umath::degreesToRadians(m_Node->getRotation()); }
+float OOP::PrimitiveLine::getRotationInRadians() const { return umath::degreesToRadians(m_Rotation); }
 
 // sets the rotation of the primitive in radians
-void OOP::PrimitiveLine::setRotationInRadians(float rotation) { m_Node->setRotation(umath::radiansToDegrees(rotation)); }
+void OOP::PrimitiveLine::setRotationInRadians(float rotation) { setRotationInDegrees(umath::radiansToDegrees(rotation)); }
+
+// draws the line with its centre at position (0.0F, 0.0F).
+void OOP::PrimitiveLine::draw()
+{
+	m_Node->drawLine(cocos2d::Vec2(0.0F - abs(m_DISTANCE.x / 2), 0.0F - abs(m_DISTANCE.y / 2)), cocos2d::Vec2(0.0F + abs(m_DISTANCE.x / 2), 0.0F + abs(m_DISTANCE.y / 2)), m_Colour);
+}
 
 //// CAPSULE /////////////////////////////////////////////////////////////////////////////
 // creates a capsule
 OOP::PrimitiveCapsule::PrimitiveCapsule(cocos2d::Vec2 startingPoint, cocos2d::Vec2 endingPoint, float radius, const cocos2d::Color4F colour)
-	: Primitive(5), /*m_Node(cocos2d::DrawNode::create()),*/ m_RADIUS(abs(radius)), m_RECT_WIDTH(abs(endingPoint.x - startingPoint.x)), m_RECT_HEIGHT(abs(endingPoint.y - startingPoint.y))
+	: Primitive(5, colour), m_RADIUS(abs(radius)), m_RECT_WIDTH(abs(endingPoint.x - startingPoint.x)), m_RECT_HEIGHT(abs(endingPoint.y - startingPoint.y))
 {
 	// Works when angle is greater than 3.14 rad, or when a 90 degree angle
 
@@ -309,16 +573,10 @@ OOP::PrimitiveCapsule::PrimitiveCapsule(cocos2d::Vec2 startingPoint, cocos2d::Ve
 	// angle = M_PI - angle; // flips the angle to the adjacent quadrant. Used to move the centre lines.
 	offset = cocos2d::Vec2(offset.x * (cosf(angle)) - offset.y * (sinf(angle)), offset.x * (sinf(angle)) + offset.y * (cosf(angle)));
 
-	// original drawLines
-	// drawing the starting and ending circles. These now subtract the position of the capsule so that the centre is at (0, 0).
-	m_Node->drawCircle(startingPoint - position, radius, 0.0F, 30, false, colour);
-	m_Node->drawCircle(endingPoint - position, radius, 0.0F, 30, false, colour);
-
-	// drawing the two lines.  These now subtract the position of the capsule so that the centre is at (0, 0).
-	m_Node->drawLine(startingPoint + offset - position, endingPoint + offset - position, colour);
-	m_Node->drawLine(startingPoint - offset - position, endingPoint - offset - position, colour);
+	// the lines and circles are drawn when the drawNode gets made (see draw()), so the offset of the lines is saved.
+	m_LineOffset = offset;
 
-	m_Node->setPosition(position); // sets the position of the drawNode to where the capsule should be.
+	m_Position = position; // sets the position of the capsule.
 	m_Circle1 = startingPoint; // saves the location of the starting point as the location of the first circle.
 	m_Circle2 = endingPoint; // saves the location of the ending circle as the endingPoint of the capsule, which is where the circle was drawn.
 
@@ -358,22 +616,12 @@ OOP::PrimitiveCapsule::~PrimitiveCapsule() { /*m_Node->release();*/ }
 // sets the position of the primitive.
 void OOP::PrimitiveCapsule::setPosition(cocos2d::Vec2 position)
 {
-	cocos2d::Vec2 oldPos = m_Node->getPosition(); // gets the old position of the capsule.
+	cocos2d::Vec2 oldPos = m_Position; // gets the old position of the capsule.
 
-	m_Node->setPosition(position);
+	m_Position = position;
+	updateNode();
 	m_Circle1 += position - oldPos; // gets the location of the new circle by offsetting it by how much the capsule moved.
 	m_Circle2 += position - oldPos; // gets the location of the new circle by offsetting it by how much the capsule moved.
-
-	/*
-	// because the position of the node isn't the same as the primitive itself, this calculation is needed.
-	m_Node->setPosition(m_Node->getPosition() + position - m_Position);
-	
-	// changes the positions of the circles
-	m_Circle1 += position - m_Position;
-	m_Circle2 += position - m_Position;
-
-	this->m_Position = position;
-	*/
 }
 
 // gets the starting circle of the capsule
@@ -397,56 +645,42 @@ float OOP::PrimitiveCapsule::getRotationInDegrees() const { return m_theta; }
 // sets the rotation factor of the capsule.
 void OOP::PrimitiveCapsule::setRotationInDegrees(float newTheta)
 {
-	float nodeTheta = m_Node->getRotation(); // gets the rotation factor of the drawNode (in degrees).
 	float netTheta = newTheta - m_theta; // gets the net change in the capsule's rotation factor.
 
-	m_Node->setRotation(m_Node->getRotation() + netTheta); // sets the node's rotation based on what the orientation of the capsule should be.
+	m_Rotation += netTheta; // sets the node's rotation based on what the orientation of the capsule should be.
+	updateNode();
 	m_theta = newTheta; // saves the rotation factor of the capsule.
 }
 
 // gets the rotation factor in radians
-float OOP::PrimitiveCapsule::getRotationInRadians() const { return umath::degreesToRadians(m_Node->getRotation()); }
+float OOP::PrimitiveCapsule::getRotationInRadians() const { return umath::degreesToRadians(m_Rotation); }
 
 // sets the rotation factor in radians
 void OOP::PrimitiveCapsule::setRotationInRadians(float newTheta){ setRotationInDegrees(umath::radiansToDegrees(newTheta)); }
 
-///// GRID ///////////////////////////////////////////////////////////////////////////////
-// creates a grid
-OOP::PrimitiveGrid::PrimitiveGrid(cocos2d::Vec2 startingPoint, cocos2d::Vec2 endingPoint, const float squareSize, const cocos2d::Color4F colour, const bool gridBox)
-	: Primitive(6), /*m_Node(cocos2d::DrawNode::create()),*/ m_WIDTH(abs((startingPoint - endingPoint).x)), m_HEIGHT(abs((startingPoint - endingPoint).y)), m_SQUARE_SIZE(squareSize)
+// draws the capsule with its centre at (0, 0).
+void OOP::PrimitiveCapsule::draw()
 {
-	const cocos2d::Vec2 POSITION = (startingPoint + endingPoint) / 2; // gets the position of the grid.
-	cocos2d::Vec2 tempVec1;
-	cocos2d::Vec2 tempVec2;
-
-	if (startingPoint.x > endingPoint.x) // switches the start point and end point if the ending point is before the starting point.
-	{
-		tempVec1 = startingPoint;
-		startingPoint = endingPoint;
-		endingPoint = tempVec1;
-	}
+	// the circles are drawn relative to where the capsule was when it was last moved, which is the same as the circles relative to the position.
+	cocos2d::Vec2 startingPoint = m_Circle1 - m_Position;
+	cocos2d::Vec2 endingPoint = m_Circle2 - m_Position;
 
-	tempVec1 = cocos2d::Vec2(0.0F, 0.0F) - cocos2d::Vec2((endingPoint - startingPoint) / 2); // gets the starting point of the graph with its centre at (0.0F, 0.0F)
-	tempVec2 = cocos2d::Vec2(0.0F, 0.0F) + cocos2d::Vec2((endingPoint - startingPoint) / 2); // gets the ending point of the graph with its centre at (0.0F, 0.0F)
+	// drawing the starting and ending circles.
+	m_Node->drawCircle(startingPoint, m_RADIUS, 0.0F, 30, false, m_Colour);
+	m_Node->drawCircle(endingPoint, m_RADIUS, 0.0F, 30, false, m_Colour);
 
-	startingPoint = tempVec1; // overrides the startingPoint so that it's in reference to the drawNode's origin (0.0F, 0.0F).
-	endingPoint = tempVec2; // overrides the endingPoint so that it's in reference to the drawNode's origin (0.0F, 0.0F).
-
-	// draws horizontal lines until the bounds of the grid are reached.
-	for (float i = 0; startingPoint.y + i < endingPoint.y; i += squareSize)
-		m_Node->drawLine(startingPoint + cocos2d::Vec2(0.0F, i), cocos2d::Vec2(endingPoint.x, startingPoint.y + i), colour); // draws a horizontal line
-
-	// vertical lines until the bounds of the grid are reached.
-	for (float i = 0; startingPoint.x + i < endingPoint.x; i += squareSize)
-		m_Node->drawLine(startingPoint + cocos2d::Vec2(i, 0.0F), cocos2d::Vec2(startingPoint.x + i, endingPoint.y), colour); // draws a vertical line
-
-
-	// if 'gridBox' is 'true', then a quadrilateral is drawn around the whole grid.
-	if (gridBox)
-		m_Node->drawRect(startingPoint, endingPoint, colour);
+	// drawing the two lines.
+	m_Node->drawLine(startingPoint + m_LineOffset, endingPoint + m_LineOffset, m_Colour);
+	m_Node->drawLine(startingPoint - m_LineOffset, endingPoint - m_LineOffset, m_Colour);
+}
 
-	m_Node->setPosition(POSITION); // sets the node to the position of the grid.
-	m_Node->setGlobalZOrder(10.3F); // sets the global z order of the grid. This is different from the global z order of other primitives.
+///// GRID ///////////////////////////////////////////////////////////////////////////////
+// creates a grid
+OOP::PrimitiveGrid::PrimitiveGrid(cocos2d::Vec2 startingPoint, cocos2d::Vec2 endingPoint, const float squareSize, const cocos2d::Color4F colour, const bool gridBox)
+	: Primitive(6, colour), m_WIDTH(abs((startingPoint - endingPoint).x)), m_HEIGHT(abs((startingPoint - endingPoint).y)), m_SQUARE_SIZE(squareSize), m_GridBox(gridBox)
+{
+	m_Position = (startingPoint + endingPoint) / 2; // sets the grid to its position.
+	setGlobalZOrder(10.3F); // sets the global z order of the grid. This is different from the global z order of other primitives.
 }
 
 // creates a grid using a size and position instead of a starting point and ending point.
@@ -462,5 +696,25 @@ OOP::PrimitiveGrid::~PrimitiveGrid() { /*m_Node->release();*/ }
 // sets the position of the primitive.
 void OOP::PrimitiveGrid::setPosition(cocos2d::Vec2 position)
 {
-	m_Node->setPosition(position);
+	m_Position = position;
+	updateNode();
+}
+
+// draws the grid with its centre at (0, 0).
+void OOP::PrimitiveGrid::draw()
+{
+	cocos2d::Vec2 startingPoint = cocos2d::Vec2(0.0F, 0.0F) - cocos2d::Vec2(m_WIDTH, m_HEIGHT) / 2; // the starting corner of the grid.
+	cocos2d::Vec2 endingPoint = cocos2d::Vec2(0.0F, 0.0F) + cocos2d::Vec2(m_WIDTH, m_HEIGHT) / 2; // the ending corner of the grid.
+
+	// draws horizontal lines until the bounds of the grid are reached.
+	for (float i = 0; startingPoint.y + i < endingPoint.y; i += m_SQUARE_SIZE)
+		m_Node->drawLine(startingPoint + cocos2d::Vec2(0.0F, i), cocos2d::Vec2(endingPoint.x, startingPoint.y + i), m_Colour); // draws a horizontal line
+
+	// vertical lines until the bounds of the grid are reached.
+	for (float i = 0; startingPoint.x + i < endingPoint.x; i += m_SQUARE_SIZE)
+		m_Node->drawLine(startingPoint + cocos2d::Vec2(i, 0.0F), cocos2d::Vec2(startingPoint.x + i, endingPoint.y), m_Colour); // draws a vertical line
+
+	// if 'gridBox' is 'true', then a quadrilateral is drawn around the whole grid.
+	if (m_GridBox)
+		m_Node->drawRect(startingPoint, endingPoint, m_Colour);
 }
@@ -10,30 +10,139 @@
 
 namespace OOP
 {
+	class Primitive;
+
+	// a plain axis-aligned bounding box in world space. 'min' is the bottom left corner, and 'max' is the top right corner.
+	struct AABB
+	{
+		cocos2d::Vec2 min;
+		cocos2d::Vec2 max;
+	};
+
+	// a plain oriented bounding box in world space. The rotation factor is in radians.
+	// the cosine and sine of the rotation are worked out when the box is made, so the collision checks don't need to do any trig.
+	struct OBB
+	{
+		cocos2d::Vec2 centre;
+		cocos2d::Vec2 size;
+		float theta;
+		float cosTheta;
+		float sinTheta;
+	};
+
+	// a plain circle in world space.
+	struct Circle
+	{
+		cocos2d::Vec2 centre;
+		float radius;
+	};
+
+	// a plain capsule in world space. 'start' and 'end' are the centres of the two circles on the ends of the capsule.
+	struct Capsule
+	{
+		cocos2d::Vec2 start;
+		cocos2d::Vec2 end;
+		float radius;
+	};
+
+	// how two shapes are touching. 'normal' is the direction the first shape needs to move in to get out of the second one (with a length of 1), and 'depth' is how far it needs to move.
+	struct Contact
+	{
+		cocos2d::Vec2 normal;
+		float depth;
+	};
+
+	/*
+	 * A world space version of a collision primitive. This has no drawNode, so it can be created on the stack (or kept in a reused vector) without any heap allocations.
+	 * Only the member that matches the 'id' is filled in. The ids are the same as the ones used by the primitives.
+		* 1 = AABB (aabb)
+		* 2 = OBB (obb)
+		* 3 = circle (circle)
+		* 5 = capsule (capsule)
+	*/
+	struct WorldShape
+	{
+		short int id;
+
+		// the primitive this shape was made from. This is where the 'active' parameter is read from.
+		const OOP::Primitive * source;
+
+		OOP::AABB aabb;
+		OOP::OBB obb;
+		OOP::Circle circle;
+		OOP::Capsule capsule;
+
+		/*
+		 * collision between two world shapes. Returns false if there is no collision. This does not check if the sources are active.
+		 * every pair of shapes has a check. The boxes are checked with the separating axis theorem, and the circles and capsules are checked using the closest points to them.
+		*/
+		static bool collision(const OOP::WorldShape & s1, const OOP::WorldShape & s2);
+
+		// collision between two world shapes, which also gets how 's1' should be pushed out of 's2'. If there's no collision, 'false' is returned and the contact is left alone.
+		// the shapes collide in the same cases as the other check (apart from rounding), except for circle-circle, which doesn't round the distance down here.
+		static bool collision(const OOP::WorldShape & s1, const OOP::WorldShape & s2, OOP::Contact & contact);
+
+		// returns an axis-aligned box that fully surrounds the shape.
+		OOP::AABB getBounds() const;
+
+		// returns the shape as an oriented box. This only works for AABBs and OBBs; an AABB becomes a box with no rotation.
+		OOP::OBB getBox() const;
+	};
 
 	// a base primitive class. This has an abstract class so that the users can't create a primitive without specifying what shape it is.
+	// the primitive only stores its geometry. The drawNode used to see the primitive is only created once it's needed (i.e. when the primitive is made visible).
 	class Primitive
 	{
 	public:
-		// creates the draw node
-		Primitive(const short int ID);
-		// releases the drawNode
+		// creates the primitive. The drawNode is not created here.
+		Primitive(const short int ID, const cocos2d::Color4F colour = cocos2d::Color4F::RED);
+
+		// copies the primitive's geometry. The drawNode isn't shared, so the copy makes its own drawNode if it needs one.
+		Primitive(const OOP::Primitive & prim);
+		// releases the drawNode if one was made.
 		virtual ~Primitive();
 
-		// returns square primitive
-		cocos2d::DrawNode * getPrimitive() const;
+		// returns the drawNode for the primitive. If the drawNode hasn't been made yet, it gets made (and drawn) here.
+		// since this creates a drawNode, only call this if you actually need to draw the primitive.
+		cocos2d::DrawNode * getPrimitive();
+
+		// returns 'true' if the drawNode for this primitive has been made.
+		bool hasDrawNode() const;
+
+		// returns the amount of primitive drawNodes that currently exist.
+		static unsigned int getDrawNodeCount();
 
 		// gets the position of the vector.
 		cocos2d::Vec2 getPosition() const;
 
+		// gets the rotation of the primitive (in degrees). This doesn't need the drawNode, so it doesn't make one.
+		float getRotation() const;
+
+		// sets the rotation of the primitive (in degrees). If there's a drawNode, it's rotated to match.
+		// this only turns the drawing for primitives that collide as AABBs; the oriented primitives have their own rotation setters.
+		void setRotation(float rotation);
+
 		// sets the position of the primitive. This is a 'pure virtual' function so that an object of this type can't be created.
 		// the setPosition() was made virtual for the needs of specific derived classes.
 		virtual void setPosition(cocos2d::Vec2 position) = 0;
 
-		// returns whether the collision shape is visible or not.
+		// returns the node that the primitive's drawNode gets added to.
+		cocos2d::Node * getParent() const;
+
+		// sets the node that the primitive's drawNode gets added to (this is normally the sprite of the entity the primitive belongs to).
+		// if the drawNode hasn't been made, it will be added to this node once it is.
+		void setParent(cocos2d::Node * parent);
+
+		// removes the primitive from its parent node.
+		void removeFromParent();
+
+		// sets the global z order of the primitive's drawNode.
+		void setGlobalZOrder(float globalZOrder);
+
+		// returns whether the collision shape is visible or not. If there is no drawNode, then the primitive is not visible.
 		bool isVisible() const; 
 
-		// turns on/off the visibility of the primitive.
+		// turns on/off the visibility of the primitive. Making the primitive visible creates its drawNode if it doesn't have one.
 		void setVisible(bool visible);
 
 		// toggle for visible; it turns it on/off.
@@ -73,23 +182,41 @@ namespace OOP
 		short int getId();
 
 		/*
-		 * collision between two primitives. Returns false if there is no check availble, at least one of the primitives is inactive, or if there is no collision.
-		 * These are the included collision checks.
-			* AABB - AABB
-			* Circle - Circle
-			* AABB - OBB
-		
-		* Some collision checks are not compatible due to lacking code for certain combinations.
+		 * collision between two primitives. Returns false if either primitive is a line or a grid, at least one of the primitives is inactive, or if there is no collision.
+		 * the checks are the same as the ones for world shapes (see OOP::WorldShape::collision()).
 		*/
 		static bool collision(OOP::Primitive * p1, OOP::Primitive * p2);
 
+		// fills in 'shape' with this primitive in world space, with the primitive's position being offset by 'offset'. Nothing is allocated.
+		// returns false if the primitive has no world shape (i.e. lines and grids).
+		bool getWorldShape(const cocos2d::Vec2 & offset, OOP::WorldShape & shape) const;
+
 	private:
 		int tag = 0; // an identification tag
 
 		bool active = true; // used so that this collision shape can be turned on and off.
 
+		cocos2d::Node * m_Parent = nullptr; // the node the drawNode is added to.
+
+		float m_GlobalZOrder = 10.1F; // since primitives are treated as collision shapes, they have the global z order of 10.1F by default.
+
+		static unsigned int drawNodeCount; // the amount of primitive drawNodes that currently exist.
+
 	protected:
-		cocos2d::DrawNode * m_Node; // drawNode member
+		// draws the primitive into the drawNode. The shape is drawn with its centre at (0, 0), and the drawNode is moved to the primitive's position.
+		// this is only called when the drawNode is made.
+		virtual void draw() = 0;
+
+		// applies the primitive's position and rotation to the drawNode, if there is one.
+		void updateNode();
+
+		cocos2d::DrawNode * m_Node = nullptr; // drawNode member. This stays as a nullptr until the primitive needs to be drawn.
+
+		cocos2d::Vec2 m_Position; // the position of the primitive.
+
+		float m_Rotation = 0.0F; // the rotation factor of the primitive (in degrees), which is also the rotation factor of the drawNode.
+
+		cocos2d::Color4F m_Colour; // the colour the primitive is drawn in.
 
 		/*
 		 * The type of the primitive. Use this for reference when you need to know what to downcast to.
@@ -123,7 +250,7 @@ namespace OOP
 		~PrimitiveSquare();
 
 		// returns square primitive
-		cocos2d::DrawNode * getPrimitive() const;
+		cocos2d::DrawNode * getPrimitive();
 
 		// sets the position of the primitive.
 		void setPosition(cocos2d::Vec2 position);
@@ -140,6 +267,9 @@ namespace OOP
 
 	private:
 
+	protected:
+		// draws the rectangle.
+		void draw();
 	};
 
 	// a subclass of the PrimitiveSquare class that allows for rotations.
@@ -189,6 +319,9 @@ namespace OOP
 
 	private:
 
+	protected:
+		// draws the circle.
+		void draw();
 	};
 
 	// Line Primitive Class
@@ -223,6 +356,9 @@ namespace OOP
 		const float m_LENGTH;
 	private:
 
+	protected:
+		// draws the line.
+		void draw();
 	};
 
 	// Capsule Primitive Class
@@ -286,6 +422,12 @@ namespace OOP
 		cocos2d::Vec2 m_Circle2; // saves the position of the ending circle of the capsule.
 
 		float m_theta; // the rotation factor of the capsule (in degrees)
+
+		cocos2d::Vec2 m_LineOffset; // the offset of the two lines of the capsule from the line between the centres of the circles.
+
+	protected:
+		// draws the capsule.
+		void draw();
 	};
 
 	// creates a grid of lines; not from original assignment
@@ -328,7 +470,11 @@ namespace OOP
 		float m_SQUARE_SIZE; 
 
 	private:
+		bool m_GridBox; // if 'true', a box is drawn around the grid.
 
+	protected:
+		// draws the grid.
+		void draw();
 	};
 }
 
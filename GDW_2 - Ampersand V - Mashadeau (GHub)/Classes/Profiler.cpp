@@ -0,0 +1,193 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+// constructor
+OOP::Profiler::Profiler(unsigned int capacity) : capacity((capacity > 0) ? capacity : 1) {}
+
+// adds a phase.
+unsigned int OOP::Profiler::addPhase(const std::string & name)
+{
+	for (unsigned int i = 0; i < phases.size(); i++) // if the phase already exists, it's used again.
+	{
+		if (phases[i].name == name)
+			return i;
+	}
+
+	phases.push_back(Phase());
+	phases.back().name = name;
+	phases.back().samples.resize(capacity, 0.0F);
+
+	// the new phase hasn't been timed in the frames that have already been recorded, so those are left at 0.
+	return phases.size() - 1;
+}
+
+// gets the amount of phases.
+unsigned int OOP::Profiler::getPhaseCount() const { return phases.size(); }
+
+// gets the name of a phase.
+const std::string & OOP::Profiler::getPhaseName(unsigned int phase) const { return phases.at(phase).name; }
+
+// adds time to a phase.
+void OOP::Profiler::addTime(unsigned int phase, float milliseconds)
+{
+	if (phase < phases.size())
+		phases[phase].frameTime += milliseconds;
+}
+
+// starts a frame.
+void OOP::Profiler::beginFrame()
+{
+	for (Phase & phase : phases)
+		phase.frameTime = 0.0F;
+}
+
+// ends a frame.
+void OOP::Profiler::endFrame()
+{
+	for (Phase & phase : phases)
+	{
+		phase.samples[next] = phase.frameTime;
+		phase.frameTime = 0.0F;
+	}
+
+	next = (next + 1) % capacity; // once the buffers are full, the oldest frame gets overwritten.
+
+	if (frames < capacity)
+		frames++;
+}
+
+// gets the amount of recorded frames.
+unsigned int OOP::Profiler::getFrameCount() const { return frames; }
+
+// gets the statistics for a phase.
+OOP::ProfileStats OOP::Profiler::getStats(unsigned int phase) const
+{
+	OOP::ProfileStats stats; // the statistics
+	std::vector<float> sorted; // the recorded times from shortest to longest.
+	double total = 0.0; // the total of all the times.
+
+	stats.name = phases.at(phase).name;
+	stats.samples = frames;
+
+	if (frames == 0)
+		return stats;
+
+	// until the buffer is full, only the start of it has been used.
+	sorted.assign(phases[phase].samples.begin(), phases[phase].samples.begin() + frames);
+	std::sort(sorted.begin(), sorted.end());
+
+	for (float sample : sorted)
+		total += sample;
+
+	stats.mean = (float)(total / frames);
+	stats.p95 = sorted[(unsigned int)ceilf(frames * 0.95F) - 1]; // nearest-rank percentiles.
+	stats.p99 = sorted[(unsigned int)ceilf(frames * 0.99F) - 1];
+	stats.max = sorted.back();
+
+	return stats;
+}
+
+// gets the statistics for all of the phases.
+std::vector<OOP::ProfileStats> OOP::Profiler::getAllStats() const
+{
+	std::vector<OOP::ProfileStats> stats; // the statistics for each phase.
+
+	for (unsigned int i = 0; i < phases.size(); i++)
+		stats.push_back(getStats(i));
+
+	return stats;
+}
+
+// gets the statistics as a table.
+std::string OOP::Profiler::getReport() const
+{
+	std::stringstream ss; // the table
+	unsigned int nameWidth = 5; // the width of the name column, which fits the longest name.
+
+	for (const Phase & phase : phases)
+		nameWidth = std::max(nameWidth, (unsigned int)phase.name.length());
+
+	ss << std::fixed << std::setprecision(3);
+	ss << std::left << std::setw(nameWidth) << "phase" << std::right << std::setw(9) << "mean" << std::setw(9) << "p95" << std::setw(9) << "p99" << std::setw(9) << "max" << "  (ms, " << frames << " frames)\n";
+
+	for (const OOP::ProfileStats & stats : getAllStats())
+		ss << std::left << std::setw(nameWidth) << stats.name << std::right << std::setw(9) << stats.mean << std::setw(9) << stats.p95 << std::setw(9) << stats.p99 << std::setw(9) << stats.max << "\n";
+
+	return ss.str();
+}
+
+// writes the statistics to a CSV file.
+bool OOP::Profiler::saveCSV(const std::string & filePath) const
+{
+	std::ofstream file(filePath); // the file being written
+
+	if (!file)
+		return false;
+
+	file << "phase,samples,mean_ms,p95_ms,p99_ms,max_ms\n";
+
+	for (const OOP::ProfileStats & stats : getAllStats())
+		file << stats.name << "," << stats.samples << "," << stats.mean << "," << stats.p95 << "," << stats.p99 << "," << stats.max << "\n";
+
+	return (bool)file;
+}
+
+// writes the statistics to a JSON file.
+bool OOP::Profiler::saveJSON(const std::string & filePath) const
+{
+	std::ofstream file(filePath); // the file being written
+	std::vector<OOP::ProfileStats> stats = getAllStats(); // the statistics to be written.
+
+	if (!file)
+		return false;
+
+	file << "{\n\t\"frames\": " << frames << ",\n\t\"phases\": [\n";
+
+	for (unsigned int i = 0; i < stats.size(); i++) // the phase names are made in code, so they don't need to be escaped.
+	{
+		file << "\t\t{ \"name\": \"" << stats[i].name << "\", \"mean_ms\": " << stats[i].mean << ", \"p95_ms\": " << stats[i].p95
+			<< ", \"p99_ms\": " << stats[i].p99 << ", \"max_ms\": " << stats[i].max << " }" << ((i + 1 < stats.size()) ? "," : "") << "\n";
+	}
+
+	file << "\t]\n}\n";
+
+	return (bool)file;
+}
+
+// clears the recorded frames.
+void OOP::Profiler::clear()
+{
+	for (Phase & phase : phases)
+	{
+		std::fill(phase.samples.begin(), phase.samples.end(), 0.0F);
+		phase.frameTime = 0.0F;
+	}
+
+	next = 0;
+	frames = 0;
+}
+
+// starts timing.
+OOP::ScopedTimer::ScopedTimer(OOP::Profiler * profiler, unsigned int phase) : profiler(profiler), phase(phase)
+{
+	if (profiler != nullptr)
+		start = std::chrono::steady_clock::now();
+}
+
+// stops timing.
+OOP::ScopedTimer::~ScopedTimer() { stop(); }
+
+// stops timing early.
+void OOP::ScopedTimer::stop()
+{
+	if (profiler == nullptr) // the timer has already been stopped, or there's no profiler.
+		return;
+
+	profiler->addTime(phase, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+	profiler = nullptr;
+}
@@ -0,0 +1,101 @@
+// times the phases of a frame (e.g. the area update, or a collision routine) and keeps the last few seconds of samples so that their mean, 95th and 99th percentile can be reported.
+// the profiler doesn't draw anything itself, so it can be used without a window. The gameplay scene shows the report as an overlay.
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace OOP
+{
+	// the statistics for one phase, in milliseconds.
+	struct ProfileStats
+	{
+		std::string name = ""; // the name of the phase.
+		unsigned int samples = 0; // the amount of frames the statistics cover.
+		float mean = 0.0F; // the average time.
+		float p95 = 0.0F; // 95% of the frames took this long or less.
+		float p99 = 0.0F; // 99% of the frames took this long or less.
+		float max = 0.0F; // the longest time.
+	};
+
+	class Profiler
+	{
+	public:
+		// creates a profiler that keeps the last 'capacity' frames for each phase. The default is 10 seconds at 60 frames per second.
+		Profiler(unsigned int capacity = 600);
+
+		// adds a phase that can be timed, and returns its index. If a phase with that name already exists, its index is returned instead.
+		unsigned int addPhase(const std::string & name);
+
+		// gets the amount of phases.
+		unsigned int getPhaseCount() const;
+
+		// gets the name of a phase.
+		const std::string & getPhaseName(unsigned int phase) const;
+
+		// adds time to a phase for the current frame. A phase can be timed several times in a frame (e.g. once per physics step); the times are added together.
+		void addTime(unsigned int phase, float milliseconds);
+
+		// starts a new frame.
+		void beginFrame();
+
+		// ends the frame, which puts the time for each phase into its ring buffer.
+		void endFrame();
+
+		// gets the amount of frames that have been recorded. This stops going up once the buffers are full.
+		unsigned int getFrameCount() const;
+
+		// gets the statistics for a phase over the recorded frames.
+		OOP::ProfileStats getStats(unsigned int phase) const;
+
+		// gets the statistics for all of the phases, in the order they were added.
+		std::vector<OOP::ProfileStats> getAllStats() const;
+
+		// gets the statistics as a table that can be shown on screen or printed out.
+		std::string getReport() const;
+
+		// writes the statistics to a CSV file. Returns 'false' if the file couldn't be written.
+		bool saveCSV(const std::string & filePath) const;
+
+		// writes the statistics to a JSON file. Returns 'false' if the file couldn't be written.
+		bool saveJSON(const std::string & filePath) const;
+
+		// removes all of the recorded frames. The phases are kept.
+		void clear();
+
+	private:
+		// a phase and the times recorded for it.
+		struct Phase
+		{
+			std::string name = ""; // the name of the phase.
+			float frameTime = 0.0F; // the time recorded for the current frame.
+			std::vector<float> samples; // the ring buffer of frame times.
+		};
+
+		std::vector<Phase> phases; // the phases being timed.
+
+		unsigned int capacity; // the amount of frames kept in each ring buffer.
+		unsigned int next = 0; // the index in the ring buffers the next frame goes into.
+		unsigned int frames = 0; // the amount of frames in the ring buffers.
+	};
+
+	// times a phase from when it's created until it goes out of scope. If no profiler is given, nothing is timed.
+	class ScopedTimer
+	{
+	public:
+		// starts timing the phase.
+		ScopedTimer(OOP::Profiler * profiler, unsigned int phase);
+
+		// stops timing, and adds the time to the profiler.
+		~ScopedTimer();
+
+		// stops timing before the timer goes out of scope. This is used when a phase doesn't end at the end of a block.
+		void stop();
+
+	private:
+		OOP::Profiler * profiler; // the profiler the time is added to.
+		unsigned int phase; // the phase being timed.
+		std::chrono::steady_clock::time_point start; // when the timer was started.
+	};
+}
@@ -15,7 +15,7 @@ Date: 04/04/2019
 
 //// SPRITE SHEET ANIMATION FRAME CLASS ////
 // constructor for sprite animation frame.
-OOP::SpriteSheetAnimationFrame::SpriteSheetAnimationFrame(cocos2d::Rect & rect, float delayUnits, int tag)
+OOP::SpriteSheetAnimationFrame::SpriteSheetAnimationFrame(const cocos2d::Rect & rect, float delayUnits, int tag)
 	: rect(rect), tag(tag)
 {
 	// this happens outside of the delay units for validation checking.
@@ -26,7 +26,7 @@ OOP::SpriteSheetAnimationFrame::SpriteSheetAnimationFrame(cocos2d::Rect & rect,
 cocos2d::Rect OOP::SpriteSheetAnimationFrame::getRect() const { return rect; }
 
 // sets the rect used for etting a section of the sprite sheet.
-void OOP::SpriteSheetAnimationFrame::setRect(cocos2d::Rect & rect) { this->rect = rect; }
+void OOP::SpriteSheetAnimationFrame::setRect(const cocos2d::Rect & rect) { this->rect = rect; }
 
 // returns the amount of delay units.
 float OOP::SpriteSheetAnimationFrame::getDelayUnits() const { return delayUnits; }
@@ -202,6 +202,15 @@ void OOP::SpriteSheetAnimation::setRestoreOriginalFrame(bool restoreFrame1) { re
 // returns the sprite sheet.
 cocos2d::Sprite * OOP::SpriteSheetAnimation::getSpriteSheet() const { return spriteSheet; }
 
+// gets where the image is in the texture.
+cocos2d::Vec2 OOP::SpriteSheetAnimation::getTextureOrigin() const { return textureOrigin; }
+
+// sets where the image is in the texture.
+void OOP::SpriteSheetAnimation::setTextureOrigin(const cocos2d::Vec2 & textureOrigin) { this->textureOrigin = textureOrigin; }
+
+// sets the texture rect, moving it to where the image is in the texture.
+void OOP::SpriteSheetAnimation::setFrameRect(const cocos2d::Rect & rect) { spriteSheet->setTextureRect(cocos2d::Rect(rect.origin + textureOrigin, rect.size)); }
+
 // returns the current frame of the animation.
 OOP::SpriteSheetAnimationFrame * OOP::SpriteSheetAnimation::getCurrentFrame() const { return frames.at(index); }
 
@@ -287,7 +296,7 @@ bool OOP::SpriteSheetAnimation::isRunning() { return running; }
 void OOP::SpriteSheetAnimation::runAnimation()
 {
 	running = true;
-	spriteSheet->setTextureRect(frames.at(0)->getRect());
+	setFrameRect(frames.at(0)->getRect());
 }
 
 // stops an animation. This will cause the animation to return to its start.
@@ -303,7 +312,7 @@ void OOP::SpriteSheetAnimation::stopAnimation(bool restoreF1)
 		frames.at(i)->setActivePrimitives(false);
 
 	// if 'restoreF1' is true, then the original frame is restored. If not, the ending frame is restored.
-	spriteSheet->setTextureRect((restoreF1) ? frames.at(0)->getRect() : frames[frames.size() - 1]->getRect());
+	setFrameRect((restoreF1) ? frames.at(0)->getRect() : frames[frames.size() - 1]->getRect());
 }
 
 // pauses an animation.
@@ -356,7 +365,7 @@ void OOP::SpriteSheetAnimation::update(float deltaTime)
 			}
 			else
 			{
-				spriteSheet->setTextureRect(frames.at(index)->getRect()); // moves onto the next frame.
+				setFrameRect(frames.at(index)->getRect()); // moves onto the next frame.
 			}
 		}
 
@@ -366,7 +375,7 @@ void OOP::SpriteSheetAnimation::update(float deltaTime)
 			if(frames.at(index - 1) != nullptr)
 				frames.at(index - 1)->getPrimitives().at(i)->setActive(false);
 
-		spriteSheet->setTextureRect(frames.at(index)->getRect()); // moves onto the next nimation frame.
+		setFrameRect(frames.at(index)->getRect()); // moves onto the next nimation frame.
 
 		for (int i = 0; i < frames.at(newIndex)->getPrimitives().size(); i++) // turns on the primitives for the now current animation frame.
 			if (frames.at(index - 1) != nullptr)
@@ -17,7 +17,7 @@ Date: 04/04/2019
 #include "cocos/2d/CCSprite.h"
 #include "cocos/math/CCGeometry.h"
 
-#include "Primitives.h";
+#include "Primitives.h"
 
 #include <iostream>
 #include <string>
@@ -33,14 +33,14 @@ namespace OOP
 		 * if there are no delayUnits, the animation will move onto the next frame the following update.
 		 * if no tag is provided, a tag of '0' is set. 
 		*/
-		SpriteSheetAnimationFrame(cocos2d::Rect & rect, float delayUnits = 0.0F, int tag = 0);
+		SpriteSheetAnimationFrame(const cocos2d::Rect & rect, float delayUnits = 0.0F, int tag = 0);
 
 		// returns the rectangle that's used to crop the sprite sheet.
 		cocos2d::Rect getRect() const;
 
 		// sets the rectangle used to get an image out of the sprite sheet.
 		// for a sprite sheet, the location (x, y) is the top left corner of the rect, and the width and height are the bottom right corner.
-		void setRect(cocos2d::Rect & rect);
+		void setRect(const cocos2d::Rect & rect);
 
 		// gets how long this sprite frame remains active (in milliseconds).
 		float getDelayUnits() const;
@@ -194,6 +194,12 @@ namespace OOP
 		// returns the sprite sheet.
 		cocos2d::Sprite * getSpriteSheet() const;
 
+		// gets where the sprite sheet's image is in its texture.
+		cocos2d::Vec2 getTextureOrigin() const;
+
+		// sets where the sprite sheet's image is in its texture. If the image is in an atlas (see OOP::TextureAtlas), the frame rects are moved by this before they're used.
+		void setTextureOrigin(const cocos2d::Vec2 & textureOrigin);
+
 		// gets the current frame of animation.
 		OOP::SpriteSheetAnimationFrame * getCurrentFrame() const;
 
@@ -256,8 +262,12 @@ namespace OOP
 		void update(float deltaTime);
 
 	private:
+		// sets the sprite sheet's texture rect to a frame's rect, moved to where the image is in the texture.
+		void setFrameRect(const cocos2d::Rect & rect);
+
 		cocos2d::Sprite * spriteSheet; // the sprite sheet.
 		std::vector<OOP::SpriteSheetAnimationFrame *> frames; // the frames of the animation.
+		cocos2d::Vec2 textureOrigin = cocos2d::Vec2::ZERO; // where the sprite sheet's image is in its texture.
 
 		unsigned int totalLoops = 0; // how many times the animation loops.
 		unsigned int finishedLoops = 0; // the amount of finished loops.
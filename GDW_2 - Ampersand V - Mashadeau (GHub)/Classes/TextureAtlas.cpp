@@ -0,0 +1,66 @@
+#include "TextureAtlas.h"
+
+#include "platform/CCFileUtils.h"
+
+const std::string OOP::TextureAtlas::ATLAS_FOLDER = "images/atlases/"; // Resources/images/atlases
+const std::vector<std::string> OOP::TextureAtlas::ATLAS_NAMES = { "tiles", "enemies", "weapons" }; // the tile, enemy, and weapon (and item) atlases.
+
+// loads the atlases.
+unsigned int OOP::TextureAtlas::loadAtlases()
+{
+	unsigned int count = 0; // the amount of atlases loaded.
+
+	for (const std::string & name : ATLAS_NAMES)
+	{
+		if (loadAtlas(name))
+			count++;
+	}
+
+	return count;
+}
+
+// loads an atlas. The sprite frame cache loads the texture named in the plist, which is in the same folder.
+bool OOP::TextureAtlas::loadAtlas(const std::string & name)
+{
+	std::string plist = ATLAS_FOLDER + name + ".plist"; // the file that lists the frames.
+
+	if (!cocos2d::FileUtils::getInstance()->isFileExist(plist))
+		return false;
+
+	cocos2d::SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plist);
+	return cocos2d::SpriteFrameCache::getInstance()->isSpriteFramesWithFileLoaded(plist);
+}
+
+// gets the frame of an image.
+cocos2d::SpriteFrame * OOP::TextureAtlas::getFrame(const std::string & image)
+{
+	if (image == "")
+		return nullptr;
+
+	return cocos2d::SpriteFrameCache::getInstance()->getSpriteFrameByName(image);
+}
+
+// gets where the image is.
+cocos2d::Vec2 OOP::TextureAtlas::getOrigin(const std::string & image)
+{
+	cocos2d::SpriteFrame * frame = getFrame(image); // the image's frame.
+
+	return (frame != nullptr) ? frame->getRect().origin : cocos2d::Vec2::ZERO;
+}
+
+// moves the rect to where the image is.
+cocos2d::Rect OOP::TextureAtlas::getRect(const std::string & image, const cocos2d::Rect & rect)
+{
+	return cocos2d::Rect(rect.origin + getOrigin(image), rect.size);
+}
+
+// sets the sprite's texture.
+void OOP::TextureAtlas::setTexture(cocos2d::Sprite * sprite, const std::string & image)
+{
+	cocos2d::SpriteFrame * frame = getFrame(image); // the image's frame.
+
+	if (frame != nullptr)
+		sprite->setSpriteFrame(frame); // sets the atlas texture, and the rect of the image in it.
+	else
+		sprite->setTexture(image);
+}
@@ -0,0 +1,40 @@
+// finds images that have been packed into texture atlases (see tools/pack_atlases.py), so that sprites can use the atlas instead of loading each image on its own.
+// an atlas frame is named after the image it came from (e.g. images/tiles/TIN_010.png). Images that aren't in an atlas are loaded normally, so the game still works without the atlases.
+// the images are kept whole in the atlases, so a texture rect inside of an image (e.g. a frame of a sprite sheet) just has to be moved by where the image is in the atlas (see getRect()).
+#pragma once
+
+#include "2d/CCSprite.h"
+#include "2d/CCSpriteFrameCache.h"
+
+#include <string>
+#include <vector>
+
+namespace OOP
+{
+	struct TextureAtlas
+	{
+		// loads all of the atlases in ATLAS_NAMES that exist, and returns how many were loaded. This should be called once the search paths are set, before anything is made.
+		static unsigned int loadAtlases();
+
+		// loads an atlas from the atlas folder (e.g. "tiles" loads images/atlases/tiles.plist and tiles.png). If the atlas doesn't exist, 'false' is returned.
+		static bool loadAtlas(const std::string & name);
+
+		// gets the atlas frame of an image. If the image isn't in a loaded atlas, a nullptr is returned.
+		static cocos2d::SpriteFrame * getFrame(const std::string & image);
+
+		// gets where an image is in its texture. If the image isn't in an atlas, (0, 0) is returned.
+		static cocos2d::Vec2 getOrigin(const std::string & image);
+
+		// converts a rect inside of an image to a rect inside of the texture the image is in.
+		static cocos2d::Rect getRect(const std::string & image, const cocos2d::Rect & rect);
+
+		// sets a sprite's texture to an image, with the texture rect covering the whole image. This uses the image's atlas if it's in one.
+		static void setTexture(cocos2d::Sprite * sprite, const std::string & image);
+
+		// the folder the atlases are in, inside of the Resources folder.
+		static const std::string ATLAS_FOLDER;
+
+		// the atlases that are loaded by loadAtlases(). These match the atlases made by tools/pack_atlases.py.
+		static const std::vector<std::string> ATLAS_NAMES;
+	};
+}
@@ -1,4 +1,5 @@
 #include "Utilities.h"
+#include <algorithm>
 #include <math.h>
 
 /// STRING AND GENERAL FUNCTIONS //////////////////////////////////////////////////////
@@ -111,6 +112,55 @@ bool umath::aabbCollision(const Vec2 aMin, const Vec2 aMax, const Vec2 bMin, con
 	return (xCol && yCol);
 }
 
+// checks when a moving box first hits another box, using the times it enters and leaves the other box on each axis.
+bool umath::sweptAabbCollision(const Vec2 min, const Vec2 max, const Vec2 motion, const Vec2 boxMin, const Vec2 boxMax, float & time, Vec2 & normal)
+{
+	float entry = -FLT_MAX; // the time the boxes start overlapping on both axes.
+	float exit = FLT_MAX; // the time the boxes stop overlapping on either axis.
+	float axisEntry, axisExit; // the times the boxes start and stop overlapping on the current axis.
+	Vec2 entryNormal(0.0F, 0.0F); // the side of the box that was entered last.
+
+	if (motion.x != 0.0F) // the times the box enters and leaves the other box on the x-axis.
+	{
+		axisEntry = ((motion.x > 0.0F) ? boxMin.x - max.x : boxMax.x - min.x) / motion.x;
+		axisExit = ((motion.x > 0.0F) ? boxMax.x - min.x : boxMin.x - max.x) / motion.x;
+
+		entry = axisEntry;
+		exit = axisExit;
+		entryNormal = Vec2((motion.x > 0.0F) ? -1.0F : 1.0F, 0.0F);
+	}
+	else if (max.x <= boxMin.x || min.x >= boxMax.x) // the box isn't moving on the x-axis, and it's outside of the other box on it.
+	{
+		return false;
+	}
+
+	if (motion.y != 0.0F) // the times on the y-axis.
+	{
+		axisEntry = ((motion.y > 0.0F) ? boxMin.y - max.y : boxMax.y - min.y) / motion.y;
+		axisExit = ((motion.y > 0.0F) ? boxMax.y - min.y : boxMin.y - max.y) / motion.y;
+
+		if (axisEntry > entry)
+		{
+			entry = axisEntry;
+			entryNormal = Vec2(0.0F, (motion.y > 0.0F) ? -1.0F : 1.0F);
+		}
+
+		exit = std::min(exit, axisExit);
+	}
+	else if (max.y <= boxMin.y || min.y >= boxMax.y)
+	{
+		return false;
+	}
+
+	// the boxes have to start overlapping on both axes before they stop overlapping on either one, and it has to happen during the motion.
+	if (entry >= exit || entry < 0.0F || entry > 1.0F)
+		return false;
+
+	time = entry;
+	normal = entryNormal;
+	return true;
+}
+
 // calls another aabb function to do the collision.
 bool umath::aabbCollision(const Vec2 topLeftA, const Vec2 topRightA, const Vec2 bottomLeftA, const Vec2 bottomRightA, const Vec2 topLeftB, const Vec2 topRightB, const Vec2 bottomLeftB, const Vec2 bottomRightB)
 {
@@ -130,7 +180,7 @@ bool umath::aabbCollision(const Rect * rect1, const Rect * rect2)
 
 // calculates obb collision between two rectangles; this assumes that the rotation angles are based on the middle of the rectangles.
 // These calculations require that the angle is put into radians, but since cocos2d inherently uses degrees, 'inDegrees' needs to check what form the angle is in.
-bool umath::obbCollision(Rect & rectA, float angleA, Rect & rectB, float angleB, bool inDegrees)
+bool umath::obbCollision(const Rect & rectA, float angleA, const Rect & rectB, float angleB, bool inDegrees)
 {
 	// if the angles have been provided in degrees, then they are converted to radians for the rotation calculations.
 	if (inDegrees) // converts angle A and B into radians.
@@ -192,6 +242,397 @@ bool umath::obbCollision(const Vec2 topLeftA, const Vec2 topRightA, const Vec2 b
 // checks collision between an aabb and a circle using built in cocos algorithms.
 bool umath::aabbCircleCollision(const Rect & rect, const Vec2 circlePos, const float radius) { return rect.intersectsCircle(circlePos, radius); }
 
+// gets the closest point on a line segment to the provided point.
+static Vec2 closestSegmentPoint(const Vec2 point, const Vec2 start, const Vec2 end)
+{
+	Vec2 d = end - start; // the direction of the segment.
+	float lengthSq = d.dot(d);
+	float t = (lengthSq > FLT_EPSILON) ? clampf((point - start).dot(d) / lengthSq, 0.0F, 1.0F) : 0.0F; // how far along the segment the closest point is (0 to 1)
+
+	return start + d * t;
+}
+
+// gets the squared distance from a point to a line segment.
+static float pointSegmentDistanceSq(const Vec2 point, const Vec2 start, const Vec2 end)
+{
+	Vec2 d = point - closestSegmentPoint(point, start, end);
+	return d.dot(d);
+}
+
+// gets the closest points between two line segments.
+static void closestSegmentPoints(const Vec2 start1, const Vec2 end1, const Vec2 start2, const Vec2 end2, Vec2 & point1, Vec2 & point2)
+{
+	Vec2 d1 = end1 - start1; // the direction of the first segment.
+	Vec2 d2 = end2 - start2; // the direction of the second segment.
+	Vec2 r = start1 - start2;
+
+	float a = d1.dot(d1); // squared length of segment 1
+	float e = d2.dot(d2); // squared length of segment 2
+	float f = d2.dot(r);
+	float s = 0.0F; // how far along segment 1 the closest point is (0 to 1)
+	float t = 0.0F; // how far along segment 2 the closest point is (0 to 1)
+
+	if (a <= FLT_EPSILON && e <= FLT_EPSILON) // both segments are points.
+	{
+		s = 0.0F;
+		t = 0.0F;
+	}
+	else if (a <= FLT_EPSILON) // the first segment is a point.
+	{
+		t = clampf(f / e, 0.0F, 1.0F);
+	}
+	else
+	{
+		float c = d1.dot(r);
+
+		if (e <= FLT_EPSILON) // the second segment is a point.
+		{
+			s = clampf(-c / a, 0.0F, 1.0F);
+		}
+		else
+		{
+			float b = d1.dot(d2);
+			float denom = a * e - b * b; // this is 0 if the segments are parallel.
+
+			s = (denom != 0.0F) ? clampf((b * f - c * e) / denom, 0.0F, 1.0F) : 0.0F;
+			t = (b * s + f) / e;
+
+			// if 't' is outside of the segment, it is clamped and 's' is recalculated.
+			if (t < 0.0F)
+			{
+				t = 0.0F;
+				s = clampf(-c / a, 0.0F, 1.0F);
+			}
+			else if (t > 1.0F)
+			{
+				t = 1.0F;
+				s = clampf((b - c) / a, 0.0F, 1.0F);
+			}
+		}
+	}
+
+	point1 = start1 + d1 * s;
+	point2 = start2 + d2 * t;
+}
+
+// gets the squared distance from a point to an axis-aligned box centred on (0, 0). Points inside of the box are 0 away.
+static float pointBoxDistanceSq(const Vec2 point, const Vec2 half)
+{
+	Vec2 outside(std::max(fabsf(point.x) - half.x, 0.0F), std::max(fabsf(point.y) - half.y, 0.0F)); // how far the point is past the box on each axis.
+	return outside.dot(outside);
+}
+
+// gets the closest points between a line segment and an axis-aligned box centred on (0, 0), and returns the squared distance between them.
+// if the segment is crossing the box, 0 is returned and the points aren't set.
+static float closestSegmentBoxPoints(const Vec2 start, const Vec2 end, const Vec2 half, Vec2 & segmentPoint, Vec2 & boxPoint)
+{
+	Vec2 normal(start.y - end.y, end.x - start.x); // perpendicular to the segment.
+	Vec2 corners[4] = { Vec2(-half.x, -half.y), Vec2(half.x, -half.y), Vec2(-half.x, half.y), Vec2(half.x, half.y) };
+	Vec2 point; // the closest point on the segment to the current corner.
+	float distanceSq = 0.0F; // the squared distance of the closest points found so far.
+	float cornerDistanceSq = 0.0F;
+
+	// if the segment overlaps the box on the box's axes and the segment's normal, it's crossing the box.
+	bool crossing = (std::min(start.x, end.x) <= half.x) & (std::max(start.x, end.x) >= -half.x) & (std::min(start.y, end.y) <= half.y) & (std::max(start.y, end.y) >= -half.y)
+		& (fabsf(normal.dot(start)) <= half.x * fabsf(normal.x) + half.y * fabsf(normal.y));
+
+	if (crossing)
+		return 0.0F;
+
+	// otherwise the closest points are either an end of the segment, or a corner of the box.
+	segmentPoint = start;
+	boxPoint = Vec2(clampf(start.x, -half.x, half.x), clampf(start.y, -half.y, half.y));
+	distanceSq = pointBoxDistanceSq(start, half);
+
+	if (pointBoxDistanceSq(end, half) < distanceSq)
+	{
+		segmentPoint = end;
+		boxPoint = Vec2(clampf(end.x, -half.x, half.x), clampf(end.y, -half.y, half.y));
+		distanceSq = pointBoxDistanceSq(end, half);
+	}
+
+	for (const Vec2 & corner : corners)
+	{
+		point = closestSegmentPoint(corner, start, end);
+		cornerDistanceSq = (point - corner).dot(point - corner);
+
+		if (cornerDistanceSq < distanceSq)
+		{
+			segmentPoint = point;
+			boxPoint = corner;
+			distanceSq = cornerDistanceSq;
+		}
+	}
+
+	return distanceSq;
+}
+
+// checks collision between two capsules by finding the closest points on their centre lines (i.e. the line segments between their circles).
+bool umath::capsuleCollision(const Vec2 start1, const Vec2 end1, const float radius1, const Vec2 start2, const Vec2 end2, const float radius2)
+{
+	Vec2 point1, point2; // the closest points on the two centre lines.
+
+	closestSegmentPoints(start1, end1, start2, end2, point1, point2);
+
+	return (point1 - point2).dot(point1 - point2) <= (radius1 + radius2) * (radius1 + radius2);
+}
+
+// checks obb collision with the separating axis theorem.
+bool umath::obbCollision(const Vec2 centreA, const Vec2 halfA, const float cosA, const float sinA, const Vec2 centreB, const Vec2 halfB, const float cosB, const float sinB)
+{
+	Vec2 d = centreB - centreA; // the distance between the boxes.
+
+	// the cosine and sine of the angle between the two boxes. B's axes are projected onto A's using these (and the other way around).
+	float c = fabsf(cosA * cosB + sinA * sinB);
+	float s = fabsf(sinA * cosB - cosA * sinB);
+
+	// the boxes are separated if the distance between them on an axis is greater than the sum of their half sizes on that axis. Every axis is checked, rather than returning early.
+	bool overlap = (fabsf(d.x * cosA + d.y * sinA) <= halfA.x + halfB.x * c + halfB.y * s) // A's x-axis
+		& (fabsf(d.y * cosA - d.x * sinA) <= halfA.y + halfB.x * s + halfB.y * c) // A's y-axis
+		& (fabsf(d.x * cosB + d.y * sinB) <= halfA.x * c + halfA.y * s + halfB.x) // B's x-axis
+		& (fabsf(d.y * cosB - d.x * sinB) <= halfA.x * s + halfA.y * c + halfB.y); // B's y-axis
+
+	return overlap;
+}
+
+// checks obb-circle collision.
+bool umath::obbCircleCollision(const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta, const Vec2 circlePos, const float radius)
+{
+	Vec2 d = circlePos - centre;
+	Vec2 local(d.x * cosTheta + d.y * sinTheta, d.y * cosTheta - d.x * sinTheta); // the circle's position with the box's rotation taken out.
+
+	return pointBoxDistanceSq(local, half) <= radius * radius;
+}
+
+// checks capsule-obb collision.
+bool umath::capsuleObbCollision(const Vec2 start, const Vec2 end, const float radius, const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta)
+{
+	Vec2 segmentPoint, boxPoint; // the closest points, which aren't needed here.
+
+	// the capsule's centre line with the box's rotation taken out, so that the box is axis-aligned and centred on (0, 0).
+	Vec2 s = start - centre, e = end - centre;
+	Vec2 localStart(s.x * cosTheta + s.y * sinTheta, s.y * cosTheta - s.x * sinTheta);
+	Vec2 localEnd(e.x * cosTheta + e.y * sinTheta, e.y * cosTheta - e.x * sinTheta);
+
+	return closestSegmentBoxPoints(localStart, localEnd, half, segmentPoint, boxPoint) <= radius * radius;
+}
+
+// checks capsule-circle collision.
+bool umath::capsuleCircleCollision(const Vec2 start, const Vec2 end, const float radius, const Vec2 circlePos, const float circleRadius)
+{
+	return pointSegmentDistanceSq(circlePos, start, end) <= (radius + circleRadius) * (radius + circleRadius);
+}
+
+// gets the contact between two circles.
+bool umath::circleContact(const Vec2 pos1, const float radius1, const Vec2 pos2, const float radius2, Vec2 & normal, float & depth)
+{
+	Vec2 d = pos1 - pos2; // from the second circle to the first.
+	float distance = d.dot(d);
+
+	if (distance > (radius1 + radius2) * (radius1 + radius2))
+		return false;
+
+	distance = sqrtf(distance);
+	normal = (distance > 0.0F) ? d / distance : Vec2(0.0F, 1.0F); // if the circles are in the same place, the first one is pushed up.
+	depth = radius1 + radius2 - distance;
+
+	return true;
+}
+
+// gets the contact between two oriented boxes.
+bool umath::obbContact(const Vec2 centreA, const Vec2 halfA, const float cosA, const float sinA, const Vec2 centreB, const Vec2 halfB, const float cosB, const float sinB, Vec2 & normal, float & depth)
+{
+	Vec2 d = centreB - centreA; // the distance between the boxes.
+
+	float c = fabsf(cosA * cosB + sinA * sinB); // the cosine and sine of the angle between the two boxes.
+	float s = fabsf(sinA * cosB - cosA * sinB);
+
+	// the axes, the distance between the boxes on each one, and how much the boxes overlap on each one. The y-axes come first, so that they're used if there's a tie.
+	Vec2 axes[4] = { Vec2(-sinA, cosA), Vec2(cosA, sinA), Vec2(-sinB, cosB), Vec2(cosB, sinB) };
+	float distances[4] = { d.y * cosA - d.x * sinA, d.x * cosA + d.y * sinA, d.y * cosB - d.x * sinB, d.x * cosB + d.y * sinB };
+	float overlaps[4] = {
+		halfA.y + halfB.x * s + halfB.y * c - fabsf(distances[0]),
+		halfA.x + halfB.x * c + halfB.y * s - fabsf(distances[1]),
+		halfA.x * s + halfA.y * c + halfB.y - fabsf(distances[2]),
+		halfA.x * c + halfA.y * s + halfB.x - fabsf(distances[3]) };
+	int axis = 0; // the axis with the smallest overlap.
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (overlaps[i] < 0.0F) // the boxes are separated on this axis.
+			return false;
+
+		if (overlaps[i] < overlaps[axis])
+			axis = i;
+	}
+
+	// box A is pushed away from box B.
+	normal = (distances[axis] > 0.0F) ? -axes[axis] : axes[axis];
+	depth = overlaps[axis];
+
+	return true;
+}
+
+// gets the contact between a circle and an oriented box.
+bool umath::circleObbContact(const Vec2 circlePos, const float radius, const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta, Vec2 & normal, float & depth)
+{
+	Vec2 d = circlePos - centre;
+	Vec2 local(d.x * cosTheta + d.y * sinTheta, d.y * cosTheta - d.x * sinTheta); // the circle's position with the box's rotation taken out.
+	Vec2 closest(clampf(local.x, -half.x, half.x), clampf(local.y, -half.y, half.y)); // the closest point in the box to the circle.
+	Vec2 localNormal; // the normal with the box's rotation taken out.
+	float distance = (local - closest).dot(local - closest);
+
+	if (distance > radius * radius)
+		return false;
+
+	if (distance > 0.0F) // the circle's centre is outside of the box, so it's pushed away from the closest point.
+	{
+		distance = sqrtf(distance);
+		localNormal = (local - closest) / distance;
+		depth = radius - distance;
+	}
+	else if (half.y - fabsf(local.y) <= half.x - fabsf(local.x)) // the circle's centre is inside of the box, so it's pushed out of the closest side.
+	{
+		localNormal = Vec2(0.0F, (local.y >= 0.0F) ? 1.0F : -1.0F);
+		depth = half.y - fabsf(local.y) + radius;
+	}
+	else
+	{
+		localNormal = Vec2((local.x >= 0.0F) ? 1.0F : -1.0F, 0.0F);
+		depth = half.x - fabsf(local.x) + radius;
+	}
+
+	normal = Vec2(localNormal.x * cosTheta - localNormal.y * sinTheta, localNormal.x * sinTheta + localNormal.y * cosTheta); // the box's rotation is put back.
+	return true;
+}
+
+// gets the contact between a capsule and an oriented box.
+bool umath::capsuleObbContact(const Vec2 start, const Vec2 end, const float radius, const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta, Vec2 & normal, float & depth)
+{
+	Vec2 segmentPoint, boxPoint; // the closest points between the capsule's centre line and the box.
+	Vec2 localNormal; // the normal with the box's rotation taken out.
+	float distance = 0.0F;
+
+	// the capsule's centre line with the box's rotation taken out.
+	Vec2 s = start - centre, e = end - centre;
+	Vec2 localStart(s.x * cosTheta + s.y * sinTheta, s.y * cosTheta - s.x * sinTheta);
+	Vec2 localEnd(e.x * cosTheta + e.y * sinTheta, e.y * cosTheta - e.x * sinTheta);
+
+	distance = closestSegmentBoxPoints(localStart, localEnd, half, segmentPoint, boxPoint);
+
+	if (distance > radius * radius)
+		return false;
+
+	if (distance > 0.0F) // the centre line is outside of the box, so the capsule is pushed away from the closest point.
+	{
+		distance = sqrtf(distance);
+		localNormal = (segmentPoint - boxPoint) / distance;
+		depth = radius - distance;
+	}
+	else // the centre line crosses the box, so the capsule is pushed out along whichever of the box's axes or the line's normal has the smallest overlap.
+	{
+		Vec2 lineNormal(localStart.y - localEnd.y, localEnd.x - localStart.x);
+		float projection = 0.0F; // where the centre line is on the line's normal.
+		float boxReach = 0.0F; // half of the box's size on the line's normal.
+
+		// the box's x-axis and y-axis. Each side is checked, and the capsule goes out of whichever one is closer.
+		float pushes[4] = { half.y - (std::min(localStart.y, localEnd.y) - radius), std::max(localStart.y, localEnd.y) + radius + half.y,
+			half.x - (std::min(localStart.x, localEnd.x) - radius), std::max(localStart.x, localEnd.x) + radius + half.x };
+		Vec2 directions[4] = { Vec2(0.0F, 1.0F), Vec2(0.0F, -1.0F), Vec2(1.0F, 0.0F), Vec2(-1.0F, 0.0F) };
+
+		depth = pushes[0];
+		localNormal = directions[0];
+
+		for (int i = 1; i < 4; i++)
+		{
+			if (pushes[i] < depth)
+			{
+				depth = pushes[i];
+				localNormal = directions[i];
+			}
+		}
+
+		if (lineNormal.dot(lineNormal) > FLT_EPSILON) // the line's normal, if the centre line isn't a point.
+		{
+			lineNormal.normalize();
+			projection = lineNormal.dot(localStart);
+			boxReach = half.x * fabsf(lineNormal.x) + half.y * fabsf(lineNormal.y);
+
+			if (boxReach - (projection - radius) < depth)
+			{
+				depth = boxReach - (projection - radius);
+				localNormal = lineNormal;
+			}
+
+			if (projection + radius + boxReach < depth)
+			{
+				depth = projection + radius + boxReach;
+				localNormal = -lineNormal;
+			}
+		}
+	}
+
+	normal = Vec2(localNormal.x * cosTheta - localNormal.y * sinTheta, localNormal.x * sinTheta + localNormal.y * cosTheta); // the box's rotation is put back.
+	return true;
+}
+
+// gets the contact between a capsule and a circle.
+bool umath::capsuleCircleContact(const Vec2 start, const Vec2 end, const float radius, const Vec2 circlePos, const float circleRadius, Vec2 & normal, float & depth)
+{
+	return circleContact(closestSegmentPoint(circlePos, start, end), radius, circlePos, circleRadius, normal, depth);
+}
+
+// gets the contact between two capsules.
+bool umath::capsuleContact(const Vec2 start1, const Vec2 end1, const float radius1, const Vec2 start2, const Vec2 end2, const float radius2, Vec2 & normal, float & depth)
+{
+	Vec2 point1, point2; // the closest points on the two centre lines.
+	Vec2 axes[2] = { Vec2(start1.y - end1.y, end1.x - start1.x), Vec2(start2.y - end2.y, end2.x - start2.x) }; // the normals of the two centre lines.
+	float min1, max1, min2, max2; // where the capsules are on the current axis.
+	float push = 0.0F; // how far the first capsule has to move along the current axis.
+	bool found = false; // becomes 'true' once an axis has been used.
+
+	closestSegmentPoints(start1, end1, start2, end2, point1, point2);
+
+	if ((point1 - point2).dot(point1 - point2) > FLT_EPSILON) // the centre lines aren't crossing, so the capsules are pushed apart like two circles at the closest points.
+		return circleContact(point1, radius1, point2, radius2, normal, depth);
+
+	// the centre lines are crossing, so the closest points don't give a direction. The capsules are pushed apart along whichever line normal they overlap the least on.
+	for (Vec2 & axis : axes)
+	{
+		if (axis.dot(axis) <= FLT_EPSILON) // this centre line is a point, so it has no normal.
+			continue;
+
+		axis.normalize();
+		min1 = std::min(axis.dot(start1), axis.dot(end1)) - radius1;
+		max1 = std::max(axis.dot(start1), axis.dot(end1)) + radius1;
+		min2 = std::min(axis.dot(start2), axis.dot(end2)) - radius2;
+		max2 = std::max(axis.dot(start2), axis.dot(end2)) + radius2;
+
+		// each direction along the axis is checked.
+		push = max2 - min1;
+
+		if (found == false || push < depth)
+		{
+			normal = axis;
+			depth = push;
+			found = true;
+		}
+
+		push = max1 - min2;
+
+		if (push < depth)
+		{
+			normal = -axis;
+			depth = push;
+		}
+	}
+
+	if (found == false) // both capsules are circles.
+		return circleContact(point1, radius1, point2, radius2, normal, depth);
+
+	return true;
+}
+
 // converts from degrees to radians
 float umath::degreesToRadians(float degrees) { return degrees * (M_PI / 180); }
 
@@ -75,6 +75,13 @@ namespace umath // mathematic utilities.
 	// collision between two rectangles (rectangle A and rectangle B). Takes the minimums and maximums of the two rectangles as Vec2s.
 	bool aabbCollision(const Vec2 aMin, const Vec2 aMax, const Vec2 bMin, const Vec2 bMax);
 
+	/*
+	 * checks when a box (from 'min' to 'max') moving by 'motion' first hits another box (from 'boxMin' to 'boxMax'). This catches boxes that move past each other in a single step.
+	 * 'time' gets how far along the motion the boxes hit (0 to 1), and 'normal' gets the side of the other box that was hit. If they don't hit, 'false' is returned and these are left alone.
+	 * boxes that are already overlapping at the start of the motion, or only touch, don't count, since the overlap checks handle those.
+	*/
+	bool sweptAabbCollision(const Vec2 min, const Vec2 max, const Vec2 motion, const Vec2 boxMin, const Vec2 boxMax, float & time, Vec2 & normal);
+
 	// calculates axis-aligned bounding box collision using the four corner points of both boxes.
 	static bool aabbCollision(const Vec2 topLeftA, const Vec2 topRightA, const Vec2 bottomLeftA, const Vec2 bottomRightA, const Vec2 topLeftB, const Vec2 topRightB, const Vec2 bottomLeftB, const Vec2 bottomRightB);
 
@@ -83,7 +90,7 @@ namespace umath // mathematic utilities.
 
 	// calculates obb collision between two rectangles; this assumes that the rotation angles are based on the middle of the rectangtles.
 	// if 'inDegrees' is true, then the angles are converted from degrees to radians. This is because cocos2d uses degrees, but C++ by default uses radians, which is what's needed for our rotations.
-	bool obbCollision(Rect & rect1, float angle1, Rect & rect2, float angle2, bool inDegrees = true);
+	bool obbCollision(const Rect & rect1, float angle1, const Rect & rect2, float angle2, bool inDegrees = true);
 
 	// calculates oriented bounding box collision. Rotation factor is in RADIANS.
 	// if IS_ROTATED is true, the points passed have already had their rotation factor applied to them.
@@ -93,6 +100,48 @@ namespace umath // mathematic utilities.
 	// checks collision between an aabb and a circle using built-in cocos algorithms.
 	bool aabbCircleCollision(const Rect & rect, const Vec2 circlePos, const float radius);
 
+	// checks collision between two capsules. 'start' and 'end' are the centres of the circles on either end of each capsule.
+	// the capsules collide if the closest points on their centre lines are within the sum of their radii.
+	bool capsuleCollision(const Vec2 start1, const Vec2 end1, const float radius1, const Vec2 start2, const Vec2 end2, const float radius2);
+
+	/*
+	 * the checks below take each box as its centre, half of its size, and the cosine and sine of its rotation (in radians), so that the trig only has to be done once per box.
+	 * an axis-aligned box is a box with a cosine of 1 and a sine of 0. The rotation goes the same way as rotate(). Touching counts as a collision for all of them.
+	*/
+	// calculates oriented bounding box collision using the separating axis theorem. The boxes collide if they overlap on all four of their axes, so no corners need to be rotated.
+	bool obbCollision(const Vec2 centreA, const Vec2 halfA, const float cosA, const float sinA, const Vec2 centreB, const Vec2 halfB, const float cosB, const float sinB);
+
+	// checks collision between an oriented box and a circle by finding the closest point in the box to the circle.
+	bool obbCircleCollision(const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta, const Vec2 circlePos, const float radius);
+
+	// checks collision between a capsule and an oriented box. The capsule collides if its centre line is within its radius of the box.
+	bool capsuleObbCollision(const Vec2 start, const Vec2 end, const float radius, const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta);
+
+	// checks collision between a capsule and a circle. They collide if the circle's centre is within the sum of their radii of the capsule's centre line.
+	bool capsuleCircleCollision(const Vec2 start, const Vec2 end, const float radius, const Vec2 circlePos, const float circleRadius);
+
+	/*
+	 * the contact checks below also work out how the first shape should be pushed out of the second one. 'normal' gets the direction to push it in (with a length of 1), and 'depth' gets how far.
+	 * if the shapes are only touching, the depth is 0. If they aren't touching, 'false' is returned and the normal and depth are left alone.
+	*/
+	// gets the contact between two circles.
+	bool circleContact(const Vec2 pos1, const float radius1, const Vec2 pos2, const float radius2, Vec2 & normal, float & depth);
+
+	// gets the contact between two oriented boxes. The box is pushed out along whichever of the four axes the boxes overlap the least on. If there's a tie, the y-axes are used.
+	bool obbContact(const Vec2 centreA, const Vec2 halfA, const float cosA, const float sinA, const Vec2 centreB, const Vec2 halfB, const float cosB, const float sinB, Vec2 & normal, float & depth);
+
+	// gets the contact between a circle and an oriented box.
+	bool circleObbContact(const Vec2 circlePos, const float radius, const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta, Vec2 & normal, float & depth);
+
+	// gets the contact between a capsule and an oriented box.
+	bool capsuleObbContact(const Vec2 start, const Vec2 end, const float radius, const Vec2 centre, const Vec2 half, const float cosTheta, const float sinTheta, Vec2 & normal, float & depth);
+
+	// gets the contact between a capsule and a circle.
+	bool capsuleCircleContact(const Vec2 start, const Vec2 end, const float radius, const Vec2 circlePos, const float circleRadius, Vec2 & normal, float & depth);
+
+	// gets the contact between two capsules.
+	bool capsuleContact(const Vec2 start1, const Vec2 end1, const float radius1, const Vec2 start2, const Vec2 end2, const float radius2, Vec2 & normal, float & depth);
+
 	// conversion from degrees to radians. 1 degree = pi/180 radians. 
 	float degreesToRadians(float degrees);
 
@@ -0,0 +1,453 @@
+#include "areas/AABBTree.h"
+
+#include <algorithm>
+
+const int world::AABBTree::NULL_NODE = -1; // no node
+const float world::AABBTree::DISPLACEMENT_MULTIPLIER = 2.0F; // the box is extended by double the distance the entity moved.
+
+// creates the tree.
+world::AABBTree::AABBTree(const float margin) : MARGIN((margin >= 0.0F) ? margin : 16.0F) {}
+
+// the entities aren't owned by the tree.
+world::AABBTree::~AABBTree() {}
+
+// adds an entity to the tree.
+void world::AABBTree::add(entity::Entity * entity, entity::etag category)
+{
+	int leaf = NULL_NODE;
+
+	if (entity == nullptr || entity->treeProxy != NULL_NODE) // the entity is already in a tree.
+		return;
+
+	leaf = allocateNode();
+
+	// the box is fattened so the entity can move a bit before the tree needs to be changed.
+	nodes[leaf].box = entity->getWorldBounds();
+	nodes[leaf].box.min -= Vec2(MARGIN, MARGIN);
+	nodes[leaf].box.max += Vec2(MARGIN, MARGIN);
+	nodes[leaf].entity = entity;
+	nodes[leaf].category = category;
+
+	insertLeaf(leaf);
+
+	entity->treeProxy = leaf;
+	entityCount++;
+}
+
+// removes an entity from the tree.
+void world::AABBTree::remove(entity::Entity * entity)
+{
+	int leaf = NULL_NODE;
+
+	if (entity == nullptr || entity->treeProxy < 0 || entity->treeProxy >= (int)nodes.size())
+		return;
+
+	leaf = entity->treeProxy;
+
+	if (nodes[leaf].entity != entity) // the entity is in a different tree.
+		return;
+
+	removeLeaf(leaf);
+	freeNode(leaf);
+
+	entity->treeProxy = NULL_NODE;
+	entityCount--;
+}
+
+// updates the entity's place in the tree.
+bool world::AABBTree::refit(entity::Entity * entity)
+{
+	int leaf = NULL_NODE;
+	OOP::AABB box; // the current box of the entity.
+	Vec2 displacement; // how far the entity has moved from the centre of its stored box.
+
+	if (entity == nullptr || entity->treeProxy < 0 || entity->treeProxy >= (int)nodes.size() || nodes[entity->treeProxy].entity != entity)
+		return false;
+
+	leaf = entity->treeProxy;
+	box = entity->getWorldBounds();
+
+	if (contains(nodes[leaf].box, box)) // the entity is still inside its box, so nothing needs to change.
+		return false;
+
+	displacement = (box.min + box.max) / 2.0F - (nodes[leaf].box.min + nodes[leaf].box.max) / 2.0F;
+
+	removeLeaf(leaf);
+
+	// the new box is fattened, and then stretched in the direction the entity is moving, since it'll probably keep going that way.
+	box.min -= Vec2(MARGIN, MARGIN);
+	box.max += Vec2(MARGIN, MARGIN);
+
+	(displacement.x < 0.0F) ? box.min.x += DISPLACEMENT_MULTIPLIER * displacement.x : box.max.x += DISPLACEMENT_MULTIPLIER * displacement.x;
+	(displacement.y < 0.0F) ? box.min.y += DISPLACEMENT_MULTIPLIER * displacement.y : box.max.y += DISPLACEMENT_MULTIPLIER * displacement.y;
+
+	nodes[leaf].box = box;
+
+	insertLeaf(leaf);
+
+	return true;
+}
+
+// removes every entity from the tree.
+void world::AABBTree::clear()
+{
+	for (Node & node : nodes) // the entities are told they're no longer in the tree.
+	{
+		if (node.height == 0 && node.entity != nullptr)
+			node.entity->treeProxy = NULL_NODE;
+	}
+
+	nodes.clear();
+	root = NULL_NODE;
+	freeList = NULL_NODE;
+	entityCount = 0;
+}
+
+// gets the entities of a given category within a box.
+void world::AABBTree::query(const Vec2 & min, const Vec2 & max, std::vector<entity::Entity *> & results, entity::etag category) const
+{
+	OOP::AABB box{ min, max }; // the box being checked.
+	int node = NULL_NODE;
+
+	results.clear();
+
+	if (root == NULL_NODE)
+		return;
+
+	stack.clear();
+	stack.push_back(root);
+
+	while (stack.size() > 0)
+	{
+		node = stack.back();
+		stack.pop_back();
+
+		if (overlap(nodes[node].box, box) == false) // nothing below this node is in the box.
+			continue;
+
+		if (isLeaf(node))
+		{
+			if (nodes[node].category == category)
+				results.push_back(nodes[node].entity);
+		}
+		else
+		{
+			stack.push_back(nodes[node].child1);
+			stack.push_back(nodes[node].child2);
+		}
+	}
+}
+
+// gets all the overlapping pairs between two categories.
+void world::AABBTree::getPairs(std::vector<Pair> & pairs, entity::etag category1, entity::etag category2) const
+{
+	int node = NULL_NODE;
+
+	pairs.clear();
+
+	if (root == NULL_NODE)
+		return;
+
+	for (int leaf = 0; leaf < (int)nodes.size(); leaf++) // goes through every leaf of the first category, and checks it against the tree.
+	{
+		if (nodes[leaf].height != 0 || nodes[leaf].entity == nullptr || nodes[leaf].category != category1)
+			continue;
+
+		stack.clear();
+		stack.push_back(root);
+
+		while (stack.size() > 0)
+		{
+			node = stack.back();
+			stack.pop_back();
+
+			if (node == leaf || overlap(nodes[node].box, nodes[leaf].box) == false)
+				continue;
+
+			if (isLeaf(node))
+			{
+				// if both categories are the same, the pair would be found from both leaves, so it's only added from the lower one.
+				if (nodes[node].category == category2 && (category1 != category2 || leaf < node))
+					pairs.push_back(Pair{ nodes[leaf].entity, nodes[node].entity });
+			}
+			else
+			{
+				stack.push_back(nodes[node].child1);
+				stack.push_back(nodes[node].child2);
+			}
+		}
+	}
+}
+
+// gets the amount of entities in the tree.
+unsigned int world::AABBTree::getEntityCount() const { return entityCount; }
+
+// gets the height of the tree.
+int world::AABBTree::getHeight() const { return (root == NULL_NODE) ? 0 : nodes[root].height; }
+
+// gets an unused node.
+int world::AABBTree::allocateNode()
+{
+	int node = NULL_NODE;
+
+	if (freeList == NULL_NODE) // there are no unused nodes, so a new one is made.
+	{
+		nodes.push_back(Node());
+		node = nodes.size() - 1;
+	}
+	else
+	{
+		node = freeList;
+		freeList = nodes[node].next;
+	}
+
+	nodes[node] = Node();
+	return node;
+}
+
+// puts a node back into the free list.
+void world::AABBTree::freeNode(int node)
+{
+	nodes[node].entity = nullptr;
+	nodes[node].height = -1;
+	nodes[node].next = freeList;
+	freeList = node;
+}
+
+// inserts a leaf into the tree.
+void world::AABBTree::insertLeaf(int leaf)
+{
+	OOP::AABB leafBox = nodes[leaf].box;
+	int sibling = root; // the node the leaf will be paired with.
+	int oldParent = NULL_NODE;
+	int newParent = NULL_NODE;
+	int child1 = NULL_NODE;
+	int child2 = NULL_NODE;
+
+	float cost = 0.0F; // the cost of making a new parent for the leaf and the current node.
+	float inheritCost = 0.0F; // the cost of going down a level, since the current node's box has to grow to fit the leaf.
+	float cost1 = 0.0F; // the cost of going down to the first child.
+	float cost2 = 0.0F; // the cost of going down to the second child.
+
+	if (root == NULL_NODE) // the tree is empty.
+	{
+		root = leaf;
+		nodes[root].parent = NULL_NODE;
+		return;
+	}
+
+	// goes down the tree, looking for the sibling that would make the boxes grow the least.
+	while (isLeaf(sibling) == false)
+	{
+		child1 = nodes[sibling].child1;
+		child2 = nodes[sibling].child2;
+
+		cost = 2.0F * perimeter(combine(nodes[sibling].box, leafBox));
+		inheritCost = 2.0F * (perimeter(combine(nodes[sibling].box, leafBox)) - perimeter(nodes[sibling].box));
+
+		// if the child is a leaf, the cost is the size of the new parent. If it isn't, the cost is how much the child would grow.
+		cost1 = perimeter(combine(leafBox, nodes[child1].box)) + inheritCost;
+		if (isLeaf(child1) == false)
+			cost1 -= perimeter(nodes[child1].box);
+
+		cost2 = perimeter(combine(leafBox, nodes[child2].box)) + inheritCost;
+		if (isLeaf(child2) == false)
+			cost2 -= perimeter(nodes[child2].box);
+
+		if (cost < cost1 && cost < cost2) // it's cheapest to pair the leaf with this node.
+			break;
+
+		sibling = (cost1 < cost2) ? child1 : child2;
+	}
+
+	// makes a new parent for the sibling and the leaf.
+	oldParent = nodes[sibling].parent;
+	newParent = allocateNode();
+
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].box = combine(leafBox, nodes[sibling].box);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+
+	if (oldParent != NULL_NODE) // the sibling wasn't the root.
+	{
+		if (nodes[oldParent].child1 == sibling)
+			nodes[oldParent].child1 = newParent;
+		else
+			nodes[oldParent].child2 = newParent;
+	}
+	else // the sibling was the root.
+	{
+		root = newParent;
+	}
+
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	// goes back up the tree, fixing the heights and boxes.
+	for (int node = nodes[leaf].parent; node != NULL_NODE; node = nodes[node].parent)
+	{
+		node = balance(node);
+
+		child1 = nodes[node].child1;
+		child2 = nodes[node].child2;
+
+		nodes[node].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+		nodes[node].box = combine(nodes[child1].box, nodes[child2].box);
+	}
+}
+
+// removes a leaf from the tree.
+void world::AABBTree::removeLeaf(int leaf)
+{
+	int parent = NULL_NODE;
+	int grandParent = NULL_NODE;
+	int sibling = NULL_NODE;
+
+	if (leaf == root) // the leaf is the only node.
+	{
+		root = NULL_NODE;
+		return;
+	}
+
+	parent = nodes[leaf].parent;
+	grandParent = nodes[parent].parent;
+	sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+	// the parent is removed, and the sibling takes its place.
+	if (grandParent != NULL_NODE)
+	{
+		if (nodes[grandParent].child1 == parent)
+			nodes[grandParent].child1 = sibling;
+		else
+			nodes[grandParent].child2 = sibling;
+
+		nodes[sibling].parent = grandParent;
+		freeNode(parent);
+
+		// goes back up the tree, fixing the heights and boxes.
+		for (int node = grandParent; node != NULL_NODE; node = nodes[node].parent)
+		{
+			node = balance(node);
+
+			nodes[node].height = 1 + std::max(nodes[nodes[node].child1].height, nodes[nodes[node].child2].height);
+			nodes[node].box = combine(nodes[nodes[node].child1].box, nodes[nodes[node].child2].box);
+		}
+	}
+	else
+	{
+		root = sibling;
+		nodes[sibling].parent = NULL_NODE;
+		freeNode(parent);
+	}
+
+	nodes[leaf].parent = NULL_NODE;
+}
+
+/*
+ * rotates the tree if one child of the node is more than one level taller than the other. The taller child takes the node's place.
+ * 'a' is the provided node, 'b' and 'c' are its children, and the children of the taller child are the 'grandchildren'.
+*/
+int world::AABBTree::balance(int a)
+{
+	int b = NULL_NODE;
+	int c = NULL_NODE;
+	int up = NULL_NODE; // the child being rotated up.
+	int stay = NULL_NODE; // the child that stays under 'a'.
+	int grandChild1 = NULL_NODE;
+	int grandChild2 = NULL_NODE;
+	int tall = NULL_NODE; // the taller grandchild, which stays with the rotated child.
+	int shortChild = NULL_NODE; // the shorter grandchild, which is moved under 'a'.
+	bool upIsChild2 = false; // 'true' if the second child is being rotated up.
+
+	if (isLeaf(a) || nodes[a].height < 2)
+		return a;
+
+	b = nodes[a].child1;
+	c = nodes[a].child2;
+
+	if (nodes[c].height - nodes[b].height > 1) // the second child is too tall.
+	{
+		up = c;
+		stay = b;
+		upIsChild2 = true;
+	}
+	else if (nodes[b].height - nodes[c].height > 1) // the first child is too tall.
+	{
+		up = b;
+		stay = c;
+	}
+	else // the node is balanced.
+	{
+		return a;
+	}
+
+	grandChild1 = nodes[up].child1;
+	grandChild2 = nodes[up].child2;
+
+	// the rotated child takes the place of 'a'.
+	nodes[up].child1 = a;
+	nodes[up].parent = nodes[a].parent;
+	nodes[a].parent = up;
+
+	if (nodes[up].parent != NULL_NODE)
+	{
+		if (nodes[nodes[up].parent].child1 == a)
+			nodes[nodes[up].parent].child1 = up;
+		else
+			nodes[nodes[up].parent].child2 = up;
+	}
+	else
+	{
+		root = up;
+	}
+
+	// the taller grandchild stays with the rotated child, and the shorter one goes under 'a' where the rotated child used to be.
+	tall = (nodes[grandChild1].height > nodes[grandChild2].height) ? grandChild1 : grandChild2;
+	shortChild = (tall == grandChild1) ? grandChild2 : grandChild1;
+
+	nodes[up].child2 = tall;
+
+	if (upIsChild2)
+		nodes[a].child2 = shortChild;
+	else
+		nodes[a].child1 = shortChild;
+
+	nodes[shortChild].parent = a;
+
+	nodes[a].box = combine(nodes[stay].box, nodes[shortChild].box);
+	nodes[a].height = 1 + std::max(nodes[stay].height, nodes[shortChild].height);
+
+	nodes[up].box = combine(nodes[a].box, nodes[tall].box);
+	nodes[up].height = 1 + std::max(nodes[a].height, nodes[tall].height);
+
+	return up;
+}
+
+// checks if a node is a leaf.
+bool world::AABBTree::isLeaf(int node) const { return nodes[node].child1 == NULL_NODE; }
+
+// combines two boxes.
+OOP::AABB world::AABBTree::combine(const OOP::AABB & box1, const OOP::AABB & box2)
+{
+	return OOP::AABB{
+		Vec2(std::min(box1.min.x, box2.min.x), std::min(box1.min.y, box2.min.y)),
+		Vec2(std::max(box1.max.x, box2.max.x), std::max(box1.max.y, box2.max.y))
+	};
+}
+
+// gets the perimeter of the box.
+float world::AABBTree::perimeter(const OOP::AABB & box) { return 2.0F * ((box.max.x - box.min.x) + (box.max.y - box.min.y)); }
+
+// checks if the outer box contains the inner box.
+bool world::AABBTree::contains(const OOP::AABB & outer, const OOP::AABB & inner)
+{
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+// checks if the boxes overlap.
+bool world::AABBTree::overlap(const OOP::AABB & box1, const OOP::AABB & box2)
+{
+	return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x && box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
+}
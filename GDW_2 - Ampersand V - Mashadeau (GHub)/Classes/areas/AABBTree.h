@@ -0,0 +1,119 @@
+// a dynamic tree of bounding boxes, used to quickly find entities that move around the area (enemies, moving platforms, projectiles).
+#pragma once
+
+#include "entities/Entity.h"
+
+#include <vector>
+
+namespace world
+{
+	class AABBTree
+	{
+	public:
+		// two entities whose boxes overlap in the tree.
+		struct Pair
+		{
+			entity::Entity * entity1;
+			entity::Entity * entity2;
+		};
+
+		// creates an empty tree. The margin is how much bigger the stored boxes are than the entities, so that small movements don't require the tree to be changed.
+		AABBTree(const float margin = 16.0F);
+
+		// the tree doesn't own the entities, so they aren't deleted.
+		~AABBTree();
+
+		// adds an entity to the tree. The category is used to filter queries, and should be what kind of entity it is (e.g. entity::enemy).
+		// if the entity is already in a tree, nothing happens.
+		void add(entity::Entity * entity, entity::etag category);
+
+		// removes an entity from the tree.
+		void remove(entity::Entity * entity);
+
+		// updates where an entity is in the tree. This should be called after the entity moves.
+		// if the entity is still within its stored box, then nothing changes and 'false' is returned. If it had to be reinserted, 'true' is returned.
+		bool refit(entity::Entity * entity);
+
+		// removes every entity from the tree.
+		void clear();
+
+		/*
+		 * fills 'results' with the entities of the given category whose (fattened) boxes overlap the box from 'min' to 'max'.
+		 * 'results' is cleared first, but keeps its capacity. A proper collision check is still needed for the entities returned.
+		*/
+		void query(const Vec2 & min, const Vec2 & max, std::vector<entity::Entity *> & results, entity::etag category) const;
+
+		/*
+		 * fills 'pairs' with every pair of entities whose boxes overlap, where the first entity is of 'category1', and the second is of 'category2'.
+		 * if both categories are the same, each pair is only put in once.
+		*/
+		void getPairs(std::vector<Pair> & pairs, entity::etag category1, entity::etag category2) const;
+
+		// gets the amount of entities in the tree.
+		unsigned int getEntityCount() const;
+
+		// gets the height of the tree. With a balanced tree this stays around log2 of the entity count.
+		int getHeight() const;
+
+	private:
+		// a node in the tree. Leaves hold the entities, while the other nodes hold boxes that surround both of their children.
+		struct Node
+		{
+			OOP::AABB box; // the box of the node. For a leaf, this is the fattened box of the entity.
+			entity::Entity * entity = nullptr; // the entity in the node; only used for leaves.
+			entity::etag category = entity::entity; // the kind of entity in the node.
+
+			int parent = -1; // the parent of the node.
+			int child1 = -1; // the first child of the node. Leaves don't have children.
+			int child2 = -1; // the second child of the node.
+			int next = -1; // the next node in the free list, if this node isn't being used.
+
+			int height = 0; // the height of the node. Leaves have a height of 0, and unused nodes have a height of -1.
+		};
+
+		// gets a node that isn't being used, making a new one if there are none.
+		int allocateNode();
+
+		// puts the node back into the free list.
+		void freeNode(int node);
+
+		// puts a leaf into the tree, picking the spot that makes the boxes grow the least.
+		void insertLeaf(int leaf);
+
+		// takes a leaf out of the tree.
+		void removeLeaf(int leaf);
+
+		// rotates the tree at the provided node if one side has become too tall. The node now in its place is returned.
+		int balance(int node);
+
+		// returns 'true' if the node is a leaf.
+		bool isLeaf(int node) const;
+
+		// gets the box that surrounds both provided boxes.
+		static OOP::AABB combine(const OOP::AABB & box1, const OOP::AABB & box2);
+
+		// gets the perimeter of a box. This is used as the cost of a box when inserting leaves.
+		static float perimeter(const OOP::AABB & box);
+
+		// returns 'true' if the first box fully contains the second box.
+		static bool contains(const OOP::AABB & outer, const OOP::AABB & inner);
+
+		// returns 'true' if the boxes overlap.
+		static bool overlap(const OOP::AABB & box1, const OOP::AABB & box2);
+
+		static const int NULL_NODE; // used to mark that there's no node.
+		static const float DISPLACEMENT_MULTIPLIER; // how far ahead the box is extended in the direction the entity is moving.
+
+		const float MARGIN; // how much bigger the leaf boxes are than the entities.
+
+		std::vector<Node> nodes; // all the nodes in the tree, including the unused ones.
+		unsigned int entityCount = 0; // the amount of entities in the tree.
+		int root = -1; // the root node of the tree.
+		int freeList = -1; // the first unused node.
+
+		mutable std::vector<int> stack; // used for going through the tree without recursion. It's kept so that queries don't need to allocate.
+
+	protected:
+
+	};
+}
@@ -1,10 +1,16 @@
 #include "Area.h"
+#include "platform/CCFileUtils.h"
 
 #include <iostream>
+#include <algorithm>
 
 const unsigned int world::Area::ROW_MAX; // maximum row amount
 const unsigned int world::Area::COL_MAX; // maximum column amount
 const float world::Area::GRID_UNIT_SIZE = 128.0F; // grid square size
+const unsigned int world::Area::CHUNK_SIZE; // tile chunk size
+const size_t world::Area::ENTITY_MEMORY_ESTIMATE; // tile or enemy size estimate
+const size_t world::Area::COLLIDER_MEMORY_ESTIMATE; // static collider size estimate
+const std::string world::Area::CONVERTED_LAYER_EXTENSION = ".pvr.ccz"; // compressed PVR texture
 
 // creates three backgrounds, and a foreground
 world::Area::Area(std::string backgroundLayer1, std::string backgroundLayer2, std::string backgroundLayer3, std::string foregroundLayer)
@@ -12,11 +18,11 @@ world::Area::Area(std::string backgroundLayer1, std::string backgroundLayer2, st
 
 	entity::Entity::areaGravity = &gravity; // sets the gravity for all entities to the gravity in the area.
 
-	// creates the sprites
-	bg1 = Sprite::create();
-	bg2 = Sprite::create();
-	bg3 = Sprite::create();
-	fg = Sprite::create();
+	// creates the layers
+	bg1 = world::ParallaxLayer::create();
+	bg2 = world::ParallaxLayer::create();
+	bg3 = world::ParallaxLayer::create();
+	fg = world::ParallaxLayer::create();
 
 	// sets the global z order of all backgrounds.
 	bg1->setGlobalZOrder(0.0F);
@@ -32,9 +38,123 @@ world::Area::Area(std::string backgroundLayer1, std::string backgroundLayer2, st
 
 }
 
-// destructor; releases all sprites.
+// creates the area from an area file's values.
+world::Area::Area(const world::AreaData & data) : Area(data.backgroundLayer1, data.backgroundLayer2, data.backgroundLayer3, data.foregroundLayer)
+{
+	entity::Tile * tileGrid[ROW_MAX][COL_MAX] = {}; // the tiles, placed in the grid the same way as they are in the area file.
+	entity::Enemy * enemyGrid[ROW_MAX][COL_MAX] = {}; // the enemies, placed in the grid the same way as they are in the area file.
+
+	name = data.name;
+	setGravity(data.gravity);
+
+	exit0 = data.exits[0];
+	exit1 = data.exits[1];
+	exit2 = data.exits[2];
+	exit3 = data.exits[3];
+	exit4 = data.exits[4];
+
+	spawn0 = data.spawns[0];
+	spawn1 = data.spawns[1];
+	spawn2 = data.spawns[2];
+	spawn3 = data.spawns[3];
+	spawn4 = data.spawns[4];
+
+	for (unsigned int i = 0; i < world::AreaData::LAYER_COUNT; i++) // sets how each layer scrolls.
+	{
+		getLayer(i)->setScrollFactor(data.layerScroll[i]);
+		getLayer(i)->setRepeat(data.layerRepeatX[i], data.layerRepeatY[i]);
+	}
+
+	// if two tiles or enemies are in the same spot, the later one replaces the earlier one.
+	for (const world::AreaData::Placement & tile : data.tiles)
+	{
+		delete tileGrid[tile.row][tile.col];
+		tileGrid[tile.row][tile.col] = new entity::Tile(tile.id, tile.letter, tile.copyUp, tile.copyDown, tile.copyLeft, tile.copyRight, tile.offsetBySpriteSize);
+	}
+
+	for (const world::AreaData::Placement & enemy : data.enemies)
+	{
+		delete enemyGrid[enemy.row][enemy.col];
+		enemyGrid[enemy.row][enemy.col] = new entity::Enemy(enemy.id, enemy.letter, enemy.copyUp, enemy.copyDown, enemy.copyLeft, enemy.copyRight, enemy.offsetBySpriteSize);
+	}
+
+	tileArrayToVector(tileGrid, data.flipY);
+	enemyArrayToVector(enemyGrid, data.flipY);
+}
+
+// creates the area from a cache file.
+world::Area::Area(const world::AreaCache & cache)
+	: Area(cache.getString(cache.getHeader()->layers[0]), cache.getString(cache.getHeader()->layers[1]), cache.getString(cache.getHeader()->layers[2]), cache.getString(cache.getHeader()->layers[3]))
+{
+	const world::AreaCache::Header * header = cache.getHeader(); // the values of the area.
+	const world::AreaCache::EntityRecord * record = nullptr; // the tile or enemy being made.
+	const world::AreaCache::RectRecord * rect = nullptr; // the collision rectangle being made.
+
+	name = cache.getString(header->name);
+	setGravity(header->gravity);
+
+	exit0 = cache.getString(header->exits[0]);
+	exit1 = cache.getString(header->exits[1]);
+	exit2 = cache.getString(header->exits[2]);
+	exit3 = cache.getString(header->exits[3]);
+	exit4 = cache.getString(header->exits[4]);
+
+	spawn0 = Vec2(header->spawns[0][0], header->spawns[0][1]);
+	spawn1 = Vec2(header->spawns[1][0], header->spawns[1][1]);
+	spawn2 = Vec2(header->spawns[2][0], header->spawns[2][1]);
+	spawn3 = Vec2(header->spawns[3][0], header->spawns[3][1]);
+	spawn4 = Vec2(header->spawns[4][0], header->spawns[4][1]);
+
+	for (unsigned int i = 0; i < world::AreaData::LAYER_COUNT; i++) // sets how each layer scrolls.
+	{
+		getLayer(i)->setScrollFactor(Vec2(header->layerScroll[i][0], header->layerScroll[i][1]));
+		getLayer(i)->setRepeat((header->layerRepeat >> (i * 2)) & 1U, (header->layerRepeat >> (i * 2 + 1)) & 1U);
+	}
+
+	areaTiles.reserve(header->tileCount);
+	areaEnemies.reserve(header->enemyCount);
+
+	for (uint32_t i = 0; i < header->tileCount; i++)
+	{
+		record = cache.getTiles() + i;
+		areaTiles.push_back(new entity::Tile(record->id, record->letter));
+		areaTiles.back()->setPosition(record->x, record->y);
+	}
+
+	tileIndex.build(areaTiles); // the same as the end of tileArrayToVector(), but the collision rectangles come from the cache.
+
+	for (entity::Tile * tile : areaTiles)
+	{
+		if (tile->isMoving())
+			entityTree.add(tile, entity::tile);
+		else if (tile->isSolidBlock())
+			tile->setCollisionMerged(true);
+	}
+
+	for (uint32_t i = 0; i < header->colliderCount; i++)
+	{
+		rect = cache.getColliders() + i;
+		addStaticCollider(Vec2(rect->minX, rect->minY), Vec2(rect->maxX, rect->maxY));
+	}
+
+	for (uint32_t i = 0; i < header->enemyCount; i++)
+	{
+		record = cache.getEnemies() + i;
+		areaEnemies.push_back(new entity::Enemy(record->id, record->letter));
+		areaEnemies.back()->setPosition(record->x, record->y);
+		entityTree.add(areaEnemies.back(), entity::enemy);
+	}
+}
+
+// destructor; releases all sprites. The area's node has to still exist, since the tiles and enemies remove their sprites from it.
 world::Area::~Area()
 {
+	for (entity::Tile * tile : areaTiles)
+		delete tile;
+
+	for (entity::Enemy * enemy : areaEnemies)
+		delete enemy;
+
 	if (bg1 != nullptr)
 		bg1->removeFromParent();
 
@@ -46,10 +166,13 @@ world::Area::~Area()
 
 	if (fg != nullptr)
 		fg->removeFromParent();
+
+	for (OOP::PrimitiveSquare * body : staticBodies) // deletes the merged collision rectangles.
+		delete body;
 }
 
 // Returns the first background layer
-Sprite * world::Area::getBackgroundLayer1() const { return bg1; }
+world::ParallaxLayer * world::Area::getBackgroundLayer1() const { return bg1; }
 
 // sets background layer 1
 void world::Area::setBackgroundLayer1(std::string backgroundLayer1)
@@ -57,11 +180,11 @@ void world::Area::setBackgroundLayer1(std::string backgroundLayer1)
 	if (backgroundLayer1 == "") // if the layer is blank, then the texture isn't changed.
 		return;
 
-	bg1->setTexture(backgroundLayer1);
+	bg1->setImage(backgroundLayer1); // the layer uses the image's tiles, or its converted image if there is one.
 }
 
 // Returns the second background layer
-Sprite * world::Area::getBackgroundLayer2() const { return bg2; }
+world::ParallaxLayer * world::Area::getBackgroundLayer2() const { return bg2; }
 
 // sets background layer 2
 void world::Area::setBackgroundLayer2(std::string backgroundLayer2)
@@ -69,11 +192,11 @@ void world::Area::setBackgroundLayer2(std::string backgroundLayer2)
 	if (backgroundLayer2 == "") // if the layer is blank, then the texture isn't changed.
 		return;
 
-	bg2->setTexture(backgroundLayer2);
+	bg2->setImage(backgroundLayer2); // the layer uses the image's tiles, or its converted image if there is one.
 }
 
 // Returns the third background layer
-Sprite * world::Area::getBackgroundLayer3() const { return bg3; }
+world::ParallaxLayer * world::Area::getBackgroundLayer3() const { return bg3; }
 
 // sets background layer 3
 void world::Area::setBackgroundLayer3(std::string backgroundLayer3)
@@ -81,11 +204,11 @@ void world::Area::setBackgroundLayer3(std::string backgroundLayer3)
 	if (backgroundLayer3 == "") // if the layer is blank, then the texture isn't changed.
 		return;
 
-	bg3->setTexture(backgroundLayer3);
+	bg3->setImage(backgroundLayer3); // the layer uses the image's tiles, or its converted image if there is one.
 }
 
 // Returns a backgorund layer based on a value.
-Sprite * world::Area::getBackground(short int bg) const
+world::ParallaxLayer * world::Area::getBackground(short int bg) const
 {
 	switch (bg)
 	{
@@ -104,7 +227,25 @@ Sprite * world::Area::getBackground(short int bg) const
 }
 
 // gets the foreground layer.
-Sprite * world::Area::getForegroundLayer() const { return fg; }
+world::ParallaxLayer * world::Area::getForegroundLayer() const { return fg; }
+
+// gets a layer by its index.
+world::ParallaxLayer * world::Area::getLayer(unsigned int index) const
+{
+	switch (index)
+	{
+	case 0:
+		return bg1;
+	case 1:
+		return bg2;
+	case 2:
+		return bg3;
+	case 3:
+		return fg;
+	}
+
+	return nullptr; // returns a null pointer if the index is out of range.
+}
 
 // sets foreground layer
 void world::Area::setForegroundLayer(std::string foregroundLayer)
@@ -112,16 +253,16 @@ void world::Area::setForegroundLayer(std::string foregroundLayer)
 	if (foregroundLayer == "") // if the layer is blank, then the texture isn't changed.
 		return;
 
-	fg->setTexture(foregroundLayer);
+	fg->setImage(foregroundLayer); // the layer uses the image's tiles, or its converted image if there is one.
 }
 
-// sets the positions of all background and foreground layers.
-void world::Area::setAllLayerPositions(Vec2 position)
+// moves all background and foreground layers for the camera.
+void world::Area::updateLayers(const Vec2 & cameraPosition, const Size & viewSize)
 {
-	bg1->setPosition(position);
-	bg2->setPosition(position);
-	bg3->setPosition(position);
-	fg->setPosition(position);
+	bg1->updateView(cameraPosition, viewSize);
+	bg2->updateView(cameraPosition, viewSize);
+	bg3->updateView(cameraPosition, viewSize);
+	fg->updateView(cameraPosition, viewSize);
 }
 
 // sets the anchour points of all layers.
@@ -145,7 +286,19 @@ void world::Area::setAllAnchourPoints(Vec2 anchour)
 Node * world::Area::getAsSingleNode()
 {
 	float gz = 0.0F;
-	Node * tempNode = Node::create(); // temporary node
+	Node * tempNode = nullptr; // temporary node
+
+	if (mergedNode != nullptr) // the sprites are already in the node.
+		return mergedNode;
+
+	tempNode = Node::create();
+
+	std::vector<Texture2D *> batchTextures; // the texture used by each tile batch.
+	Node * batch = nullptr; // the batch the current tile is being added to.
+
+	std::vector<Vec2> chunkCells; // the (column, row) of each tile chunk, counted in chunks.
+	Vec2 cell; // the chunk the current tile is in.
+	world::TileChunk * chunk = nullptr; // the chunk the current tile is being baked into.
 
 	// ParallaxNode * gscl = ParallaxNode::create();
 	// gscl->addChild(bg1, bg1->getGlobalZOrder(), Vec2(1.0F, 1.0F), Vec2::ZERO);
@@ -156,10 +309,81 @@ Node * world::Area::getAsSingleNode()
 	tempNode->addChild(bg3);
 	tempNode->addChild(fg);
 	
+	/*
+	 * the tiles are grouped by texture. The renderer batches sprites that are drawn one after another with the same texture (and z-order) into a single draw call,
+	 * but if the tile sets are mixed together, every change in texture starts a new draw call. With the tiles grouped, each tile set is drawn in one batch.
+	 * a SpriteBatchNode isn't used since it only allows sprites as children, and some tiles have DrawNodes on them (exit markers and collision shapes).
+	*/
+	tileBatches.clear();
+	tileChunks.clear();
+
+	bakedTiles = Node::create();
+	bakedTiles->setVisible(false);
+	tempNode->addChild(bakedTiles);
+
 	for (int i = 0; i < areaTiles.size(); i++) // adds all the tiles from the tile vector
 	{
 		gz = areaTiles.at(i)->getSprite()->getGlobalZOrder();
-		tempNode->addChild(areaTiles.at(i)->getSprite());
+		batch = nullptr;
+		chunk = nullptr;
+
+		/*
+		 * static tiles are baked into chunks of CHUNK_SIZE X CHUNK_SIZE grid squares. Each chunk is a single mesh, and is culled as a whole if the camera can't see it.
+		 * the tile's sprite is still kept (hidden), since the tile uses it for its position and size.
+		*/
+		if (areaTiles.at(i)->isBakeable())
+		{
+			cell = Vec2(floorf(areaTiles.at(i)->getPositionX() / (GRID_UNIT_SIZE * CHUNK_SIZE)), floorf(areaTiles.at(i)->getPositionY() / (GRID_UNIT_SIZE * CHUNK_SIZE)));
+
+			for (int j = 0; j < chunkCells.size(); j++) // looks for the chunk the tile is in.
+			{
+				if (chunkCells[j] == cell)
+				{
+					chunk = tileChunks[j];
+					break;
+				}
+			}
+
+			if (chunk == nullptr) // this is the first tile in this chunk.
+			{
+				chunk = world::TileChunk::create();
+				chunk->setGlobalZOrder(gz);
+
+				tileChunks.push_back(chunk);
+				chunkCells.push_back(cell);
+			}
+
+			chunk->addSprite(areaTiles.at(i)->getSprite());
+			bakedTiles->addChild(areaTiles.at(i)->getSprite());
+			areaTiles.at(i)->setBaked(true);
+			continue;
+		}
+
+		for (int j = 0; j < batchTextures.size(); j++) // looks for the batch with the tile's texture.
+		{
+			if (batchTextures[j] == areaTiles.at(i)->getSprite()->getTexture())
+			{
+				batch = tileBatches[j];
+				break;
+			}
+		}
+
+		if (batch == nullptr) // no tiles with this texture have been added yet, so a new batch is made.
+		{
+			batch = Node::create();
+			tempNode->addChild(batch);
+
+			tileBatches.push_back(batch);
+			batchTextures.push_back(areaTiles.at(i)->getSprite()->getTexture());
+		}
+
+		batch->addChild(areaTiles.at(i)->getSprite());
+	}
+
+	for (world::TileChunk * tileChunk : tileChunks) // the chunks are done being made.
+	{
+		tileChunk->finish();
+		tempNode->addChild(tileChunk);
 	}
 
 	for (int i = 0; i < areaEnemies.size(); i++) // adds all the enemies from the enemy vector
@@ -170,6 +394,65 @@ Node * world::Area::getAsSingleNode()
 	return tempNode;
 }
 
+// returns whether the area's node has been made.
+bool world::Area::hasSingleNode() const { return mergedNode != nullptr; }
+
+// estimates the memory used by the area.
+size_t world::Area::getMemoryEstimate() const
+{
+	return (areaTiles.size() + areaEnemies.size()) * ENTITY_MEMORY_ESTIMATE + staticColliders.size() * COLLIDER_MEMORY_ESTIMATE;
+}
+
+// gets the memory used by the layer textures.
+size_t world::Area::getLayerTextureMemory(bool asRGBA8888) const
+{
+	std::vector<Texture2D *> textures; // the textures of the loaded tiles. Layers can share a texture, so each one is only counted once.
+	size_t memory = 0; // the memory used by the textures.
+
+	for (world::ParallaxLayer * layer : { bg1, bg2, bg3, fg })
+	{
+		if (layer != nullptr)
+			layer->getTextures(textures);
+	}
+
+	for (Texture2D * texture : textures)
+		memory += (size_t)texture->getPixelsWide() * texture->getPixelsHigh() * ((asRGBA8888) ? 32 : texture->getBitsPerPixelForFormat()) / 8;
+
+	return memory;
+}
+
+// gets the amount of loaded layer tiles.
+unsigned int world::Area::getLayerTileCount() const
+{
+	unsigned int count = 0; // the amount of tiles.
+
+	for (world::ParallaxLayer * layer : { bg1, bg2, bg3, fg })
+	{
+		if (layer != nullptr)
+			count += layer->getTileCount();
+	}
+
+	return count;
+}
+
+// gets the converted version of a layer image, if there is one.
+std::string world::Area::getLayerImage(const std::string & image)
+{
+	std::string converted = ""; // the converted image.
+
+	if (image.length() < 4 || image.substr(image.length() - 4) != ".png")
+		return image;
+
+	converted = image.substr(0, image.length() - 4) + CONVERTED_LAYER_EXTENSION;
+	return (FileUtils::getInstance()->isFileExist(converted)) ? converted : image;
+}
+
+// gets the amount of tile batches.
+unsigned int world::Area::getTileBatchCount() const { return tileBatches.size(); }
+
+// gets the amount of tile chunks.
+unsigned int world::Area::getTileChunkCount() const { return tileChunks.size(); }
+
 // sets the name of the area
 std::string world::Area::getName() const { return name; }
 
@@ -276,6 +559,220 @@ void world::Area::setGravity(float gravity)
 // returns the tiles in the area.
 std::vector<entity::Tile*> * world::Area::getAreaTiles() { return &areaTiles; }
 
+// returns the grid holding the area tiles.
+world::SpatialGrid * world::Area::getTileIndex() { return &tileIndex; }
+
+// returns the tree holding the moving entities.
+world::AABBTree * world::Area::getEntityTree() { return &entityTree; }
+
+// gets the static and moving tiles near a box.
+void world::Area::queryTiles(const Vec2 & min, const Vec2 & max, std::vector<entity::Tile *> & results)
+{
+	tileIndex.query(min, max, results); // the static tiles.
+
+	entityTree.query(min, max, treeResults, entity::tile); // the moving tiles.
+
+	for (entity::Entity * tile : treeResults)
+		results.push_back((entity::Tile *)tile);
+}
+
+// returns the merged collision rectangles.
+const std::vector<OOP::WorldShape> & world::Area::getStaticColliders() const { return staticColliders; }
+
+// gets the merged collision rectangles that overlap a box. There are usually only a few dozen of these in an area, so they're all checked.
+void world::Area::queryStaticColliders(const Vec2 & min, const Vec2 & max, std::vector<const OOP::WorldShape *> & results) const
+{
+	unsigned int hits; // the mask of the rectangles in the current batch that overlap the box.
+
+	results.clear();
+
+	for (unsigned int first = 0; first < staticColliderBoxes.size(); first += umath::BATCH_SIZE)
+	{
+		hits = umath::aabbCollisionBatch(min, max, staticColliderBoxes, first);
+
+		for (unsigned int i = 0; hits != 0; i++, hits >>= 1) // goes through the set bits.
+		{
+			if (hits & 1U)
+				results.push_back(&staticColliders[first + i]);
+		}
+	}
+}
+
+// finds the first tile or merged rectangle that a moving box hits.
+bool world::Area::sweepTiles(const Vec2 & min, const Vec2 & max, const Vec2 & motion, float & time, Vec2 & normal, entity::Tile *& tile)
+{
+	// the box covering the whole motion, which is used to get the tiles along the way.
+	Vec2 sweepMin(std::min(min.x, min.x + motion.x), std::min(min.y, min.y + motion.y));
+	Vec2 sweepMax(std::max(max.x, max.x + motion.x), std::max(max.y, max.y + motion.y));
+
+	OOP::AABB bounds; // the box of the current collision body.
+	float hitTime = 0.0F; // the time of the current hit.
+	Vec2 hitNormal; // the side of the current hit.
+	bool hit = false; // becomes 'true' once something has been hit.
+
+	queryStaticColliders(sweepMin, sweepMax, sweepShapeResults);
+
+	for (const OOP::WorldShape * shape : sweepShapeResults)
+	{
+		if (umath::sweptAabbCollision(min, max, motion, shape->aabb.min, shape->aabb.max, hitTime, hitNormal) && (hit == false || hitTime < time))
+		{
+			time = hitTime;
+			normal = hitNormal;
+			tile = nullptr;
+			hit = true;
+		}
+	}
+
+	// the moving tiles aren't checked, since they move during the step too.
+	tileIndex.query(sweepMin, sweepMax, sweepTileResults);
+
+	for (entity::Tile * areaTile : sweepTileResults)
+	{
+		if (areaTile->isCollisionMerged()) // this tile was checked with a merged rectangle.
+			continue;
+
+		for (const OOP::WorldShape & shape : areaTile->getWorldCollisionBodies())
+		{
+			if (shape.source->isActive() == false)
+				continue;
+
+			bounds = shape.getBounds();
+
+			if (umath::sweptAabbCollision(min, max, motion, bounds.min, bounds.max, hitTime, hitNormal) && (hit == false || hitTime < time))
+			{
+				time = hitTime;
+				normal = hitNormal;
+				tile = areaTile;
+				hit = true;
+			}
+		}
+	}
+
+	return hit;
+}
+
+// merges neighbouring solid blocks into rectangles.
+void world::Area::mergeStaticColliders()
+{
+	std::vector<entity::Tile *> solidTiles; // the tiles being merged.
+	std::vector<bool> filled; // 'true' for the grid squares that have a solid block in them.
+	std::vector<bool> used; // 'true' for the grid squares that are already part of a rectangle.
+
+	OOP::AABB box; // the collision body of the current tile.
+
+	// the range of grid squares the solid blocks take up.
+	int minCol = 0, minRow = 0, maxCol = 0, maxRow = 0;
+	int cols = 0, rows = 0;
+
+	int width = 0; // the width of the current rectangle, in grid squares.
+	int height = 0; // the height of the current rectangle, in grid squares.
+	bool rowFilled = true; // becomes 'false' if the row above the rectangle can't be added to it.
+
+	// the old rectangles are removed.
+	for (OOP::PrimitiveSquare * body : staticBodies)
+		delete body;
+
+	staticBodies.clear();
+	staticColliders.clear();
+	staticColliderBoxes.clear();
+
+	for (entity::Tile * tile : areaTiles) // gets the solid blocks.
+	{
+		tile->setCollisionMerged(false);
+
+		if (tile->isSolidBlock())
+			solidTiles.push_back(tile);
+	}
+
+	if (solidTiles.size() == 0)
+		return;
+
+	// gets the grid squares the solid blocks are in.
+	for (int i = 0; i < solidTiles.size(); i++)
+	{
+		box = solidTiles[i]->getWorldCollisionBodies()[0].aabb;
+
+		if (i == 0)
+		{
+			minCol = maxCol = (int)roundf(box.min.x / GRID_UNIT_SIZE);
+			minRow = maxRow = (int)roundf(box.min.y / GRID_UNIT_SIZE);
+		}
+
+		minCol = std::min(minCol, (int)roundf(box.min.x / GRID_UNIT_SIZE));
+		maxCol = std::max(maxCol, (int)roundf(box.min.x / GRID_UNIT_SIZE));
+		minRow = std::min(minRow, (int)roundf(box.min.y / GRID_UNIT_SIZE));
+		maxRow = std::max(maxRow, (int)roundf(box.min.y / GRID_UNIT_SIZE));
+	}
+
+	cols = maxCol - minCol + 1;
+	rows = maxRow - minRow + 1;
+
+	filled.resize(cols * rows, false);
+	used.resize(cols * rows, false);
+
+	for (entity::Tile * tile : solidTiles) // fills in the squares with solid blocks.
+	{
+		box = tile->getWorldCollisionBodies()[0].aabb;
+		filled[((int)roundf(box.min.y / GRID_UNIT_SIZE) - minRow) * cols + ((int)roundf(box.min.x / GRID_UNIT_SIZE) - minCol)] = true;
+	}
+
+	// goes from the bottom left-hand corner, making the largest rectangle it can from each square that isn't in a rectangle yet.
+	for (int row = 0; row < rows; row++)
+	{
+		for (int col = 0; col < cols; col++)
+		{
+			if (filled[row * cols + col] == false || used[row * cols + col])
+				continue;
+
+			// goes right for as long as there are solid blocks.
+			width = 1;
+			while (col + width < cols && filled[row * cols + col + width] && used[row * cols + col + width] == false)
+				width++;
+
+			// goes up for as long as the whole row above is solid blocks.
+			height = 1;
+			rowFilled = true;
+
+			while (row + height < rows && rowFilled)
+			{
+				for (int i = 0; i < width; i++)
+				{
+					if (filled[(row + height) * cols + col + i] == false || used[(row + height) * cols + col + i])
+					{
+						rowFilled = false;
+						break;
+					}
+				}
+
+				if (rowFilled)
+					height++;
+			}
+
+			for (int r = row; r < row + height; r++) // marks the squares as being part of a rectangle.
+			{
+				for (int c = col; c < col + width; c++)
+					used[r * cols + c] = true;
+			}
+
+			addStaticCollider(Vec2((minCol + col) * GRID_UNIT_SIZE, (minRow + row) * GRID_UNIT_SIZE), Vec2((minCol + col + width) * GRID_UNIT_SIZE, (minRow + row + height) * GRID_UNIT_SIZE));
+		}
+	}
+
+	for (entity::Tile * tile : solidTiles)
+		tile->setCollisionMerged(true);
+}
+
+// gets the enemies near a box.
+void world::Area::queryEnemies(const Vec2 & min, const Vec2 & max, std::vector<entity::Enemy *> & results)
+{
+	entityTree.query(min, max, treeResults, entity::enemy);
+
+	results.clear();
+
+	for (entity::Entity * enemy : treeResults)
+		results.push_back((entity::Enemy *)enemy);
+}
+
 // takes a array of entity tiles and puts it into the vector. The values of ROW_MAX and COL_MAX are the limits for it.
 void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool flipY, int rowMax, int colMax)
 {
@@ -295,8 +792,11 @@ void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool fl
 			if (tileGrid[row][col] == nullptr) // if the location is a nullptr, the program skips it
 				continue;
 
-			if (areaTiles.size() >= ROW_MAX * COL_MAX) // if the vector is full.
-				return;
+			if (areaTiles.size() >= ROW_MAX * COL_MAX) // if the vector is full, the rest of the array is skipped.
+			{
+				row = ROW_MAX;
+				break;
+			}
 
 			
 			tileGrid[row][col]->setPosition(64.0F + GRID_UNIT_SIZE * col, 64.0F + GRID_UNIT_SIZE * row); // sets the position of the current tile, based on its position in the array.
@@ -333,7 +833,7 @@ void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool fl
 			if (tileGrid[row][col]->COPY_UP > 0) // Copies Upwards
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's height is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getSprite()->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
+				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= tileGrid[row][col]->COPY_UP; i++) // loops while there are still copies left to be made.
 				{
@@ -345,7 +845,7 @@ void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool fl
 			if (tileGrid[row][col]->COPY_DOWN > 0) // Copies  Down
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's height is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getSprite()->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
+				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= tileGrid[row][col]->COPY_DOWN; i++) // loops while there are still copies left to be made.
 				{
@@ -357,7 +857,7 @@ void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool fl
 			if (tileGrid[row][col]->COPY_LEFT > 0) // Copies left
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's width is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getSprite()->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
+				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= tileGrid[row][col]->COPY_LEFT; i++) // loops while there are still copies left to be made.
 				{
@@ -369,7 +869,7 @@ void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool fl
 			if (tileGrid[row][col]->COPY_RIGHT > 0) // Copies Right
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's width is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getSprite()->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
+				offset = (tileGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? tileGrid[row][col]->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= tileGrid[row][col]->COPY_RIGHT; i++) // loops while there are still copies left to be made.
 				{
@@ -380,19 +880,34 @@ void world::Area::tileArrayToVector(entity::Tile * tileGrid[][52], const bool fl
 
 		}
 	}
+
+	tileIndex.build(areaTiles); // the tiles are all in place, so the grid gets (re)built around them.
+
+	for (entity::Tile * tile : areaTiles) // moving tiles go in the entity tree instead. Tiles that are already in the tree are skipped.
+	{
+		if (tile->isMoving())
+			entityTree.add(tile, entity::tile);
+	}
+
+	mergeStaticColliders(); // merges the collision of the solid blocks.
 }
 
 // adds a tile to the area
 void world::Area::operator+=(entity::Tile * tile)
 {
 	// check to see if the passed tile already exists in the vector. If it doesn't, it will get added in.
-	for each(entity::Tile * vecTile in areaTiles)
+	for (entity::Tile * vecTile : areaTiles)
 	{
 		if (vecTile == tile) // returns void if the tile already exists in the vector.
 			return;
 	}
 
 	areaTiles.push_back(tile); // adds the tile into the vector if it isn't in there already.
+
+	if (tile->isMoving())
+		entityTree.add(tile, entity::tile);
+	else
+		tileIndex.add(tile);
 }
 
 // subtracts a tile from the area
@@ -404,6 +919,14 @@ void world::Area::operator-=(entity::Tile * tile)
 		if (areaTiles.at(i) == tile) // if the passed tile has been found, it is then deleted.
 		{
 			areaTiles.erase(areaTiles.begin() + i);
+			(tile->treeProxy != -1) ? entityTree.remove(tile) : tileIndex.remove(tile);
+			removeFromCullLists(tile);
+
+			if (tile->isCollisionMerged()) // the merged rectangles need to be remade without the tile.
+			{
+				tile->setCollisionMerged(false);
+				mergeStaticColliders();
+			}
 			return; // returns 'void' since the check is done.
 		}
 	}
@@ -442,7 +965,7 @@ void world::Area::enemyArrayToVector(entity::Enemy * enemyGrid[][52], const bool
 			if (enemyGrid[row][col]->COPY_UP > 0) // Copies Upwards
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's height is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getSprite()->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
+				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= enemyGrid[row][col]->COPY_UP; i++) // loops while there are still copies left to be made.
 				{
@@ -454,7 +977,7 @@ void world::Area::enemyArrayToVector(entity::Enemy * enemyGrid[][52], const bool
 			if (enemyGrid[row][col]->COPY_DOWN > 0) // Copies  Down
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's height is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getSprite()->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
+				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getTextureRect().getMaxY() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= enemyGrid[row][col]->COPY_DOWN; i++) // loops while there are still copies left to be made.
 				{
@@ -466,7 +989,7 @@ void world::Area::enemyArrayToVector(entity::Enemy * enemyGrid[][52], const bool
 			if (enemyGrid[row][col]->COPY_LEFT > 0) // Copies left
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's width is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getSprite()->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
+				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= enemyGrid[row][col]->COPY_LEFT; i++) // loops while there are still copies left to be made.
 				{
@@ -478,7 +1001,7 @@ void world::Area::enemyArrayToVector(entity::Enemy * enemyGrid[][52], const bool
 			if (enemyGrid[row][col]->COPY_RIGHT > 0) // Copies Right
 			{
 				// If the user wants the sprite to be offset by its actual size, the textureRect's width is used. If not, then GRID_UNIT_SIZE pixels are used.
-				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getSprite()->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
+				offset = (enemyGrid[row][col]->OFFSET_BY_SPRITE_SIZE) ? enemyGrid[row][col]->getTextureRect().getMaxX() : GRID_UNIT_SIZE;
 
 				for (int i = 1; i <= enemyGrid[row][col]->COPY_RIGHT; i++) // loops while there are still copies left to be made.
 				{
@@ -489,19 +1012,23 @@ void world::Area::enemyArrayToVector(entity::Enemy * enemyGrid[][52], const bool
 
 		}
 	}
+
+	for (entity::Enemy * enemy : areaEnemies) // the enemies are all in place, so they're put in the entity tree. Enemies that are already in the tree are skipped.
+		entityTree.add(enemy, entity::enemy);
 }
 
 // adds an enemy to the area
 void world::Area::operator+=(entity::Enemy * enemy)
 {
 	// check to see if the passed enemy already exists in the vector. If it doesn't, it will get added in.
-	for each(entity::Enemy * vecEnemy in areaEnemies)
+	for (entity::Enemy * vecEnemy : areaEnemies)
 	{
 		if (vecEnemy == enemy) // returns void if the enemy already exists in the vector.
 			return;
 	}
 
 	areaEnemies.push_back(enemy); // adds the enemy into the vector if it isn't in there already.
+	entityTree.add(enemy, entity::enemy);
 }
 
 // subtracts an enemy from the area
@@ -513,132 +1040,319 @@ void world::Area::operator-=(entity::Enemy * enemy)
 		if (areaEnemies[i] == enemy) // if the passed enemy has been found, it is then deleted.
 		{
 			areaEnemies.erase(areaEnemies.begin() + i);
+			entityTree.remove(enemy);
+			removeFromCullLists(enemy);
 			return; // returns 'void' since the check is done.
 		}
 	}
 }
 
-// gets the class data in bytes.
-char * world::Area::toBytes() const
+// adds a merged collision rectangle. The rectangle is already in world space, so there's no offset.
+void world::Area::addStaticCollider(const Vec2 & min, const Vec2 & max)
 {
-	char bytes[sizeof(Area)]; // size of the vec2 class
-	memcpy(bytes, this, sizeof(Area)); // getting the current object in byte form
+	OOP::WorldShape shape; // the collision rectangle in the game world.
 
-	return bytes;
+	staticBodies.push_back(new OOP::PrimitiveSquare(min, max));
+	staticBodies.back()->getWorldShape(Vec2(0.0F, 0.0F), shape);
+	staticColliders.push_back(shape);
+	staticColliderBoxes.add(shape.aabb.min, shape.aabb.max);
 }
 
-// writes the level data to a file.
-void world::Area::saveToFile() { saveToFile("dats/AIN_" + getName() + ".dat", this); }
+// interpolates the moving entities.
+void world::Area::interpolate(float alpha)
+{
+	for (entity::Tile * tile : activeTiles)
+	{
+		if (tile->treeProxy != -1) // only moving tiles are in the entity tree.
+			tile->interpolate(alpha);
+	}
+
+	for (entity::Enemy * enemy : activeEnemies)
+		enemy->interpolate(alpha);
+}
 
-// writes the level data to a file.
-void world::Area::saveToFile(std::string fileName, world::Area * area)
+// ends the interpolation of the moving entities.
+void world::Area::endInterpolation()
 {
-	std::ofstream file;
-	file.open(fileName, std::ios::out); // creates the file for output to it
+	for (entity::Tile * tile : activeTiles)
+		tile->endInterpolation();
 
-	// validity check
-	try
+	for (entity::Enemy * enemy : activeEnemies)
+		enemy->endInterpolation();
+}
+
+// works out what should be updated and drawn.
+void world::Area::cull(const Vec2 & cameraMin, const Vec2 & cameraMax)
+{
+	Rect renderRect(cameraMin - renderMargin, Size(cameraMax.x - cameraMin.x + renderMargin.x * 2, cameraMax.y - cameraMin.y + renderMargin.y * 2)); // the area that gets drawn.
+
+	if (culled == false) // everything starts off inactive and hidden, and then the entities near the camera are turned on.
 	{
-		if (!file)
-			throw "Failed to open file for saving. Information saving failed";
+		for (entity::Tile * tile : areaTiles)
+		{
+			tile->onScreen = false;
+
+			if (tile->isBaked() == false)
+				tile->getSprite()->setVisible(false);
+		}
+
+		for (unsigned int i = 0; i < areaEnemies.size(); i++)
+		{
+			areaEnemies[i]->onScreen = false;
+			areaEnemies[i]->getSprite()->setVisible(false);
+			areaEnemies[i]->updateSlot = i; // spreads the middle tier enemies out over the steps.
+		}
+
+		culled = true;
 	}
-	catch (const char * ex)
+
+	// the entities from the last cull are turned off.
+	for (entity::Tile * tile : activeTiles)
+		tile->onScreen = false;
+
+	for (entity::Enemy * enemy : activeEnemies)
 	{
-		std::cout << ex << std::endl;
-		return;
+		enemy->onScreen = false;
+		enemy->updateTier = entity::Enemy::farTier;
 	}
-	catch (...)
+
+	for (entity::Enemy * enemy : midEnemies)
+		enemy->updateTier = entity::Enemy::farTier;
+
+	for (entity::Entity * entity : visibleEntities)
+		entity->getSprite()->setVisible(false);
+
+	visibleEntities.clear();
+
+	// gets the entities that should be updated.
+	queryTiles(cameraMin - updateMargin, cameraMax + updateMargin, activeTiles);
+	queryEnemies(cameraMin - updateMargin, cameraMax + updateMargin, activeEnemies);
+
+	for (entity::Tile * tile : activeTiles)
+		tile->onScreen = true;
+
+	for (entity::Enemy * enemy : activeEnemies)
 	{
-		std::cout << "Error encountered. Unable to write to file" << std::endl;
-		return;
+		enemy->onScreen = true;
+		enemy->updateTier = entity::Enemy::nearTier;
 	}
 
-	// writes information to file.
-	file.write(reinterpret_cast<const char *>(area), sizeof(world::Area));
+	// gets the enemies in the middle tier, which are the ones close to the update margin that aren't active.
+	queryEnemies(cameraMin - updateMargin - lodMargin, cameraMax + updateMargin + lodMargin, midEnemies);
+	midEnemies.erase(std::remove_if(midEnemies.begin(), midEnemies.end(), [](entity::Enemy * enemy) { return enemy->updateTier == entity::Enemy::nearTier; }), midEnemies.end());
 
-	file.close();
-	
-}
+	for (entity::Enemy * enemy : midEnemies)
+		enemy->updateTier = entity::Enemy::midTier;
 
-// loads level information from a file if the file isn't empty.
-world::Area * world::Area::loadFromFile() { return loadFromFile("dats/AIN_" + name + ".dat"); }
+	// picks the middle and far tier enemies that get updated on this step. The middle tier enemies take turns based on their slots, and the far tier enemies take turns based on where they are in the area's list.
+	scheduledEnemies.clear();
 
-// loads level information from a provided area file.
-world::Area * world::Area::loadFromFile(std::string fileName)
-{
-	world::Area * area = nullptr;
+	for (entity::Enemy * enemy : midEnemies)
+	{
+		if ((enemy->updateSlot + updateStep) % MID_UPDATE_INTERVAL == 0)
+			scheduledEnemies.push_back(enemy);
+	}
 
-	std::ifstream file; // the file to be opened
-	file.open(fileName, std::ios::in);
+	for (unsigned int i = updateStep % FAR_UPDATE_INTERVAL; i < areaEnemies.size(); i += FAR_UPDATE_INTERVAL)
+	{
+		if (areaEnemies[i]->updateTier == entity::Enemy::farTier)
+			scheduledEnemies.push_back(areaEnemies[i]);
+	}
+
+	// gets the entities that should be drawn. The queries only give the entities that might be in the box, so their sprites are checked as well.
+	queryTiles(renderRect.origin, renderRect.origin + renderRect.size, cullTiles);
+	queryEnemies(renderRect.origin, renderRect.origin + renderRect.size, cullEnemies);
+
+	for (entity::Tile * tile : cullTiles)
+	{
+		if (tile->isBaked() == false && tile->getSprite()->getBoundingBox().intersectsRect(renderRect))
+		{
+			tile->getSprite()->setVisible(true);
+			visibleEntities.push_back(tile);
+		}
+	}
 
-	try
+	for (entity::Enemy * enemy : cullEnemies)
 	{
-		if (!file)
-			throw "Failed to open file for reading. Information failed to load";
+		if (enemy->getSprite()->getBoundingBox().intersectsRect(renderRect))
+		{
+			enemy->getSprite()->setVisible(true);
+			visibleEntities.push_back(enemy);
+		}
 	}
-	catch (const char * ex)
+}
+
+// sets the cull margins.
+void world::Area::setCullMargins(Vec2 updateMargin, Vec2 renderMargin)
+{
+	this->updateMargin = Vec2(std::max(updateMargin.x, 0.0F), std::max(updateMargin.y, 0.0F));
+	this->renderMargin = Vec2(std::max(renderMargin.x, 0.0F), std::max(renderMargin.y, 0.0F));
+}
+
+// sets the LOD margin.
+void world::Area::setLodMargin(Vec2 lodMargin) { this->lodMargin = Vec2(std::max(lodMargin.x, 0.0F), std::max(lodMargin.y, 0.0F)); }
+
+// gets the enemies being updated on this step from the middle and far tiers.
+const std::vector<entity::Enemy *> & world::Area::getScheduledEnemies() const { return scheduledEnemies; }
+
+// gets how long an enemy should be updated for.
+float world::Area::getCatchUpTime(entity::Enemy * enemy, float deltaTime) const
+{
+	unsigned int steps = updateStep + 1 - enemy->lastUpdateStep; // the amount of steps the enemy missed, including this one.
+	float speed = enemy->getVelocity().length(); // how far the enemy moves in a second.
+
+	if (steps <= 1) // the enemy was updated on the last step.
+		return deltaTime;
+
+	// if the enemy would move too far, the rest of the time is dropped. It falls a bit behind, but it doesn't go through any tiles.
+	if (speed * deltaTime * steps > GRID_UNIT_SIZE / 2.0F)
+		return std::max(deltaTime, GRID_UNIT_SIZE / 2.0F / speed);
+
+	return deltaTime * steps;
+}
+
+// keeps an enemy inside of the area.
+void world::Area::keepInBounds(entity::Enemy * enemy)
+{
+	Vec2 areaMax(COL_MAX * GRID_UNIT_SIZE, ROW_MAX * GRID_UNIT_SIZE); // the top right-hand corner of the area's grid.
+	Vec2 position = enemy->getPosition(); // the enemy's position.
+
+	if (position.x >= 0.0F && position.x <= areaMax.x && position.y >= 0.0F && position.y <= areaMax.y) // the enemy is in the area.
+		return;
+
+	// the enemy is put back on the edge it went past, and stops moving that way.
+	if (position.x < 0.0F || position.x > areaMax.x)
 	{
-		std::cout << ex << std::endl;
-		return nullptr;
+		position.x = clampf(position.x, 0.0F, areaMax.x);
+		enemy->zeroVelocityX();
 	}
-	catch (...)
+
+	if (position.y < 0.0F || position.y > areaMax.y)
 	{
-		std::cout << "Error encountered. Unable to open file for reading" << std::endl;
-		return nullptr;
+		position.y = clampf(position.y, 0.0F, areaMax.y);
+		enemy->zeroVelocityY();
 	}
 
-	// loads in area information
-	file.read(reinterpret_cast<char *>(area), sizeof(world::Area));
-	
-	file.close();
+	enemy->setPosition(position);
+}
+
+// gets the active tiles.
+const std::vector<entity::Tile *> & world::Area::getActiveTiles() const { return activeTiles; }
+
+// gets the active enemies.
+const std::vector<entity::Enemy *> & world::Area::getActiveEnemies() const { return activeEnemies; }
 
-	return area;
+// removes an entity from the cull lists.
+void world::Area::removeFromCullLists(entity::Entity * entity)
+{
+	activeTiles.erase(std::remove(activeTiles.begin(), activeTiles.end(), entity), activeTiles.end());
+	activeEnemies.erase(std::remove(activeEnemies.begin(), activeEnemies.end(), entity), activeEnemies.end());
+	midEnemies.erase(std::remove(midEnemies.begin(), midEnemies.end(), entity), midEnemies.end());
+	scheduledEnemies.erase(std::remove(scheduledEnemies.begin(), scheduledEnemies.end(), entity), scheduledEnemies.end());
+	visibleEntities.erase(std::remove(visibleEntities.begin(), visibleEntities.end(), entity), visibleEntities.end());
 }
 
 // updates the area
 void world::Area::update(float deltaTime)
 {
-	entity::Entity * tempEntity = nullptr;
+	entity::Tile * tile = nullptr; // the tile being updated.
+	entity::Enemy * enemy = nullptr; // the enemy being updated.
+	float catchUpTime = 0.0F; // the time an enemy is updated for, which includes the steps it missed.
 
-	// updates the scene tiles
-	for (int i = 0; i < areaTiles.size(); i++)
+	// the entities only queue up their movement while they're updated, and are all moved at once when the batch is flushed (see entity::PhysicsStore).
+	// the simulation starts the batch before the player is updated, so the player gets moved in the same pass.
+	entity::Entity::physics->beginBatch();
+
+	// updates the active scene tiles
+	for (int i = 0; i < activeTiles.size(); i++)
 	{
-		if (areaTiles.at(i)->onScreen == false) // not on screen, so don't update.
+		tile = activeTiles[i];
+
+		if (tile->isBaked()) // baked into a chunk, so it never changes.
 			continue;
 
-		areaTiles.at(i)->update(deltaTime);
+		tile->storePreviousPosition();
+		tile->update(deltaTime);
+	}
 
-		if (areaTiles[i]->getHealth() <= 0.0F) // if the tile has no health, it should be deleted.
-		{
-			for (OOP::Primitive * p : areaTiles[i]->getCollisionBodies()) // removing all of the primitives from their parents for the tiles.
-				p->getPrimitive()->removeFromParent();
+	// updates the active enemies
+	for (int i = 0; i < activeEnemies.size(); i++)
+	{
+		enemy = activeEnemies[i];
 
-			areaTiles[i]->getSprite()->removeFromParent(); // removes the tile's sprite.
-			areaTiles.erase(areaTiles.begin() + i); // erases the pointer and other tile data.
-		}
+		catchUpTime = getCatchUpTime(enemy, deltaTime); // an enemy that just came into range may have missed some steps.
+		enemy->lastUpdateStep = updateStep + 1;
 
+		enemy->storePreviousPosition();
+		enemy->update(catchUpTime);
 	}
-		
 
-	// updates the enemies
-	for (int i = 0; i < areaEnemies.size(); i++)
+	// catches up the middle and far tier enemies that were picked for this step (see cull()). The far tier enemies only get the coarse update.
+	for (entity::Enemy * emy : scheduledEnemies)
+	{
+		catchUpTime = getCatchUpTime(emy, deltaTime);
+		emy->lastUpdateStep = updateStep + 1;
+
+		emy->storePreviousPosition();
+		(emy->updateTier == entity::Enemy::midTier) ? emy->update(catchUpTime) : emy->updateCoarse(catchUpTime);
+	}
+
+	entity::Entity::physics->flush(); // moves everything that was updated.
+
+	// refits the moving tiles, and removes the destroyed ones.
+	for (int i = 0; i < activeTiles.size(); i++)
 	{
-		if (areaEnemies.at(i)->onScreen == false) // not on screen, so don't update.
+		tile = activeTiles[i];
+
+		if (tile->isBaked())
 			continue;
 
-		areaEnemies[i]->update(deltaTime);
+		if (tile->treeProxy != -1) // moving tiles get refitted in the entity tree.
+			entityTree.refit(tile);
+
+		if (tile->getHealth() <= 0.0F) // if the tile has no health, it should be deleted.
+		{
+			for (OOP::Primitive * p : tile->getCollisionBodies()) // removing all of the primitives from their parents for the tiles.
+				p->removeFromParent();
+
+			tile->getSprite()->removeFromParent(); // removes the tile's sprite.
+			(tile->treeProxy != -1) ? entityTree.remove(tile) : tileIndex.remove(tile); // the tile is no longer in the grid or tree.
+			areaTiles.erase(std::remove(areaTiles.begin(), areaTiles.end(), tile), areaTiles.end()); // erases the pointer and other tile data.
+
+			removeFromCullLists(tile);
+			i--; // the next tile is now at this index.
+		}
+	}
+
+	// refits the active enemies, and removes the defeated ones.
+	for (int i = 0; i < activeEnemies.size(); i++)
+	{
+		enemy = activeEnemies[i];
+
+		entityTree.refit(enemy); // the enemy may have moved, so its place in the tree is updated.
 		
-		if (areaEnemies[i]->getHealth() <= 0.0F) // if the enemy has lost all of its health.
+		if (enemy->getHealth() <= 0.0F) // if the enemy has lost all of its health.
 		{
-			for (OOP::Primitive * p : areaEnemies[i]->getCollisionBodies()) // removing all of the primitives from their parents.
-				p->getPrimitive()->removeFromParent();
+			for (OOP::Primitive * p : enemy->getCollisionBodies()) // removing all of the primitives from their parents.
+				p->removeFromParent();
 
-			areaEnemies[i]->getSprite()->removeFromParent();
-			areaEnemies.erase(areaEnemies.begin() + i); // erases the pointer.
+			enemy->getSprite()->removeFromParent();
+			entityTree.remove(enemy); // the enemy is taken out of the tree.
+			areaEnemies.erase(std::remove(areaEnemies.begin(), areaEnemies.end(), enemy), areaEnemies.end()); // erases the pointer.
 
-			
+			removeFromCullLists(enemy);
+			i--; // the next enemy is now at this index.
 		}
 	}
+
+	// keeps the caught up enemies in the area, and refits them.
+	for (entity::Enemy * emy : scheduledEnemies)
+	{
+		keepInBounds(emy);
+		entityTree.refit(emy);
+	}
+
+	updateStep++;
 }
 
 
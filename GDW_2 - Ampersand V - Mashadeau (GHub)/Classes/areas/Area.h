@@ -4,10 +4,16 @@
 // #include "PlatformManager.h"
 #include "entities/Tile.h"
 #include "entities/Enemy.h"
+#include "areas/SpatialGrid.h"
+#include "areas/AABBTree.h"
+#include "areas/TileChunk.h"
+#include "areas/ParallaxLayer.h"
+#include "areas/AreaData.h"
+#include "areas/AreaCache.h"
+#include "CollisionBatch.h"
 
 #include "2d/CCSprite.h"
 #include <string>
-#include <fstream> // used for file reading and writing
 using namespace cocos2d;
 
 namespace world
@@ -26,32 +32,73 @@ namespace world
 		*/
 		Area(std::string backgroundLayer1, std::string backgroundLayer2 = "", std::string backgroundLayer3 = "", std::string foregroundLayer = "");
 
+		// creates the area from the values in an area file (see world::AreaData). This makes all of the area's tiles and enemies.
+		Area(const world::AreaData & data);
+
+		// creates the area from a cache file (see world::AreaCache). The tiles and enemies are put right where the cache says, and the collision rectangles aren't merged again.
+		Area(const world::AreaCache & cache);
+
 		~Area();
 
+		// The size of the screen is 13 X 7.5 on full screen (i.e. 13 128 X 128 blocks along the x-axis, and 7.5 128 X 128 blocks along the y-axis.
+		// The ROW_MAX and COL_MAX determines the maximum size of the area. They are currently 30 X 52 (13 * 4, 7.5 * 4)
+		static const unsigned int ROW_MAX = 30; // maximum amount of rows
+		static const unsigned int COL_MAX = 52; // maximum amount of columns
+
 		// returns background layer 1 
-		Sprite * getBackgroundLayer1() const;
+		world::ParallaxLayer * getBackgroundLayer1() const;
 
 		// returns background layer 2
-		Sprite * getBackgroundLayer2() const;
+		world::ParallaxLayer * getBackgroundLayer2() const;
 
 		// returns background layer 3
-		Sprite * getBackgroundLayer3() const;
+		world::ParallaxLayer * getBackgroundLayer3() const;
 
 		// gets a background based on a passed value.
-		Sprite * getBackground(short int bg) const;
+		world::ParallaxLayer * getBackground(short int bg) const;
 
 		// returns the foreground layer
-		Sprite * getForegroundLayer() const;
+		world::ParallaxLayer * getForegroundLayer() const;
+
+		// gets a layer by its index. 0 to 2 are background layers 1 to 3, and 3 is the foreground layer. If the index is out of range, a nullptr is returned.
+		world::ParallaxLayer * getLayer(unsigned int index) const;
 
-		// sets the position of all background and foreground layers to be the same.
-		void setAllLayerPositions(Vec2 position);
+		// moves the background and foreground layers for a camera at 'cameraPosition' that shows 'viewSize' of the area. Each layer scrolls based on its own scroll factor (see world::ParallaxLayer).
+		void updateLayers(const Vec2 & cameraPosition, const Size & viewSize);
 
 		// sets the anchour points of all layers.
 		void setAllAnchourPoints(Vec2 anchour);
 
 		// gets all graphic elements as a single drawNode.
+		// the tile sprites are grouped into one child node per texture, so that the renderer can draw each tile set in a single batch.
+		// the node is only made once. If it's called again, the same node is returned (e.g. when an area is reused; see world::LiveAreaCache).
 		Node * getAsSingleNode();
 
+		// returns 'true' if the area's node has been made by getAsSingleNode().
+		bool hasSingleNode() const;
+
+		// gets a rough estimate of the memory the area's tiles, enemies, and sprites take up. This uses fixed sizes so that it's the same on every platform.
+		size_t getMemoryEstimate() const;
+
+		// gets the amount of tile batches (i.e. different tile textures) made by getAsSingleNode().
+		unsigned int getTileBatchCount() const;
+
+		// gets the amount of tile chunks made by getAsSingleNode(). The static tiles are baked into these chunks.
+		unsigned int getTileChunkCount() const;
+
+		// gets the memory used by the background and foreground textures, in bytes. If 'asRGBA8888' is true, the memory they would use if they were loaded from their PNGs is returned instead.
+		// only the tiles that are loaded are counted (see world::ParallaxLayer).
+		size_t getLayerTextureMemory(bool asRGBA8888 = false) const;
+
+		// gets the amount of background and foreground tiles that are loaded.
+		unsigned int getLayerTileCount() const;
+
+		// gets the file a layer is loaded from. If the image has been converted to a smaller texture format (see tools/convert_backgrounds.py), the converted file is used instead of the PNG.
+		static std::string getLayerImage(const std::string & image);
+
+		// the extension of the converted layer images, which replaces the '.png' extension.
+		static const std::string CONVERTED_LAYER_EXTENSION;
+
 		// gets the name of the area. This does NOT include the 'AIN_' prefix, just the ending three characters (Letter, Integer, Integer)
 		std::string getName() const;
 
@@ -100,6 +147,40 @@ namespace world
 
 		// gets the scene tiles
 		std::vector<entity::Tile *> * getAreaTiles();
+
+		// gets the grid that holds the area tiles. This should be used to get tiles near a given location instead of going through every tile.
+		world::SpatialGrid * getTileIndex();
+
+		// gets the tree that holds the things that move around the area (enemies and moving tiles).
+		world::AABBTree * getEntityTree();
+
+		// fills 'results' with the tiles that might overlap the box from 'min' to 'max'. This includes both static tiles (from the grid) and moving tiles (from the tree).
+		void queryTiles(const Vec2 & min, const Vec2 & max, std::vector<entity::Tile *> & results);
+
+		// fills 'results' with the enemies that might overlap the box from 'min' to 'max'.
+		void queryEnemies(const Vec2 & min, const Vec2 & max, std::vector<entity::Enemy *> & results);
+
+		// gets the collision rectangles made by merging neighbouring solid tiles (see mergeStaticColliders()).
+		const std::vector<OOP::WorldShape> & getStaticColliders() const;
+
+		// fills 'results' with the merged collision rectangles that overlap the box from 'min' to 'max'. The rectangles are checked in batches (see umath::aabbCollisionBatch()).
+		void queryStaticColliders(const Vec2 & min, const Vec2 & max, std::vector<const OOP::WorldShape *> & results) const;
+
+		/*
+		 * finds the first merged collision rectangle or static tile that the box from 'min' to 'max' would hit if it moved by 'motion' (see umath::sweptAabbCollision()).
+		 * this is used for things that move far enough in one step to pass through a tile without ever overlapping it. Only the tiles in the grid cells along the way are checked.
+		 * 'time' gets how far along the motion the hit is (0 to 1), 'normal' gets the side that was hit, and 'tile' gets the tile that was hit (or nullptr if it was a merged rectangle).
+		 * returns 'false' if nothing was hit, in which case the other values are left alone.
+		*/
+		bool sweepTiles(const Vec2 & min, const Vec2 & max, const Vec2 & motion, float & time, Vec2 & normal, entity::Tile *& tile);
+
+		/*
+		 * merges the collision bodies of neighbouring solid blocks (see entity::Tile::isSolidBlock()) into as few rectangles as possible.
+		 * each rectangle is made by going as far right as possible from the first free square, and then going up for as long as the whole row is filled.
+		 * the merged tiles keep their own collision bodies, but they're marked so that the collision checks use the rectangles instead.
+		 * this is called at the end of tileArrayToVector(), but it can be called again if the solid blocks change.
+		*/
+		void mergeStaticColliders();
 	
 		/*
 		* adds an array to the area tiles vector. The maximum size of the array is the value of ROW_MAX and COL_MAX.
@@ -140,40 +221,94 @@ namespace world
 		// subtracts an enemy from the area
 		void operator-=(entity::Enemy *);
 
-		// returns the class in bytes.
-		char * toBytes() const;
+		/*
+		 * works out which tiles and enemies should be updated and drawn, based on what the camera can see (the box from 'cameraMin' to 'cameraMax').
+		 * entities within the update margin of the camera are put into the active lists, and have their 'onScreen' flag turned on. Only these are updated and checked for collisions.
+		 * entities within the render margin have their sprites made visible, and the rest are hidden so the renderer skips them. Baked tiles are culled by their chunks instead.
+		 * the enemies outside of the update margin aren't frozen. They're put into update tiers based on how far away they are (see entity::Enemy::UpdateTier):
+			* the enemies within the LOD margin of the update margin are in the middle tier. They're split up so that a few of them are updated on each step, and each one is updated every MID_UPDATE_INTERVAL steps.
+			* the rest are in the far tier, and get a coarse update (see entity::Enemy::updateCoarse()) every FAR_UPDATE_INTERVAL steps, which is also spread out over the steps.
+			* when an enemy is updated, it's given all of the time it missed, so it ends up about where it would have been if it had been updated every step.
+		 * this should be called once per physics step, before update().
+		*/
+		void cull(const Vec2 & cameraMin, const Vec2 & cameraMax);
+
+		// sets the extra space around the camera for updating entities, and for drawing them (see cull()). Negative values are set to 0.
+		void setCullMargins(Vec2 updateMargin, Vec2 renderMargin);
+
+		// sets the extra space around the update margin where enemies are in the middle update tier (see cull()). Negative values are set to 0.
+		void setLodMargin(Vec2 lodMargin);
+
+		// gets the enemies outside of the update margin that are being updated on this physics step (see cull()). These are in the middle or far update tiers.
+		const std::vector<entity::Enemy *> & getScheduledEnemies() const;
 
-		// writes the class data to its desigated file.
-		void saveToFile();
+		// the amount of physics steps between the updates of an enemy in the middle tier.
+		static const unsigned int MID_UPDATE_INTERVAL = 4;
 
-		// writes the class data to a specific file.
-		void saveToFile(std::string fileName, world::Area * area);
+		// the amount of physics steps between the coarse updates of an enemy in the far tier.
+		static const unsigned int FAR_UPDATE_INTERVAL = 32;
 
-		// loads level data from a file if there is any.
-		world::Area * loadFromFile();
+		// gets the tiles that are close enough to the camera to be updated (see cull()).
+		const std::vector<entity::Tile *> & getActiveTiles() const;
 
-		// loads an area in from a file. If an error occurs, a nullptr is returned.
-		static world::Area * loadFromFile(std::string fileName);
+		// gets the enemies that are close enough to the camera to be updated (see cull()).
+		const std::vector<entity::Enemy *> & getActiveEnemies() const;
 
-		// updates the Area.
+		// updates the Area. The active tiles and enemies are updated, along with the middle and far tier enemies picked by the last cull (see cull()). This is called once per physics step.
 		void update(float deltaTime);
 
+		// moves the sprites of the active enemies and moving tiles between their last two physics steps (see entity::Entity::interpolate()).
+		void interpolate(float alpha);
+
+		// puts the active enemies and moving tiles back at their actual positions. This should be called before the area is culled or updated again.
+		void endInterpolation();
+
 		// Background images
-		Sprite * bg1 = nullptr; // the first background layer; it's the farthest back layer
-		Sprite * bg2 = nullptr; // the second background layer; it's infront of bg1.
-		Sprite * bg3 = nullptr; // the third background layer; it's in front of bg2.
+		world::ParallaxLayer * bg1 = nullptr; // the first background layer; it's the farthest back layer
+		world::ParallaxLayer * bg2 = nullptr; // the second background layer; it's infront of bg1.
+		world::ParallaxLayer * bg3 = nullptr; // the third background layer; it's in front of bg2.
 
 		// Foreground image.
-		Sprite * fg = nullptr; // a foreground layer; this would go in front of all other level assets.
+		world::ParallaxLayer * fg = nullptr; // a foreground layer; this would go in front of all other level assets.
 
-		Node * mergedNode; // a node that saves the whole area on a single node (see getAsSingleNode())
+		Node * mergedNode = nullptr; // a node that saves the whole area on a single node (see getAsSingleNode())
+		std::vector<Node *> tileBatches; // the nodes in the mergedNode that hold the tile sprites. There is one node for each tile texture.
+		std::vector<world::TileChunk *> tileChunks; // the chunks the static tiles have been baked into.
+		Node * bakedTiles = nullptr; // holds the sprites of the baked tiles so that they aren't deleted. This node is hidden, so they aren't drawn (or visited).
 
 	private:
 		// float gravity = 100.0F; // the level of gravity in the area. This is too floaty.
 		float gravity = 500.0F; // final game gravity?
 
-		std::string fileName; // the name of the file
-		std::fstream file; // the file itself
+		// adds a merged collision rectangle that goes from 'min' to 'max' in the game world.
+		void addStaticCollider(const Vec2 & min, const Vec2 & max);
+
+		// removes an entity from the active and visible lists. This is used when the entity is taken out of the area.
+		void removeFromCullLists(entity::Entity * entity);
+
+		// gets how long an enemy should be updated for to catch it up on the steps it missed. This is limited so that the enemy can't move more than half of a grid square in one go, since it could pass through a tile without touching it.
+		float getCatchUpTime(entity::Enemy * enemy, float deltaTime) const;
+
+		// stops an enemy at the edges of the area's grid. This is only done for the middle and far tier enemies, which are updated while they're off screen, where there may be nothing for them to turn around at.
+		// this works around the enemies' movement force, which always pushes them the same way (see entity::Enemy::addMoveForce()). The enemies near the view are left as they were.
+		void keepInBounds(entity::Enemy * enemy);
+
+		Vec2 updateMargin = Vec2(128.0F, 128.0F); // the space around the camera where entities are still updated.
+		Vec2 renderMargin = Vec2(64.0F, 64.0F); // the space around the camera where entities are still drawn.
+		Vec2 lodMargin = Vec2(1920.0F, 1080.0F); // the space around the update margin where enemies are in the middle update tier.
+
+		std::vector<entity::Tile *> activeTiles; // the tiles being updated.
+		std::vector<entity::Enemy *> activeEnemies; // the enemies being updated.
+		std::vector<entity::Entity *> visibleEntities; // the tiles and enemies that had their sprites made visible by the last cull.
+		std::vector<entity::Enemy *> midEnemies; // the enemies in the middle update tier.
+		std::vector<entity::Enemy *> scheduledEnemies; // the middle and far tier enemies being updated on this step.
+		unsigned int updateStep = 0; // the amount of times the area has been updated. This decides which middle and far tier enemies are updated (see cull()).
+
+		// these hold query results during the cull so that new vectors aren't needed every frame.
+		std::vector<entity::Tile *> cullTiles;
+		std::vector<entity::Enemy *> cullEnemies;
+
+		bool culled = false; // becomes 'true' once the area has been culled for the first time.
 
 	protected:
 		// setting bg1 layer
@@ -210,13 +345,23 @@ namespace world
 		Vec2 spawn3 = spawn2;
 		Vec2 spawn4 = spawn3;
 
-		// The size of the screen is 13 X 7.5 on full screen (i.e. 13 128 X 128 blocks along the x-axis, and 7.5 128 X 128 blocks along the y-axis.
-		// The ROW_MAX and COL_MAX determines the maximum size of the area. They are currently 30 X 52 (13 * 4, 7.5 * 4)
-		static const unsigned int ROW_MAX = 30; // maximum amount of rows
-		static const unsigned int COL_MAX = 52; // maximum amount of columns
 		static const float GRID_UNIT_SIZE; // the size of one square on the grid. Setting an inital value had to be done in the cpp file.
+		static const unsigned int CHUNK_SIZE = 8; // the width and height of a tile chunk, in grid squares.
+		static const size_t ENTITY_MEMORY_ESTIMATE = 2048; // the rough size of a tile or enemy, including its sprite and collision bodies (see getMemoryEstimate()).
+		static const size_t COLLIDER_MEMORY_ESTIMATE = 128; // the rough size of a merged static collider.
 
 		std::vector<entity::Tile *> areaTiles; // holds all tiles for the scene
+		world::SpatialGrid tileIndex{ GRID_UNIT_SIZE }; // holds the area tiles based on their location; the cells are the size of the area grid.
+		world::AABBTree entityTree; // holds the enemies and moving tiles, which get refitted as they move.
+		std::vector<entity::Entity *> treeResults; // used to hold the results of entity tree queries so that a new vector isn't needed every time.
+
+		std::vector<OOP::PrimitiveSquare *> staticBodies; // the merged collision rectangles. These are owned by the area.
+		std::vector<OOP::WorldShape> staticColliders; // the merged collision rectangles in the game world. These don't move, so they're only made once.
+		umath::BoxBatch staticColliderBoxes; // the boxes of the merged collision rectangles, packed so that the queries can check several at a time.
+
+		// these hold the tiles and rectangles along the way during a sweep (see sweepTiles()), so that new vectors aren't needed every time.
+		std::vector<entity::Tile *> sweepTileResults;
+		std::vector<const OOP::WorldShape *> sweepShapeResults;
 		std::vector<entity::Enemy *> areaEnemies; // holds all enemies for the scene
 		// entity::Tile * tileGrid[ROW_MAX][COL_MAX];
 	};
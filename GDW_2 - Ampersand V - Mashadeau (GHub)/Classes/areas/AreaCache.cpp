@@ -0,0 +1,287 @@
+#include "areas/AreaCache.h"
+#include "areas/Area.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const uint32_t world::AreaCache::VERSION = 2; // added the layer scroll factors and repeats.
+
+static_assert(sizeof(world::AreaCache::Header) == 176, "The area cache header has padding in it.");
+static_assert(sizeof(world::AreaCache::EntityRecord) == 16, "The area cache entity record has padding in it.");
+static_assert(sizeof(world::AreaCache::RectRecord) == 16, "The area cache rectangle record has padding in it.");
+
+// unmaps the file.
+world::AreaCache::~AreaCache() { close(); }
+
+// maps the file into memory. Nothing is read until the tables are used.
+bool world::AreaCache::open(const std::string & filePath)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr); // the file being mapped.
+	LARGE_INTEGER fileSize; // the size of the file.
+
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(Header))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file); // the mapping keeps the file open.
+
+	if (mapping == nullptr)
+		return false;
+
+	data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	size = (size_t)fileSize.QuadPart;
+
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		mapping = nullptr;
+		return false;
+	}
+#else
+	int file = ::open(filePath.c_str(), O_RDONLY); // the file being mapped.
+	struct stat status; // used to get the size of the file.
+	void * mapped = MAP_FAILED; // the mapped file.
+
+	if (file < 0)
+		return false;
+
+	if (fstat(file, &status) == 0 && status.st_size >= (off_t)sizeof(Header))
+		mapped = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+	::close(file); // the mapping keeps the file open.
+
+	if (mapped == MAP_FAILED)
+		return false;
+
+	data = (const char *)mapped;
+	size = (size_t)status.st_size;
+#endif
+
+	if (!validate())
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+// unmaps the file.
+void world::AreaCache::close()
+{
+	if (data == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mapping);
+	mapping = nullptr;
+#else
+	munmap((void *)data, size);
+#endif
+
+	data = nullptr;
+	size = 0;
+}
+
+// checks that the header is right, and that every table and string is inside of the file.
+bool world::AreaCache::validate() const
+{
+	const Header * header = getHeader(); // the header of the file.
+
+	// checks that a table starts on a 4 byte boundary, and ends before the end of the file.
+	auto inFile = [this](uint32_t offset, uint32_t count, size_t recordSize) -> bool
+	{
+		return offset % 4 == 0 && offset >= sizeof(Header) && offset <= size && count <= (size - offset) / recordSize;
+	};
+
+	if (memcmp(header->magic, "MSQA", 4) != 0 || header->version != VERSION || header->byteOrder != 0x01020304 || header->fileSize != size)
+		return false;
+
+	if (!inFile(header->tileOffset, header->tileCount, sizeof(EntityRecord)) || !inFile(header->enemyOffset, header->enemyCount, sizeof(EntityRecord)) ||
+		!inFile(header->colliderOffset, header->colliderCount, sizeof(RectRecord)) || !inFile(header->stringOffset, header->stringSize, 1))
+		return false;
+
+	// the string table has to end with a null character so that no string runs off the end of it.
+	if (header->stringSize == 0 || data[header->stringOffset + header->stringSize - 1] != '\0')
+		return false;
+
+	if (header->name >= header->stringSize)
+		return false;
+
+	for (int i = 0; i < 5; i++)
+	{
+		if ((i < 4 && header->layers[i] >= header->stringSize) || header->exits[i] >= header->stringSize)
+			return false;
+	}
+
+	return true;
+}
+
+// returns whether a file is open.
+bool world::AreaCache::isOpen() const { return data != nullptr; }
+
+// gets the header.
+const world::AreaCache::Header * world::AreaCache::getHeader() const { return (const Header *)data; }
+
+// gets a string.
+const char * world::AreaCache::getString(uint32_t offset) const { return data + getHeader()->stringOffset + offset; }
+
+// gets the tiles.
+const world::AreaCache::EntityRecord * world::AreaCache::getTiles() const { return (const EntityRecord *)(data + getHeader()->tileOffset); }
+
+// gets the enemies.
+const world::AreaCache::EntityRecord * world::AreaCache::getEnemies() const { return (const EntityRecord *)(data + getHeader()->enemyOffset); }
+
+// gets the collision rectangles.
+const world::AreaCache::RectRecord * world::AreaCache::getColliders() const { return (const RectRecord *)(data + getHeader()->colliderOffset); }
+
+// saves the area. The layout is: the header, the tiles, the enemies, the collision rectangles, then the string table.
+bool world::AreaCache::save(const world::AreaData & data, world::Area * area, uint64_t sourceHash, const std::string & filePath)
+{
+	Header header; // the header of the file.
+	EntityRecord record; // a tile or enemy being saved.
+	RectRecord rect; // a collision rectangle being saved.
+
+	std::vector<char> file; // the contents of the file.
+	std::string strings(1, '\0'); // the string table. The first string is the empty string.
+
+	// adds a string to the string table, and returns its offset.
+	auto addString = [&strings](const std::string & str) -> uint32_t
+	{
+		uint32_t offset = (uint32_t)strings.size(); // where the string starts.
+
+		if (str == "")
+			return 0;
+
+		strings.append(str.c_str(), str.size() + 1);
+		return offset;
+	};
+
+	// adds the bytes of a record to the end of the file.
+	auto append = [&file](const void * bytes, size_t count)
+	{
+		file.insert(file.end(), (const char *)bytes, (const char *)bytes + count);
+	};
+
+	memset(&header, 0, sizeof(Header));
+	memset(&record, 0, sizeof(EntityRecord));
+
+	memcpy(header.magic, "MSQA", 4);
+	header.version = VERSION;
+	header.byteOrder = 0x01020304;
+	header.sourceHash = sourceHash;
+
+	header.gravity = area->getGravity();
+	header.name = addString(data.name);
+	header.layers[0] = addString(data.backgroundLayer1);
+	header.layers[1] = addString(data.backgroundLayer2);
+	header.layers[2] = addString(data.backgroundLayer3);
+	header.layers[3] = addString(data.foregroundLayer);
+
+	for (unsigned int i = 0; i < world::AreaData::LAYER_COUNT; i++)
+	{
+		header.layerScroll[i][0] = data.layerScroll[i].x;
+		header.layerScroll[i][1] = data.layerScroll[i].y;
+		header.layerRepeat |= (data.layerRepeatX[i] ? 1U : 0U) << (i * 2);
+		header.layerRepeat |= (data.layerRepeatY[i] ? 1U : 0U) << (i * 2 + 1);
+	}
+
+	for (int i = 0; i < 5; i++) // the spawn points come from the area, since spawn point tiles move them.
+	{
+		header.exits[i] = addString(area->getExit(i));
+		header.spawns[i][0] = area->getSpawn(i).x;
+		header.spawns[i][1] = area->getSpawn(i).y;
+	}
+
+	append(&header, sizeof(Header)); // the header is written again once the offsets are known.
+
+	header.tileOffset = (uint32_t)file.size();
+	header.tileCount = (uint32_t)area->getAreaTiles()->size();
+
+	for (entity::Tile * tile : *area->getAreaTiles())
+	{
+		record.x = tile->getPositionX();
+		record.y = tile->getPositionY();
+		record.id = tile->getTIN();
+		record.letter = tile->getLetter();
+		append(&record, sizeof(EntityRecord));
+	}
+
+	header.enemyOffset = (uint32_t)file.size();
+	header.enemyCount = (uint32_t)area->getAreaEnemies()->size();
+
+	for (entity::Enemy * enemy : *area->getAreaEnemies())
+	{
+		record.x = enemy->getPositionX();
+		record.y = enemy->getPositionY();
+		record.id = enemy->getEIN();
+		record.letter = enemy->getLetter();
+		append(&record, sizeof(EntityRecord));
+	}
+
+	header.colliderOffset = (uint32_t)file.size();
+	header.colliderCount = (uint32_t)area->getStaticColliders().size();
+
+	for (const OOP::WorldShape & collider : area->getStaticColliders())
+	{
+		rect.minX = collider.aabb.min.x;
+		rect.minY = collider.aabb.min.y;
+		rect.maxX = collider.aabb.max.x;
+		rect.maxY = collider.aabb.max.y;
+		append(&rect, sizeof(RectRecord));
+	}
+
+	header.stringOffset = (uint32_t)file.size();
+	header.stringSize = (uint32_t)strings.size();
+	append(strings.data(), strings.size());
+
+	file.resize((file.size() + 7) / 8 * 8, '\0'); // keeps the file size a multiple of 8.
+	header.fileSize = (uint32_t)file.size();
+	memcpy(file.data(), &header, sizeof(Header));
+
+	std::ofstream out(filePath, std::ios::out | std::ios::binary); // the cache file.
+
+	if (!out)
+		return false;
+
+	out.write(file.data(), file.size());
+	return (bool)out;
+}
+
+// FNV-1a hash of the file's contents.
+uint64_t world::AreaCache::hash(const std::string & text)
+{
+	uint64_t result = 14695981039346656037ULL; // the FNV offset basis.
+
+	for (unsigned char c : text)
+	{
+		result ^= c;
+		result *= 1099511628211ULL; // the FNV prime.
+	}
+
+	return result;
+}
@@ -0,0 +1,114 @@
+// a binary copy of a built area, saved so that the area can be opened again without reading its area file (see world::AreaData).
+// the file is made of flat arrays that are used right where they are in the file, which is mapped into memory instead of being read in.
+// the tiles and enemies are saved after their copies have been made, and the merged collision rectangles are saved too, so none of that is redone when the cache is used.
+// if the way tiles, enemies, or their collision bodies are made changes, VERSION has to go up so that the old caches are made again.
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace world
+{
+	class Area;
+	struct AreaData;
+
+	class AreaCache
+	{
+	public:
+		// the start of the file. All offsets are in bytes from the start of the file, and strings are offsets into the string table.
+		struct Header
+		{
+			char magic[4]; // always 'MSQA'.
+			uint32_t version; // the version of the format (see VERSION).
+			uint32_t byteOrder; // always 0x01020304 on the machine that saved the file. If it doesn't match, the file came from a machine with a different byte order.
+			uint32_t fileSize; // the size of the whole file, which is used to catch files that weren't fully written.
+			uint64_t sourceHash; // the hash of the area file the cache was made from. If the area file changes, the cache is out of date.
+
+			float gravity; // the level of gravity in the area.
+			uint32_t name; // the name of the area.
+			uint32_t layers[4]; // the file paths for background layers 1 to 3, and the foreground layer.
+			float layerScroll[4][2]; // the scroll factors of the layers.
+			uint32_t layerRepeat; // which layers are repeated. Bit (layer * 2) is set if the layer is repeated along the x-axis, and the next bit is set if it's repeated along the y-axis.
+			uint32_t exits[5]; // the areas each exit leads to.
+			float spawns[5][2]; // the spawn points.
+
+			uint32_t tileCount; // the amount of tiles.
+			uint32_t tileOffset; // where the tiles start.
+			uint32_t enemyCount; // the amount of enemies.
+			uint32_t enemyOffset; // where the enemies start.
+			uint32_t colliderCount; // the amount of merged collision rectangles.
+			uint32_t colliderOffset; // where the collision rectangles start.
+			uint32_t stringSize; // the size of the string table.
+			uint32_t stringOffset; // where the string table starts.
+		};
+
+		// a tile or an enemy, in its final position in the area.
+		struct EntityRecord
+		{
+			float x; // the x position.
+			float y; // the y position.
+			uint32_t id; // the TIN of a tile, or the EIN of an enemy.
+			char letter; // the version of the tile or enemy.
+			uint8_t padding[3]; // keeps the records 4 byte aligned.
+		};
+
+		// a merged collision rectangle of the solid blocks (see world::Area::mergeStaticColliders()).
+		struct RectRecord
+		{
+			float minX; // the left side.
+			float minY; // the bottom side.
+			float maxX; // the right side.
+			float maxY; // the top side.
+		};
+
+		AreaCache() = default;
+
+		// unmaps the file.
+		~AreaCache();
+
+		// opens a cache file and checks that it's usable. If the file doesn't exist, is from a different version, or is damaged, 'false' is returned.
+		bool open(const std::string & filePath);
+
+		// unmaps the file.
+		void close();
+
+		// returns 'true' if a cache file is open.
+		bool isOpen() const;
+
+		// gets the header of the open file.
+		const Header * getHeader() const;
+
+		// gets a string from the string table.
+		const char * getString(uint32_t offset) const;
+
+		// gets the tiles, in the order they were added to the area.
+		const EntityRecord * getTiles() const;
+
+		// gets the enemies, in the order they were added to the area.
+		const EntityRecord * getEnemies() const;
+
+		// gets the merged collision rectangles.
+		const RectRecord * getColliders() const;
+
+		// saves a cache of an area that was made from the provided area data. Returns 'false' if the file couldn't be written.
+		static bool save(const world::AreaData & data, world::Area * area, uint64_t sourceHash, const std::string & filePath);
+
+		// gets the hash of an area file's contents, which is saved in the cache to tell if the area file has changed.
+		static uint64_t hash(const std::string & text);
+
+		// the version of the cache format. Caches with a different version are made again.
+		static const uint32_t VERSION;
+
+	private:
+		// the file can't be copied, since it would get unmapped twice.
+		AreaCache(const AreaCache &) = delete;
+		AreaCache & operator=(const AreaCache &) = delete;
+
+		// checks that the file's header and tables are within the file.
+		bool validate() const;
+
+		const char * data = nullptr; // the mapped file.
+		size_t size = 0; // the size of the mapped file.
+		void * mapping = nullptr; // the handle of the file mapping (only used on Windows).
+	};
+}
@@ -0,0 +1,153 @@
+#include "areas/AreaData.h"
+#include "areas/Area.h"
+
+#include "platform/CCFileUtils.h"
+#include <iostream>
+#include <sstream>
+
+const int world::AreaData::VERSION = 1; // the first version.
+
+// loads an area file. The file is found through the file utilities, so it can be inside of the game's resources.
+bool world::AreaData::loadFromFile(const std::string & filePath)
+{
+	cocos2d::FileUtils * fileUtils = cocos2d::FileUtils::getInstance(); // used to find and read the file.
+	std::string fullPath = fileUtils->fullPathForFilename(filePath); // the location of the file.
+
+	if (fullPath == "" || !fileUtils->isFileExist(fullPath))
+		return false;
+
+	return loadFromString(fileUtils->getStringFromFile(fullPath), filePath);
+}
+
+/*
+ * reads an area file. The file is a text file with one value per line, in the following format. Lines starting with '#' are ignored.
+	 * MSQ_AREA <version>
+	 * name <name>
+	 * flip <0 or 1>
+	 * gravity <gravity>   (optional)
+	 * background1 <file>, background2 <file>, background3 <file>, foreground <file>   (optional)
+	 * scroll <background1, background2, background3, or foreground> <x factor> <y factor>   (optional)
+	 * repeat <background1, background2, background3, or foreground> <repeat x (0 or 1)> <repeat y (0 or 1)>   (optional)
+	 * exit <exit number> <AIN_###_#>   (optional)
+	 * spawn <spawn number> <x> <y>   (optional)
+	 * tile <row> <column> <TIN> <letter> <copies up> <copies down> <copies left> <copies right> <offset by sprite size>   (one line per tile)
+	 * enemy <row> <column> <EIN> <letter> <copies up> <copies down> <copies left> <copies right> <offset by sprite size>   (one line per enemy)
+*/
+bool world::AreaData::loadFromString(const std::string & text, const std::string & source)
+{
+	std::istringstream file(text); // the contents of the file.
+	std::string line = ""; // the line being read.
+	std::string key = ""; // the first word on the line.
+	int version = 0; // the version of the file.
+	unsigned int index = 0; // the exit, spawn point, or layer being read.
+	std::string layer = ""; // the name of the layer being read.
+	unsigned int lineNum = 0; // the line being read, which is printed if there's an error.
+
+	Placement placement; // a tile or enemy being read.
+
+	*this = world::AreaData(); // clears out any old values.
+
+	try
+	{
+		// finds the version, skipping the comments at the top of the file.
+		while (std::getline(file, line))
+		{
+			lineNum++;
+
+			if (line.find_first_not_of(" \t\r") == std::string::npos || line[line.find_first_not_of(" \t\r")] == '#')
+				continue;
+
+			std::istringstream ss(line); // the line's values.
+
+			if (!(ss >> key >> version) || key != "MSQ_AREA")
+				throw "The file is not an area file.\n";
+
+			break;
+		}
+
+		if (version != VERSION)
+			throw "The area file is from a different version.\n";
+
+		while (std::getline(file, line))
+		{
+			std::istringstream ss(line); // the line's values.
+			lineNum++;
+
+			if (!(ss >> key) || key[0] == '#')
+				continue;
+
+			if (key == "name")
+			{
+				if (!(ss >> name))
+					throw "The name could not be read.\n";
+			}
+			else if (key == "flip")
+			{
+				if (!(ss >> flipY))
+					throw "The flip could not be read.\n";
+			}
+			else if (key == "gravity")
+			{
+				if (!(ss >> gravity) || gravity <= 0.0F)
+					throw "The gravity could not be read.\n";
+			}
+			else if (key == "background1" || key == "background2" || key == "background3" || key == "foreground")
+			{
+				std::string & layer = (key == "background1") ? backgroundLayer1 : (key == "background2") ? backgroundLayer2 : (key == "background3") ? backgroundLayer3 : foregroundLayer;
+
+				if (!(ss >> layer))
+					throw "A layer's file could not be read.\n";
+			}
+			else if (key == "scroll" || key == "repeat")
+			{
+				if (!(ss >> layer))
+					throw "A layer could not be read.\n";
+
+				index = (layer == "background1") ? 0 : (layer == "background2") ? 1 : (layer == "background3") ? 2 : (layer == "foreground") ? 3 : LAYER_COUNT;
+
+				if (index >= LAYER_COUNT)
+					throw "Unknown layer.\n";
+
+				if (key == "scroll" && !(ss >> layerScroll[index].x >> layerScroll[index].y))
+					throw "A layer's scroll factor could not be read.\n";
+
+				if (key == "repeat" && !(ss >> layerRepeatX[index] >> layerRepeatY[index]))
+					throw "A layer's repeat could not be read.\n";
+			}
+			else if (key == "exit")
+			{
+				if (!(ss >> index) || index >= EXIT_COUNT || !(ss >> exits[index]))
+					throw "An exit could not be read.\n";
+			}
+			else if (key == "spawn")
+			{
+				if (!(ss >> index) || index >= EXIT_COUNT || !(ss >> spawns[index].x >> spawns[index].y))
+					throw "A spawn point could not be read.\n";
+			}
+			else if (key == "tile" || key == "enemy")
+			{
+				if (!(ss >> placement.row >> placement.col >> placement.id >> placement.letter >> placement.copyUp >> placement.copyDown >> placement.copyLeft >> placement.copyRight >> placement.offsetBySpriteSize))
+					throw "A tile or enemy could not be read.\n";
+
+				if (placement.row >= world::Area::ROW_MAX || placement.col >= world::Area::COL_MAX)
+					throw "A tile or enemy is outside of the area's grid.\n";
+
+				(key == "tile") ? tiles.push_back(placement) : enemies.push_back(placement);
+			}
+			else
+			{
+				throw "Unknown value.\n";
+			}
+		}
+
+		if (name == "")
+			throw "The area has no name.\n";
+	}
+	catch (const char * ex) // prints out why the area couldn't be loaded.
+	{
+		std::cout << source << " (line " << lineNum << "): " << ex;
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,64 @@
+// the values that make up an area, read from an area file (Resources/areas/AIN_###.area).
+// nothing is created when the file is read, so areas can be read without loading any sprites. The tiles and enemies are made when a world::Area is created from the data.
+#pragma once
+
+#include "cocos/math/Vec2.h"
+#include <string>
+#include <vector>
+
+namespace world
+{
+	struct AreaData
+	{
+		// a tile or an enemy in the area's grid. These are the values passed to the entity::Tile and entity::Enemy constructors.
+		struct Placement
+		{
+			unsigned int row = 0; // the row of the grid the tile or enemy is in.
+			unsigned int col = 0; // the column of the grid the tile or enemy is in.
+			unsigned int id = 0; // the TIN of a tile, or the EIN of an enemy.
+			char letter = 'a'; // the version of the tile or enemy.
+
+			unsigned int copyUp = 0; // the amount of copies made above.
+			unsigned int copyDown = 0; // the amount of copies made below.
+			unsigned int copyLeft = 0; // the amount of copies made to the left.
+			unsigned int copyRight = 0; // the amount of copies made to the right.
+			bool offsetBySpriteSize = false; // if 'true', the copies are spaced out by the size of the sprite instead of the size of a grid space.
+		};
+
+		// loads an area file. If the file can't be found, or isn't an area file, 'false' is returned.
+		bool loadFromFile(const std::string & filePath);
+
+		// reads the contents of an area file. The source is the name of the file, which is used when printing errors.
+		bool loadFromString(const std::string & text, const std::string & source = "");
+
+		// the version of the area file format. Area files with a different version can't be loaded.
+		static const int VERSION;
+
+		// the amount of exits and spawn points an area has.
+		static const unsigned int EXIT_COUNT = 5;
+
+		// the amount of background and foreground layers an area has.
+		static const unsigned int LAYER_COUNT = 4;
+
+		std::string name = ""; // the name of the area, without the 'AIN_' prefix (e.g. 'B00').
+
+		std::string backgroundLayer1 = ""; // the file path for background layer 1.
+		std::string backgroundLayer2 = ""; // the file path for background layer 2.
+		std::string backgroundLayer3 = ""; // the file path for background layer 3.
+		std::string foregroundLayer = ""; // the file path for the foreground layer.
+
+		// how much each layer (background layers 1 to 3, then the foreground layer) moves with the area (see world::ParallaxLayer). By default, the layers are pinned to the camera.
+		cocos2d::Vec2 layerScroll[LAYER_COUNT] = { cocos2d::Vec2::ZERO, cocos2d::Vec2::ZERO, cocos2d::Vec2::ZERO, cocos2d::Vec2::ZERO };
+		bool layerRepeatX[LAYER_COUNT] = {}; // if 'true', the layer's image is repeated along the x-axis.
+		bool layerRepeatY[LAYER_COUNT] = {}; // if 'true', the layer's image is repeated along the y-axis.
+
+		float gravity = 500.0F; // the level of gravity in the area.
+		bool flipY = false; // if 'true', the first row of the grid is at the top of the area instead of the bottom.
+
+		std::string exits[EXIT_COUNT]; // the areas each exit leads to, in the format AIN_###_#.
+		cocos2d::Vec2 spawns[EXIT_COUNT] = { cocos2d::Vec2(64.0F, 64.0F), cocos2d::Vec2(64.0F, 64.0F), cocos2d::Vec2(64.0F, 64.0F), cocos2d::Vec2(64.0F, 64.0F), cocos2d::Vec2(64.0F, 64.0F) }; // the spawn points.
+
+		std::vector<Placement> tiles; // the tiles in the area.
+		std::vector<Placement> enemies; // the enemies in the area.
+	};
+}
@@ -0,0 +1,198 @@
+#include "areas/InputRecording.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+const int world::InputRecording::VERSION = 1; // the first version.
+
+// checks if two input states are the same.
+bool world::InputState::operator==(const world::InputState & input) const
+{
+	return moveLeft == input.moveLeft && moveRight == input.moveRight && moveUp == input.moveUp && moveDown == input.moveDown &&
+		jump == input.jump && attack == input.attack && weapon == input.weapon;
+}
+
+// checks if two input states are different.
+bool world::InputState::operator!=(const world::InputState & input) const { return !(*this == input); }
+
+// constructor
+world::InputRecording::InputRecording(const std::string & area, int spawnPoint, const world::PlayerStats & playerStats)
+	: area(area), spawnPoint(spawnPoint), playerStats(playerStats)
+{
+}
+
+/*
+ * loads a recording. The file is a text file with one value per line, in the following format:
+	 * MSQ_REPLAY <version>
+	 * area <area> <spawn point>
+	 * player <health> <max health> <magic> <max magic> <weapon WINs...>
+	 * input <step> <left><right><up><down><jump><attack> <weapon>   (one line per input change, with a '0' or '1' for each button)
+	 * end <step> <checksum in hex>
+*/
+world::InputRecording * world::InputRecording::loadFromFile(const std::string & filePath)
+{
+	std::ifstream file(filePath); // the file being read.
+	std::string line = ""; // the line being read.
+	std::string key = ""; // the first word on the line.
+	std::string buttons = ""; // the buttons for an input change.
+	int version = 0; // the version of the file.
+	int value = 0; // a value being read.
+
+	world::InputRecording * recording = nullptr; // the recording being loaded.
+	InputChange change; // an input change being read.
+
+	try
+	{
+		if (!file)
+			throw "The file could not be opened.\n";
+
+		if (!(file >> key >> version) || key != "MSQ_REPLAY")
+			throw "The file is not a recording.\n";
+
+		if (version != VERSION)
+			throw "The recording is from a different version.\n";
+
+		recording = new world::InputRecording();
+
+		while (std::getline(file, line))
+		{
+			std::istringstream ss(line); // the line's values.
+
+			if (!(ss >> key))
+				continue;
+
+			if (key == "area")
+			{
+				if (!(ss >> recording->area >> recording->spawnPoint))
+					throw "The area could not be read.\n";
+			}
+			else if (key == "player")
+			{
+				if (!(ss >> recording->playerStats.health >> recording->playerStats.maxHealth >> recording->playerStats.magic >> recording->playerStats.maxMagic))
+					throw "The player's values could not be read.\n";
+
+				while (ss >> value)
+					recording->playerStats.weapons.push_back(value);
+			}
+			else if (key == "input")
+			{
+				if (!(ss >> change.step >> buttons >> change.input.weapon) || buttons.length() != 6)
+					throw "An input change could not be read.\n";
+
+				if (!recording->changes.empty() && change.step <= recording->changes.back().step)
+					throw "The input changes are out of order.\n";
+
+				change.input.moveLeft = buttons[0] == '1';
+				change.input.moveRight = buttons[1] == '1';
+				change.input.moveUp = buttons[2] == '1';
+				change.input.moveDown = buttons[3] == '1';
+				change.input.jump = buttons[4] == '1';
+				change.input.attack = buttons[5] == '1';
+
+				recording->changes.push_back(change);
+			}
+			else if (key == "end")
+			{
+				if (!(ss >> recording->endStep >> std::hex >> recording->checksum))
+					throw "The end of the recording could not be read.\n";
+
+				recording->finished = true;
+			}
+		}
+
+		if (recording->area == "")
+			throw "The recording has no area.\n";
+	}
+	catch (const char * ex) // prints out why the recording couldn't be loaded.
+	{
+		std::cout << filePath << ": " << ex;
+		delete recording;
+		return nullptr;
+	}
+
+	return recording;
+}
+
+// saves the recording.
+bool world::InputRecording::saveToFile(const std::string & filePath) const
+{
+	std::ofstream file(filePath); // the file being written.
+
+	if (!file)
+		return false;
+
+	file << "MSQ_REPLAY " << VERSION << "\n";
+	file << "area " << area << " " << spawnPoint << "\n";
+	file << "player " << playerStats.health << " " << playerStats.maxHealth << " " << playerStats.magic << " " << playerStats.maxMagic;
+
+	for (int WIN : playerStats.weapons)
+		file << " " << WIN;
+
+	file << "\n";
+
+	for (const InputChange & change : changes)
+	{
+		file << "input " << change.step << " " << change.input.moveLeft << change.input.moveRight << change.input.moveUp << change.input.moveDown
+			<< change.input.jump << change.input.attack << " " << change.input.weapon << "\n";
+	}
+
+	if (finished)
+		file << "end " << endStep << " " << std::hex << checksum << std::dec << "\n";
+
+	return (bool)file;
+}
+
+// gets the area.
+const std::string & world::InputRecording::getArea() const { return area; }
+
+// gets the spawn point.
+int world::InputRecording::getSpawnPoint() const { return spawnPoint; }
+
+// gets the player's starting values.
+const world::PlayerStats & world::InputRecording::getPlayerStats() const { return playerStats; }
+
+// records the input for a step.
+void world::InputRecording::record(unsigned int step, const world::InputState & input)
+{
+	if (finished) // nothing more is added once the recording has ended.
+		return;
+
+	if (changes.empty()) // the first step is always stored if something is pressed, since the input starts with nothing pressed.
+	{
+		if (input != world::InputState())
+			changes.push_back(InputChange{ step, input });
+	}
+	else if (step > changes.back().step && input != changes.back().input)
+	{
+		changes.push_back(InputChange{ step, input });
+	}
+}
+
+// gets the input for a step.
+world::InputState world::InputRecording::getInput(unsigned int step) const
+{
+	// finds the first change after the step. The change before that one is the input on the step.
+	std::vector<InputChange>::const_iterator it = std::upper_bound(changes.begin(), changes.end(), step,
+		[](unsigned int step, const InputChange & change) { return step < change.step; });
+
+	return (it == changes.begin()) ? world::InputState() : (it - 1)->input;
+}
+
+// ends the recording.
+void world::InputRecording::finish(unsigned int endStep, uint64_t checksum)
+{
+	this->endStep = endStep;
+	this->checksum = checksum;
+	finished = true;
+}
+
+// returns whether the recording has ended.
+bool world::InputRecording::isFinished() const { return finished; }
+
+// gets the step the recording ended on.
+unsigned int world::InputRecording::getEndStep() const { return endStep; }
+
+// gets the checksum.
+uint64_t world::InputRecording::getChecksum() const { return checksum; }
@@ -0,0 +1,101 @@
+// the player's input for a physics step, and recordings of it that can be played back.
+// a recording stores the input at the physics step it was used on, so playing it back from the same starting point gives the same result at any frame rate, with or without a window.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace world
+{
+	// the player's input for a physics step. The movement buttons are held; the jump, attack, and weapon switch are only used for the step they're pressed on.
+	struct InputState
+	{
+		bool moveLeft = false; // move left
+		bool moveRight = false; // move right
+		bool moveUp = false; // move up (debug mode only)
+		bool moveDown = false; // move down (debug mode only)
+
+		bool jump = false; // jump
+		bool attack = false; // attack with the current weapon
+		short int weapon = 0; // switches to weapon 1, 2, or 3. If it's '0', the weapon isn't switched.
+
+		// checks if two input states are the same.
+		bool operator==(const world::InputState & input) const;
+
+		// checks if two input states are different.
+		bool operator!=(const world::InputState & input) const;
+	};
+
+	// the player's values when a recording starts. These are carried over when the player goes from one area to another.
+	// a value of '-1' means the player's default value is kept.
+	struct PlayerStats
+	{
+		int health = -1; // the player's current health.
+		int maxHealth = -1; // the player's max health.
+		int magic = -1; // the player's magic amount.
+		int maxMagic = -1; // the player's maximum magic amount.
+		std::vector<int> weapons; // the 'WIN' numbers of the player's weapons.
+	};
+
+	class InputRecording
+	{
+	public:
+		// creates a recording that starts in the provided area, at the provided spawn point, with the provided player values.
+		InputRecording(const std::string & area = "", int spawnPoint = 0, const world::PlayerStats & playerStats = world::PlayerStats());
+
+		// loads a recording from a file. If the file can't be read, or isn't a recording, a nullptr is returned.
+		static world::InputRecording * loadFromFile(const std::string & filePath);
+
+		// saves the recording to a file. Returns 'false' if the file couldn't be written.
+		bool saveToFile(const std::string & filePath) const;
+
+		// gets the area the recording starts in.
+		const std::string & getArea() const;
+
+		// gets the spawn point the recording starts at.
+		int getSpawnPoint() const;
+
+		// gets the player's values at the start of the recording.
+		const world::PlayerStats & getPlayerStats() const;
+
+		// records the input used on a physics step. Only changes are stored, so this should be called for every step, in order.
+		void record(unsigned int step, const world::InputState & input);
+
+		// gets the input that was used on a physics step.
+		world::InputState getInput(unsigned int step) const;
+
+		// ends the recording. The step the recording ended on and a checksum of the game at that point are saved so that a playback can be checked against them.
+		void finish(unsigned int endStep, uint64_t checksum);
+
+		// returns 'true' if the recording has been ended.
+		bool isFinished() const;
+
+		// gets the amount of physics steps the recording covers.
+		unsigned int getEndStep() const;
+
+		// gets the checksum of the game at the end of the recording.
+		uint64_t getChecksum() const;
+
+		// the version of the recording format. Recordings with a different version can't be loaded.
+		static const int VERSION;
+
+	private:
+		// an input change, and the step it happened on.
+		struct InputChange
+		{
+			unsigned int step; // the step the input changed on.
+			world::InputState input; // the new input.
+		};
+
+		std::string area; // the area the recording starts in.
+		int spawnPoint; // the spawn point the recording starts at.
+		world::PlayerStats playerStats; // the player's values at the start.
+
+		std::vector<InputChange> changes; // the input changes, in order.
+
+		bool finished = false; // 'true' if the recording has ended.
+		unsigned int endStep = 0; // the step the recording ended on.
+		uint64_t checksum = 0; // the checksum at the end.
+	};
+}
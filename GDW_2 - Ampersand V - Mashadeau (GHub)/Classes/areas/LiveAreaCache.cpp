@@ -0,0 +1,124 @@
+#include "areas/LiveAreaCache.h"
+#include "areas/Area.h"
+
+const size_t world::LiveAreaCache::DEFAULT_MEMORY_BUDGET = 4 * 1024 * 1024; // 4 MB, which is around four areas.
+
+// constructor
+world::LiveAreaCache::LiveAreaCache(size_t memoryBudget) : memoryBudget(memoryBudget) {}
+
+// deletes the areas.
+world::LiveAreaCache::~LiveAreaCache() { clear(); }
+
+// keeps an area.
+bool world::LiveAreaCache::add(const std::string & AIN, world::Area * area)
+{
+	if (area == nullptr || !area->hasSingleNode())
+		return false;
+
+	// if the area is somehow already being kept, the old copy is replaced.
+	for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); it++)
+	{
+		if (it->AIN == AIN)
+		{
+			memoryUsage -= it->memory;
+
+			if (it->area != area)
+				deleteArea(it->area);
+			else
+				it->area->getAsSingleNode()->release(); // the area is retained again below.
+
+			entries.erase(it);
+			break;
+		}
+	}
+
+	area->getAsSingleNode()->retain(); // stops the node from being deleted when its scene is.
+
+	entries.push_front(Entry{ AIN, area, area->getMemoryEstimate() });
+	memoryUsage += entries.front().memory;
+
+	trim();
+	return true;
+}
+
+// takes an area out of the cache.
+world::Area * world::LiveAreaCache::take(const std::string & AIN)
+{
+	world::Area * area = nullptr; // the area being taken.
+
+	for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); it++)
+	{
+		if (it->AIN != AIN)
+			continue;
+
+		area = it->area;
+		memoryUsage -= it->memory;
+		entries.erase(it);
+
+		// the node is taken out of its old scene, and the cache's reference is handed over. It's autoreleased so that it lasts until it's added to the new scene.
+		area->getAsSingleNode()->removeFromParent();
+		area->getAsSingleNode()->autorelease();
+		return area;
+	}
+
+	return nullptr;
+}
+
+// checks if an area is being kept.
+bool world::LiveAreaCache::contains(const std::string & AIN) const
+{
+	for (const Entry & entry : entries)
+	{
+		if (entry.AIN == AIN)
+			return true;
+	}
+
+	return false;
+}
+
+// deletes all areas.
+void world::LiveAreaCache::clear()
+{
+	for (Entry & entry : entries)
+		deleteArea(entry.area);
+
+	entries.clear();
+	memoryUsage = 0;
+}
+
+// sets the budget.
+void world::LiveAreaCache::setMemoryBudget(size_t memoryBudget)
+{
+	this->memoryBudget = memoryBudget;
+	trim();
+}
+
+// gets the budget.
+size_t world::LiveAreaCache::getMemoryBudget() const { return memoryBudget; }
+
+// gets the memory used.
+size_t world::LiveAreaCache::getMemoryUsage() const { return memoryUsage; }
+
+// gets the amount of areas.
+unsigned int world::LiveAreaCache::getAreaCount() const { return entries.size(); }
+
+// deletes areas from the back of the list (the least recently used) until the budget is met.
+// the most recently added area is never deleted, since the scene it was in may still use it until the scene is replaced.
+void world::LiveAreaCache::trim()
+{
+	while (entries.size() > 1 && memoryUsage > memoryBudget)
+	{
+		memoryUsage -= entries.back().memory;
+		deleteArea(entries.back().area);
+		entries.pop_back();
+	}
+}
+
+// deletes an area.
+void world::LiveAreaCache::deleteArea(world::Area * area)
+{
+	cocos2d::Node * node = area->getAsSingleNode(); // the area's node, which holds the sprites that the area's tiles and enemies remove from it.
+
+	delete area;
+	node->release();
+}
@@ -0,0 +1,69 @@
+// keeps the areas the player has left, so that going back to one doesn't have to build it again. The areas are kept as they were left (e.g. enemy health and positions).
+// the least recently left areas are deleted once the kept areas go over the memory budget (see world::Area::getMemoryEstimate()). The most recently left area is always kept, even if it's over the budget on its own.
+#pragma once
+
+#include <list>
+#include <string>
+
+namespace world
+{
+	class Area;
+
+	class LiveAreaCache
+	{
+	public:
+		// creates the cache with a memory budget, in bytes.
+		LiveAreaCache(size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+		// deletes all kept areas.
+		~LiveAreaCache();
+
+		/*
+		 * keeps an area that's no longer being used. The area's node is retained so that it isn't deleted along with the scene it was in.
+		 * only areas that have had their node made (see world::Area::getAsSingleNode()) can be kept, since the sprites are deleted otherwise. If the area can't be kept, 'false' is returned, and the area isn't deleted.
+		*/
+		bool add(const std::string & AIN, world::Area * area);
+
+		// takes an area out of the cache so that it can be used again. Its node is taken out of its old scene. If the area isn't being kept, a nullptr is returned.
+		world::Area * take(const std::string & AIN);
+
+		// returns 'true' if the area is being kept.
+		bool contains(const std::string & AIN) const;
+
+		// deletes all kept areas.
+		void clear();
+
+		// sets the memory budget, in bytes. Areas are deleted if the kept areas are now over it.
+		void setMemoryBudget(size_t memoryBudget);
+
+		// gets the memory budget, in bytes.
+		size_t getMemoryBudget() const;
+
+		// gets the estimated memory used by the kept areas, in bytes.
+		size_t getMemoryUsage() const;
+
+		// gets the amount of areas being kept.
+		unsigned int getAreaCount() const;
+
+		static const size_t DEFAULT_MEMORY_BUDGET; // the default memory budget.
+
+	private:
+		// a kept area.
+		struct Entry
+		{
+			std::string AIN; // the area's AIN number (AIN_###).
+			world::Area * area; // the area.
+			size_t memory; // the area's estimated memory use.
+		};
+
+		// deletes the least recently used areas until the kept areas are within the budget.
+		void trim();
+
+		// deletes an area and releases its node.
+		static void deleteArea(world::Area * area);
+
+		std::list<Entry> entries; // the kept areas. The most recently used area is at the front.
+		size_t memoryBudget; // the memory budget.
+		size_t memoryUsage = 0; // the estimated memory used by the kept areas.
+	};
+}
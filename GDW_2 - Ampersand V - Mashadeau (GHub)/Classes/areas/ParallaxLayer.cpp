@@ -0,0 +1,382 @@
+#include "areas/ParallaxLayer.h"
+#include "areas/Area.h"
+
+#include "base/CCDirector.h"
+#include "platform/CCFileUtils.h"
+#include "renderer/CCTextureCache.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+const std::string world::ParallaxLayer::TILE_FOLDER = "tiles/"; // inside of the image's folder (e.g. images/backgrounds/tiles)
+const std::string world::ParallaxLayer::TILE_SET_EXTENSION = ".layer"; // a text file
+const int world::ParallaxLayer::TILE_SET_VERSION = 1; // the first version.
+
+// creates a layer.
+world::ParallaxLayer * world::ParallaxLayer::create()
+{
+	world::ParallaxLayer * layer = new (std::nothrow) world::ParallaxLayer();
+
+	if (layer != nullptr && layer->init())
+	{
+		layer->autorelease();
+		return layer;
+	}
+
+	delete layer;
+	return nullptr;
+}
+
+// removes the tiles, and lets go of the image's texture.
+world::ParallaxLayer::~ParallaxLayer()
+{
+	clearTiles();
+
+	if (imageTexture != nullptr)
+		imageTexture->release();
+}
+
+// sets the layer's image.
+void world::ParallaxLayer::setImage(const std::string & image)
+{
+	clearTiles();
+
+	if (imageTexture != nullptr)
+	{
+		imageTexture->release();
+		imageTexture = nullptr;
+	}
+
+	this->image = image;
+	tileSet = TileSet();
+	tiled = (image != "" && loadTileSet(image, tileSet));
+
+	// an image that wasn't split is loaded now, and is used as a tile that's the size of the whole image.
+	if (!tiled && image != "")
+	{
+		imageTexture = Director::getInstance()->getTextureCache()->addImage(world::Area::getLayerImage(image)); // uses the converted image if there is one.
+
+		if (imageTexture != nullptr)
+		{
+			imageTexture->retain();
+			tileSet.imageSize = imageTexture->getContentSize();
+			tileSet.tileSize = tileSet.imageSize;
+			tileSet.columns = 1;
+			tileSet.rows = 1;
+		}
+	}
+
+	setContentSize(tileSet.imageSize); // the anchour point is based on the size of the image.
+}
+
+// gets the layer's image.
+const std::string & world::ParallaxLayer::getImage() const { return image; }
+
+// checks if the image was split into tiles.
+bool world::ParallaxLayer::isTiled() const { return tiled; }
+
+// sets the scroll factor.
+void world::ParallaxLayer::setScrollFactor(const Vec2 & scrollFactor) { this->scrollFactor = scrollFactor; }
+
+// gets the scroll factor.
+const Vec2 & world::ParallaxLayer::getScrollFactor() const { return scrollFactor; }
+
+// sets whether the image is repeated.
+void world::ParallaxLayer::setRepeat(bool repeatX, bool repeatY)
+{
+	this->repeatX = repeatX;
+	this->repeatY = repeatY;
+}
+
+// checks if the image is repeated along the x-axis.
+bool world::ParallaxLayer::isRepeatedX() const { return repeatX; }
+
+// checks if the image is repeated along the y-axis.
+bool world::ParallaxLayer::isRepeatedY() const { return repeatY; }
+
+// sets the stream margin.
+void world::ParallaxLayer::setStreamMargin(float streamMargin) { this->streamMargin = std::max(streamMargin, 0.0F); }
+
+// moves the layer, and loads the tiles that are in view.
+void world::ParallaxLayer::updateView(const Vec2 & cameraPosition, const Size & viewSize)
+{
+	Vec2 home(viewSize.width / 2.0F, viewSize.height / 2.0F); // where the camera is when it's at the bottom left-hand corner of the area.
+	Vec2 corner; // the bottom left-hand corner of the image in the area.
+	Vec2 viewMin; // the bottom left-hand corner of the view (and the stream margin) in the layer's space.
+	Vec2 viewMax; // the top right-hand corner of the view (and the stream margin) in the layer's space.
+	bool found = false; // becomes 'true' if a tile in view is already loaded.
+
+	// the layer moves between staying with the camera (0) and staying with the area (1).
+	setPosition(cameraPosition.x + (home.x - cameraPosition.x) * scrollFactor.x, cameraPosition.y + (home.y - cameraPosition.y) * scrollFactor.y);
+
+	corner = getPosition() - Vec2(getAnchorPoint().x * tileSet.imageSize.width, getAnchorPoint().y * tileSet.imageSize.height);
+	viewMin = cameraPosition - Vec2(viewSize.width / 2.0F + streamMargin, viewSize.height / 2.0F + streamMargin) - corner;
+	viewMax = cameraPosition + Vec2(viewSize.width / 2.0F + streamMargin, viewSize.height / 2.0F + streamMargin) - corner;
+
+	findCells(viewMin.x, viewMax.x, tileSet.imageSize.width, tileSet.tileSize.width, tileSet.columns, repeatX, columns);
+	findCells(viewMin.y, viewMax.y, tileSet.imageSize.height, tileSet.tileSize.height, tileSet.rows, repeatY, rows);
+
+	for (Tile & tile : tiles)
+		tile.seen = false;
+
+	// loads the tiles that came into view.
+	for (int y : rows)
+	{
+		for (int x : columns)
+		{
+			found = false;
+
+			for (Tile & tile : tiles)
+			{
+				if (tile.x == x && tile.y == y)
+				{
+					tile.seen = true;
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+			{
+				tiles.push_back(Tile());
+				tiles.back().x = x;
+				tiles.back().y = y;
+				tiles.back().sprite = createTile(x, y);
+				tiles.back().seen = true;
+			}
+		}
+	}
+
+	// unloads the tiles that left the view.
+	for (int i = tiles.size() - 1; i >= 0; i--)
+	{
+		if (tiles[i].seen)
+			continue;
+
+		removeTile(tiles[i].sprite);
+		tiles.erase(tiles.begin() + i);
+	}
+}
+
+// removes all of the tiles.
+void world::ParallaxLayer::clearTiles()
+{
+	for (Tile & tile : tiles)
+		removeTile(tile.sprite);
+
+	tiles.clear();
+}
+
+// gets the amount of loaded tiles.
+unsigned int world::ParallaxLayer::getTileCount() const { return tiles.size(); }
+
+// adds the textures of the loaded tiles.
+void world::ParallaxLayer::getTextures(std::vector<Texture2D *> & textures) const
+{
+	for (const Tile & tile : tiles)
+	{
+		if (tile.sprite == nullptr || tile.sprite->getTexture() == nullptr || std::find(textures.begin(), textures.end(), tile.sprite->getTexture()) != textures.end())
+			continue;
+
+		textures.push_back(tile.sprite->getTexture());
+	}
+}
+
+// sets the global z order of the layer and its tiles.
+void world::ParallaxLayer::setGlobalZOrder(float globalZOrder)
+{
+	Node::setGlobalZOrder(globalZOrder);
+
+	for (Tile & tile : tiles)
+	{
+		if (tile.sprite != nullptr)
+			tile.sprite->setGlobalZOrder(globalZOrder);
+	}
+}
+
+// gets the tile set file of an image.
+std::string world::ParallaxLayer::getTileSetFile(const std::string & image)
+{
+	size_t slash = image.find_last_of('/'); // the end of the image's folder.
+	std::string folder = (slash == std::string::npos) ? "" : image.substr(0, slash + 1); // the folder the image is in.
+	std::string name = (slash == std::string::npos) ? image : image.substr(slash + 1); // the name of the image.
+
+	return folder + TILE_FOLDER + name.substr(0, name.find('.')) + TILE_SET_EXTENSION;
+}
+
+/*
+ * reads a tile set file. The file is made by tools/split_backgrounds.py, and has one value per line, in the following format. Lines starting with '#' are ignored.
+	 * MSQ_LAYER <version>
+	 * size <image width> <image height>
+	 * tile <tile width> <tile height>
+	 * grid <columns> <rows>
+	 * extension <tile file extension>
+ * the tiles are saved next to the file as <image name>_<column>_<row><extension>, with row 0 at the bottom of the image.
+*/
+bool world::ParallaxLayer::loadTileSet(const std::string & image, TileSet & tileSet)
+{
+	FileUtils * fileUtils = FileUtils::getInstance(); // used to read the file.
+	std::string filePath = getTileSetFile(image); // the tile set file.
+	std::istringstream file; // the contents of the file.
+	std::string line = ""; // the line being read.
+	std::string key = ""; // the first word on the line.
+	int version = 0; // the version of the file.
+	unsigned int lineNum = 0; // the line being read, which is printed if there's an error.
+
+	if (!fileUtils->isFileExist(filePath))
+		return false;
+
+	file.str(fileUtils->getStringFromFile(filePath));
+	tileSet = TileSet();
+	tileSet.prefix = filePath.substr(0, filePath.length() - TILE_SET_EXTENSION.length()) + "_";
+
+	try
+	{
+		while (std::getline(file, line))
+		{
+			std::istringstream ss(line); // the line's values.
+			lineNum++;
+
+			if (!(ss >> key) || key[0] == '#')
+				continue;
+
+			if (version == 0) // the version comes before everything else.
+			{
+				if (key != "MSQ_LAYER" || !(ss >> version))
+					throw "The file is not a tile set file.\n";
+
+				if (version != TILE_SET_VERSION)
+					throw "The tile set file is from a different version.\n";
+			}
+			else if (key == "size")
+			{
+				if (!(ss >> tileSet.imageSize.width >> tileSet.imageSize.height))
+					throw "The image size could not be read.\n";
+			}
+			else if (key == "tile")
+			{
+				if (!(ss >> tileSet.tileSize.width >> tileSet.tileSize.height))
+					throw "The tile size could not be read.\n";
+			}
+			else if (key == "grid")
+			{
+				if (!(ss >> tileSet.columns >> tileSet.rows))
+					throw "The grid could not be read.\n";
+			}
+			else if (key == "extension")
+			{
+				if (!(ss >> tileSet.extension))
+					throw "The extension could not be read.\n";
+			}
+			else
+			{
+				throw "Unknown value.\n";
+			}
+		}
+
+		if (tileSet.imageSize.width <= 0.0F || tileSet.imageSize.height <= 0.0F || tileSet.tileSize.width <= 0.0F || tileSet.tileSize.height <= 0.0F)
+			throw "The tile set has no size.\n";
+
+		if (tileSet.columns == 0 || tileSet.rows == 0 || tileSet.columns * tileSet.tileSize.width < tileSet.imageSize.width || tileSet.rows * tileSet.tileSize.height < tileSet.imageSize.height)
+			throw "The tiles don't cover the image.\n";
+	}
+	catch (const char * ex) // prints out why the tile set couldn't be used. The image is loaded whole instead.
+	{
+		std::cout << filePath << " (line " << lineNum << "): " << ex;
+		tileSet = TileSet();
+		return false;
+	}
+
+	return true;
+}
+
+// finds the cells in view along one axis.
+void world::ParallaxLayer::findCells(float start, float end, float imageSize, float tileSize, unsigned int count, bool repeat, std::vector<int> & cells)
+{
+	int firstCopy = 0; // the first copy of the image in view.
+	int lastCopy = 0; // the last copy of the image in view.
+	float copyStart = 0.0F; // the start of the part of the view that's in a copy, in the copy's space.
+	float copyEnd = 0.0F; // the end of the part of the view that's in a copy, in the copy's space.
+
+	cells.clear();
+
+	if (count == 0)
+		return;
+
+	// the size of an image that wasn't split isn't known until its texture is loaded, so its only tile is always shown.
+	if (imageSize <= 0.0F || tileSize <= 0.0F)
+	{
+		cells.push_back(0);
+		return;
+	}
+
+	if (repeat)
+	{
+		firstCopy = (int)floorf(start / imageSize);
+		lastCopy = (int)floorf(end / imageSize);
+	}
+
+	for (int copy = firstCopy; copy <= lastCopy; copy++)
+	{
+		copyStart = std::max(start - copy * imageSize, 0.0F);
+		copyEnd = std::min(end - copy * imageSize, imageSize);
+
+		for (int cell = (int)(copyStart / tileSize); cell < (int)count && cell * tileSize < copyEnd; cell++)
+			cells.push_back(copy * (int)count + cell);
+	}
+}
+
+// gets the position of a cell.
+float world::ParallaxLayer::getCellPosition(int cell, float imageSize, float tileSize, unsigned int count)
+{
+	int copy = (cell >= 0) ? cell / (int)count : (cell + 1) / (int)count - 1; // the copy of the image the cell is in.
+
+	return copy * imageSize + (cell - copy * (int)count) * tileSize;
+}
+
+// makes a tile's sprite.
+Sprite * world::ParallaxLayer::createTile(int x, int y)
+{
+	int column = x - (int)floorf((float)x / tileSet.columns) * tileSet.columns; // the column of the tile in the image.
+	int row = y - (int)floorf((float)y / tileSet.rows) * tileSet.rows; // the row of the tile in the image.
+	Sprite * sprite = nullptr; // the tile's sprite.
+
+	if (tiled)
+		sprite = Sprite::create(tileSet.prefix + std::to_string(column) + "_" + std::to_string(row) + tileSet.extension);
+	else if (imageTexture != nullptr)
+		sprite = Sprite::createWithTexture(imageTexture);
+
+	if (sprite == nullptr) // the tile is left empty if its file couldn't be loaded, so it isn't tried again every frame.
+		return nullptr;
+
+	sprite->setAnchorPoint(Vec2(0.0F, 0.0F));
+	sprite->setPosition(getCellPosition(x, tileSet.imageSize.width, tileSet.tileSize.width, tileSet.columns), getCellPosition(y, tileSet.imageSize.height, tileSet.tileSize.height, tileSet.rows));
+	sprite->setGlobalZOrder(getGlobalZOrder());
+	addChild(sprite);
+
+	return sprite;
+}
+
+// removes a tile's sprite.
+void world::ParallaxLayer::removeTile(Sprite * sprite)
+{
+	Texture2D * texture = nullptr; // the tile's texture.
+
+	if (sprite == nullptr)
+		return;
+
+	texture = sprite->getTexture();
+
+	if (texture != nullptr)
+		texture->retain(); // keeps the texture around until it's been checked.
+
+	sprite->removeFromParent();
+
+	// if only the texture cache (and this function) are holding onto the texture, nothing else is using it, so it's unloaded. The texture of an image that wasn't split stays loaded.
+	if (tiled && texture != nullptr && texture->getReferenceCount() == 2)
+		Director::getInstance()->getTextureCache()->removeTexture(texture);
+
+	if (texture != nullptr)
+		texture->release();
+}
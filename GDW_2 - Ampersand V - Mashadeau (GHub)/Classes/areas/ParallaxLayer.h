@@ -0,0 +1,142 @@
+// a background or foreground layer that scrolls slower (or faster) than the area, so that it looks farther away (or closer).
+// the layer's image can be split into tiles (see tools/split_backgrounds.py). Only the tiles that are in view are loaded, so the size of the image doesn't change how much texture memory the layer uses.
+// images that haven't been split are used as a single tile, which is kept loaded.
+#pragma once
+
+#include "2d/CCNode.h"
+#include "2d/CCSprite.h"
+
+#include <string>
+#include <vector>
+
+using namespace cocos2d;
+
+namespace world
+{
+	class ParallaxLayer : public Node
+	{
+	public:
+		// the tiles an image was split into, read from its tile set file (<image name>.layer in TILE_FOLDER).
+		struct TileSet
+		{
+			Size imageSize; // the size of the whole image.
+			Size tileSize; // the size of each tile. The tiles on the right and top edges can be smaller.
+			unsigned int columns = 0; // the amount of tiles along the x-axis.
+			unsigned int rows = 0; // the amount of tiles along the y-axis. Row 0 is at the bottom of the image.
+			std::string prefix = ""; // the start of each tile's file path. The column, row, and extension are added to it.
+			std::string extension = ""; // the extension of the tile files.
+		};
+
+		// creates a layer with no image.
+		static ParallaxLayer * create();
+
+		/*
+		 * sets the image of the layer. If the image has a tile set, its tiles are loaded as they come into view (see updateView()).
+		 * otherwise, the image (or its converted file; see world::Area::getLayerImage()) is loaded right away as a single tile. If the image is blank, the layer is emptied.
+		*/
+		void setImage(const std::string & image);
+
+		// gets the image the layer was made from.
+		const std::string & getImage() const;
+
+		// returns 'true' if the layer's image was split into tiles.
+		bool isTiled() const;
+
+		/*
+		 * sets how much the layer moves with the area. (0, 0) keeps the layer pinned to the camera, which makes it look infinitely far away. (1, 1) moves it along with the area.
+		 * values in between make the layer look farther back the closer they are to 0, and values above 1 make it look like it's in front of the area.
+		*/
+		void setScrollFactor(const Vec2 & scrollFactor);
+
+		// gets how much the layer moves with the area.
+		const Vec2 & getScrollFactor() const;
+
+		// sets whether the image is repeated along the x-axis and the y-axis. If it isn't, nothing is shown past the edges of the image.
+		void setRepeat(bool repeatX, bool repeatY);
+
+		// returns 'true' if the image is repeated along the x-axis.
+		bool isRepeatedX() const;
+
+		// returns 'true' if the image is repeated along the y-axis.
+		bool isRepeatedY() const;
+
+		// sets the space around the view where tiles are still loaded, so that they're ready before they come into view.
+		void setStreamMargin(float streamMargin);
+
+		/*
+		 * moves the layer for a camera at 'cameraPosition' that shows 'viewSize' of the area. The tiles that came into view are loaded, and the ones that left it are unloaded.
+		 * the image's anchour point is where the camera is for a scroll factor of 0. For a scroll factor of 1, it's at the middle of the view when the camera is at the bottom left-hand corner of the area.
+		*/
+		void updateView(const Vec2 & cameraPosition, const Size & viewSize);
+
+		// removes all of the tiles, and unloads their textures if nothing else is using them.
+		void clearTiles();
+
+		// gets the amount of tiles that are loaded.
+		unsigned int getTileCount() const;
+
+		// adds the textures used by the loaded tiles to 'textures', skipping any that are already in it.
+		void getTextures(std::vector<Texture2D *> & textures) const;
+
+		// sets the global z order of the layer and all of its tiles.
+		void setGlobalZOrder(float globalZOrder) override;
+
+		// gets the tile set file of an image (e.g. images/backgrounds/tiles/AIN_X00a.layer for images/backgrounds/AIN_X00a.png).
+		static std::string getTileSetFile(const std::string & image);
+
+		// reads the tile set of an image. If the image hasn't been split into tiles, or the file can't be read, 'false' is returned.
+		static bool loadTileSet(const std::string & image, TileSet & tileSet);
+
+		// the folder the tiles are saved in. This must match TILE_FOLDER in tools/split_backgrounds.py.
+		static const std::string TILE_FOLDER;
+
+		// the extension of tile set files.
+		static const std::string TILE_SET_EXTENSION;
+
+		// the version of the tile set file format.
+		static const int TILE_SET_VERSION;
+
+	private:
+		// a loaded tile. The cell counts every copy of the image when it's repeated, so the same tile can be loaded more than once.
+		struct Tile
+		{
+			int x = 0; // the column of the tile, counting the copies to the left and right.
+			int y = 0; // the row of the tile, counting the copies above and below.
+			Sprite * sprite = nullptr; // the tile's sprite, which is a child of the layer.
+			bool seen = false; // used to mark the tiles that are still in view.
+		};
+
+		ParallaxLayer() = default;
+
+		// finds the cells along one axis that are between 'start' and 'end' in the layer's space.
+		static void findCells(float start, float end, float imageSize, float tileSize, unsigned int count, bool repeat, std::vector<int> & cells);
+
+		// gets the position of a cell along one axis, in the layer's space.
+		static float getCellPosition(int cell, float imageSize, float tileSize, unsigned int count);
+
+		// makes the sprite of a tile.
+		Sprite * createTile(int x, int y);
+
+		// removes a tile's sprite, and unloads its texture if nothing else is using it.
+		void removeTile(Sprite * sprite);
+
+		std::string image = ""; // the image the layer was made from.
+		TileSet tileSet; // the tiles of the image. If the image wasn't split, this is a single tile with the whole image.
+		bool tiled = false; // 'true' if the image was split into tiles.
+		Texture2D * imageTexture = nullptr; // the texture of an image that wasn't split. The layer keeps it loaded.
+
+		std::vector<Tile> tiles; // the tiles that are loaded.
+		std::vector<int> columns; // holds the columns in view during updateView() so that new vectors aren't needed every frame.
+		std::vector<int> rows; // holds the rows in view during updateView().
+
+		Vec2 scrollFactor = Vec2::ZERO; // how much the layer moves with the area.
+		bool repeatX = false; // if 'true', the image is repeated along the x-axis.
+		bool repeatY = false; // if 'true', the image is repeated along the y-axis.
+		float streamMargin = 256.0F; // the space around the view where tiles are still loaded.
+
+	protected:
+		// removes the tiles.
+		virtual ~ParallaxLayer();
+
+	};
+}
@@ -0,0 +1,786 @@
+#include "areas/Simulation.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+const float world::Simulation::PHYSICS_STEP = 1.0F / 120.0F; // 120 steps per second.
+const int world::Simulation::MAX_PHYSICS_STEPS = 8; // if more than 8 steps are needed in one go, the game has fallen too far behind.
+const float world::Simulation::FALL_TIME_MAX = 6.5F; // 6.5 seconds.
+
+// constructor
+world::Simulation::Simulation(world::Area * area, entity::Player * plyr) : area(area), plyr(plyr) {}
+
+// runs the physics steps that fit into the time provided.
+int world::Simulation::advance(float deltaTime)
+{
+	int steps = 0; // the amount of steps run.
+
+	// the physics is run in fixed steps so that it acts the same at any frame rate. If a frame took a long time, several steps are run to catch up instead of one big step.
+	// if the game falls too far behind, the extra time is dropped so that it doesn't keep falling further behind.
+	physicsTime = std::min(physicsTime + deltaTime, PHYSICS_STEP * MAX_PHYSICS_STEPS);
+
+	while (physicsTime >= PHYSICS_STEP && exitReached() == false && playerDefeated() == false) // stops if the player has reached an exit or has been defeated, since the area is being left.
+	{
+		step();
+		physicsTime -= PHYSICS_STEP;
+		steps++;
+	}
+
+	return steps;
+}
+
+// a fixed physics step
+void world::Simulation::step()
+{
+	world::InputState stepInput = (playback != nullptr) ? playback->getInput(stepCount) : input; // the input for this step.
+	Vec2 centre = (viewFollowsPlayer) ? plyr->getPosition() : viewCentre; // the centre of the view.
+
+	if (recording != nullptr)
+		recording->record(stepCount, stepInput);
+
+	// the buttons that are only pressed for one step have been used now.
+	input.jump = false;
+	input.attack = false;
+	input.weapon = 0;
+
+	applyInput(stepInput);
+
+	// works out which tiles and enemies are near the view, which are the only ones that get updated. This is done every step, since which enemies are active changes how the step plays out.
+	{
+		OOP::ScopedTimer timer(profiler, cullPhase);
+		area->cull(centre - Vec2(viewSize.width / 2, viewSize.height / 2), centre + Vec2(viewSize.width / 2, viewSize.height / 2));
+	}
+
+	// the jump is started here so that it happens on a physics step. If the player can't jump, the 'jump' variable is set to false again.
+	if (plyr->jump)
+	{
+		if (canJump)
+		{
+			plyr->setPositionY(plyr->getPositionY() + 10.0F); // this was an attempt to fix the jump issue. It didn't work.
+			jumpTime = 1.0F / entity::Entity::REFERENCE_RATE; // the jump force was made to be applied for one update at the reference rate, so it's added over that much time.
+			canJump = false;
+		}
+
+		plyr->jump = false;
+	}
+
+	// the player's force is cleared after every update, so the movement force is added again every step. In debug mode, the scene moves the player at a fixed speed instead.
+	if (debug == false)
+	{
+		if (plyr->moveLeft && !plyr->cancelLeft) // moving left
+			plyr->addForce(plyr->getMoveForceX() * -1, 0.0F);
+		else if (plyr->moveRight && !plyr->cancelRight) // moving right
+			plyr->addForce(plyr->getMoveForceX(), 0.0F);
+	}
+
+	if (jumpTime > 0.0F) // the jump force is still being applied.
+	{
+		plyr->addJumpForce();
+		jumpTime -= PHYSICS_STEP;
+	}
+
+	// the movement of everything updated in this step is done in one batch, which the area flushes after its entities have been updated (see world::Area::update()).
+	entity::Entity::physics->beginBatch();
+
+	// updates the player
+	{
+		OOP::ScopedTimer timer(profiler, playerPhase);
+		plyr->storePreviousPosition();
+		plyr->update(PHYSICS_STEP);
+	}
+
+	// updates the area the player is currently in. This update also updates the active tiles, and enemies.
+	{
+		OOP::ScopedTimer timer(profiler, areaPhase);
+		area->update(PHYSICS_STEP);
+	}
+
+	collisions(); // collisions
+
+	checkFall();
+
+	stepCount++;
+}
+
+// applies the input for a step.
+void world::Simulation::applyInput(const world::InputState & stepInput)
+{
+	bool plyrAction = stepInput.attack; // becomes 'true' when a new animation should be played for the player.
+	int pAction = (stepInput.attack) ? 6 : 0; // the action the player is taking.
+
+	plyr->moveLeft = stepInput.moveLeft;
+	plyr->moveRight = stepInput.moveRight;
+	plyr->moveUp = stepInput.moveUp;
+	plyr->moveDown = stepInput.moveDown;
+
+	if (stepInput.jump) // the jump is used (or cancelled) in step().
+		plyr->jump = true;
+
+	if (stepInput.weapon != 0) // switches weapons.
+		plyr->switchWeapon(stepInput.weapon);
+
+	// triggers the player's idle animation if no other animation should take presedence
+	if (plyr->moveLeft == false && plyr->moveRight == false && plyr->jump == false && plyr->getVelocity() == Vec2(0.0F, 0.0F))
+	{
+		if (plyr->getCurrentAnimation() != nullptr)
+		{
+			if (plyr->getCurrentAnimation()->getTag() != 2)
+			{
+				plyr->runAction(2);
+			}
+		}
+	}
+
+	if (plyr->moveLeft && !plyr->cancelLeft) // moving left
+	{
+		if (plyr->getFlippedSpriteX() == false) // flips the sprite so that it's facing left
+			plyr->setFlippedSpriteX(true);
+
+		if (plyr->getCurrentAnimation()->getTag() != 4) // sets up the variables to trigger the running animation.
+		{
+			plyrAction = true;
+			pAction = 4;
+		}
+	}
+	else if (plyr->moveRight && !plyr->cancelRight) // moving right
+	{
+		if (plyr->getFlippedSpriteX() == true) // flips the sprite so that it's facing right (i.e. the default)
+			plyr->setFlippedSpriteX(false);
+
+		if (plyr->getCurrentAnimation()->getTag() != 4) // sets up the variables to trigger the running animation.
+		{
+			plyrAction = true;
+			pAction = 4;
+		}
+	}
+	else
+	{
+		if (plyr->getCurrentAnimation()->getTag() != 2) // return to idle animation.
+			plyr->runAction(2);
+	}
+
+	if (plyr->jump && canJump) // if the has decided to jump, and that is allowed. The jump animation only appears for a moment.
+	{
+		plyrAction = true;
+		pAction = 5;
+	}
+
+	if (plyrAction) // animation should be played
+	{
+		if (pAction == 6) // attack animation (which is triggered in useWeapon()).
+			plyr->useWeapon();
+		else
+			plyr->runAction(pAction); // starts animation.
+	}
+}
+
+// checks if the player has been falling for too long.
+void world::Simulation::checkFall()
+{
+	if (plyr->getAntiGravity() == false) // if the player is falling.
+	{
+		fallTime += PHYSICS_STEP; // tracks time since fall began.
+
+		if (fallTime >= FALL_TIME_MAX) // if the player has fallen for long enough, they respawn.
+		{
+			plyr->setPosition(area->getSpawn(spawnPoint));
+			plyr->addHealth(-20.0F);
+			fallTime = 0.0F;
+			plyr->gotHit();
+		}
+	}
+	else
+	{
+		fallTime = 0.0F;
+	}
+}
+
+// interpolates the player and the area.
+void world::Simulation::interpolate()
+{
+	plyr->interpolate(physicsTime / PHYSICS_STEP);
+	area->interpolate(physicsTime / PHYSICS_STEP);
+}
+
+// ends the interpolation of the player and the area.
+void world::Simulation::endInterpolation()
+{
+	plyr->endInterpolation();
+	area->endInterpolation();
+}
+
+// gets the input for the next step.
+world::InputState & world::Simulation::getInput() { return input; }
+
+// gets the area.
+world::Area * world::Simulation::getArea() const { return area; }
+
+// gets the player.
+entity::Player * world::Simulation::getPlayer() const { return plyr; }
+
+// sets the view size.
+void world::Simulation::setViewSize(const Size & viewSize) { this->viewSize = viewSize; }
+
+// sets a fixed view centre.
+void world::Simulation::setViewCentre(const Vec2 & viewCentre)
+{
+	this->viewCentre = viewCentre;
+	viewFollowsPlayer = false;
+}
+
+// sets the spawn point.
+void world::Simulation::setSpawnPoint(int spawnPoint) { this->spawnPoint = spawnPoint; }
+
+// sets debug mode.
+void world::Simulation::setDebug(bool debug) { this->debug = debug; }
+
+// returns whether the player can jump.
+bool world::Simulation::getCanJump() const { return canJump; }
+
+// returns whether an exit has been reached.
+bool world::Simulation::exitReached() const { return exit != ""; }
+
+// gets the exit.
+const std::string & world::Simulation::getExit() const { return exit; }
+
+// returns whether the player has been defeated.
+bool world::Simulation::playerDefeated() const { return plyr->getHealth() == 0.0F; }
+
+// gets the step count.
+unsigned int world::Simulation::getStepCount() const { return stepCount; }
+
+// sets the step count.
+void world::Simulation::setStepCount(unsigned int stepCount) { this->stepCount = stepCount; }
+
+// gets the recording.
+world::InputRecording * world::Simulation::getRecording() const { return recording; }
+
+// sets the recording.
+void world::Simulation::setRecording(world::InputRecording * recording) { this->recording = recording; }
+
+// gets the recording being played back.
+const world::InputRecording * world::Simulation::getPlayback() const { return playback; }
+
+// sets the recording to play back.
+void world::Simulation::setPlayback(const world::InputRecording * playback) { this->playback = playback; }
+
+// gets a checksum of the player and the enemies.
+uint64_t world::Simulation::getChecksum() const
+{
+	uint64_t checksum = 0; // the checksum.
+
+	// mixes a value into the checksum.
+	auto mix = [&checksum](int64_t value) { checksum ^= (uint64_t)value + 0x9E3779B97F4A7C15ULL + (checksum << 6) + (checksum >> 2); };
+
+	// the positions are rounded to 1/16 of a unit so that tiny floating point differences between compilers don't change the checksum.
+	mix((int64_t)roundf(plyr->getPositionX() * 16.0F));
+	mix((int64_t)roundf(plyr->getPositionY() * 16.0F));
+	mix((int64_t)roundf(plyr->getHealth() * 16.0F));
+	mix((int64_t)area->getAreaEnemies()->size());
+
+	for (entity::Enemy * enemy : *area->getAreaEnemies())
+	{
+		mix((int64_t)roundf(enemy->getPositionX() * 16.0F));
+		mix((int64_t)roundf(enemy->getPositionY() * 16.0F));
+		mix((int64_t)roundf(enemy->getHealth() * 16.0F));
+	}
+
+	return checksum;
+}
+
+// gets the player's values.
+world::PlayerStats world::Simulation::getPlayerStats(entity::Player * plyr)
+{
+	world::PlayerStats playerStats; // the player's values.
+
+	playerStats.health = plyr->getHealth();
+	playerStats.maxHealth = plyr->getMaxHealth();
+	playerStats.magic = plyr->getMagicPower();
+	playerStats.maxMagic = plyr->getMagicPowerMax();
+
+	for (int i = 0; i < 4; i++) // saves the 'WIN' number of the weapons the player has (the current weapon, and weapons 1 to 3).
+	{
+		if (plyr->getWeapon(i) != nullptr)
+			playerStats.weapons.push_back(plyr->getWeapon(i)->getWIN());
+	}
+
+	return playerStats;
+}
+
+// gives the player their values from another area. A value of '-1' is used to denote when no value is available.
+void world::Simulation::setPlayerStats(entity::Player * plyr, const world::PlayerStats & playerStats)
+{
+	if (playerStats.health > -1) // current health
+		plyr->setHealth(playerStats.health);
+
+	if (playerStats.maxHealth > -1) // max health
+		plyr->setMaxHealth(playerStats.maxHealth);
+
+	if (playerStats.magic > -1) // current magic
+		plyr->setMagicPower(playerStats.magic);
+
+	if (playerStats.maxMagic > -1) // max magic
+		plyr->setMagicPowerMax(playerStats.maxMagic, false);
+
+	for (int WIN : playerStats.weapons) // giving the player back their weapons via providing their 'WIN' numbers and recreating them.
+		plyr->giveWeapon(WIN);
+}
+
+// sets the profiler.
+void world::Simulation::setProfiler(OOP::Profiler * profiler)
+{
+	this->profiler = profiler;
+
+	if (profiler == nullptr)
+		return;
+
+	cullPhase = profiler->addPhase("cull");
+	playerPhase = profiler->addPhase("player update");
+	areaPhase = profiler->addPhase("area update");
+	playerTilePhase = profiler->addPhase("player-tile");
+	enemyTilePhase = profiler->addPhase("enemy-tile");
+	playerEnemyPhase = profiler->addPhase("player-enemy");
+	weaponEnemyPhase = profiler->addPhase("weapon-enemy");
+}
+
+// runs collision tests.
+void world::Simulation::collisions()
+{	
+	unsigned int allocations = entity::Entity::getCollisionAllocations(); // the number of collision allocations before this frame's collisions.
+
+	entity::Entity::nextCollisionFrame(); // the world collision bodies from the last frame are now out of date.
+
+	playerTileCollisions(); // called for player-tile collisions.
+	enemyTileCollisions(); // collision between the enemies and the tiles.
+	
+	playerEnemyCollisions(); // called for player collisions with enemies.
+	weaponEnemyCollisions(); // called for weapon collisions with enemies.
+
+	// the collision path should only allocate when an entity's world bodies are cached for the first time. In debug mode, any allocations are printed out.
+	if (debug && entity::Entity::getCollisionAllocations() != allocations)
+		std::cout << "Collision allocations this frame: " << entity::Entity::getCollisionAllocations() - allocations << std::endl;
+}
+
+// calculates player collision with tiles.
+void world::Simulation::playerTileCollisions()
+{
+	OOP::ScopedTimer timer(profiler, playerTilePhase); // times the collisions.
+
+	entity::Tile * tile = nullptr; // the tile the player has collided with.
+	OOP::Contact contact; // the normal and depth of the collision between the player and a tile.
+
+	bool platformBelow = false; // if 'true', then there's a platform below the player.
+
+	OOP::AABB plyrBounds; // the bounds of the player, used to get the tiles the player might be touching.
+	float margin = area->getTileIndex()->getCellSize(); // extra space around the player, so the tiles the player is only touching are found too.
+
+	// the furthest the tiles push the player in each direction. Every contact is found before the player is moved, so the order the tiles are checked in doesn't matter.
+	Vec2 pushMin(0.0F, 0.0F);
+	Vec2 pushMax(0.0F, 0.0F);
+	Vec2 push; // the amount the player is moved out of the tiles.
+
+	if(debug == false)
+		plyr->setAntiGravity(false); // turns off gravity for the collision check. If the player is not on top of a tile, gravity is turned back on.
+	
+	// sets the direction cancels to false for the collision check. These are left off if they should not be changed (i.e. if there's no collision relative to the direction).
+	plyr->cancelUp = false;
+	plyr->cancelDown = false;
+	plyr->cancelLeft = false;
+	plyr->cancelRight = false;
+
+	if (sweepPlayer()) // the player went through an exit, so they're leaving the area.
+		return;
+
+	// gets the tiles the player could be touching (optimization).
+	plyrBounds = plyr->getWorldBounds();
+	area->queryStaticColliders(plyrBounds.min - Vec2(margin, margin), plyrBounds.max + Vec2(margin, margin), collisionShapes);
+	area->queryTiles(plyrBounds.min - Vec2(margin, margin), plyrBounds.max + Vec2(margin, margin), collisionTiles);
+
+	// collisions with the solid blocks are done with the area's merged collision rectangles, so the player doesn't get caught on the seams between tiles.
+	for (const OOP::WorldShape * shape : collisionShapes)
+	{
+		if (entity::Entity::collision(plyr, *shape, contact))
+		{
+			if (playerTileResponse(contact, pushMin, pushMax))
+				platformBelow = true;
+
+			plyr->collidedPrimitive = nullptr;
+		}
+	}
+
+	// the tiles are checked against the player in batches first, so the full check is only done for the tiles the player is touching.
+	packTiles(collisionTiles);
+	findTileHits(plyr);
+
+	for (int i = 0; i < collisionTiles.size(); i++)
+	{
+		tile = collisionTiles.at(i);
+
+		if (tile->isCollisionMerged() || tileHit(i) == false) // this tile was handled by a merged collision rectangle, or the player isn't near it.
+			continue;
+
+		if (entity::Entity::collision(plyr, tile, contact)) // if collision has happened, then related calculations must be done.
+		{
+			if (exit == "" && tile->getTIN() >= 0 && tile->getTIN() <= 4) // if it's a scene exit, then no other checks need to be done. The player is leaving the area.
+			{
+				exit = area->getExit(tile->getTIN()); // gets the tile identification number, which helps get the exit attached to it. The scene switches the area once the step is done.
+				return;
+			}
+
+			if (tile->getTIN() >= 800 && tile->getTIN() <= 899) // if it's a weapon tile, the player gets the weapon. This was not used in the final game, but is functional.
+			{
+				entity::Tile::effect(tile, plyr); // checks to see how the player was effected by the collision. This is only used for weapon switching in the final product.
+			}
+			else if (playerTileResponse(contact, pushMin, pushMax))
+			{
+				platformBelow = true;
+			}
+
+			// empties contents for next check.
+			plyr->collidedPrimitive = nullptr;
+			tile->collidedPrimitive = nullptr;
+		}
+	}
+
+	// the player is pushed out of all of the tiles at once.
+	push = pushMin + pushMax;
+
+	if (push.x != 0.0F || push.y != 0.0F)
+		plyr->setPosition(plyr->getPosition() + push);
+
+	// if the player is on a platform, they can now jump.
+	if (platformBelow == true)
+		canJump = true;
+}
+
+// moves the player back to the first tile they hit, if they moved too far for the overlap checks.
+bool world::Simulation::sweepPlayer()
+{
+	OOP::AABB bounds; // the box around the player's collision bodies.
+	Vec2 motion = plyr->getPosition() - plyr->getPreviousPosition(); // how far the player moved in this step.
+	float skin = 1.0F; // the player's box is made this much smaller on each side, so the tiles the player is standing on or is pressed against don't count as hits. This also leaves the player slightly inside of the tile they hit, so the overlap checks push them out of it.
+	float time = 0.0F; // how far along the motion the player hit a tile.
+	Vec2 normal; // the side of the tile that was hit.
+	entity::Tile * tile = nullptr; // the tile that was hit. This stays nullptr if the player hit a merged collision rectangle.
+
+	if (plyr->getCollisionBounds(bounds) == false)
+		return false;
+
+	// if the player moved less than half of their size on both axes, the overlap checks will find any tile they went into, and push them out of the side they came from.
+	if (fabsf(motion.x) <= (bounds.max.x - bounds.min.x) / 2 && fabsf(motion.y) <= (bounds.max.y - bounds.min.y) / 2)
+		return false;
+
+	// the sweep starts from where the player was before the step.
+	bounds.min -= motion;
+	bounds.max -= motion;
+
+	// once the movement on the axis that was hit is cut short, the movement on the other axis is swept again, since it can go through a different tile (e.g. a floor below a wall).
+	for (int i = 0; i < 2; i++)
+	{
+		if (area->sweepTiles(bounds.min + Vec2(skin, skin), bounds.max - Vec2(skin, skin), motion, time, normal, tile) == false)
+			return false;
+
+		if (tile != nullptr && exit == "" && tile->getTIN() <= 4) // the player went through an exit.
+		{
+			exit = area->getExit(tile->getTIN());
+			return true;
+		}
+
+		if (tile != nullptr && tile->getTIN() >= 800 && tile->getTIN() <= 899) // weapon tiles don't stop the player.
+			return false;
+
+		// only the movement into the side that was hit is cut short, so the player keeps sliding along the tile. The overlap checks then treat it like any other tile the player is touching.
+		// the box is moved up to the hit on that axis, and that axis is taken out of the rest of the motion.
+		if (normal.x != 0.0F)
+		{
+			plyr->setPositionX(plyr->getPositionX() - motion.x * (1.0F - time));
+			plyr->zeroVelocityX();
+
+			bounds.min.x += motion.x * time;
+			bounds.max.x += motion.x * time;
+			motion.x = 0.0F;
+		}
+		else
+		{
+			plyr->setPositionY(plyr->getPositionY() - motion.y * (1.0F - time));
+			plyr->zeroVelocityY();
+
+			bounds.min.y += motion.y * time;
+			bounds.max.y += motion.y * time;
+			motion.y = 0.0F;
+		}
+	}
+
+	return false;
+}
+
+// adds a tile the player has collided with to the push out of the tiles, and stops the player from moving into it. Returns 'true' if the player is standing on the tile.
+bool world::Simulation::playerTileResponse(const OOP::Contact & contact, Vec2 & pushMin, Vec2 & pushMax)
+{
+	Vec2 push = contact.normal * contact.depth; // the amount this tile pushes the player.
+
+	// only the furthest push in each direction is kept, so two tiles that push the player the same way don't push them twice as far.
+	pushMin.x = std::min(pushMin.x, push.x);
+	pushMin.y = std::min(pushMin.y, push.y);
+	pushMax.x = std::max(pushMax.x, push.x);
+	pushMax.y = std::max(pushMax.y, push.y);
+
+	// if the normal is mostly sideways, the tile is a wall.
+	if (fabsf(contact.normal.x) > fabsf(contact.normal.y))
+	{
+		if (contact.normal.x < 0.0F) // canceling rightward movement
+		{
+			plyr->cancelRight = true;
+
+			if (plyr->getVelocity().x > 0.0F)
+				plyr->zeroVelocityX(); // removing (x) (horizontal) velocity
+		}
+		else // canceling leftward movement.
+		{
+			plyr->cancelLeft = true;
+
+			if (plyr->getVelocity().x < 0.0F)
+				plyr->zeroVelocityX();
+		}
+
+		return false;
+	}
+
+	// otherwise, the player is on top or below the tile.
+	if (contact.normal.y < 0.0F) // the player hit the ceiling, so they stop moving upwards.
+	{
+		plyr->cancelUp = true;
+
+		if (plyr->getVelocity().y > 0.0F)
+			plyr->zeroVelocityY();
+
+		return false;
+	}
+
+	plyr->cancelDown = true; // the player is on top of the tile.
+
+	if (debug == false)
+		plyr->setAntiGravity(true); // the player is standing on the tile, so gravity is turned off.
+
+	if (plyr->getVelocity().y < 0.0F)
+		plyr->zeroVelocityY();
+
+	return true;
+}
+
+// collisions between enemies and tiles. Only the enemies that were updated on this step are checked.
+void world::Simulation::enemyTileCollisions()
+{
+	OOP::ScopedTimer timer(profiler, enemyTilePhase); // times the collisions.
+
+	OOP::AABB emyBounds; // the bounds of the enemy being checked.
+
+	float cellSize = area->getTileIndex()->getCellSize(); // the size of a grid square.
+	Vec2 cellPos; // the position of the grid square in a merged collision rectangle that's closest to the enemy.
+
+	// enemies against the static tiles, which are found using the area's tile grid and merged collision rectangles.
+	// the middle and far tier enemies that were updated on this step are checked too, so that they still turn around when they hit something.
+	for (const std::vector<entity::Enemy *> * enemies : { &area->getActiveEnemies(), &area->getScheduledEnemies() })
+	{
+		for (entity::Enemy * emy : *enemies)
+		{
+			emyBounds = emy->getWorldBounds();
+			area->queryStaticColliders(emyBounds.min, emyBounds.max, collisionShapes);
+			area->getTileIndex()->query(emyBounds.min, emyBounds.max, enemyCollisionTiles);
+
+			for (const OOP::WorldShape * shape : collisionShapes)
+			{
+				if (entity::Entity::collision(emy, *shape)) // the closest grid square in the rectangle is treated as the tile.
+				{
+					cellPos.x = clampf(emy->getPositionX(), shape->aabb.min.x + cellSize / 2, shape->aabb.max.x - cellSize / 2);
+					cellPos.y = clampf(emy->getPositionY(), shape->aabb.min.y + cellSize / 2, shape->aabb.max.y - cellSize / 2);
+
+					enemyTileCollision(emy, cellPos);
+				}
+			}
+
+			// the enemy doesn't get moved by the tiles, so the batches only need to be checked once.
+			packTiles(enemyCollisionTiles);
+			findTileHits(emy);
+
+			for (unsigned int i = 0; i < enemyCollisionTiles.size(); i++)
+			{
+				if (tileHit(i) && emy->collision(enemyCollisionTiles[i])) // if there is collision. Merged tiles are never hit.
+					enemyTileCollision(emy, enemyCollisionTiles[i]->getPosition());
+			}
+		}
+	}
+
+	// enemies against the moving tiles. Both are in the area's entity tree, so the overlapping pairs are taken from there.
+	area->getEntityTree()->getPairs(entityPairs, entity::enemy, entity::tile);
+
+	for (world::AABBTree::Pair & pair : entityPairs)
+	{
+		if (pair.entity1->onScreen && pair.entity1->collision(pair.entity2)) // 'onScreen' is set by the area's cull, so only active enemies are checked.
+			enemyTileCollision((entity::Enemy *)pair.entity1, pair.entity2->getPosition());
+	}
+}
+
+// handles an enemy that has collided with a tile.
+void world::Simulation::enemyTileCollision(entity::Enemy * emy, const Vec2 & tilePosition)
+{
+	// the enemy only turns around if it's moving towards the tile. Otherwise it would turn around every frame while it's still touching the tile.
+	if (emy->getMoveForceY() != 0.0F) // if the enemy is choosing to move vertically.
+	{
+		if ((tilePosition.y > emy->getPositionY()) == emy->moveUp)
+			emy->moveUp = !emy->moveUp; // makes the enemy move in the opposite direction.
+	}
+	else if (emy->getMoveForceY() == 0.0F) // if the enemy is not moving, and has fallen via gravity.
+	{
+		emy->setAntiGravity(true); // sets gravity to true
+	}
+
+	if (emy->getMoveForceX() != 0.0F) // stop movement towards the tile.
+	{
+		if ((tilePosition.x > emy->getPositionX()) == emy->moveRight)
+			emy->moveRight = !emy->moveRight;
+	}
+}
+
+// packs the tiles' boxes
+void world::Simulation::packTiles(const std::vector<entity::Tile *> & tiles)
+{
+	// a box that covers everything. Half of the largest float is used so that its size doesn't overflow.
+	const Vec2 EVERYWHERE_MIN(-FLT_MAX / 2, -FLT_MAX / 2), EVERYWHERE_MAX(FLT_MAX / 2, FLT_MAX / 2);
+
+	tileBoxes.clear();
+
+	for (entity::Tile * tile : tiles)
+	{
+		if (tile->isCollisionMerged()) // this tile is handled by a merged collision rectangle, so it gets a box that's inside out.
+		{
+			tileBoxes.add(EVERYWHERE_MAX, EVERYWHERE_MIN);
+			continue;
+		}
+
+		const std::vector<OOP::WorldShape> & bodies = tile->getWorldCollisionBodies();
+
+		if (bodies.size() == 1 && bodies[0].id == 1) // a single box, which is what nearly every tile is.
+			tileBoxes.add(bodies[0].aabb.min, bodies[0].aabb.max);
+		else
+			tileBoxes.add(EVERYWHERE_MIN, EVERYWHERE_MAX);
+	}
+}
+
+// finds the packed tiles the entity could be touching
+void world::Simulation::findTileHits(entity::Entity * e)
+{
+	OOP::AABB bounds; // the box that's checked against the tiles for the current shape.
+
+	tileHits.assign((tileBoxes.size() + umath::BATCH_SIZE - 1) / umath::BATCH_SIZE, 0U);
+
+	for (const OOP::WorldShape & shape : e->getWorldCollisionBodies())
+	{
+		if (shape.source->isActive() == false)
+			continue;
+
+		// there's no batch check for OBBs and capsules, so the box around them is used instead. It's made a little bigger so that rounding in the full check can't let the shape hit a tile the box missed.
+		bounds = shape.getBounds();
+
+		if (shape.id != 1 && shape.id != 3)
+		{
+			bounds.min -= Vec2(1.0F, 1.0F);
+			bounds.max += Vec2(1.0F, 1.0F);
+		}
+
+		for (unsigned int first = 0; first < tileBoxes.size(); first += umath::BATCH_SIZE)
+		{
+			tileHits[first / umath::BATCH_SIZE] |= (shape.id == 3) ? umath::aabbCircleCollisionBatch(shape.circle.centre, shape.circle.radius, tileBoxes, first)
+				: umath::aabbCollisionBatch(bounds.min, bounds.max, tileBoxes, first);
+		}
+	}
+}
+
+// checks if a packed tile was hit.
+bool world::Simulation::tileHit(unsigned int index) const { return (tileHits[index / umath::BATCH_SIZE] & (1U << (index % umath::BATCH_SIZE))) != 0; }
+
+// calculates player collision with enemies
+void world::Simulation::playerEnemyCollisions()
+{
+	OOP::ScopedTimer timer(profiler, playerEnemyPhase); // times the collisions.
+
+	OOP::AABB plyrBounds; // the bounds of the player.
+
+	if (plyr->getInvincible()) // if the player currently has invincibility frames, then the enemy collisions are ignored.
+		return;
+
+	// only the enemies that could be touching the player are checked (optimization).
+	plyrBounds = plyr->getWorldBounds();
+	area->queryEnemies(plyrBounds.min, plyrBounds.max, collisionEnemies);
+
+	for (entity::Enemy * enemy : collisionEnemies)
+	{
+		if (entity::Entity::collision(plyr, enemy)) // checks for collision
+		{
+			// player takes damage
+			plyr->setHealth(plyr->getHealth() - magic::MagicType::damage(enemy->getMagicType(), plyr->getMagicType(), enemy->getAttackPower()));
+			plyr->gotHit();
+
+			break;
+
+		}
+	}
+}
+
+// collision between the player's current weapon and the enemy.
+void world::Simulation::weaponEnemyCollisions()
+{
+	OOP::ScopedTimer timer(profiler, weaponEnemyPhase); // times the collisions.
+
+	entity::Weapon * weapon = plyr->getCurrentWeapon(); // the player's active weapon
+	magic::Magic weaponMagic; // gets the magic type of the weapon.
+
+	OOP::AABB weaponBounds; // the box surrounding all of the weapon's collision bodies.
+	OOP::AABB shapeBounds; // the box surrounding the current collision body.
+
+	if (weapon == nullptr)
+		return;
+
+	// so essenially, a problem with the weapon collisions is that they would be based off the weapon's sprite instead of the player's sprite under a normal function call.
+	// as such, a collision body needs to be paired with the player that only contains the weapons at the appropriate spot, hence the function call.
+	const std::vector<OOP::WorldShape> & weaponBodies = weapon->getWorldCollisionBodies(weapon->getOwner()->getSprite());
+
+	if (weaponBodies.size() == 0) // the weapon can't hit anything.
+		return;
+
+	// if the player has no magic power, then the weapon's type is switched to 'null' for the collisions.
+	weaponMagic = (plyr->getMagicPower() > 0.0F) ? weapon->getMagicType() : magic::Magic(magic::null);
+
+	// gets the area the weapon covers so that only the enemies near it are checked (optimization).
+	weaponBounds = weaponBodies[0].getBounds();
+
+	for (const OOP::WorldShape & shape : weaponBodies)
+	{
+		shapeBounds = shape.getBounds();
+
+		weaponBounds.min.x = std::min(weaponBounds.min.x, shapeBounds.min.x);
+		weaponBounds.min.y = std::min(weaponBounds.min.y, shapeBounds.min.y);
+		weaponBounds.max.x = std::max(weaponBounds.max.x, shapeBounds.max.x);
+		weaponBounds.max.y = std::max(weaponBounds.max.y, shapeBounds.max.y);
+	}
+
+	area->queryEnemies(weaponBounds.min, weaponBounds.max, collisionEnemies);
+
+	for (entity::Enemy * emy : collisionEnemies)
+	{
+		if (entity::Entity::collision(plyr, weaponBodies, emy, emy->getWorldCollisionBodies())) // checks for collision.
+		{
+			// if the player has no magic power, then the weapon's attack power is cut in half, and has a type value of 'null'.
+			emy->setHealth(emy->getHealth() - 
+				magic::Magic::damage(weaponMagic, emy->getMagicType(), weapon->getDamage() / (plyr->getMagicPower() > 0.0F) ? 1 : 2));
+
+			emy->gotHit(); // the enemy has been hit
+
+			plyr->addMagicPower(-1 * (weapon->getMagicUsage())); // reduces the player's magic. The scene resizes the mp bar to match.
+
+			break;
+		}
+	}
+
+}
@@ -0,0 +1,187 @@
+// runs the gameplay for an area (the player, the enemies, the tiles, and the collisions between them) in fixed physics steps.
+// nothing here uses the director or draws anything, so the simulation can be run without a window (see the 'sim' folder).
+#pragma once
+
+#include "areas/Area.h"
+#include "areas/InputRecording.h"
+#include "entities/Player.h"
+#include "Profiler.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace world
+{
+	class Simulation
+	{
+	public:
+		// creates a simulation for the provided area and player. Neither of them is deleted by the simulation.
+		Simulation(world::Area * area = nullptr, entity::Player * plyr = nullptr);
+
+		/*
+		 * adds 'deltaTime' to the time waiting to be simulated, and runs as many fixed physics steps as fit into it. If the game falls too far behind, the extra time is dropped.
+		 * no more steps are run once the player has reached an exit, or has been defeated, so that the step count is the same no matter how many steps a frame runs.
+		 * returns the amount of steps that were run.
+		*/
+		int advance(float deltaTime);
+
+		/*
+		 * runs one fixed physics step. This applies the player's input, culls the area around the view (see world::Area::cull()), updates the player and the area, and runs the collisions.
+		 * everything that changes the gameplay happens here, so that the same input on the same steps always gives the same result.
+		*/
+		void step();
+
+		// gets the input for the next physics step. The buttons should be set on this as they're pressed and released.
+		// the jump, attack, and weapon switch stay set until a step has used them.
+		world::InputState & getInput();
+
+		// moves the sprites between the last two physics steps, based on how much time is left over (see entity::Entity::interpolate()).
+		void interpolate();
+
+		// puts the sprites back at their actual positions. This should be called before anything else moves the entities.
+		void endInterpolation();
+
+		// the length of a physics step, which gives 120 steps per second.
+		static const float PHYSICS_STEP;
+
+		// the most physics steps that can be run in one call to advance().
+		static const int MAX_PHYSICS_STEPS;
+
+		// gets the area being simulated.
+		world::Area * getArea() const;
+
+		// gets the player being simulated.
+		entity::Player * getPlayer() const;
+
+		// sets the size of the view the area is culled with (i.e. the window size).
+		void setViewSize(const Size & viewSize);
+
+		// makes the view stay at the provided position, rather than following the player. This is used when the camera is turned off.
+		void setViewCentre(const Vec2 & viewCentre);
+
+		// sets the spawn point the player is sent back to if they fall for too long.
+		void setSpawnPoint(int spawnPoint);
+
+		// turns on or off debug mode. In debug mode, the player isn't affected by gravity, and isn't moved by their movement force.
+		void setDebug(bool debug);
+
+		// returns 'true' if the player is on a platform, and can jump.
+		bool getCanJump() const;
+
+		// returns 'true' if the player has touched an exit. The simulation stops once this happens.
+		bool exitReached() const;
+
+		// gets the exit the player touched, which is in the format AIN_###_#. If no exit has been reached, a "" string is returned.
+		const std::string & getExit() const;
+
+		// returns 'true' if the player has run out of health. The simulation stops once this happens.
+		bool playerDefeated() const;
+
+		// gets how many physics steps have been run.
+		unsigned int getStepCount() const;
+
+		// sets the step count. This is used to keep counting steps when the player goes into a new area, which has a new simulation.
+		void setStepCount(unsigned int stepCount);
+
+		// gets the recording the input is being added to.
+		world::InputRecording * getRecording() const;
+
+		// sets a recording that the input for each step is added to. If it's a nullptr, nothing is recorded.
+		void setRecording(world::InputRecording * recording);
+
+		// gets the recording being played back.
+		const world::InputRecording * getPlayback() const;
+
+		// sets a recording to play back. While it's set, the input for each step comes from the recording instead of getInput(). If it's a nullptr, the normal input is used.
+		void setPlayback(const world::InputRecording * playback);
+
+		// gets a checksum of the player and the enemies in the area. If two runs have the same checksum on the same step, they've (almost certainly) played out the same way.
+		uint64_t getChecksum() const;
+
+		// gets the player's values so that they can be carried over to a new area.
+		static world::PlayerStats getPlayerStats(entity::Player * plyr);
+
+		// gives the player the values that were carried over from another area.
+		static void setPlayerStats(entity::Player * plyr, const world::PlayerStats & playerStats);
+
+		// how long the player can be falling for before they're sent back to the spawn point.
+		static const float FALL_TIME_MAX;
+
+		// sets the profiler the culling, the updates and each collision routine are timed with. The phases are added to the profiler here. If it's a nullptr, nothing is timed.
+		void setProfiler(OOP::Profiler * profiler);
+
+	private:
+		// applies the input for a physics step to the player, which also chooses the player's animation.
+		void applyInput(const world::InputState & stepInput);
+
+		// sends the player back to the spawn point if they've been falling for too long.
+		void checkFall();
+
+		// runs the collisions for a physics step.
+		void collisions();
+
+		void playerTileCollisions(); // player tile collisions
+		// if the player moved far enough in this step to pass through a tile (or be pushed out of the wrong side of it), they're moved back to where they first hit one (see world::Area::sweepTiles()).
+		// returns 'true' if the player passed through an exit.
+		bool sweepPlayer();
+		// adds the contact between the player and a tile to the push out of the tiles (see playerTileCollisions()). Returns 'true' if the player is standing on the tile.
+		bool playerTileResponse(const OOP::Contact & contact, Vec2 & pushMin, Vec2 & pushMax);
+		void enemyTileCollisions(); // enemy-tile collisions
+		void enemyTileCollision(entity::Enemy * emy, const Vec2 & tilePosition); // handles an enemy that has collided with a tile at the provided position.
+
+		// packs the boxes of the provided tiles into 'tileBoxes', so that they can be checked in batches by findTileHits().
+		// tiles that aren't a single box get a box that covers everything, so they always get the full check. Tiles that were merged get a box that nothing can touch.
+		void packTiles(const std::vector<entity::Tile *> & tiles);
+
+		// checks the entity's shapes against the packed tiles, four or eight at a time (see umath::aabbCollisionBatch()), and saves which tiles were hit.
+		// the full collision check only needs to be done for those tiles. This should be called again if the entity is moved.
+		void findTileHits(entity::Entity * e);
+
+		// returns 'true' if the packed tile at 'index' was hit in the last call to findTileHits().
+		bool tileHit(unsigned int index) const;
+		void playerEnemyCollisions(); // player enemy collisions
+		void weaponEnemyCollisions(); // collisions between the player's weapon and the enemies.
+
+		world::Area * area; // the area being simulated.
+		entity::Player * plyr; // the player.
+
+		Size viewSize = Size(1920.0F, 1080.0F); // the size of the view the area is culled with.
+		bool viewFollowsPlayer = true; // if 'true', the view is centred on the player. This is where the camera is when it's on.
+		Vec2 viewCentre = Vec2(0.0F, 0.0F); // the centre of the view if it doesn't follow the player.
+		bool debug = false; // 'true' if debug mode is on.
+
+		world::InputState input; // the input for the next step.
+		world::InputRecording * recording = nullptr; // the recording the input is added to.
+		const world::InputRecording * playback = nullptr; // the recording being played back.
+
+		float physicsTime = 0.0F; // the time that has passed but hasn't been simulated yet.
+		float jumpTime = 0.0F; // how much longer the jump force should be applied for.
+		bool canJump = true; // used to check if the player should be allowed to jump or not.
+
+		int spawnPoint = 0; // the spawn point the player is sent back to if they fall for too long.
+		float fallTime = 0.0F; // how long the player has been falling for.
+
+		std::string exit = ""; // the exit the player has touched.
+		unsigned int stepCount = 0; // the amount of physics steps that have been run.
+
+		OOP::Profiler * profiler = nullptr; // times the parts of the simulation.
+		// the profiler phases for each part of the simulation.
+		unsigned int cullPhase = 0; // culling the area.
+		unsigned int playerPhase = 0; // updating the player.
+		unsigned int areaPhase = 0; // updating the area.
+		unsigned int playerTilePhase = 0; // player-tile collisions.
+		unsigned int enemyTilePhase = 0; // enemy-tile collisions.
+		unsigned int playerEnemyPhase = 0; // player-enemy collisions.
+		unsigned int weaponEnemyPhase = 0; // weapon-enemy collisions.
+
+		// these are kept between steps so that the queries don't need to allocate.
+		std::vector<entity::Tile *> collisionTiles; // the tiles that are close enough to the player for a collision check.
+		std::vector<entity::Tile *> enemyCollisionTiles; // the tiles close to the enemy currently being checked.
+		std::vector<const OOP::WorldShape *> collisionShapes; // the area's merged collision rectangles that are close to the entity being checked.
+		std::vector<entity::Enemy *> collisionEnemies; // the enemies that are close enough to the player (or their weapon) for a collision check.
+		umath::BoxBatch tileBoxes; // the boxes of the tiles being checked (see packTiles()).
+		std::vector<unsigned int> tileHits; // a bit for each packed tile, which is set if the tile was hit. Each value holds umath::BATCH_SIZE tiles.
+		std::vector<world::AABBTree::Pair> entityPairs; // pairs of moving entities that may be touching.
+	};
+}
@@ -0,0 +1,204 @@
+#include "areas/SpatialGrid.h"
+
+#include <algorithm>
+
+// creates the grid. The cells are made when the grid is built.
+world::SpatialGrid::SpatialGrid(const float cellSize) : CELL_SIZE((cellSize > 0.0F) ? cellSize : 128.0F) {}
+
+// the grid doesn't own the tiles, so they aren't deleted.
+world::SpatialGrid::~SpatialGrid() {}
+
+// builds the grid around the provided tiles.
+void world::SpatialGrid::build(const std::vector<entity::Tile *> & tiles)
+{
+	OOP::AABB area; // the area all of the tiles take up.
+	OOP::AABB bounds; // the bounds of the current tile.
+	bool first = true; // used to start the area off with the first tile.
+
+	clear();
+
+	for (entity::Tile * tile : tiles) // gets the area the static tiles take up.
+	{
+		if (tile == nullptr || tile->isMoving())
+			continue;
+
+		bounds = tile->getWorldBounds();
+
+		if (first)
+		{
+			area = bounds;
+			first = false;
+			continue;
+		}
+
+		area.min.x = std::min(area.min.x, bounds.min.x);
+		area.min.y = std::min(area.min.y, bounds.min.y);
+		area.max.x = std::max(area.max.x, bounds.max.x);
+		area.max.y = std::max(area.max.y, bounds.max.y);
+	}
+
+	if (first == false) // sets up the cells so that the grid lines up with the area's grid.
+	{
+		origin = Vec2(floorf(area.min.x / CELL_SIZE) * CELL_SIZE, floorf(area.min.y / CELL_SIZE) * CELL_SIZE);
+		columns = (int)ceilf((area.max.x - origin.x) / CELL_SIZE) + 1;
+		rows = (int)ceilf((area.max.y - origin.y) / CELL_SIZE) + 1;
+
+		cells.resize(columns * rows);
+	}
+
+	for (entity::Tile * tile : tiles) // adds all of the tiles.
+		add(tile);
+}
+
+// adds a tile to the grid.
+void world::SpatialGrid::add(entity::Tile * tile)
+{
+	if (tile == nullptr || tile->isMoving()) // moving tiles don't stay in one cell, so they aren't put in the grid.
+		return;
+
+	tileCount++;
+	insert(tile);
+}
+
+// puts the tile in all the cells it overlaps.
+void world::SpatialGrid::insert(entity::Tile * tile)
+{
+	OOP::AABB bounds = tile->getWorldBounds();
+	int minCol = 0, maxCol = 0, minRow = 0, maxRow = 0; // the cells the tile covers. A tile that lines up with the grid only covers one.
+
+	getCellRange(bounds.min, bounds.max, minCol, maxCol, minRow, maxRow);
+
+	// if the tile isn't fully within the grid, it's treated as an unbound tile.
+	if (minCol < 0 || minRow < 0 || maxCol >= columns || maxRow >= rows)
+	{
+		tile->gridMinCell = tile->gridMaxCell = -1;
+		unbound.push_back(tile);
+		return;
+	}
+
+	// the cells are saved so that remove() only has to look in them.
+	tile->gridMinCell = minRow * columns + minCol;
+	tile->gridMaxCell = maxRow * columns + maxCol;
+
+	for (int row = minRow; row <= maxRow; row++)
+	{
+		for (int col = minCol; col <= maxCol; col++)
+			cells[row * columns + col].push_back(Entry{ tile, minCol != maxCol || minRow != maxRow });
+	}
+}
+
+// removes a tile from the grid.
+void world::SpatialGrid::remove(entity::Tile * tile)
+{
+	int minCol = 0, maxCol = 0, minRow = 0, maxRow = 0; // the cells the tile was put in.
+	bool removed = false;
+
+	if (tile == nullptr)
+		return;
+
+	for (unsigned int i = 0; i < unbound.size(); i++) // checks the unbound tiles.
+	{
+		if (unbound[i] == tile)
+		{
+			unbound.erase(unbound.begin() + i);
+			tileCount--;
+			return;
+		}
+	}
+
+	// only the cells insert() put the tile in are checked. The tile's bounds aren't used, since its sprite may already be gone.
+	if (tile->gridMinCell < 0 || tile->gridMaxCell >= (int)cells.size())
+		return;
+
+	minCol = tile->gridMinCell % columns;
+	minRow = tile->gridMinCell / columns;
+	maxCol = tile->gridMaxCell % columns;
+	maxRow = tile->gridMaxCell / columns;
+	tile->gridMinCell = tile->gridMaxCell = -1;
+
+	for (int row = minRow; row <= maxRow; row++)
+	{
+		for (int col = minCol; col <= maxCol; col++)
+		{
+			std::vector<Entry> & cell = cells[row * columns + col];
+
+			for (unsigned int i = 0; i < cell.size(); i++)
+			{
+				if (cell[i].tile == tile)
+				{
+					cell.erase(cell.begin() + i);
+					removed = true;
+					break;
+				}
+			}
+		}
+	}
+
+	if (removed)
+		tileCount--;
+}
+
+// clears the grid.
+void world::SpatialGrid::clear()
+{
+	cells.clear();
+	unbound.clear();
+	columns = 0;
+	rows = 0;
+	tileCount = 0;
+}
+
+// gets the tiles near the provided box.
+void world::SpatialGrid::query(const Vec2 & min, const Vec2 & max, std::vector<entity::Tile *> & results) const
+{
+	int minCol = 0, maxCol = 0, minRow = 0, maxRow = 0; // the cells the box covers.
+
+	getCellRange(min, max, minCol, maxCol, minRow, maxRow);
+
+	// clamps the cells to the grid.
+	minCol = std::max(minCol, 0);
+	maxCol = std::min(maxCol, columns - 1);
+	minRow = std::max(minRow, 0);
+	maxRow = std::min(maxRow, rows - 1);
+
+	results.clear();
+
+	for (int row = minRow; row <= maxRow; row++)
+	{
+		for (int col = minCol; col <= maxCol; col++)
+		{
+			for (const Entry & entry : cells[row * columns + col])
+			{
+				// tiles that are in multiple cells may have already been added. Only tiles bigger than a cell (or off the grid lines) are.
+				if (entry.multiCell && std::find(results.begin(), results.end(), entry.tile) != results.end())
+					continue;
+
+				results.push_back(entry.tile);
+			}
+		}
+	}
+
+	for (entity::Tile * tile : unbound) // unbound tiles are always returned.
+		results.push_back(tile);
+}
+
+// gets the column based on an x position.
+int world::SpatialGrid::getColumn(float x) const { return (int)floorf((x - origin.x) / CELL_SIZE); }
+
+// gets the row based on a y position.
+int world::SpatialGrid::getRow(float y) const { return (int)floorf((y - origin.y) / CELL_SIZE); }
+
+// gets the cells a box covers. The last cell is the one before the cell the max side starts, unless the box is in a single cell.
+void world::SpatialGrid::getCellRange(const Vec2 & min, const Vec2 & max, int & minCol, int & maxCol, int & minRow, int & maxRow) const
+{
+	minCol = getColumn(min.x);
+	minRow = getRow(min.y);
+	maxCol = std::max(minCol, (int)ceilf((max.x - origin.x) / CELL_SIZE) - 1);
+	maxRow = std::max(minRow, (int)ceilf((max.y - origin.y) / CELL_SIZE) - 1);
+}
+
+// gets the size of a cell.
+float world::SpatialGrid::getCellSize() const { return CELL_SIZE; }
+
+// gets the amount of tiles in the grid.
+unsigned int world::SpatialGrid::getTileCount() const { return tileCount; }
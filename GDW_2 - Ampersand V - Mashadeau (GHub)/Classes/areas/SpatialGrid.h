@@ -0,0 +1,78 @@
+// a uniform grid used to quickly find the tiles near a given area, instead of checking every tile in the Area.
+#pragma once
+
+#include "entities/Tile.h"
+
+#include <vector>
+
+namespace world
+{
+	class SpatialGrid
+	{
+	public:
+		// creates an empty grid. The cell size should be the size of a grid unit in the area (128.0F).
+		SpatialGrid(const float cellSize = 128.0F);
+
+		~SpatialGrid();
+
+		// clears the grid and puts all of the provided tiles into it. The size of the grid is based on where the tiles are.
+		// moving tiles are skipped, since they don't stay in one place; those go in the area's AABB tree instead.
+		void build(const std::vector<entity::Tile *> & tiles);
+
+		// adds a tile to the grid. If the tile is outside of the grid, it gets returned by every query. Moving tiles are not added.
+		void add(entity::Tile * tile);
+
+		// removes a tile from the grid. Only the cells the tile was put in are checked.
+		void remove(entity::Tile * tile);
+
+		// removes all tiles from the grid.
+		void clear();
+
+		/*
+		 * fills 'results' with all the tiles in the cells that overlap the box from 'min' to 'max'. Every tile is only put in once.
+		 * 'results' is cleared first, but keeps its capacity, so reusing the same vector every frame doesn't allocate anything.
+		 * The tiles returned are only the ones that *might* overlap the box, so a proper collision check is still needed.
+		*/
+		void query(const Vec2 & min, const Vec2 & max, std::vector<entity::Tile *> & results) const;
+
+		// gets the size of a cell in the grid.
+		float getCellSize() const;
+
+		// gets the amount of tiles in the grid.
+		unsigned int getTileCount() const;
+
+	private:
+		// an entry in a grid cell.
+		struct Entry
+		{
+			entity::Tile * tile;
+			bool multiCell; // 'true' if the tile is in more than one cell, meaning it has to be checked for duplicates during a query.
+		};
+
+		// gets the column of a cell based on an x position.
+		int getColumn(float x) const;
+
+		// gets the row of a cell based on a y position.
+		int getRow(float y) const;
+
+		// gets the cells a box covers. The right and top sides are open, so a box that ends exactly on a cell's edge isn't put in the next cell over.
+		void getCellRange(const Vec2 & min, const Vec2 & max, int & minCol, int & maxCol, int & minRow, int & maxRow) const;
+
+		// puts a tile into all of the cells it overlaps.
+		void insert(entity::Tile * tile);
+
+		const float CELL_SIZE; // the size of a single cell.
+
+		Vec2 origin; // the bottom left-hand corner of the grid.
+		int columns = 0; // the amount of columns in the grid.
+		int rows = 0; // the amount of rows in the grid.
+
+		std::vector<std::vector<Entry>> cells; // the grid cells, going row by row starting from the bottom left-hand corner.
+		std::vector<entity::Tile *> unbound; // tiles that are outside of the grid. These are returned by every query.
+
+		unsigned int tileCount = 0; // the amount of tiles in the grid.
+
+	protected:
+
+	};
+}
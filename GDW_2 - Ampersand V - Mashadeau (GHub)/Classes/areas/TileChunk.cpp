@@ -0,0 +1,152 @@
+#include "areas/TileChunk.h"
+
+#include "renderer/CCGLProgramState.h"
+#include "renderer/CCRenderer.h"
+
+#include <algorithm>
+
+// creates a chunk.
+world::TileChunk * world::TileChunk::create()
+{
+	world::TileChunk * chunk = new (std::nothrow) world::TileChunk();
+
+	if (chunk != nullptr && chunk->init())
+	{
+		chunk->autorelease();
+		return chunk;
+	}
+
+	delete chunk;
+	return nullptr;
+}
+
+// deletes the batches.
+world::TileChunk::~TileChunk()
+{
+	for (Batch * batch : batches)
+		delete batch;
+
+	batches.clear();
+}
+
+// adds a sprite's quad to the chunk.
+void world::TileChunk::addSprite(Sprite * sprite)
+{
+	Batch * batch = nullptr; // the batch that uses the sprite's texture.
+	V3F_C4B_T2F_Quad quad; // the sprite's quad.
+	Mat4 transform; // used to move the quad to where the sprite is in the area.
+	unsigned short first = 0; // the index of the first vertex of the quad.
+
+	if (finished || sprite == nullptr || sprite->getTexture() == nullptr)
+		return;
+
+	for (Batch * b : batches) // looks for the batch with this texture.
+	{
+		if (b->texture == sprite->getTexture())
+		{
+			batch = b;
+			break;
+		}
+	}
+
+	if (batch == nullptr) // this is the first sprite with this texture.
+	{
+		batch = new Batch();
+		batch->texture = sprite->getTexture();
+		batch->blend = sprite->getBlendFunc();
+		batches.push_back(batch);
+	}
+
+	// the quad is in the sprite's own space, so it's moved to where the sprite is.
+	quad = sprite->getQuad();
+	transform = sprite->getNodeToParentTransform();
+
+	transform.transformPoint(&quad.bl.vertices);
+	transform.transformPoint(&quad.br.vertices);
+	transform.transformPoint(&quad.tl.vertices);
+	transform.transformPoint(&quad.tr.vertices);
+
+	first = batch->vertices.size();
+
+	batch->vertices.push_back(quad.tl);
+	batch->vertices.push_back(quad.bl);
+	batch->vertices.push_back(quad.tr);
+	batch->vertices.push_back(quad.br);
+
+	// the same triangle order cocos uses for quads.
+	batch->indices.push_back(first + 0);
+	batch->indices.push_back(first + 1);
+	batch->indices.push_back(first + 2);
+	batch->indices.push_back(first + 3);
+	batch->indices.push_back(first + 2);
+	batch->indices.push_back(first + 1);
+
+	if (spriteCount == 0) // the bounds start off at the first sprite.
+		minCorner = maxCorner = Vec2(quad.bl.vertices.x, quad.bl.vertices.y);
+
+	// expands the bounds of the chunk. The sprite may be flipped or rotated, so all four corners are checked.
+	for (unsigned int i = batch->vertices.size() - 4; i < batch->vertices.size(); i++)
+	{
+		minCorner.x = std::min(minCorner.x, batch->vertices[i].vertices.x);
+		minCorner.y = std::min(minCorner.y, batch->vertices[i].vertices.y);
+		maxCorner.x = std::max(maxCorner.x, batch->vertices[i].vertices.x);
+		maxCorner.y = std::max(maxCorner.y, batch->vertices[i].vertices.y);
+	}
+
+	spriteCount++;
+}
+
+// moves the vertices so that they're relative to the bottom left-hand corner of the chunk.
+void world::TileChunk::finish()
+{
+	if (finished)
+		return;
+
+	for (Batch * batch : batches)
+	{
+		for (V3F_C4B_T2F & vertex : batch->vertices)
+		{
+			vertex.vertices.x -= minCorner.x;
+			vertex.vertices.y -= minCorner.y;
+		}
+	}
+
+	// the chunk's content size is its bounding box, so it can be culled the same way a sprite is.
+	setAnchorPoint(Vec2(0.0F, 0.0F));
+	setPosition(minCorner);
+	setContentSize(Size(maxCorner.x - minCorner.x, maxCorner.y - minCorner.y));
+
+	setGLProgramState(GLProgramState::getOrCreateWithGLProgramName(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
+
+	finished = true;
+}
+
+// draws the chunk.
+void world::TileChunk::draw(Renderer * renderer, const Mat4 & transform, uint32_t flags)
+{
+	if (finished == false || spriteCount == 0)
+		return;
+
+	// if the chunk's bounding box isn't seen by the camera, nothing is drawn.
+	if (renderer->checkVisibility(transform, _contentSize) == false)
+		return;
+
+	TrianglesCommand::Triangles triangles; // the mesh of the current batch.
+
+	for (Batch * batch : batches)
+	{
+		triangles.verts = batch->vertices.data();
+		triangles.indices = batch->indices.data();
+		triangles.vertCount = batch->vertices.size();
+		triangles.indexCount = batch->indices.size();
+
+		batch->command.init(_globalZOrder, batch->texture->getName(), getGLProgramState(), batch->blend, triangles, transform, flags);
+		renderer->addCommand(&batch->command);
+	}
+}
+
+// gets the amount of sprites in the chunk.
+unsigned int world::TileChunk::getSpriteCount() const { return spriteCount; }
+
+// gets the amount of textures in the chunk.
+unsigned int world::TileChunk::getTextureCount() const { return batches.size(); }
@@ -0,0 +1,62 @@
+// a block of static tiles that have been baked into a single mesh. The chunk is drawn with one command per texture, and is culled as a whole.
+#pragma once
+
+#include "2d/CCNode.h"
+#include "2d/CCSprite.h"
+#include "renderer/CCTrianglesCommand.h"
+
+#include <vector>
+
+using namespace cocos2d;
+
+namespace world
+{
+	class TileChunk : public Node
+	{
+	public:
+		// creates an empty chunk.
+		static TileChunk * create();
+
+		/*
+		 * copies the sprite's quad into the chunk's mesh, using where the sprite is in the area. The sprite's colour and texture rect are copied as they are now.
+		 * after all of the sprites are added, finish() must be called. Sprites can't be added after that.
+		*/
+		void addSprite(Sprite * sprite);
+
+		// moves the chunk to the bottom left-hand corner of its sprites, and sets the draw commands up.
+		void finish();
+
+		// draws the chunk if any part of it is visible to the camera.
+		void draw(Renderer * renderer, const Mat4 & transform, uint32_t flags) override;
+
+		// gets the amount of sprites in the chunk.
+		unsigned int getSpriteCount() const;
+
+		// gets the amount of textures used by the chunk. Each texture takes up a draw command.
+		unsigned int getTextureCount() const;
+
+	private:
+		// the part of the chunk that uses a single texture.
+		struct Batch
+		{
+			Texture2D * texture = nullptr; // the texture of the sprites
+			BlendFunc blend; // how the sprites are blended
+			std::vector<V3F_C4B_T2F> vertices; // four vertices per sprite.
+			std::vector<unsigned short> indices; // six indices per sprite (two triangles).
+			TrianglesCommand command; // the command used to draw the batch.
+		};
+
+		TileChunk() = default;
+
+		std::vector<Batch *> batches; // the batches in the chunk, one per texture.
+		Vec2 minCorner; // the bottom left-hand corner of the sprites.
+		Vec2 maxCorner; // the top right-hand corner of the sprites.
+		unsigned int spriteCount = 0; // the amount of sprites in the chunk.
+		bool finished = false; // becomes 'true' once finish() has been called.
+
+	protected:
+		// deletes the batches.
+		virtual ~TileChunk();
+
+	};
+}
@@ -1,9 +1,23 @@
 #include "areas/World.h"
 #include "Utilities.h"
+#include "TextureAtlas.h"
 
-world::Area * world::World::getArea(std::string & AIN)
+#include "base/CCDirector.h"
+#include "platform/CCFileUtils.h"
+#include "renderer/CCTextureCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+const std::string world::World::AREA_FOLDER = "areas/"; // Resources/areas
+const std::string world::World::CACHE_EXTENSION = ".msqa"; // Mashadeau area
+
+std::map<std::string, world::World::Preload> world::World::preloads; // the areas being preloaded.
+world::LiveAreaCache world::World::liveAreas; // the areas that have been left.
+
+// gets the file path of an area's file (areas/AIN_###.area) based on its AIN number.
+std::string world::World::getAreaFile(std::string & AIN)
 {
-	world::Area * newArea = nullptr; // the new area to be made.
 	AIN = ustd::toUpper(AIN); // makes the area name uppercase, just to make sure that it's in the right format.
 	std::string tempStr = AIN; // a temporary string that holds the AIN value.
 
@@ -15,34 +29,282 @@ world::Area * world::World::getArea(std::string & AIN)
 	if (AIN.find(" ") != std::string::npos)
 		tempStr.at(tempStr.find(" ")) = '_'; // changes the space ot an underscore.
 
-	// the length of the string must be 7 (AIN_###). If it is not, then it is invalid, and a nullptr is returned.
+	// the length of the string must be 7 (AIN_###). If it is not, then it is invalid, and an empty string is returned.
 	if (tempStr.length() != 7)
+		return "";
+
+	return AREA_FOLDER + tempStr + ".area";
+}
+
+// checks if there is an area file for the AIN number.
+bool world::World::areaExists(std::string & AIN)
+{
+	std::string filePath = getAreaFile(AIN); // the area's file.
+
+	return filePath != "" && cocos2d::FileUtils::getInstance()->isFileExist(filePath);
+}
+
+/*
+ * loads an area. If there's a cache of the area that was made from the same area file, the area is made from the cache instead (see world::AreaCache).
+ * otherwise, the area file is read, and a new cache is saved in the writable path so that the next load doesn't have to read it.
+*/
+world::Area * world::World::getArea(std::string & AIN)
+{
+	std::map<std::string, Preload>::iterator preload; // the preload of the area, if there is one.
+	PreparedArea prepared; // the area that was read.
+	world::Area * area = nullptr; // the new area.
+	std::string filePath = getAreaFile(AIN); // the area's file.
+
+	if (filePath == "")
+		return nullptr;
+
+	// if the area was left recently, it's used as it was left.
+	area = liveAreas.take(filePath.substr(AREA_FOLDER.length(), 7));
+
+	if (area != nullptr)
+		return area;
+
+	if (!startPreload(AIN)) // if there's no file for the area.
+		return nullptr;
+
+	// the area is read the same way whether it was preloaded or not. If it wasn't, this waits for it to be read.
+	preload = preloads.find(getAreaFile(AIN).substr(AREA_FOLDER.length(), 7));
+
+	if (preload->second.ready)
+		prepared = std::move(preload->second.prepared);
+	else
+		prepared = preload->second.future.get();
+
+	preloads.erase(preload);
+
+	area = buildArea(prepared);
+	return area;
+}
+
+// keeps the area so that it can be reused.
+void world::World::releaseArea(world::Area * area)
+{
+	std::string AIN = ""; // the area's AIN number.
+	std::string filePath = ""; // the area's file.
+
+	if (area == nullptr)
+		return;
+
+	AIN = area->getName();
+	filePath = getAreaFile(AIN);
+
+	// areas that were never put in a scene don't own their sprites, so they can't be kept. Areas without an AIN number can't be found again, so there's no point keeping them.
+	if (filePath == "" || !liveAreas.add(filePath.substr(AREA_FOLDER.length(), 7), area))
+	{
+		if (!area->hasSingleNode())
+			delete area;
+	}
+}
+
+// deletes the kept areas.
+void world::World::clearAreas() { liveAreas.clear(); }
+
+// sets the memory budget of the kept areas.
+void world::World::setAreaMemoryBudget(size_t memoryBudget) { liveAreas.setMemoryBudget(memoryBudget); }
+
+// checks if an area is being kept.
+bool world::World::isAreaLive(std::string AIN)
+{
+	std::string filePath = getAreaFile(AIN); // the area's file.
+
+	return filePath != "" && liveAreas.contains(filePath.substr(AREA_FOLDER.length(), 7));
+}
+
+// reads the area. This doesn't use the file utilities' relative paths, since those aren't safe to use from other threads.
+world::World::PreparedArea world::World::prepareArea(std::string filePath, std::string fullPath, std::string cachePath)
+{
+	PreparedArea prepared; // the area being read.
+	std::string source = cocos2d::FileUtils::getInstance()->getStringFromFile(fullPath); // the contents of the area's file.
+	char texture[32]; // the file path of a tile or enemy texture.
+
+	prepared.filePath = filePath;
+	prepared.cachePath = cachePath;
+	prepared.sourceHash = world::AreaCache::hash(source);
+	prepared.cache = std::make_shared<world::AreaCache>();
+
+	if (source != "" && prepared.cache->open(cachePath) && prepared.cache->getHeader()->sourceHash == prepared.sourceHash)
+	{
+		const world::AreaCache::Header * header = prepared.cache->getHeader(); // the values of the area.
+
+		for (int i = 0; i < 4; i++)
+			prepared.textures.push_back(prepared.cache->getString(header->layers[i]));
+
+		// the tile and enemy images are named after their TIN and EIN numbers. Not every one has an image, so they're checked for before they're loaded.
+		for (uint32_t i = 0; i < header->tileCount; i++)
+		{
+			snprintf(texture, sizeof(texture), "images/tiles/TIN_%03u.png", prepared.cache->getTiles()[i].id);
+			prepared.textures.push_back(texture);
+		}
+
+		for (uint32_t i = 0; i < header->enemyCount; i++)
+		{
+			snprintf(texture, sizeof(texture), "images/enemies/EIN_%03u.png", prepared.cache->getEnemies()[i].id);
+			prepared.textures.push_back(texture);
+		}
+
+		prepared.valid = true;
+	}
+	else
+	{
+		prepared.cache.reset(); // the old cache gets replaced.
+
+		// if the file isn't a usable area file, the reason is printed by the loader.
+		if (source != "" && prepared.data.loadFromString(source, filePath))
+		{
+			prepared.textures.push_back(prepared.data.backgroundLayer1);
+			prepared.textures.push_back(prepared.data.backgroundLayer2);
+			prepared.textures.push_back(prepared.data.backgroundLayer3);
+			prepared.textures.push_back(prepared.data.foregroundLayer);
+
+			for (const world::AreaData::Placement & tile : prepared.data.tiles)
+			{
+				snprintf(texture, sizeof(texture), "images/tiles/TIN_%03u.png", tile.id);
+				prepared.textures.push_back(texture);
+			}
+
+			for (const world::AreaData::Placement & enemy : prepared.data.enemies)
+			{
+				snprintf(texture, sizeof(texture), "images/enemies/EIN_%03u.png", enemy.id);
+				prepared.textures.push_back(texture);
+			}
+
+			prepared.valid = true;
+		}
+	}
+
+	// each texture only has to be loaded once.
+	std::sort(prepared.textures.begin(), prepared.textures.end());
+	prepared.textures.erase(std::unique(prepared.textures.begin(), prepared.textures.end()), prepared.textures.end());
+	prepared.textures.erase(std::remove(prepared.textures.begin(), prepared.textures.end(), ""), prepared.textures.end());
+
+	return prepared;
+}
+
+// makes the area.
+world::Area * world::World::buildArea(PreparedArea & prepared)
+{
+	world::Area * area = nullptr; // the new area.
+
+	if (!prepared.valid)
 		return nullptr;
 
-	// Goes through every area and sees if it can find what the player has asked for.
-	//DEBUG
-	if (AIN == "AIN_X00") newArea = new AIN_X00();
-	else if (AIN == "AIN_X01") newArea = new AIN_X01();
+	if (prepared.cache != nullptr)
+		return new world::Area(*prepared.cache);
+
+	area = new world::Area(prepared.data);
+
+	// the area still works without a cache, so it's only mentioned if one couldn't be saved.
+	if (!world::AreaCache::save(prepared.data, area, prepared.sourceHash, prepared.cachePath))
+		std::cout << "The area cache " << prepared.cachePath << " could not be saved.\n";
+
+	return area;
+}
+
+// starts reading an area on another thread.
+bool world::World::startPreload(std::string & AIN)
+{
+	cocos2d::FileUtils * fileUtils = cocos2d::FileUtils::getInstance(); // used to find the area's files.
+	std::string filePath = getAreaFile(AIN); // the area's file.
+	std::string fullPath = ""; // the full path of the area's file.
+	std::string key = ""; // the AIN number of the area, without a spawn point.
+
+	if (filePath == "")
+		return false;
+
+	key = filePath.substr(AREA_FOLDER.length(), 7);
+
+	if (preloads.find(key) != preloads.end()) // if the area is already being read.
+		return true;
 
-	//CASTLE
-	else if (AIN == "AIN_A00") newArea = new AIN_A00();
-	else if (AIN == "AIN_A01") newArea = new AIN_A01();
+	// the paths are found here, since the file utilities can only look for files on the main thread.
+	fullPath = fileUtils->fullPathForFilename(filePath);
 
-	//SHADOW
-	else if (AIN == "AIN_B00") newArea = new AIN_B00();
-	else if (AIN == "AIN_B01") newArea = new AIN_B01();
+	if (fullPath == "" || !fileUtils->isFileExist(fullPath))
+		return false;
 
-	//FIRE
-	else if (AIN == "AIN_C00") newArea = new AIN_C00();
-	else if (AIN == "AIN_C01") newArea = new AIN_C01();
+	preloads[key].future = std::async(std::launch::async, prepareArea, filePath, fullPath, fileUtils->getWritablePath() + key + CACHE_EXTENSION);
+	return true;
+}
+
+// preloads an area.
+void world::World::preloadArea(std::string AIN) { startPreload(AIN); }
+
+// preloads the areas the exits lead to.
+void world::World::preloadExits(const world::Area * area)
+{
+	std::vector<std::string> exits; // the areas the exits lead to (AIN_###).
+	std::string AIN = ""; // the area an exit leads to.
+
+	for (unsigned int i = 0; i < 5; i++)
+	{
+		AIN = area->getExit(i);
+
+		if (AIN.length() < 7) // if the exit isn't used.
+			continue;
 
-	//EARTH
-	else if (AIN == "AIN_E00") newArea = new AIN_E00();
-	else if (AIN == "AIN_E01") newArea = new AIN_E01();
+		AIN = AIN.substr(0, 7);
 
-	//AIR
-	else if (AIN == "AIN_F00") newArea = new AIN_F00();
-	else if (AIN == "AIN_F01") newArea = new AIN_F01();
+		if (isAreaLive(AIN)) // areas that are being kept don't need to be read again.
+			continue;
+
+		if (startPreload(AIN))
+			exits.push_back(AIN.substr(0, 7));
+	}
+
+	// finished preloads for areas that can't be reached anymore are removed. Unfinished ones are left until they're done so that this doesn't wait on them.
+	for (std::map<std::string, Preload>::iterator it = preloads.begin(); it != preloads.end();)
+	{
+		if (it->second.ready && std::find(exits.begin(), exits.end(), it->first) == exits.end())
+			it = preloads.erase(it);
+		else
+			it++;
+	}
+}
+
+// requests the textures of the areas that have been read.
+void world::World::updatePreloads()
+{
+	cocos2d::FileUtils * fileUtils = cocos2d::FileUtils::getInstance(); // used to check that the textures exist.
+	cocos2d::TextureCache * textureCache = cocos2d::Director::getInstance()->getTextureCache(); // loads the textures on its own thread.
+	std::string image = ""; // the file a texture is loaded from.
+
+	for (std::pair<const std::string, Preload> & preload : preloads)
+	{
+		if (preload.second.ready || preload.second.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			continue;
+
+		preload.second.prepared = preload.second.future.get();
+		preload.second.ready = true;
+
+		for (const std::string & texture : preload.second.prepared.textures)
+		{
+			if (OOP::TextureAtlas::getFrame(texture) != nullptr) // images in an atlas were loaded along with it.
+				continue;
+
+			if (fileUtils->isFileExist(world::ParallaxLayer::getTileSetFile(texture))) // layers that were split into tiles load them as they come into view.
+				continue;
+
+			// the backgrounds are loaded from their converted files if they have them, the same way the area loads them.
+			image = world::Area::getLayerImage(texture);
+
+			if (fileUtils->isFileExist(image))
+				textureCache->addImageAsync(image, [](cocos2d::Texture2D *) {});
+		}
+	}
+}
+
+// removes all preloads.
+void world::World::clearPreloads() { preloads.clear(); }
+
+// checks if an area is being preloaded.
+bool world::World::isPreloading(std::string AIN)
+{
+	std::string filePath = getAreaFile(AIN); // the area's file.
 
-	return newArea;
+	return filePath != "" && preloads.find(filePath.substr(AREA_FOLDER.length(), 7)) != preloads.end();
 }
@@ -1,25 +1,16 @@
-// stores inclusions for all areas
+// finds and loads the areas. Each area is stored in its own area file in the 'Resources/areas' folder (see world::AreaData).
+// loaded areas are cached in the writable path (see world::AreaCache), which is used instead of the area file until the area file changes.
+// areas that the player has left are kept alive (see world::LiveAreaCache), so going back to one reuses it as it was left.
+// the areas the current area's exits lead to can be preloaded. Their files are read on another thread, and their textures are loaded by the texture cache in the background, so only the sprites are left to make when the player goes through an exit.
 #pragma once
 
 #include "areas/Area.h"
+#include "areas/LiveAreaCache.h"
 
-#include "areas/AIN_A/AIN_A00.h"
-#include "areas/AIN_A/AIN_A01.h"
-
-#include "areas/AIN_B/AIN_B00.h"
-#include "areas/AIN_B/AIN_B01.h"
-
-#include "areas/AIN_C/AIN_C00.h"
-#include "areas/AIN_C/AIN_C01.h"
-
-#include "areas/AIN_E/AIN_E00.h"
-#include "areas/AIN_E/AIN_E01.h"
-
-#include "areas/AIN_F/AIN_F00.h"
-#include "areas/AIN_F/AIN_F01.h"
-
-#include "areas/AIN_X/AIN_X00.h"
-#include "areas/AIN_X/AIN_X01.h"
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace world
 {
@@ -27,9 +18,83 @@ namespace world
 	{
 		World() = default;
 
-		// returns an area based on a passed AIN number.
+		// returns an area based on a passed AIN number. If the area doesn't exist, or its file can't be read, a nullptr is returned.
+		// if the area was left recently (see releaseArea()), the same area is returned. If the area was preloaded, the preloaded data is used, waiting for it if it isn't done yet.
 		static world::Area * getArea(std::string & AIN);
 
+		// hands back an area that's no longer being used. The area is kept so that it can be reused by getArea(), and is deleted once too many areas are kept.
+		// the area has to have been put in a scene (see world::Area::getAsSingleNode()); if it wasn't, it's deleted.
+		static void releaseArea(world::Area * area);
+
+		// deletes all of the areas that are being kept.
+		static void clearAreas();
+
+		// sets how much memory the kept areas can use, in bytes.
+		static void setAreaMemoryBudget(size_t memoryBudget);
+
+		// returns 'true' if the area is being kept (i.e. getArea() will reuse it).
+		static bool isAreaLive(std::string AIN);
+
+		// returns 'true' if there's an area file for the AIN number. The area isn't loaded.
+		static bool areaExists(std::string & AIN);
+
+		// starts reading an area on another thread so that it's ready when getArea() is called for it. If the area is already being preloaded, nothing happens.
+		static void preloadArea(std::string AIN);
+
+		// preloads the areas that the area's exits lead to. Any finished preloads for other areas are thrown out.
+		static void preloadExits(const world::Area * area);
+
+		// starts loading the textures of the preloads that have finished reading. This has to be called from the main thread (e.g. once per frame).
+		static void updatePreloads();
+
+		// throws out all of the preloads, waiting for any that are still being read.
+		static void clearPreloads();
+
+		// returns 'true' if the area is being preloaded, or has been preloaded.
+		static bool isPreloading(std::string AIN);
+
+		// the folder the area files are in, inside of the Resources folder.
+		static const std::string AREA_FOLDER;
+
+		// the extension of the area cache files, which are saved in the writable path.
+		static const std::string CACHE_EXTENSION;
+
+	private:
+		// an area that has been read, but hasn't been made yet. This doesn't have any cocos objects in it, so it can be made on any thread.
+		struct PreparedArea
+		{
+			std::string filePath = ""; // the area's file.
+			std::string cachePath = ""; // the area's cache file.
+			uint64_t sourceHash = 0; // the hash of the area's file.
+
+			bool valid = false; // 'true' if the area could be read.
+			std::shared_ptr<world::AreaCache> cache; // the area's cache, if it was up to date.
+			world::AreaData data; // the values read from the area's file, if the cache couldn't be used.
+
+			std::vector<std::string> textures; // the images the area might use, which are loaded before the area is made.
+		};
+
+		// an area being read on another thread.
+		struct Preload
+		{
+			std::future<PreparedArea> future; // the area being read.
+			PreparedArea prepared; // the area once it has been read.
+			bool ready = false; // becomes 'true' once the area has been read, and its textures have been requested.
+		};
+
+		// gets the path of the area file for an AIN number. If the AIN number is invalid, an empty string is returned.
+		static std::string getAreaFile(std::string & AIN);
+
+		// reads an area's file (or its cache) without making anything. The paths have to be full paths, since this can run on another thread.
+		static PreparedArea prepareArea(std::string filePath, std::string fullPath, std::string cachePath);
+
+		// makes an area from what was read, and saves a new cache if the cache wasn't used. This has to be called from the main thread.
+		static world::Area * buildArea(PreparedArea & prepared);
+
+		// starts preparing an area. If the area isn't valid, the preload isn't started, and 'false' is returned.
+		static bool startPreload(std::string & AIN);
+
+		static std::map<std::string, Preload> preloads; // the areas being preloaded, using their AIN numbers (AIN_###) as keys.
+		static world::LiveAreaCache liveAreas; // the areas that have been left, using their AIN numbers (AIN_###) as keys.
 	};
 }
-
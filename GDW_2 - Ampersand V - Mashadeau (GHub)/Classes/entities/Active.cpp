@@ -113,4 +113,22 @@ void entity::Active::update(float deltaTime)
 		projectiles.at(i)->update(deltaTime);
 
 	Entity::update(deltaTime); // calls the entity update loop.
+}
+
+// the cheaper update loop for active entities
+void entity::Active::updateCoarse(float deltaTime)
+{
+	if (invincible) // the invincibility still runs out while the entity can't be seen.
+	{
+		inviTime += deltaTime;
+
+		if (inviTime >= inviTimeMax)
+		{
+			setOpacity(1.0F);
+			inviTime = 0.0F;
+			invincible = false;
+		}
+	}
+
+	Entity::updateCoarse(deltaTime);
 }
\ No newline at end of file
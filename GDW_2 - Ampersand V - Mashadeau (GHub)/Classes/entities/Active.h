@@ -66,6 +66,9 @@ namespace entity
 		// the update loop for the active entity.
 		void update(float deltaTime);
 
+		// the cheaper update for the active entity. The invincibility still runs out, but the sprite doesn't flash, and the projectiles aren't updated.
+		void updateCoarse(float deltaTime);
+
 	private:
 		float health; // the entity's health
 		
@@ -98,9 +98,9 @@ void entity::Enemy::createEnemy(unsigned int EIN, char letter)
 
 	for (OOP::Primitive * colShape : collisionBodies) // adds all of the collision shapes to the sprite.
 	{
-		colShape->getPrimitive()->setGlobalZOrder(10.1F);
-		colShape->getPrimitive()->setVisible(shapesVisible);
-		sprite->addChild(colShape->getPrimitive());
+		colShape->setGlobalZOrder(10.1F);
+		colShape->setParent(sprite);
+		colShape->setVisible(shapesVisible); // the drawNode is only made if the shapes are visible.
 	}
 }
 
@@ -108,8 +108,23 @@ void entity::Enemy::createEnemy(unsigned int EIN, char letter)
 void entity::Enemy::update(float deltaTime)
 {
 	// setHealth(getHealth() - 1);
-	addForce(Vec2(moveForce.x * (moveRight) ? 1 : -1, moveForce.y * (moveUp) ? 1 : -1)); // adds to the force of the entity
+	addMoveForce(); // adds to the force of the entity
 	Active::update(deltaTime); // calls the 'Active' update loop
 
 	
+}
+
+// the cheaper update loop
+void entity::Enemy::updateCoarse(float deltaTime)
+{
+	addMoveForce(); // the same force as the full update, so the enemy moves the same way.
+	Active::updateCoarse(deltaTime);
+}
+
+// adds the enemy's movement force.
+void entity::Enemy::addMoveForce()
+{
+	// this was written as 'moveForce.x * (moveRight) ? 1 : -1', which multiplies before checking, so each axis is 1 if 'moveRight' (or 'moveUp') is set and the force isn't 0, and -1 otherwise.
+	// the enemies were made with this movement, so it's kept. The areas keep the off screen enemies from drifting out of the area because of it (see world::Area::keepInBounds()).
+	addForce(Vec2((moveForce.x * moveRight != 0.0F) ? 1.0F : -1.0F, (moveForce.y * moveUp != 0.0F) ? 1.0F : -1.0F));
 }
\ No newline at end of file
@@ -19,6 +19,21 @@ namespace entity
 		// the update loop
 		void update(float deltaTime);
 
+		// the cheaper update loop, which is used for enemies that are far from the view (see world::Area::cull()).
+		void updateCoarse(float deltaTime);
+
+		// how often the enemy is updated, based on how far it is from the view (see world::Area::cull()).
+		enum UpdateTier
+		{
+			nearTier, // updated every physics step, and checked for collisions.
+			midTier, // updated every few physics steps, a few enemies at a time.
+			farTier // given a coarse update every so often.
+		};
+
+		UpdateTier updateTier = farTier; // how often the enemy is being updated.
+		unsigned int updateSlot = 0; // decides which physics step the enemy is updated on when it's in the middle tier. This is set by the area.
+		unsigned int lastUpdateStep = 0; // the area update the enemy was last updated on. When the enemy is updated, it's given all of the time since then.
+
 		// variable used for copying the enemy in the upward direction.
 		const unsigned int COPY_UP = 0;
 		// variable used for copying the enemy in the rightward direction.
@@ -41,6 +56,9 @@ namespace entity
 		// called to create an Enemy and give it initial values.
 		void createEnemy(unsigned int EIN, char letter);
 
+		// adds the enemy's movement force. This is shared by the full and the coarse update.
+		void addMoveForce();
+
 		// setting the EIN value of the enemy
 		unsigned int EIN;
 		// setting the letter for the enemy
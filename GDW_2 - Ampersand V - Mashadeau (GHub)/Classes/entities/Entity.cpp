@@ -1,8 +1,13 @@
 #include "entities/Entity.h"
 #include "Utilities.h"
+#include "TextureAtlas.h"
 
 float * entity::Entity::areaGravity = new float(1.0F); // the default level of gravity for all entities.
+entity::PhysicsStore * entity::Entity::physics = new entity::PhysicsStore(); // the physics bodies of all entities.
 bool entity::Entity::shapesVisible = false; // change this to 'false' to hide all collision shapes from view.
+unsigned int entity::Entity::collisionFrame = 1; // the current collision frame.
+const float entity::Entity::REFERENCE_RATE = 60.0F; // the movement values were made when the game updated once per frame at 60 fps.
+unsigned int entity::Entity::collisionAllocations = 0; // the number of allocations made by the collision path.
 
 const Color4F entity::Entity::CLR_ATK = Color4F::RED; // colour used for attacking collision shapes (i.e. these deal damage)
 const Color4F entity::Entity::CLR_DEF = Color4F::BLUE; // colour used for defensive collision shapes (i.e. these take damage)
@@ -11,8 +16,10 @@ const Color4F entity::Entity::CLR_NEU = Color4F::GREEN; // colour used when two
 
 entity::Entity::Entity(std::string texture, float globalZOrder) : sprite(Sprite::create())
 {
+	body.index = physics->addBody(this);
 	imagePath = texture;
-	sprite->setTexture(texture);
+	textureOrigin = OOP::TextureAtlas::getOrigin(texture);
+	OOP::TextureAtlas::setTexture(sprite, texture); // uses the image's atlas if it's in one.
 	sprite->setAnchorPoint(Vec2(0.5, 0.5)); // anchour point is the middle of the sprite
 	sprite->setGlobalZOrder(globalZOrder); // setting the global z order
 	sprite->setTag(entity);
@@ -22,13 +29,13 @@ entity::Entity::Entity(std::string texture, float globalZOrder) : sprite(Sprite:
 entity::Entity::~Entity() 
 {
 	for (OOP::Primitive * p : collisionBodies) // removing all of the primitives from their parents
-		p->getPrimitive()->removeFromParent();
+		p->removeFromParent();
 
 	collisionBodies.clear();
 
 	sprite->removeFromParent();
 	
-	
+	physics->removeBody(body);
 }
 
 // returns the length of time the entity has existed for.
@@ -60,7 +67,14 @@ void entity::Entity::setTag(entity::etag tag) { sprite->setTag((int)tag); }
 Sprite * entity::Entity::getSprite() const { return sprite; }
 
 // sets the entity's sprite
-void entity::Entity::setSprite(Sprite * sprite) { this->sprite = sprite; }
+void entity::Entity::setSprite(Sprite * sprite)
+{
+	this->sprite = sprite;
+
+	// the body moves to where the new sprite is.
+	physics->positionX[body] = sprite->getPositionX();
+	physics->positionY[body] = sprite->getPositionY();
+}
 
 // returns the sprite's texture (image)
 Texture2D * entity::Entity::getTexture() const { return sprite->getTexture(); }
@@ -68,17 +82,21 @@ Texture2D * entity::Entity::getTexture() const { return sprite->getTexture(); }
 // sets the entity's texture via an image path
 void entity::Entity::setTexture(std::string image) {
 	imagePath = image;
-	sprite->setTexture(image);
+	textureOrigin = OOP::TextureAtlas::getOrigin(image);
+	OOP::TextureAtlas::setTexture(sprite, image); // uses the image's atlas if it's in one.
+
+	for (OOP::SpriteSheetAnimation * animation : animations) // the animation frames are inside of the image, so they have to be moved with it.
+		animation->setTextureOrigin(textureOrigin);
 }
 
 // gets the texture file path.
 std::string entity::Entity::getTextureFilePath() const { return imagePath; }
 
 // returns hte texture rect used to crop the sprite's image
-Rect entity::Entity::getTextureRect() const { return sprite->getTextureRect(); }
+Rect entity::Entity::getTextureRect() const { return Rect(sprite->getTextureRect().origin - textureOrigin, sprite->getTextureRect().size); }
 
 // sets the textureRect (cropped area) for the sprite
-void entity::Entity::setTextureRect(Rect textureRect) { sprite->setTextureRect(textureRect); }
+void entity::Entity::setTextureRect(Rect textureRect) { sprite->setTextureRect(Rect(textureRect.origin + textureOrigin, textureRect.size)); }
 
 // sets the textureRect(cropped area) for the sprite
 void entity::Entity::setTextureRect(float x, float y, float width, float height, const bool USE_CENTRE)
@@ -101,7 +119,19 @@ void entity::Entity::setMagicType(magic::magic_t magicType) { this->magicType =
 void entity::Entity::setMagicType(magic::MagicType newMagic) { magicType = newMagic; }
 
 // sets the entity's position. While all sprite children move with the sprite, their positions don't change (i.e. getPosition() for them would return the same value).
-void entity::Entity::setPosition(Vec2 newPos)  { sprite->setPosition(newPos); }
+// if the sprite is interpolated, the new position replaces the actual position, and the entity doesn't move smoothly to it (e.g. when respawning).
+void entity::Entity::setPosition(Vec2 newPos)
+{
+	if (interpolated)
+	{
+		interpolated = false;
+		previousPosition = newPos;
+	}
+
+	physics->positionX[body] = newPos.x;
+	physics->positionY[body] = newPos.y;
+	sprite->setPosition(newPos);
+}
 
 // sets the entity's position
 void entity::Entity::setPosition(float x, float y) { setPosition(Vec2(x, y)); }
@@ -223,62 +253,77 @@ void entity::Entity::setOpacity(float opacity)
 }
 
 // returns the mass of the entity
-float entity::Entity::getMass() const { return mass; }
+float entity::Entity::getMass() const { return physics->mass[body]; }
 
 // sets the mass of the entity; can't be below or equal to 0.
-void entity::Entity::setMass(float mass) { (mass > 0.0F) ? this->mass = mass : this->mass; }
+void entity::Entity::setMass(float mass) { (mass > 0.0F) ? physics->mass[body] = mass : physics->mass[body]; }
 
 // returns the force on both axes
-Vec2 entity::Entity::getForce() const { return force; }
+Vec2 entity::Entity::getForce() const { return Vec2(physics->forceX[body], physics->forceY[body]); }
 
 // returns the force on the x-axis
-float entity::Entity::getForceX() const { return force.x; }
+float entity::Entity::getForceX() const { return physics->forceX[body]; }
 
 // returns the force on the y-axis
-float entity::Entity::getForceY() const { return force.y; }
+float entity::Entity::getForceY() const { return physics->forceY[body]; }
 
 // sets the force for both axes
-void entity::Entity::setForce(Vec2 force) { this->force = force; }
+void entity::Entity::setForce(Vec2 force)
+{
+	physics->forceX[body] = force.x;
+	physics->forceY[body] = force.y;
+}
 
 // sets the force for both axes
 void entity::Entity::setForce(float x, float y) { setForce(Vec2(x, y)); }
 
 // adds to the entity's current force
-void entity::Entity::addForce(Vec2 force) { this->force += force; }
+void entity::Entity::addForce(Vec2 force)
+{
+	physics->forceX[body] += force.x;
+	physics->forceY[body] += force.y;
+}
 
 // adds to the entity's current force
-void entity::Entity::addForce(float forceX, float forceY) { force += Vec2(forceX, forceY); }
+void entity::Entity::addForce(float forceX, float forceY) { addForce(Vec2(forceX, forceY)); }
 
 // states whether acceleration gets rotated or not.
-bool entity::Entity::getRotateAcceleration() const { return rotateAccel; }
+bool entity::Entity::getRotateAcceleration() const { return physics->rotateAcceleration[body] != 0; }
 
 // sets whether to rotate the acceleration or not.
-void entity::Entity::setRotateAcceleration(bool rAccel) { rotateAccel = rAccel; }
+void entity::Entity::setRotateAcceleration(bool rAccel) { physics->rotateAcceleration[body] = rAccel; }
 
 // gets the current velocity of the entity.
-Vec2 entity::Entity::getVelocity() { return velocity; }
+Vec2 entity::Entity::getVelocity() { return Vec2(physics->velocityX[body], physics->velocityY[body]); }
 
 // sets the entity's velocity to 0.
 void entity::Entity::zeroVelocity() { setVelocity(Vec2(0.0F, 0.0F)); }
 
 // sets the velocity of the entity.
-void entity::Entity::setVelocity(Vec2 velocity) { this->velocity = velocity; }
+void entity::Entity::setVelocity(Vec2 velocity)
+{
+	physics->velocityX[body] = velocity.x;
+	physics->velocityY[body] = velocity.y;
+}
 
 // zeroes out the entity's's velocity on the x-axis.
-void entity::Entity::zeroVelocityX() { setVelocity(Vec2(0.0F, velocity.y)); }
+void entity::Entity::zeroVelocityX() { physics->velocityX[body] = 0.0F; }
 
 // zeroes out the entity's velocity on the y-axis.
-void entity::Entity::zeroVelocityY() { setVelocity(Vec2(velocity.x, 0.0F)); }
+void entity::Entity::zeroVelocityY() { physics->velocityY[body] = 0.0F; }
 
 // gets the maixmum velocity of the entity
-Vec2 entity::Entity::getMaxVelocity() { return maxVelocity; }
+Vec2 entity::Entity::getMaxVelocity() { return Vec2(physics->maxVelocityX[body], physics->maxVelocityY[body]); }
 
 // sets the maximum velocity; it cannot be below 0.
 void entity::Entity::setMaxVelocity(Vec2 maxVelocity)
 {
 	// sets the maximum velocity of the entity. Comparisons use the absolute value of the entity, hence why it must be above 0.
 	if (maxVelocity > Vec2(0.0F, 0.0F))
-		this->maxVelocity = maxVelocity;
+	{
+		physics->maxVelocityX[body] = maxVelocity.x;
+		physics->maxVelocityY[body] = maxVelocity.y;
+	}
 }
 
 // gets rotation factor in degrees, which is what it's stored as.
@@ -296,18 +341,21 @@ void entity::Entity::setRotationInRadians(float theta) { sprite->setRotation(uma
 
 
 // returns the deceleration rate of the entity.
-Vec2 entity::Entity::getDecelerate() const { return decelerate; }
+Vec2 entity::Entity::getDecelerate() const { return Vec2(physics->decelerateX[body], physics->decelerateY[body]); }
 
 // sets the deceleration rate of the entity. This should be less than 1 but greater than 0.
 void entity::Entity::setDecelerate(Vec2 decelerate)
 {
 	// if the deceleration rate passed is greater than 0, and less than 1.0 (since this would cause no deceleration).
 	if ((decelerate.x > 0.0F && decelerate.x < 1.0F) && (decelerate.y > 0.0F && decelerate.y < 1.0F))
-		this->decelerate = decelerate;
+	{
+		physics->decelerateX[body] = decelerate.x;
+		physics->decelerateY[body] = decelerate.y;
+	}
 }
 
 // returns at what point the entity comes to a complete stop.
-Vec2 entity::Entity::getForceStop() const { return forceStop; }
+Vec2 entity::Entity::getForceStop() const { return Vec2(physics->forceStopX[body], physics->forceStopY[body]); }
 
 // sets the threshold the entity's velocity must pass (i.e. value the entity's velocity must fall below) to be brought into a complete stop.
 void entity::Entity::setForceStop(Vec2 forceStop)
@@ -315,20 +363,23 @@ void entity::Entity::setForceStop(Vec2 forceStop)
 	// the provided forceStop must be greater than 0.0F, since a value cannot be divided to become 0.
 	// forceStop must also be positive, as it uses the absolute value of the entity's velocity to check if they're below 'forceStop' or not.
 	if (forceStop.x > 0.0F && forceStop.y > 0.0F)
-		this->forceStop = forceStop;
+	{
+		physics->forceStopX[body] = forceStop.x;
+		physics->forceStopY[body] = forceStop.y;
+	}
 }
 
 // returns whether the entity has a constant velocity or not.
-bool entity::Entity::getConstVelocity() const { return constVelocity; }
+bool entity::Entity::getConstVelocity() const { return physics->constVelocity[body] != 0; }
 
 // returns the current bool of 'anti gravity', which determines if the entity is affected by gravity or not.
-bool entity::Entity::getAntiGravity() const { return antiGravity; }
+bool entity::Entity::getAntiGravity() const { return physics->antiGravity[body] != 0; }
 
 // sets whether the entity has anti gravity or not.
-void entity::Entity::setAntiGravity(float antiGravity) { this->antiGravity = antiGravity; }
+void entity::Entity::setAntiGravity(float antiGravity) { physics->antiGravity[body] = (antiGravity != 0.0F); }
 
 // toggles anti gravity on/off.
-void entity::Entity::setAntiGravity() { antiGravity = !antiGravity; }
+void entity::Entity::setAntiGravity() { physics->antiGravity[body] = !physics->antiGravity[body]; }
 
 
 
@@ -340,13 +391,14 @@ std::vector<OOP::Primitive*> entity::Entity::getCollisionBodies() const { return
 void entity::Entity::setCollisionBodies(std::vector<OOP::Primitive*>& colBodies)
 {
 	for (OOP::Primitive * p : collisionBodies) // removes all of the primitives from the current sprite.
-		p->getPrimitive()->removeFromParent();
+		p->removeFromParent();
 
 	collisionBodies.erase(collisionBodies.begin(), collisionBodies.end() + 1); // removes the information in the vector.
 	collisionBodies = colBodies; // saves the new values.
+	worldBodiesFrame = 0; // the cached world bodies are now out of date.
 
 	for (OOP::Primitive * p : collisionBodies) // adds all of the new primitives to the sprite.
-		sprite->addChild(p->getPrimitive());
+		p->setParent(sprite);
 }
 
 // gets collision bodies offset by the sprite's position in the scene (or just whatever the sprite is relative to)
@@ -367,21 +419,25 @@ std::vector<OOP::Primitive*> entity::Entity::getOffsetCollisionBodies(const coco
 		switch (ePrim->getId())
 		{
 		case 1: // Square (AABB)
+			collisionAllocations++;
 			newPrims.push_back(new OOP::PrimitiveSquare(eBl + ((OOP::PrimitiveSquare *)ePrim)->getPosition(), ((OOP::PrimitiveSquare *)ePrim)->m_WIDTH, ((OOP::PrimitiveSquare *)ePrim)->m_HEIGHT));
 			added = true;
 			break;
 
 		case 2: // Square (OBB)
+			collisionAllocations++;
 			newPrims.push_back(new OOP::PrimitiveOrientedSquare(eBl + ((OOP::PrimitiveOrientedSquare *)ePrim)->getPosition(), ((OOP::PrimitiveOrientedSquare *) ePrim)->m_WIDTH, ((OOP::PrimitiveOrientedSquare *) ePrim)->m_HEIGHT));
 			added = true;
 			break;
 
 		case 3: // Circle
+			collisionAllocations++;
 			newPrims.push_back(new OOP::PrimitiveCircle(Vec2(eBl.x + ((OOP::PrimitiveCircle *)ePrim)->getPosition().x, eBl.y + ((OOP::PrimitiveCircle *)ePrim)->getPosition().y), ((OOP::PrimitiveCircle *)ePrim)->m_RADIUS));
 			added = true;
 			break;
 
 		case 5: // Capsule
+			collisionAllocations++;
 			newPrims.push_back(new OOP::PrimitiveCapsule(eBl + ((OOP::PrimitiveCapsule *) ePrim)->getPosition(), ((OOP::PrimitiveCapsule *) ePrim)->m_RECT_WIDTH, ((OOP::PrimitiveCapsule *) ePrim)->m_RECT_HEIGHT / 2, ((OOP::PrimitiveCapsule *) ePrim)->getRotationInDegrees()));
 			added = true;
 			break;
@@ -394,17 +450,111 @@ std::vector<OOP::Primitive*> entity::Entity::getOffsetCollisionBodies(const coco
 	return newPrims;
 }
 
+// gets the world collision bodies using the entity's own sprite.
+const std::vector<OOP::WorldShape> & entity::Entity::getWorldCollisionBodies() { return getWorldCollisionBodies(sprite); }
+
+// gets the world collision bodies. The shapes are only recomputed if this is a new collision frame, or if the sprite has moved since they were last computed.
+const std::vector<OOP::WorldShape> & entity::Entity::getWorldCollisionBodies(const cocos2d::Sprite * spr)
+{
+	OOP::WorldShape shape; // the shape being filled in.
+	size_t capacity = worldBodies.capacity(); // used to check if the vector needed to allocate more space.
+
+	// the bottom left-hand corner of the sprite, which is what the positions of the collision bodies are relative to.
+	Vec2 eBl(spr->getPositionX() - spr->getTextureRect().size.width / 2, spr->getPositionY() - spr->getTextureRect().size.height / 2);
+
+	if (worldBodiesFrame == collisionFrame && worldBodiesOrigin == eBl) // the cached shapes are still valid.
+		return worldBodies;
+
+	worldBodies.clear(); // clear() keeps the capacity, so refilling the vector doesn't allocate.
+
+	if (worldBodies.capacity() < collisionBodies.size())
+		worldBodies.reserve(collisionBodies.size());
+
+	for (OOP::Primitive * prim : collisionBodies)
+	{
+		if (prim != nullptr && prim->getWorldShape(eBl, shape)) // lines and grids don't have world shapes, so they're skipped.
+			worldBodies.push_back(shape);
+	}
+
+	if (worldBodies.capacity() != capacity) // the vector had to grow.
+		collisionAllocations++;
+
+	worldBodiesOrigin = eBl;
+	worldBodiesFrame = collisionFrame;
+
+	return worldBodies;
+}
+
+// gets a box surrounding the sprite and the collision bodies.
+OOP::AABB entity::Entity::getWorldBounds()
+{
+	OOP::AABB bounds; // the box surrounding the entity.
+	OOP::AABB shapeBounds; // the box surrounding the current shape.
+
+	// the sprite's area is used as the starting bounds.
+	bounds.min = Vec2(sprite->getPositionX() - sprite->getTextureRect().size.width / 2, sprite->getPositionY() - sprite->getTextureRect().size.height / 2);
+	bounds.max = Vec2(sprite->getPositionX() + sprite->getTextureRect().size.width / 2, sprite->getPositionY() + sprite->getTextureRect().size.height / 2);
+
+	for (const OOP::WorldShape & shape : getWorldCollisionBodies()) // expands the bounds to fit every collision body.
+	{
+		shapeBounds = shape.getBounds();
+
+		bounds.min.x = std::min(bounds.min.x, shapeBounds.min.x);
+		bounds.min.y = std::min(bounds.min.y, shapeBounds.min.y);
+		bounds.max.x = std::max(bounds.max.x, shapeBounds.max.x);
+		bounds.max.y = std::max(bounds.max.y, shapeBounds.max.y);
+	}
+
+	return bounds;
+}
+
+// gets a box surrounding the active collision bodies.
+bool entity::Entity::getCollisionBounds(OOP::AABB & bounds)
+{
+	OOP::AABB shapeBounds; // the box surrounding the current shape.
+	bool found = false; // becomes 'true' once an active body has been found.
+
+	for (const OOP::WorldShape & shape : getWorldCollisionBodies())
+	{
+		if (shape.source->isActive() == false)
+			continue;
+
+		shapeBounds = shape.getBounds();
+
+		if (found == false) // the first body is used as the starting bounds.
+		{
+			bounds = shapeBounds;
+			found = true;
+			continue;
+		}
+
+		bounds.min.x = std::min(bounds.min.x, shapeBounds.min.x);
+		bounds.min.y = std::min(bounds.min.y, shapeBounds.min.y);
+		bounds.max.x = std::max(bounds.max.x, shapeBounds.max.x);
+		bounds.max.y = std::max(bounds.max.y, shapeBounds.max.y);
+	}
+
+	return found;
+}
+
+// moves onto the next collision frame. '0' is skipped since it's used to mark an empty cache.
+void entity::Entity::nextCollisionFrame() { collisionFrame = (collisionFrame + 1 == 0) ? 1 : collisionFrame + 1; }
+
+// gets the number of allocations made by the collision path.
+unsigned int entity::Entity::getCollisionAllocations() { return collisionAllocations; }
+
 // adds a collision body to the vector
 void entity::Entity::addCollisionBody(OOP::Primitive * prim)
 {
 	// if it's already in the vector, it won't be added again.
-	for each(OOP::Primitive * p in collisionBodies)
+	for (OOP::Primitive * p : collisionBodies)
 	{
 		if (p == prim)
 			return;
 	}
 
 	collisionBodies.push_back(prim);
+	worldBodiesFrame = 0; // the cached world bodies are now out of date.
 }
 
 // removes a collision body from the vector
@@ -416,6 +566,7 @@ void entity::Entity::removeCollisionBody(OOP::Primitive * prim)
 		if (collisionBodies.at(i) == prim) // removes the primitive.
 		{
 			collisionBodies.erase(collisionBodies.begin() + i);
+			worldBodiesFrame = 0; // the cached world bodies are now out of date.
 			return;
 		}
 	}
@@ -461,7 +612,115 @@ bool entity::Entity::collision(std::vector<OOP::Primitive*>& cols1, std::vector<
 bool entity::Entity::collision(entity::Entity * e2) { return collision(this, e2); }
 
 // checks for collisions using collision bodies
-bool entity::Entity::collision(entity::Entity * e1, entity::Entity * e2) { return collision(e1, e1->getOffsetCollisionBodies(), e2, e2->getOffsetCollisionBodies()); }
+// the world bodies are cached per frame, so this doesn't allocate anything.
+bool entity::Entity::collision(entity::Entity * e1, entity::Entity * e2)
+{
+	if (e1 == nullptr || e2 == nullptr) // if either one is null, then a 'false' is returned.
+		return false;
+
+	return collision(e1, e1->getWorldCollisionBodies(), e2, e2->getWorldCollisionBodies());
+}
+
+// checks for collisions using two entities and their world space shapes.
+bool entity::Entity::collision(entity::Entity * e1, const std::vector<OOP::WorldShape> & e1Bodies, entity::Entity * e2, const std::vector<OOP::WorldShape> & e2Bodies)
+{
+	if (e1 == nullptr || e2 == nullptr) // if either one is null, then a 'false' is returned.
+		return false;
+
+	for (const OOP::WorldShape & e1Shape : e1Bodies)
+	{
+		if (e1Shape.source->isActive() == false) // if the primitive is inactive (i.e. the collision has been turned off), it moves onto the next one.
+			continue;
+
+		for (const OOP::WorldShape & e2Shape : e2Bodies)
+		{
+			if (e2Shape.source->isActive() == false) // if the primitive is inactive, it moves onto the next one.
+				continue;
+
+			if (OOP::WorldShape::collision(e1Shape, e2Shape)) // if the two shapes have collided.
+			{
+				e1->collidedPrimitive = (OOP::Primitive *)e1Shape.source;
+				e2->collidedPrimitive = (OOP::Primitive *)e2Shape.source;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// checks for collision between an entity and a shape in the game world.
+bool entity::Entity::collision(entity::Entity * e1, const OOP::WorldShape & shape)
+{
+	if (e1 == nullptr || shape.source->isActive() == false)
+		return false;
+
+	for (const OOP::WorldShape & e1Shape : e1->getWorldCollisionBodies())
+	{
+		if (e1Shape.source->isActive() == false) // if the primitive is inactive, it moves onto the next one.
+			continue;
+
+		if (OOP::WorldShape::collision(e1Shape, shape))
+		{
+			e1->collidedPrimitive = (OOP::Primitive *)e1Shape.source;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// checks for collision between an entity and a shape, and gets the deepest contact.
+bool entity::Entity::collision(entity::Entity * e1, const OOP::WorldShape & shape, OOP::Contact & contact)
+{
+	OOP::Contact bodyContact; // the contact for the current body.
+	bool col = false;
+
+	if (e1 == nullptr || shape.source->isActive() == false)
+		return false;
+
+	for (const OOP::WorldShape & e1Shape : e1->getWorldCollisionBodies())
+	{
+		if (e1Shape.source->isActive() == false) // if the primitive is inactive, it moves onto the next one.
+			continue;
+
+		if (OOP::WorldShape::collision(e1Shape, shape, bodyContact) && (col == false || bodyContact.depth > contact.depth))
+		{
+			contact = bodyContact;
+			e1->collidedPrimitive = (OOP::Primitive *)e1Shape.source;
+			col = true;
+		}
+	}
+
+	return col;
+}
+
+// checks for collision between two entities, and gets the deepest contact.
+bool entity::Entity::collision(entity::Entity * e1, entity::Entity * e2, OOP::Contact & contact)
+{
+	OOP::Contact shapeContact; // the contact for the current shape of e2.
+	OOP::Primitive * e1Prim = nullptr; // the body of e1 with the deepest contact. e1's collided primitive gets changed by every shape that collides, so it's set at the end.
+	bool col = false;
+
+	if (e1 == nullptr || e2 == nullptr)
+		return false;
+
+	for (const OOP::WorldShape & e2Shape : e2->getWorldCollisionBodies())
+	{
+		if (collision(e1, e2Shape, shapeContact) && (col == false || shapeContact.depth > contact.depth))
+		{
+			contact = shapeContact;
+			e1Prim = e1->collidedPrimitive;
+			e2->collidedPrimitive = (OOP::Primitive *)e2Shape.source;
+			col = true;
+		}
+	}
+
+	if (col)
+		e1->collidedPrimitive = e1Prim;
+
+	return col;
+}
 
 // checks for collisions using two entites and passed collision vectors
 bool entity::Entity::collision(entity::Entity * e1, const std::vector<OOP::Primitive *> & e1Bodies, entity::Entity * e2, const std::vector<OOP::Primitive *> & e2Bodies)
@@ -493,12 +752,12 @@ bool entity::Entity::collision(entity::Entity * e1, const std::vector<OOP::Primi
 	OOP::PrimitiveCapsule * tempCap1 = nullptr; // temporary capsule pointer for e1
 	OOP::PrimitiveCapsule * tempCap2 = nullptr; // temporary capsule pointer for e2
 
-	for each(OOP::Primitive * e1Prim in e1Bodies)
+	for (OOP::Primitive * e1Prim : e1Bodies)
 	{
 		if (e1Prim == nullptr || e1Prim->isActive() == false) // if the primitive is inactive (i.e. the collision has been turned off), it moves onto the next one.
 			continue;
 
-		for each(OOP::Primitive * e2Prim in e2Bodies)
+		for (OOP::Primitive * e2Prim : e2Bodies)
 		{
 			if (e2Prim == nullptr || e2Prim->isActive() == false) // if the primitive is inactive (i.e. the collision has been turned off), it moves onto the next one.
 				continue;
@@ -722,6 +981,7 @@ OOP::SpriteSheetAnimation * entity::Entity::getCurrentAnimation() { return curre
 // adds an animation to the entity, and returns the index of said animation.
 void entity::Entity::addAnimation(OOP::SpriteSheetAnimation * newAnimation)
 {
+	newAnimation->setTextureOrigin(textureOrigin); // the frames are moved to where the image is in the texture.
 	animations.push_back(newAnimation);
 }
 
@@ -760,10 +1020,10 @@ void entity::Entity::runAnimationByTag(int tag)
 bool entity::Entity::runningAnimation() { return currentAnimation->isRunning(); }
 
 // sets whether the entity has a constant velocity (i.e. the velocity is either '0', or some value) or not.
-void entity::Entity::setConstVelocity(bool constVelocity) { this->constVelocity = constVelocity; }
+void entity::Entity::setConstVelocity(bool constVelocity) { physics->constVelocity[body] = constVelocity; }
 
 // toggles the 'constVelocity' variable.
-void entity::Entity::setConstVelocity() { setConstVelocity(!constVelocity); }
+void entity::Entity::setConstVelocity() { setConstVelocity(!getConstVelocity()); }
 
 
 
@@ -771,59 +1031,57 @@ void entity::Entity::setConstVelocity() { setConstVelocity(!constVelocity); }
 // Update Loop
 void entity::Entity::update(float deltaTime)
 {
-	Vec2 position = getPosition(); // gets the entity's current position
-	Vec2 acceleration; // the enemy's current acceleration
-
-	acceleration = force / mass; // gets the force to be applied, divided by the entity's mass.
-
-	if (rotateAccel) // rotates the acceleration.
-		acceleration = umath::rotate(acceleration, sprite->getRotation(), true);
+	integrate(deltaTime); // moves the entity.
 
-	if(antiGravity == false)  // applies gravity to the entity if anti gravity is turned off.
-		acceleration.y -= *areaGravity / mass;
-
-	velocity += acceleration * deltaTime; // adds the acceleration to the entity's velocity
-	
-	// Capping Velocity (x, y)
-	// if the entity has gone over its maximum velocity, their speed is set to their maximum velocity (x-axis ver.).
-	if (abs(velocity.x * deltaTime) > maxVelocity.x)
-		(velocity.x > 0.0F) ? velocity.x = maxVelocity.x / deltaTime : velocity.x = -maxVelocity.x / deltaTime; // checks the direction of the entity to see whether its new velocity should be positive or negative.
-
-	// if the entity has gone over its maximum velocity, their speed is set to their maximum velocity (y-axis ver.).
-	if (abs(velocity.y * deltaTime) > maxVelocity.y)
-		(velocity.y > 0.0F) ? velocity.y = maxVelocity.y / deltaTime : velocity.y = -maxVelocity.y / deltaTime; // checks the direction of the entity to see whether its new velocity should be positive or negative.
+	// if there is an animation being run, then the update loop is called.
+	if (currentAnimation != nullptr)
+		currentAnimation->update(deltaTime);
 
+	age += deltaTime; // counts how long an entity has existed for.
+}
 
-	// Slowing Down (x, y)
-	// if the entity does NOT have a constant velocity, currently has a non-zero x-velocity, and has no force being applied to it on the x-axis, it starts to slow down.
-	if (velocity.x != 0.0F && force.x == 0.0F)
-		velocity.x *= decelerate.x; // multiplied by the deceleration rate
+// the cheaper update
+void entity::Entity::updateCoarse(float deltaTime)
+{
+	integrate(deltaTime); // moves the entity.
+	age += deltaTime;
+}
 
-	// if the entity does NOT have a constant velocity, currently has a non-zero y-velocity, and has no force being applied to it on the y-axis, it starts to slow down.
-	if (velocity.y != 0.0F && force.y == 0.0F)
-		velocity.y *= decelerate.y; // multiplied by the deceleration rate
+// moves the entity.
+void entity::Entity::integrate(float deltaTime)
+{
+	// the movement itself is done by the physics store, which applies the force, gravity, maximum velocity, deceleration, and force stop to every queued body in one loop.
+	// the sprite's rotation is passed along for entities that rotate their acceleration.
+	physics->queue(body, deltaTime, sprite->getRotation());
+}
 
+// saves the entity's position before it gets updated.
+void entity::Entity::storePreviousPosition()
+{
+	previousPosition = getPosition();
+	previousStored = true;
+}
 
-	// Stopping the Entity (x, y)
-	// if the entity does not have a constant velocity, it has no force being applied, has a non-zero x-velocity, and has fallen below 'forceStop' on the x-axis, its x velocity is set to 0.
-	if (constVelocity == false && force.x == 0.0F && velocity.x != 0.0F && abs(velocity.x * deltaTime) < forceStop.x)
-		velocity.x = 0.0F;
+// gets the position from before the last update.
+Vec2 entity::Entity::getPreviousPosition() const { return previousPosition; }
 
-	// if the entity does not have a constant velocity, it has no force being applied, has a non-zero y-velocity, and has fallen below 'forceStop' on the y-axis, its y velocity is set to 0.
-	if (constVelocity == false && force.y == 0.0F && velocity.y != 0.0F && abs(velocity.y * deltaTime) < forceStop.y)
-		velocity.y = 0.0F;
-	
-	position += velocity * deltaTime; // adds the velocity to the entity's position.
+// moves the sprite to a position between the last two physics steps.
+void entity::Entity::interpolate(float alpha)
+{
+	if (previousStored == false) // the entity hasn't been updated yet, so there's nothing to interpolate from.
+		return;
 
-	setPosition(position); // sets the entity's new position
-	setForce(Vec2(0.0F, 0.0F)); // returns the force back to a value of 0.
+	interpolated = true; // the actual position stays in the entity's body, so only the sprite is moved.
 
-	if (constVelocity) // if the entity has a constant velocity, the velocity is reset to '0', so values don't carry over.
-		velocity = Vec2(0.0F, 0.0F);
+	sprite->setPosition(previousPosition.lerp(Vec2(physics->positionX[body], physics->positionY[body]), clampf(alpha, 0.0F, 1.0F)));
+}
 
-	// if there is an animation being run, then the update loop is called.
-	if (currentAnimation != nullptr)
-		currentAnimation->update(deltaTime);
+// returns the sprite to the entity's actual position.
+void entity::Entity::endInterpolation()
+{
+	if (interpolated == false)
+		return;
 
-	age += deltaTime; // counts how long an entity has existed for.
+	sprite->setPosition(Vec2(physics->positionX[body], physics->positionY[body]));
+	interpolated = false;
 }
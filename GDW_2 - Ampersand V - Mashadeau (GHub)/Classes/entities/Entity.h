@@ -7,6 +7,7 @@
 #include "Primitives.h"
 #include "Utilities.h"
 #include "SpriteAnimation.h"
+#include "entities/PhysicsStore.h"
 #include <iostream>
 using namespace cocos2d;
 
@@ -61,7 +62,7 @@ namespace entity
 		// gets the file path for the texture.
 		std::string getTextureFilePath() const;
 
-		// returns the rectangle used for cropping the texture
+		// returns the rectangle used for cropping the texture. This is inside of the entity's image, even if the image is in an atlas.
 		Rect getTextureRect() const;
 
 		// returns the magic type of the entity; changing the magic type will result in the defaults for that type being used.
@@ -217,6 +218,26 @@ namespace entity
 		//		* Calling this function under these conditions will throw an exception.
 		static std::vector<OOP::Primitive *> getOffsetCollisionBodies(const cocos2d::Sprite * spr, const std::vector<OOP::Primitive *> & prims);
 
+		// returns the collision bodies as world space shapes. These are computed in place from the sprite's position, and are cached until the next collision frame (or until the sprite moves).
+		// unlike getOffsetCollisionBodies(), this doesn't create any new primitives, so nothing is allocated once the cache has been filled for the first time.
+		const std::vector<OOP::WorldShape> & getWorldCollisionBodies();
+
+		// returns the collision bodies as world space shapes, with 'spr' being the sprite the bodies are attached to (e.g. weapons have their bodies attached to their owner's sprite).
+		const std::vector<OOP::WorldShape> & getWorldCollisionBodies(const cocos2d::Sprite * spr);
+
+		// returns an axis-aligned box surrounding the entity's sprite and all of its world collision bodies.
+		OOP::AABB getWorldBounds();
+
+		// gets an axis-aligned box surrounding the entity's active world collision bodies, without the sprite. Returns 'false' if none of the bodies are active.
+		bool getCollisionBounds(OOP::AABB & bounds);
+
+		// moves onto the next collision frame, which makes all of the cached world collision bodies out of date. This should be called once per physics step before the collisions are run.
+		static void nextCollisionFrame();
+
+		// returns how many heap allocations the collision path has made since the game started.
+		// once every entity has had its world collision bodies cached, this number shouldn't go up anymore.
+		static unsigned int getCollisionAllocations();
+
 		// adds a primitive to the collision bodies vector. If it's already in the vector, it won't be added again.
 		void addCollisionBody(OOP::Primitive * prim);
 
@@ -247,6 +268,19 @@ namespace entity
 		// checks for collision between two entities. If the collisionBodies vector isn't the one meant to be used, pass a different set of vectors.
 		static bool collision(entity::Entity * e1, const std::vector<OOP::Primitive *> & e1Bodies, entity::Entity * e2, const std::vector<OOP::Primitive *> & e2Bodies);
 
+		// checks for collision between two entities using world space shapes. The collided primitives are the primitives the shapes came from.
+		static bool collision(entity::Entity * e1, const std::vector<OOP::WorldShape> & e1Bodies, entity::Entity * e2, const std::vector<OOP::WorldShape> & e2Bodies);
+
+		// checks for collision between an entity and a shape that doesn't belong to an entity (e.g. an area's merged collision rectangles). Only the entity's collided primitive is set.
+		static bool collision(entity::Entity * e1, const OOP::WorldShape & shape);
+
+		// checks for collision between an entity and a shape, and gets the deepest contact out of the entity's bodies (see OOP::WorldShape::collision()).
+		// the contact's normal points away from the shape, so the entity gets out of the shape by moving along it. The collided primitive is the body with the deepest contact.
+		static bool collision(entity::Entity * e1, const OOP::WorldShape & shape, OOP::Contact & contact);
+
+		// checks for collision between two entities, and gets the deepest contact out of all of their bodies. The normal points away from 'e2'.
+		static bool collision(entity::Entity * e1, entity::Entity * e2, OOP::Contact & contact);
+
 
 
 		// returns the vector of animations.
@@ -276,12 +310,34 @@ namespace entity
 		// returns 'true' if an animation is currently running, and false otherwise.
 		bool runningAnimation();
 
-		// update loop
+		// update loop. 'deltaTime' should be a fixed physics step (see world::Simulation::PHYSICS_STEP), but the movement works out the same for any step size.
 		virtual void update(float deltaTime);
 
+		// a cheaper update for entities that can't be seen, which is used to catch them up on the time they weren't updated for (see world::Area::cull()). The entity moves the same way, but its animation isn't run.
+		virtual void updateCoarse(float deltaTime);
+
+		// saves the entity's current position as where it was before its next update. This should be called at the start of every physics step the entity is updated in.
+		void storePreviousPosition();
+
+		// gets where the entity was before its last update (see storePreviousPosition()).
+		Vec2 getPreviousPosition() const;
+
+		// moves the sprite part of the way from where the entity was before its last update to where it is now, so that it moves smoothly between physics steps.
+		// 'alpha' is how far along to go (0 to 1). endInterpolation() must be called before the entity is updated again. If the entity is moved in the meantime, the interpolation is dropped.
+		void interpolate(float alpha);
+
+		// puts the sprite back at the entity's actual position after interpolate() was called.
+		void endInterpolation();
+
+		// the update rate (per second) that the maximum velocity, deceleration, and force stop values were made for. These values are scaled for other step sizes.
+		static const float REFERENCE_RATE;
+
 		static float * areaGravity; // saves the level of gravity for the area. This should be shared by all entities.
+
+		// the physics state of all entities. Updating an entity during a batch only queues up its movement, which gets done for every entity at once when the batch is flushed (see world::Area::update()).
+		static entity::PhysicsStore * physics;
 	
-		// the primitive that has recently encountered a collison. The location of this primitive is where it is in the game world overall, NOT where it is relative to the entity.
+		// the primitive that has recently encountered a collison. This is the entity's own primitive, so its location is relative to the entity, NOT where it is in the game world overall.
 		OOP::Primitive * collidedPrimitive;
 
 		// a boolean that toggles on/off hitbox visibility.
@@ -294,21 +350,22 @@ namespace entity
 
 		bool onScreen = true; // becomes 'true' when the entity is on screen, and 'false' when they aren't Used for optimization of collisions and updates.
 
-	private:
-		float mass = 1.0; // the mass of the entity
-		
-		// the velocity of the entity
-		Vec2 velocity = Vec2(0.0f, 0.0f);
-		// the maximum velocity an entity can reach.
-		Vec2 maxVelocity = Vec2(999.0F, 999.0F);
-		
-		// when no force is being applied, the entity slows down by being multiplied by this deceleration rate. This should be less than one.
-		Vec2 decelerate = Vec2(0.85F, 0.85F);
-		// controls at what point the entity comes to a complete stop.
-		Vec2 forceStop = Vec2(0.001F, 0.001F);
+		int treeProxy = -1; // the node holding the entity in an area's AABB tree (see world::AABBTree). If it's '-1', the entity isn't in a tree.
+
+	protected:
+		// applies the force, gravity, and deceleration to the velocity, and moves the entity by it. This is the physics part of the update.
+		// during a batch, the entity is only queued up, and is moved when the batch is flushed (see entity::PhysicsStore).
+		void integrate(float deltaTime);
 
-		// makes it so that the entity goes right to its maximum speed, instead of steadily approaching its max speed.
-		bool constVelocity = false;
+	private:
+		// the entity's body in the physics store, which holds its position, velocity, force, mass, and the rest of its movement values.
+		// the mass starts at 1, the maximum velocity at (999, 999), the deceleration rate at (0.85, 0.85), and the force stop at (0.001, 0.001).
+		// entities can't be copied, since each one needs its own body. Assigning an entity to another copies the physics values over (see entity::BodyHandle).
+		entity::BodyHandle body;
+
+		Vec2 previousPosition; // where the entity was before its last update.
+		bool previousStored = false; // becomes 'true' once the previous position has been saved.
+		bool interpolated = false; // 'true' while the sprite is at an interpolated position. The entity's actual position is still in its body.
 		
 		float age = 0; // gets the length of time the entity has existed for, in milliseconds (delta time)
 
@@ -319,6 +376,17 @@ namespace entity
 		// the image path of the entity. Can be used to create another texture.
 		std::string imagePath = "";
 
+		// where the entity's image is in the sprite's texture. This is only moved from (0, 0) if the image is in an atlas (see OOP::TextureAtlas).
+		// the texture rects used by the entity are inside of its image, so this is added to them before they're given to the sprite.
+		Vec2 textureOrigin = Vec2::ZERO;
+
+		std::vector<OOP::WorldShape> worldBodies; // the cached world space collision bodies.
+		Vec2 worldBodiesOrigin; // the bottom left-hand corner of the sprite the cached bodies were computed from.
+		unsigned int worldBodiesFrame = 0; // the collision frame the cached bodies were computed on. '0' means the cache is empty.
+
+		static unsigned int collisionFrame; // the current collision frame. This starts at '1' so that a new entity's cache is never treated as valid.
+		static unsigned int collisionAllocations; // counts the heap allocations made by the collision path.
+
 	protected:
 		// sets the sprite for the entity
 		void setSprite(Sprite * sprite);
@@ -367,17 +435,9 @@ namespace entity
 
 		OOP::SpriteSheetAnimation * currentAnimation = nullptr; // saves a pointer to the current animation being run.
 
-		Vec2 force = Vec2(0.0f, 0.0f); // the force of the entity
-
-		// rotates the acceleration if 'true'. This uses the 'theta' value.
-		bool rotateAccel = false;
-
 		// holds all physical body collisions. There is an 'ID' that tells you what type is stored there so you can downcast.
 		std::vector<OOP::Primitive * > collisionBodies;
 
-		// used to turn on and off the gravity. If 'antiGravity' is false, then the entity IS affected by gravity. If it's false, then the entity ISN'T effected by gravity.
-		bool antiGravity = false;
-
 	};
 }
 
@@ -0,0 +1,298 @@
+#include "entities/PhysicsStore.h"
+#include "entities/Entity.h"
+#include "Utilities.h"
+
+#include <algorithm>
+
+const entity::PhysicsStore::Handle entity::PhysicsStore::NO_BODY = 0xFFFFFFFF; // the largest handle, which is never given out.
+
+entity::PhysicsStore::PhysicsStore() {}
+
+// adds a body for an entity
+entity::PhysicsStore::Handle entity::PhysicsStore::addBody(entity::Entity * owner)
+{
+	Handle body = 0; // the handle of the new body.
+
+	if (freeBodies.empty()) // there are no removed bodies to reuse, so the arrays get bigger.
+	{
+		body = owners.size();
+
+		positionX.push_back(0.0F);
+		positionY.push_back(0.0F);
+		velocityX.push_back(0.0F);
+		velocityY.push_back(0.0F);
+		forceX.push_back(0.0F);
+		forceY.push_back(0.0F);
+		mass.push_back(0.0F);
+		maxVelocityX.push_back(0.0F);
+		maxVelocityY.push_back(0.0F);
+		decelerateX.push_back(0.0F);
+		decelerateY.push_back(0.0F);
+		forceStopX.push_back(0.0F);
+		forceStopY.push_back(0.0F);
+		constVelocity.push_back(0);
+		antiGravity.push_back(0);
+		rotateAcceleration.push_back(0);
+
+		owners.push_back(nullptr);
+		queued.push_back(0);
+		stepTime.push_back(0.0F);
+		decayX.push_back(1.0F);
+		decayY.push_back(1.0F);
+		rotationCos.push_back(1.0F);
+		rotationSin.push_back(0.0F);
+		nextPositionX.push_back(0.0F);
+		nextPositionY.push_back(0.0F);
+		nextVelocityX.push_back(0.0F);
+		nextVelocityY.push_back(0.0F);
+	}
+	else
+	{
+		body = freeBodies.back();
+		freeBodies.pop_back();
+	}
+
+	// the default physics values.
+	positionX[body] = 0.0F;
+	positionY[body] = 0.0F;
+	velocityX[body] = 0.0F;
+	velocityY[body] = 0.0F;
+	forceX[body] = 0.0F;
+	forceY[body] = 0.0F;
+	mass[body] = 1.0F;
+	maxVelocityX[body] = 999.0F;
+	maxVelocityY[body] = 999.0F;
+	decelerateX[body] = 0.85F;
+	decelerateY[body] = 0.85F;
+	forceStopX[body] = 0.001F;
+	forceStopY[body] = 0.001F;
+	constVelocity[body] = 0;
+	antiGravity[body] = 0;
+	rotateAcceleration[body] = 0;
+
+	owners[body] = owner;
+	queued[body] = 0;
+
+	return body;
+}
+
+// removes a body
+void entity::PhysicsStore::removeBody(Handle body)
+{
+	if (body >= owners.size() || owners[body] == nullptr)
+		return;
+
+	owners[body] = nullptr;
+	queued[body] = 0; // the body is skipped if it was waiting to be integrated.
+	freeBodies.push_back(body);
+}
+
+// copies one body onto another
+void entity::PhysicsStore::copyBody(Handle source, Handle destination)
+{
+	if (source >= owners.size() || destination >= owners.size() || owners[source] == nullptr || owners[destination] == nullptr)
+		return;
+
+	positionX[destination] = positionX[source];
+	positionY[destination] = positionY[source];
+	velocityX[destination] = velocityX[source];
+	velocityY[destination] = velocityY[source];
+	forceX[destination] = forceX[source];
+	forceY[destination] = forceY[source];
+	mass[destination] = mass[source];
+	maxVelocityX[destination] = maxVelocityX[source];
+	maxVelocityY[destination] = maxVelocityY[source];
+	decelerateX[destination] = decelerateX[source];
+	decelerateY[destination] = decelerateY[source];
+	forceStopX[destination] = forceStopX[source];
+	forceStopY[destination] = forceStopY[source];
+	constVelocity[destination] = constVelocity[source];
+	antiGravity[destination] = antiGravity[source];
+	rotateAcceleration[destination] = rotateAcceleration[source];
+}
+
+// gets the amount of bodies
+unsigned int entity::PhysicsStore::getBodyCount() const { return owners.size() - freeBodies.size(); }
+
+// starts a batch
+void entity::PhysicsStore::beginBatch()
+{
+	if (batching)
+		return;
+
+	batching = true;
+	queueBegin = owners.size();
+	queueEnd = 0;
+}
+
+// returns whether a batch is running.
+bool entity::PhysicsStore::isBatching() const { return batching; }
+
+// queues up a body
+void entity::PhysicsStore::queue(Handle body, float deltaTime, float rotation)
+{
+	float angle = 0.0F; // the rotation in radians.
+
+	if (body >= owners.size() || owners[body] == nullptr)
+		return;
+
+	if (queued[body]) // the body is being updated twice in one batch, so the first update has to happen first.
+	{
+		integrate(body, body + 1);
+		writeBack(body, body + 1);
+	}
+
+	// the deceleration and rotation don't change during the step, so they're worked out here to keep the calls out of the integration loop.
+	stepTime[body] = deltaTime;
+	decayX[body] = powf(decelerateX[body], deltaTime * Entity::REFERENCE_RATE);
+	decayY[body] = powf(decelerateY[body], deltaTime * Entity::REFERENCE_RATE);
+
+	if (rotateAcceleration[body])
+	{
+		angle = umath::degreesToRadians(rotation);
+		rotationCos[body] = cosf(angle);
+		rotationSin[body] = sinf(angle);
+	}
+
+	queued[body] = 1;
+
+	if (batching == false) // there's no batch, so the body is integrated on its own.
+	{
+		integrate(body, body + 1);
+		writeBack(body, body + 1);
+		return;
+	}
+
+	queueBegin = std::min(queueBegin, body);
+	queueEnd = std::max(queueEnd, body + 1);
+}
+
+// integrates the queued bodies
+void entity::PhysicsStore::flush()
+{
+	flushedCount = 0;
+
+	if (queueBegin < queueEnd)
+	{
+		for (Handle i = queueBegin; i < queueEnd; i++)
+			flushedCount += queued[i];
+
+		integrate(queueBegin, queueEnd);
+		writeBack(queueBegin, queueEnd);
+	}
+
+	batching = false;
+	queueBegin = 0;
+	queueEnd = 0;
+}
+
+// gets the amount of bodies the last flush integrated.
+unsigned int entity::PhysicsStore::getFlushedCount() const { return flushedCount; }
+
+/*
+ * the integration loop, which works out the next position and velocity of every body in the range [first, last).
+ * the arrays are passed in as pointers marked as not overlapping ('__restrict'). Otherwise, the compiler would have to assume that writing the results could change the body values,
+ * and there are too many arrays for it to check that before the loop, so it wouldn't vectorize it. The compiler only trusts '__restrict' on parameters, hence the separate function.
+*/
+static void integrateBodies(unsigned int first, unsigned int last, const float GRAVITY, const float RATE,
+	const float * __restrict positionX, const float * __restrict positionY, const float * __restrict velocityX, const float * __restrict velocityY,
+	const float * __restrict forceX, const float * __restrict forceY, const float * __restrict mass,
+	const float * __restrict maxVelocityX, const float * __restrict maxVelocityY, const float * __restrict forceStopX, const float * __restrict forceStopY,
+	const unsigned char * __restrict constVelocity, const unsigned char * __restrict antiGravity, const unsigned char * __restrict rotateAcceleration,
+	const float * __restrict stepTime, const float * __restrict decayX, const float * __restrict decayY, const float * __restrict rotationCos, const float * __restrict rotationSin,
+	float * __restrict nextPositionX, float * __restrict nextPositionY, float * __restrict nextVelocityX, float * __restrict nextVelocityY)
+{
+	// every value is worked out for every body, and the results are then picked between instead of branching.
+	float deltaTime, accelX, accelY, rotatedX, rotatedY, fallingY, velX, velY, limitX, limitY, decayedX, decayedY;
+	bool stopX, stopY;
+
+	for (unsigned int i = first; i < last; i++)
+	{
+		deltaTime = stepTime[i];
+
+		// the force is divided by the mass, and rotated if the body rotates its acceleration. Gravity is taken away if the body doesn't have anti gravity.
+		accelX = forceX[i] / mass[i];
+		accelY = forceY[i] / mass[i];
+		rotatedX = accelX * rotationCos[i] - accelY * rotationSin[i];
+		rotatedY = accelX * rotationSin[i] + accelY * rotationCos[i];
+		accelX = (rotateAcceleration[i]) ? rotatedX : accelX;
+		accelY = (rotateAcceleration[i]) ? rotatedY : accelY;
+		fallingY = accelY - GRAVITY / mass[i];
+		accelY = (antiGravity[i]) ? accelY : fallingY;
+
+		velX = velocityX[i] + accelX * deltaTime;
+		velY = velocityY[i] + accelY * deltaTime;
+
+		// caps the velocity. The maximum velocity is a distance per reference update, so it's turned into a speed.
+		limitX = maxVelocityX[i] * RATE;
+		limitY = maxVelocityY[i] * RATE;
+		velX = (fabsf(velX) > limitX) ? ((velX > 0.0F) ? limitX : -limitX) : velX;
+		velY = (fabsf(velY) > limitY) ? ((velY > 0.0F) ? limitY : -limitY) : velY;
+
+		// slows the body down on the axes that have no force. A velocity of 0 stays the same when it's multiplied, so it doesn't need to be checked for.
+		decayedX = velX * decayX[i];
+		decayedY = velY * decayY[i];
+		velX = (forceX[i] == 0.0F) ? decayedX : velX;
+		velY = (forceY[i] == 0.0F) ? decayedY : velY;
+
+		// stops the body once it's slow enough, unless it has a constant velocity. The conditions use '&' instead of '&&' so that they don't turn into branches.
+		stopX = (constVelocity[i] == 0) & (forceX[i] == 0.0F) & (velX != 0.0F) & (fabsf(velX / RATE) < forceStopX[i]);
+		stopY = (constVelocity[i] == 0) & (forceY[i] == 0.0F) & (velY != 0.0F) & (fabsf(velY / RATE) < forceStopY[i]);
+		velX = (stopX) ? 0.0F : velX;
+		velY = (stopY) ? 0.0F : velY;
+
+		nextPositionX[i] = positionX[i] + velX * deltaTime;
+		nextPositionY[i] = positionY[i] + velY * deltaTime;
+
+		// a body with a constant velocity has its velocity cleared, so that it doesn't carry over.
+		nextVelocityX[i] = (constVelocity[i]) ? 0.0F : velX;
+		nextVelocityY[i] = (constVelocity[i]) ? 0.0F : velY;
+	}
+}
+
+// integrates the bodies
+void entity::PhysicsStore::integrate(Handle first, Handle last)
+{
+	// gravity is the same for every body.
+	integrateBodies(first, last, *Entity::areaGravity, Entity::REFERENCE_RATE,
+		positionX.data(), positionY.data(), velocityX.data(), velocityY.data(),
+		forceX.data(), forceY.data(), mass.data(),
+		maxVelocityX.data(), maxVelocityY.data(), forceStopX.data(), forceStopY.data(),
+		constVelocity.data(), antiGravity.data(), rotateAcceleration.data(),
+		stepTime.data(), decayX.data(), decayY.data(), rotationCos.data(), rotationSin.data(),
+		nextPositionX.data(), nextPositionY.data(), nextVelocityX.data(), nextVelocityY.data());
+}
+
+// saves the results
+void entity::PhysicsStore::writeBack(Handle first, Handle last)
+{
+	bool moved = false; // 'true' if the body's position changed.
+
+	for (Handle i = first; i < last; i++)
+	{
+		if (queued[i] == 0)
+			continue;
+
+		moved = nextPositionX[i] != positionX[i] || nextPositionY[i] != positionY[i];
+
+		positionX[i] = nextPositionX[i];
+		positionY[i] = nextPositionY[i];
+		velocityX[i] = nextVelocityX[i];
+		velocityY[i] = nextVelocityY[i];
+		forceX[i] = 0.0F; // the force only lasts for one update.
+		forceY[i] = 0.0F;
+		queued[i] = 0;
+
+		if (moved) // the sprite is only moved if the body did; an entity that's standing still doesn't need its sprite touched.
+			owners[i]->setPosition(positionX[i], positionY[i]);
+	}
+}
+
+// copies the physics values of another body.
+entity::BodyHandle & entity::BodyHandle::operator=(const BodyHandle & other)
+{
+	if (this != &other)
+		Entity::physics->copyBody(other.index, index);
+
+	return *this;
+}
@@ -0,0 +1,122 @@
+// the physics state of every entity, kept in one array per value (structure of arrays) so that all of the bodies can be moved in a single loop.
+#pragma once
+
+#include <vector>
+
+namespace entity
+{
+	class Entity;
+
+	/*
+	 * every entity gets a body in the store when it's made, and holds on to its handle (an index into the arrays) for as long as it exists.
+	 * the arrays are public so that the entity's getters and setters can go straight to them, the same way a struct would be used.
+	 * when an entity is updated during a batch (see beginBatch()), it's only queued up. flush() then integrates all of the queued bodies in one pass over the arrays,
+	 * and only moves the sprites of the bodies whose position actually changed.
+	*/
+	class PhysicsStore
+	{
+	public:
+		typedef unsigned int Handle; // the index of a body in the arrays.
+
+		PhysicsStore();
+
+		// adds a body for the provided entity, and returns its handle. The body starts with the default physics values.
+		Handle addBody(entity::Entity * owner);
+
+		// removes a body. Its handle gets reused by the next body that's added. If the body was queued, it won't be integrated.
+		void removeBody(Handle body);
+
+		// copies the physics values (position, velocity, force, and the rest) of one body onto another. Nothing is copied if either body doesn't exist.
+		void copyBody(Handle source, Handle destination);
+
+		// gets the amount of bodies in the store.
+		unsigned int getBodyCount() const;
+
+		// starts a batch. Bodies queued from now on aren't integrated until flush() is called. Calling this while a batch is already running does nothing.
+		void beginBatch();
+
+		// returns 'true' if a batch is running.
+		bool isBatching() const;
+
+		/*
+		 * queues a body to be integrated over 'deltaTime'. 'rotation' is the sprite's rotation (in degrees), which is only used if the body rotates its acceleration.
+		 * outside of a batch, the body is integrated right away. If the body was already queued in this batch, its first step is integrated before the new one is queued.
+		*/
+		void queue(Handle body, float deltaTime, float rotation);
+
+		// integrates all of the queued bodies, moves the sprites of the ones that moved, and ends the batch.
+		void flush();
+
+		// gets the amount of bodies integrated by the last flush.
+		unsigned int getFlushedCount() const;
+
+		static const Handle NO_BODY; // the handle of an entity that doesn't have a body.
+
+		std::vector<float> positionX; // the actual position of each body. The sprite is only moved away from this while it's being interpolated.
+		std::vector<float> positionY;
+		std::vector<float> velocityX; // the velocity (per second).
+		std::vector<float> velocityY;
+		std::vector<float> forceX; // the force for the upcoming update. This gets cleared when the body is integrated.
+		std::vector<float> forceY;
+		std::vector<float> mass; // the mass, which is always above 0.
+		std::vector<float> maxVelocityX; // the maximum velocity, as a distance per update at the reference rate (see Entity::REFERENCE_RATE).
+		std::vector<float> maxVelocityY;
+		std::vector<float> decelerateX; // the rate the velocity is multiplied by (per reference update) while no force is applied.
+		std::vector<float> decelerateY;
+		std::vector<float> forceStopX; // the speed the body has to fall below to be stopped completely.
+		std::vector<float> forceStopY;
+
+		// the flags are kept as bytes (rather than std::vector<bool>, which packs them into bits) so that the integration loop can read them like any other array.
+		std::vector<unsigned char> constVelocity; // '1' if the body's velocity is cleared after every update.
+		std::vector<unsigned char> antiGravity; // '1' if the body isn't affected by gravity.
+		std::vector<unsigned char> rotateAcceleration; // '1' if the acceleration is rotated by the sprite's rotation.
+
+	private:
+		// works out the next position and velocity of every body in the range [first, last). This is the one loop that moves everything.
+		// it has no calls, branches, or writes to the body values themselves, so that it can be vectorized. Bodies that aren't queued are worked out too, but their results aren't used.
+		void integrate(Handle first, Handle last);
+
+		// saves the results for the queued bodies in the range [first, last), clears their force, and takes them out of the queue. Only the sprites of the bodies that moved are moved.
+		void writeBack(Handle first, Handle last);
+
+		std::vector<entity::Entity *> owners; // the entity each body belongs to. This is a nullptr for removed bodies.
+		std::vector<Handle> freeBodies; // the handles of removed bodies, which get reused.
+
+		// the values for the queued step, which are worked out when the body is queued.
+		std::vector<unsigned char> queued; // '1' if the body is waiting to be integrated.
+		std::vector<float> stepTime; // the time the body is integrated over.
+		std::vector<float> decayX; // the deceleration rate raised to the amount of reference updates in the step.
+		std::vector<float> decayY;
+		std::vector<float> rotationCos; // the cosine and sine of the sprite's rotation, for bodies that rotate their acceleration.
+		std::vector<float> rotationSin;
+
+		// the results of the integration loop, which are only saved for the queued bodies.
+		std::vector<float> nextPositionX;
+		std::vector<float> nextPositionY;
+		std::vector<float> nextVelocityX;
+		std::vector<float> nextVelocityY;
+
+		bool batching = false; // 'true' while a batch is running.
+		Handle queueBegin = 0; // the range of handles that have bodies queued, so the whole store doesn't have to be looped over.
+		Handle queueEnd = 0;
+		unsigned int flushedCount = 0; // the amount of bodies integrated by the last flush.
+
+	protected:
+
+	};
+
+	// an entity's handle to its body in the physics store (see entity::Entity::physics). It can be used in place of the handle itself.
+	// entities hold on to the same body for as long as they exist, so assigning one entity to another copies the physics values across instead of the handle.
+	struct BodyHandle
+	{
+		BodyHandle() = default;
+		BodyHandle(const BodyHandle &) = delete;
+
+		// copies the other body's physics values onto this body.
+		BodyHandle & operator=(const BodyHandle & other);
+
+		operator PhysicsStore::Handle() const { return index; }
+
+		PhysicsStore::Handle index = PhysicsStore::NO_BODY; // the body's index in the store.
+	};
+}
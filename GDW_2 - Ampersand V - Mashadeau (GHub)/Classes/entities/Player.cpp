@@ -12,19 +12,19 @@ entity::Player::Player() : Active("images/PLR_000.png")
 
 	setMagicType(magic::shadow);
 
-	sprite->setTextureRect(Rect(0.0F + frameSize.getMaxX() * 0.0F, 0.0F + frameSize.getMaxY() * 1, frameSize.getMaxX(), frameSize.getMaxY())); // setting the area of the sprite that's used
+	setTextureRect(Rect(0.0F + frameSize.getMaxX() * 0.0F, 0.0F + frameSize.getMaxY() * 1, frameSize.getMaxX(), frameSize.getMaxY())); // setting the area of the sprite that's used
 	sprite->setGlobalZOrder(2.0F); // sets the global Z order of the player.
 	sprite->setTag(player);
 
 	// collisionShapes.push_back(new OOP::PrimitiveCircle(Vec2(0.0f, 0.0f), 29.0f));
 	collisionBodies.push_back(new OOP::PrimitiveSquare(Vec2(frameSize.getMidX(), frameSize.getMidY()), 53.0F, 185.0F, CLR_DEF));
-	collisionBodies.at(0)->getPrimitive()->setGlobalZOrder(10.1F); // the z-order is now set upon initalization.
+	collisionBodies.at(0)->setGlobalZOrder(10.1F); // the z-order is now set upon initalization.
 	collisionBodies.at(0)->setVisible(shapesVisible);
 
 
 	// collisionShapes.push_back(new OOP::PrimitiveCapsule(Vec2(frameSize.getMidX(), frameSize.getMidY() + 185.0F / 2), Vec2(frameSize.getMidX(), frameSize.getMidY() - 185.0F / 2), 53.0F / 2, CLR_DEF));
 	collisionBodies.push_back(new OOP::PrimitiveCapsule(Vec2(frameSize.getMidX(), frameSize.getMidY()), 185.0F, 53.0F / 2, 90.0F, CLR_DEF));
-	collisionBodies.at(1)->getPrimitive()->setGlobalZOrder(10.1F); // the z-order is now set upon initalization.
+	collisionBodies.at(1)->setGlobalZOrder(10.1F); // the z-order is now set upon initalization.
 	collisionBodies.at(1)->setVisible(shapesVisible);
 	// sprite->addChild(circles.at(0)->getPrimitive());
 
@@ -149,8 +149,8 @@ entity::Player::Player() : Active("images/PLR_000.png")
 	// tempAnimate->add(new OOP::SpriteSheetAnimationFrame(Rect(0.0F + frameSize.getMaxX(), 0.0F + frameSize.getMaxY(), frameSize.getMaxX(), frameSize.getMaxY())));
 	animations.push_back(tempAnimate);
 
-	for (OOP::Primitive * prim : collisionBodies)
-		sprite->addChild(prim->getPrimitive());
+	for (OOP::Primitive * prim : collisionBodies) // the drawNodes only get made (and added to the sprite) if the shapes are visible.
+		prim->setParent(sprite);
 }
 
 
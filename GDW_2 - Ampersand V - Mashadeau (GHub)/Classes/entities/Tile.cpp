@@ -61,8 +61,7 @@ void entity::Tile::createTile(unsigned int TIN, char letter)
 			break;
 		}
 
-		collisionBodies.at(0)->getPrimitive()->setGlobalZOrder(19.9F);
-		collisionBodies.at(0)->setVisible(true);
+		collisionBodies.at(0)->setGlobalZOrder(19.9F);
 
 		// sprite->setVisible(false); // uncomment to hide all graphics
 		break;
@@ -97,7 +96,7 @@ void entity::Tile::createTile(unsigned int TIN, char letter)
 			this->LETTER = 'a'; // since 'a' is also the default, this is set to 'a', just to be sure.
 
 			setTextureRect(frameSize);
-			collisionBodies.push_back(new OOP::PrimitiveSquare(Vec2(sprite->getTextureRect().getMidX(), sprite->getTextureRect().getMidY()), 128.0F, CLR_DEF));
+			collisionBodies.push_back(new OOP::PrimitiveSquare(Vec2(getTextureRect().getMidX(), getTextureRect().getMidY()), 128.0F, CLR_DEF));
 			break;
 		}
 
@@ -480,9 +479,9 @@ void entity::Tile::createTile(unsigned int TIN, char letter)
 
 		for (OOP::Primitive * colShape : collisionBodies) // adds all of the collision shapes to the sprite.
 		{
-			colShape->getPrimitive()->setGlobalZOrder(10.1F);
-			colShape->getPrimitive()->setVisible(shapesVisible);
-			sprite->addChild(colShape->getPrimitive());
+			colShape->setGlobalZOrder(10.1F);
+			colShape->setParent(sprite);
+			colShape->setVisible(shapesVisible); // the drawNode is only made if the shapes are visible.
 		}
 
 }
@@ -521,6 +520,52 @@ void entity::Tile::setHealth(float hp) { health = (hp >= 0.0F) ? hp : 0.0F; }
 // gets whether the tile can be damaged or not.
 bool entity::Tile::getDamagable() { return damageable; }
 
+// returns 'true' if the tile is a moving platform.
+bool entity::Tile::isMoving() const { return moveSpeedX > 0.0F || moveSpeedY > 0.0F || rotationSpeed > 0.0F; }
+
+// returns 'true' if the tile is a plain solid block.
+bool entity::Tile::isSolidBlock()
+{
+	OOP::AABB box; // the tile's collision body in the game world.
+
+	// exits, spawns, orbs and weapons all do something when touched, so they aren't plain blocks.
+	if (isMoving() || damageable || TIN <= 9 || (TIN >= 700 && TIN <= 899))
+		return false;
+
+	// the tile must have a single active square for its collision body.
+	if (getCollisionBodies().size() != 1 || getWorldCollisionBodies().size() != 1 || getWorldCollisionBodies()[0].id != 1 || getWorldCollisionBodies()[0].source->isActive() == false)
+		return false;
+
+	box = getWorldCollisionBodies()[0].aabb;
+
+	// the square must fill the tile's grid square (128 X 128), otherwise merging it would change the collision.
+	return abs(box.max.x - box.min.x - 128.0F) < 0.5F && abs(box.max.y - box.min.y - 128.0F) < 0.5F &&
+		abs(box.min.x - roundf(box.min.x / 128.0F) * 128.0F) < 0.5F && abs(box.min.y - roundf(box.min.y / 128.0F) * 128.0F) < 0.5F;
+}
+
+// returns 'true' if the tile's collision has been merged.
+bool entity::Tile::isCollisionMerged() const { return collisionMerged; }
+
+// sets whether the tile's collision has been merged.
+void entity::Tile::setCollisionMerged(bool merged) { collisionMerged = merged; }
+
+// returns 'true' if the tile can be baked into a tile chunk.
+bool entity::Tile::isBakeable()
+{
+	// TIN 053 is the breakable block, and exits, spawns, orbs and weapons can all change or be removed.
+	if (isMoving() || damageable || TIN == 053 || TIN <= 9 || (TIN >= 700 && TIN <= 899))
+		return false;
+
+	// children (e.g. visible collision shapes) and actions wouldn't be part of the baked mesh.
+	return sprite->getTexture() != nullptr && sprite->isVisible() && sprite->getChildrenCount() == 0 && sprite->getNumberOfRunningActions() == 0;
+}
+
+// returns 'true' if the tile has been baked.
+bool entity::Tile::isBaked() const { return baked; }
+
+// sets whether the tile has been baked.
+void entity::Tile::setBaked(bool baked) { this->baked = baked; }
+
 // checks the effect the tile has on the player.
 void entity::Tile::effect(entity::Tile * tile, entity::Player * plyr)
 {
@@ -564,7 +609,7 @@ void entity::Tile::update(float deltaTime)
 	}
 
 	if(rotationSpeed > 0.0F)
-		sprite->setRotation(sprite->getRotation() + ((rotateClockwise) ? 1 : -1) * 10.0F * rotationSpeed); // rotates the tile.
+		sprite->setRotation(sprite->getRotation() + ((rotateClockwise) ? 1 : -1) * 10.0F * rotationSpeed * deltaTime * REFERENCE_RATE); // rotates the tile. The speed was made for one rotation per update at the reference rate.
 
 	// if the platform has passed the ending point, then it starts moving the other way.
 	if (getPositionX() >= endingPoint.x)
@@ -51,6 +51,29 @@ namespace entity
 		// gets whether the tile can be damaged or not.
 		bool getDamagable();
 
+		// returns 'true' if the tile moves or rotates on its own (i.e. it's a moving platform).
+		bool isMoving() const;
+
+		// returns 'true' if the tile is a plain solid block; it doesn't move, can't be destroyed, has no special effect, and its only collision body fills its grid square.
+		// solid blocks that are next to each other can have their collision bodies merged (see world::Area::mergeStaticColliders()).
+		bool isSolidBlock();
+
+		// returns 'true' if the tile's collision is handled by one of the area's merged collision rectangles instead of its own collision bodies.
+		bool isCollisionMerged() const;
+
+		// sets whether the tile's collision has been merged into one of the area's collision rectangles.
+		void setCollisionMerged(bool merged);
+
+		// returns 'true' if the tile's sprite never changes once the area is loaded, so it can be baked into one of the area's tile chunks (see world::TileChunk).
+		// moving tiles, tiles that can be destroyed (or have effects), and sprites with children or actions on them can't be baked.
+		bool isBakeable();
+
+		// returns 'true' if the tile's sprite has been baked into a tile chunk. Baked tiles don't need to be updated.
+		bool isBaked() const;
+
+		// sets whether the tile's sprite has been baked into a tile chunk.
+		void setBaked(bool baked);
+
 		// gets the effect applied on the entity by the tile.
 		static void effect(entity::Tile * tile, entity::Player * plyr);
 
@@ -73,6 +96,10 @@ namespace entity
 
 		unsigned int weaponNum = 0; // a weapon provided by the tile if applicable. DO NOT CHANGE THIS.
 
+		// the first and last cells holding the tile in an area's spatial grid (see world::SpatialGrid). If they're '-1', the tile isn't in the grid's cells.
+		int gridMinCell = -1;
+		int gridMaxCell = -1;
+
 	private:
 		// called to create the tile and give it its initial values
 		void createTile(unsigned int TIN, char letter);
@@ -102,6 +129,9 @@ namespace entity
 		float health = 1; // the amount of health a tile has. If a tile has 0 health, it will get deleted in the Area update.
 		bool damageable = false; // if true, the tile can be damaged and destroyed.
 
+		bool collisionMerged = false; // if true, the tile's collision is handled by the area's merged collision rectangles.
+		bool baked = false; // if true, the tile's sprite is drawn as part of a tile chunk instead of on its own.
+
 	protected:
 		
 	
@@ -124,29 +124,13 @@ void entity::Weapon::createWeapon(unsigned int WIN)
 // adds all the colision primitives to the owner, and chooses to either enable them, disable them, or do nothing to them.
 void entity::Weapon::addPrimitivesToOwner(bool changeActive, bool activeBodies)
 {
-	bool attachted = false;
-	Vector<Node *> ownerChildren = owner->getSprite()->getChildren(); // gets the children of the owner.
-
 	for (int i = 0; i < collisionBodies.size(); i++)
 	{
-		for (int j = 0; j < ownerChildren.size(); j++)
-		{
-			// if the primitive's draw node is already attachted to the owner, it isn't attachted again.
-			if (ownerChildren.at(j) == collisionBodies.at(i)->getPrimitive())
-			{
-				attachted = true; // tells the program that the primitive is already attachted.
-				break;
-			}
-		}
-
-		 // adds the drawNode to the owner's sprite.
+		 // adds the primitive to the owner's sprite. If the primitive is already attachted to the owner, it isn't attachted again.
 		// owner->addCollisionBody(collisionBodies.at(i)); // adds the collision body to the owner's vector.
 
-		if (!attachted) // if the Node is not already attached.
-		{
-			owner->getSprite()->addChild(collisionBodies.at(i)->getPrimitive());
-			attachted = false;
-		}
+		if (collisionBodies.at(i)->getParent() != owner->getSprite()) // if the primitive is not already attached.
+			collisionBodies.at(i)->setParent(owner->getSprite());
 	}
 
 	if (changeActive) // if the 'active' parameter should be changed.
@@ -183,14 +167,14 @@ void entity::Weapon::setOwner(entity::Entity * newOwner)
 
 	for (int i = 0; i < collisionBodies.size() && owner != nullptr; i++) // removes the primitives from the old owner.
 	{
-		collisionBodies[i]->getPrimitive()->removeFromParent();
+		collisionBodies[i]->removeFromParent();
 		owner->removeCollisionBody(collisionBodies.at(i)); // removes it from the 
 	}
 	owner = newOwner;
 
 	for (int i = 0; i < collisionBodies.size(); i++) // adds the collision bodies to their new owner.
 	{
-		owner->getSprite()->addChild(collisionBodies.at(i)->getPrimitive());
+		collisionBodies.at(i)->setParent(owner->getSprite());
 		owner->addCollisionBody(collisionBodies.at(i));
 	}
 
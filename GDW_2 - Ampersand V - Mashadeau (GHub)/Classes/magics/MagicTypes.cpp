@@ -83,7 +83,7 @@ float magic::MagicType::getEarthWeakness() const { return *earthWeakness; }
 float magic::MagicType::getAirWeakness() const { return *airWeakness; }
 
 // calculates how much damage the 'attacker' will do the the 'victim' by applying a multiplier to 'damage'.
-float magic::MagicType::damage(MagicType & attacker, MagicType & victim, float damage)
+float magic::MagicType::damage(const MagicType & attacker, const MagicType & victim, float damage)
 {
 	// the amount of weakness the victim has to the attack is gotten, and is then multiplied by how much damage the attack should do to calculate total damage.
 	return damage * victim.getWeakness(attacker.getType());
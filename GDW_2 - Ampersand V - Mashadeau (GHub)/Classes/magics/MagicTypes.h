@@ -76,7 +76,7 @@ namespace magic {
 		float getAirWeakness() const;
 
 		// calculates the amount of damage the 'attacker' will do the 'victim' my multiplying variable 'damage'.
-		static float damage(MagicType & attacker, MagicType & victim, float damage);
+		static float damage(const MagicType & attacker, const MagicType & victim, float damage);
 
 		static const int TOTAL_TYPES; // the total amount of types in the game.
 	private:
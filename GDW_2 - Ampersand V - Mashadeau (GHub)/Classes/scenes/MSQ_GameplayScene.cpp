@@ -16,6 +16,7 @@ Date: 04/04/2019
 #include "scenes/MSQ_GameplayScene.h"
 
 #include <iostream>
+#include <algorithm>
 
 // initalizing static variables
 std::string MSQ_GameplayScene::areaName = "AIN_B00"; // the area the player is in.
@@ -23,15 +24,17 @@ const std::string MSQ_GameplayScene::DEFAULT_AREA = "AIN_B00_0";  // the origina
 int MSQ_GameplayScene::spawnPoint = 0; // spawn point 0
 
 // used for saving information between scenes.
-int MSQ_GameplayScene::pHealth = -1; // current health
-int MSQ_GameplayScene::pHealthMax = -1; // maximum health
-int MSQ_GameplayScene::pMagic = -1; // current magic
-int MSQ_GameplayScene::pMagicMax = -1; // maximum magic.
-std::vector<int> MSQ_GameplayScene::pWeapons; // player weapons.
+world::PlayerStats MSQ_GameplayScene::playerStats; // the player's health, magic, and weapons.
+unsigned int MSQ_GameplayScene::stepCount = 0; // physics steps.
+
+// input recording
+world::InputRecording * MSQ_GameplayScene::recording = nullptr; // the recording in progress.
+bool MSQ_GameplayScene::startRecording = false; // start a recording in the next scene.
 
 // debug related functions
 bool MSQ_GameplayScene::debug = false; // debug mode
 bool MSQ_GameplayScene::enable_hud = true; // enables hud view
+bool MSQ_GameplayScene::showProfiler = false; // profiler overlay
 
 std::vector<std::string> MSQ_GameplayScene::areasVisited; // a vector for the areas visieted by the player (their names specifically).
 
@@ -116,11 +119,16 @@ void MSQ_GameplayScene::initSprites()
 		areasVisited.push_back(areaName);
 
 
-	// as mentioned elsewhere, originally area data was supposed to be saved upon leaving a scene, but this could not be completed, so the 'revisit' parameter doesn't really do anything.
-	sceneArea = world::World::getArea(areaName); // makes the area. Remember, all the anchour points are the middle of the sprite layers (0.5, 0.5).
-	sceneArea->setAllLayerPositions(Vec2(director->getWinSizeInPixels().width / 2, director->getWinSizeInPixels().height / 2)); // makes all the layers be at the middle of the screen.
+	// originally area data was supposed to be saved upon leaving a scene. Areas that have been left are now kept alive instead (see world::World::releaseArea()), so a revisit gets the area back as it was left, unless it was deleted to save memory.
+	sceneArea = world::World::getArea(areaName); // makes the area, or reuses it if it was left recently. Remember, all the anchour points are the middle of the sprite layers (0.5, 0.5).
+	sceneArea->updateLayers(Vec2(director->getWinSize().width / 2, director->getWinSize().height / 2), director->getWinSize()); // puts the layers around the middle of the screen, and loads the tiles that start in view.
 
 	this->addChild(sceneArea->getAsSingleNode()); // gets the scene graphic elements (hitboxes not withstanding) as a single node.
+	world::World::preloadExits(sceneArea); // starts reading the areas the exits lead to, so that going through an exit doesn't have to wait for them.
+
+	// the memory used by the background textures is printed along with the draw calls, so that the converted backgrounds can be compared to the PNGs (see tools/convert_backgrounds.py).
+	if (debug || REPORT_DRAW_CALLS)
+		std::cout << "Layer textures: " << sceneArea->getLayerTextureMemory() / 1024 << " KB (" << sceneArea->getLayerTextureMemory(true) / 1024 << " KB as RGBA8888), " << sceneArea->getLayerTileCount() << " tiles" << std::endl;
 
 	sceneTiles = sceneArea->getAreaTiles(); // saves a pointer to the scene tiles
 	sceneEnemies = sceneArea->getAreaEnemies(); // saves a pointer to the scene enemies
@@ -130,31 +138,21 @@ void MSQ_GameplayScene::initSprites()
 	plyr->setPosition(sceneArea->getSpawn(spawnPoint)); // sets the player using spawn point 0.
 	plyr->setAntiGravity(debug); // turns on/off anti-gravity based on the value of 'debug'
 
-	// changes the player's values to what they were when leaving the previous scene. A value of '-1' is used to denote when no value is available. 
-	if (pHealth > -1) // current health
-	{
-		plyr->setHealth(pHealth);
-		pHealth = -1;
-	}
-	if (pHealthMax > -1) // max health
-	{
-		plyr->setMaxHealth(pHealthMax);
-		pHealthMax = -1;
-	}
-	if (pMagic > -1) // current magic
-	{
-		plyr->setMagicPower(pMagic);
-		pMagic = -1;
-	}
-	if (pMagicMax > -1) // max magic
+	// changes the player's values to what they were when leaving the previous scene, then clears them so that they're only used once.
+	world::Simulation::setPlayerStats(plyr, playerStats);
+
+	// a recording starts at the beginning of an area, so that it can be played back from the same point. The values the player was given are saved with it so that a playback can give them to the player the same way.
+	if (startRecording)
 	{
-		plyr->setMagicPowerMax(pMagicMax, false);
-		pMagicMax = -1;
+		delete recording;
+		recording = new world::InputRecording(areaName, spawnPoint, playerStats);
+		stepCount = 0;
+		startRecording = false;
+
+		std::cout << "Recording started in " << areaName << std::endl;
 	}
-	for (int i = 0; i < pWeapons.size(); i++) // giving the player back their weapons via providing their 'WIN' numbers and recreating them.
-		plyr->giveWeapon(pWeapons.at(i));
-	
-	pWeapons.clear(); // removes the 'WIN' numbers since the weapons have been added.
+
+	playerStats = world::PlayerStats();
 
 	this->addChild(plyr->getSprite());
 
@@ -200,8 +198,8 @@ void MSQ_GameplayScene::initSprites()
 				if (plyr->getWeapon(i) != nullptr)
 				{
 					weaponImages[i] = plyr->getWeapon(i)->getTextureFilePath(); // saves the weapon image name
-					hudWeapons[i][j]->setTexture(weaponImages[i]); // sets the image
-					hudWeapons[i][j]->setTextureRect(weaponIconSize); // sets a section of the image so that it matches up with everything else.
+					OOP::TextureAtlas::setTexture(hudWeapons[i][j], weaponImages[i]); // sets the image, using the weapon atlas if the image is in it.
+					hudWeapons[i][j]->setTextureRect(OOP::TextureAtlas::getRect(weaponImages[i], weaponIconSize)); // sets a section of the image so that it matches up with everything else.
 				}
 				hudWeapons[i][j]->setLocalZOrder(2.0F); // layering
 
@@ -321,10 +319,21 @@ void MSQ_GameplayScene::initSprites()
 
 	// creating the grid; the z-order is set within the grid class.
 	grid = new OOP::PrimitiveGrid(cocos2d::Vec2(0.0F, 0.0F), cocos2d::Vec2(director->getWinSizeInPixels().width, director->getWinSizeInPixels().height), 128.0F, Color4F::WHITE);
-	grid->getPrimitive()->setVisible(false); // makes the grid visible (or not visible)
-	this->addChild(grid->getPrimitive()); // adds grid to drawList for the scene.
+	grid->setParent(this); // adds grid to drawList for the scene once it's drawn.
+	grid->setVisible(false); // makes the grid visible (or not visible). The grid is only drawn once it's made visible.
 	gridOffset = grid->getPosition() - getDefaultCamera()->getPosition(); // used to keep the grid in place and not move it with the cmaera.
 
+	// creating the profiler overlay. A monospaced font is used so that the columns line up.
+	profilerLabel = Label::createWithSystemFont("", "Courier New", 18);
+	profilerLabel->setAnchorPoint(Vec2(0.0F, 1.0F)); // the overlay grows down from its top-left corner.
+	profilerLabel->setPosition(director->getWinSizeInPixels().width * 0.01F, director->getWinSizeInPixels().height * 0.82F);
+	profilerLabel->setTextColor(Color4B::WHITE);
+	profilerLabel->enableOutline(Color4B::BLACK, 1);
+	profilerLabel->setGlobalZOrder(100.0F); // in front of everything, including the hud.
+	profilerLabel->setVisible(showProfiler);
+	this->addChild(profilerLabel);
+	profilerOffset = profilerLabel->getPosition() - getDefaultCamera()->getPosition(); // keeps the overlay in place with the camera.
+
 
 	// setting the camera if it's activated.
 	if (ENABLE_CAMERA)
@@ -343,6 +352,25 @@ void MSQ_GameplayScene::initSprites()
 	debugMode(); // called to turn on (or off) debug mode.
 	winSize = director->getWinSizeInPixels(); // gets the window size for ease of calculations.
 
+	// the simulation runs the physics and collisions for the area and the player. The area is culled using the window size.
+	simulation = world::Simulation(sceneArea, plyr);
+	simulation.setViewSize(winSize);
+	simulation.setDebug(debug);
+	simulation.setSpawnPoint(spawnPoint);
+	simulation.setStepCount(stepCount); // the steps keep being counted from the last area, which a recording needs.
+	simulation.setRecording(recording);
+
+	if (ENABLE_CAMERA == false) // the view stays where the camera is.
+		simulation.setViewCentre(getDefaultCamera()->getPosition());
+
+	// the phases are listed in the overlay in the order they're added, so the scene's phases are split around the simulation's.
+	framePhase = profiler.addPhase("frame");
+	updatePhase = profiler.addPhase("update");
+	inputPhase = profiler.addPhase("input");
+	simulation.setProfiler(&profiler);
+	hudPhase = profiler.addPhase("hud");
+	cameraPhase = profiler.addPhase("camera");
+
 }
 
 // initializes pause menu, which was not done in time, so it does nothing.
@@ -386,41 +414,40 @@ void MSQ_GameplayScene::onKeyPressed(EventKeyboard::KeyCode keyCode, Event * eve
 	{
 	case EventKeyboard::KeyCode::KEY_UP_ARROW:
 		if (debug)
-			plyr->moveUp = true; // tells the program to move the player up. This only happens in debug mode.
+			simulation.getInput().moveUp = true; // tells the program to move the player up. This only happens in debug mode.
 
 		break;
 
 	case EventKeyboard::KeyCode::KEY_DOWN_ARROW:
 		if (debug)
-			plyr->moveDown = true; // tells the player to go down.
+			simulation.getInput().moveDown = true; // tells the player to go down.
 		break;
 
 	case EventKeyboard::KeyCode::KEY_LEFT_ARROW:
-		plyr->moveLeft = true; // move left
+		simulation.getInput().moveLeft = true; // move left
 		break;
 
 	case EventKeyboard::KeyCode::KEY_RIGHT_ARROW:
-		plyr->moveRight = true; // move right
+		simulation.getInput().moveRight = true; // move right
 		break;
 	case EventKeyboard::KeyCode::KEY_W:
-		plyr->moveUp = true; // this was supposed to be an alternate button for jumping, but we forgot to set it properly. So instead, it just moves the player up, which only happens in debug.
+		simulation.getInput().moveUp = true; // this was supposed to be an alternate button for jumping, but we forgot to set it properly. So instead, it just moves the player up, which only happens in debug.
 		break;
 
 	case EventKeyboard::KeyCode::KEY_S:
-		plyr->moveDown = true; // moves the character down, only really happens in debug.
+		simulation.getInput().moveDown = true; // moves the character down, only really happens in debug.
 		break;
 
 	case EventKeyboard::KeyCode::KEY_A:
-		plyr->moveLeft = true; // leftward movement (alternate)
+		simulation.getInput().moveLeft = true; // leftward movement (alternate)
 		break;
 
 	case EventKeyboard::KeyCode::KEY_D:
-		plyr->moveRight = true; // rightward movement (alternate)
+		simulation.getInput().moveRight = true; // rightward movement (alternate)
 		break;
 
-	case EventKeyboard::KeyCode::KEY_F: // used for attacking; it saves what action the player has used for animation purposes.
-		pAction = 6;
-		plyrAction = true;
+	case EventKeyboard::KeyCode::KEY_F: // used for attacking; the attack starts on the next physics step.
+		simulation.getInput().attack = true;
 		AudioLibrary::MSQ_sword.play(); // plays a sound.
 		break;
 	}
@@ -440,55 +467,72 @@ void MSQ_GameplayScene::onKeyReleased(EventKeyboard::KeyCode keyCode, Event * ev
 		enable_hud = !enable_hud;
 		break;
 
+	case EventKeyboard::KeyCode::KEY_P: // toggles on/off the profiler overlay.
+		showProfiler = !showProfiler;
+		profilerLabel->setVisible(showProfiler);
+		profilerTimer = PROFILER_REFRESH; // the overlay is refreshed straight away.
+		break;
+
+	case EventKeyboard::KeyCode::KEY_R: // starts or stops recording the player's input.
+		toggleRecording();
+		break;
+
+	case EventKeyboard::KeyCode::KEY_O: // saves the profiler statistics for this area.
+		if (profiler.saveCSV("profile_" + areaName + ".csv") && profiler.saveJSON("profile_" + areaName + ".json"))
+			std::cout << "Profile saved to profile_" << areaName << ".csv and profile_" << areaName << ".json" << std::endl;
+		else
+			std::cout << "The profile could not be saved." << std::endl;
+		break;
+
 	case EventKeyboard::KeyCode::KEY_UP_ARROW:
-		plyr->moveUp = false; // player should stop moving up.
+		simulation.getInput().moveUp = false; // player should stop moving up.
 
 		if(!debug) // if debug is off, then the jump is turned on upon the 'UP' button being let go.
-			plyr->jump = true;
+			simulation.getInput().jump = true;
 
 		break;
 
 	case EventKeyboard::KeyCode::KEY_DOWN_ARROW:
-		plyr->moveDown = false; // stop applying downard force
+		simulation.getInput().moveDown = false; // stop applying downard force
 		break;
 
 	case EventKeyboard::KeyCode::KEY_LEFT_ARROW:
-		plyr->moveLeft = false; // stop applying leftward force
+		simulation.getInput().moveLeft = false; // stop applying leftward force
 		break;
 
 	case EventKeyboard::KeyCode::KEY_RIGHT_ARROW:
-		plyr->moveRight = false; // stop applying rightward force
+		simulation.getInput().moveRight = false; // stop applying rightward force
 		break;
 
 	case EventKeyboard::KeyCode::KEY_SPACE:
-		plyr->jump = true; // spacebar is used for jumping
+		simulation.getInput().jump = true; // spacebar is used for jumping
 		break;
 	case EventKeyboard::KeyCode::KEY_W:
-		plyr->moveUp = false; // this was meant to be an alternate jump button, but we forgot to set it properly.
+		simulation.getInput().moveUp = false; // this was meant to be an alternate jump button, but we forgot to set it properly.
 		break;
 
 	case EventKeyboard::KeyCode::KEY_S: // same as KEY_DOWN
-		plyr->moveDown = false;
+		simulation.getInput().moveDown = false;
 		break;
 
 	case EventKeyboard::KeyCode::KEY_A: // same as KEY_LEFT
-		plyr->moveLeft = false;
+		simulation.getInput().moveLeft = false;
 		break;
 
 	case EventKeyboard::KeyCode::KEY_D: // same as KEY_RIGHT
-		plyr->moveRight = false;
+		simulation.getInput().moveRight = false;
 		break;
 	case EventKeyboard::KeyCode::KEY_F: // originally used for triggering the attack, but it was moved to keyDown().
 
 		break;
 	case EventKeyboard::KeyCode::KEY_1: // switch to weapon 1
-		plyr->switchWeapon(1);
+		simulation.getInput().weapon = 1;
 		break;
 	case EventKeyboard::KeyCode::KEY_2: // switch to weapon 2
-		plyr->switchWeapon(2);
+		simulation.getInput().weapon = 2;
 		break;
 	case EventKeyboard::KeyCode::KEY_3: // switch to weapon 3
-		plyr->switchWeapon(3);
+		simulation.getInput().weapon = 3;
 		break;
 	case EventKeyboard::KeyCode::KEY_ESCAPE: // opens the menu, which wasn't inplemented in time, so nothing happens.
 		//menu
@@ -510,6 +554,34 @@ void MSQ_GameplayScene::debugMode()
 	plyr->setAntiGravity(debug); // disables or enables the player's gravity (debug mode has gravity off)
 }
 
+// starts or stops recording.
+void MSQ_GameplayScene::toggleRecording()
+{
+	std::string filePath = ""; // where the recording is saved.
+	std::string restart = ""; // the area and spawn point to restart at.
+
+	if (recording == nullptr) // starts a recording by restarting the area.
+	{
+		startRecording = true;
+		restart = areaName + "_" + std::to_string(spawnPoint);
+		switchArea(restart);
+		return;
+	}
+
+	// the sprites may be between two physics steps, so they're put back before the checksum is taken.
+	simulation.endInterpolation();
+	recording->finish(simulation.getStepCount(), simulation.getChecksum());
+
+	filePath = "replay_" + recording->getArea() + ".msqr";
+
+	if (recording->saveToFile(filePath))
+		std::cout << "Recording saved to " << filePath << " (" << recording->getEndStep() << " steps)" << std::endl;
+	else
+		std::cout << "The recording could not be saved." << std::endl;
+
+	delete recording;
+	recording = nullptr;
+}
 
 // switches the area based on the passed file name.
 // the last digit is needed to know what spawn point to use. It must be greater than or equal to 0, and not exceed 4 (it can be 4 though). In other words, it's from 0-4.
@@ -542,7 +614,7 @@ void MSQ_GameplayScene::switchArea(std::string & fileName)
 		if (std::stoi(spawn) < 0 || std::stoi(spawn) > 4) // if the spawn point is out of range.
 			throw "Spawn point does not exist\n";
 
-		if (world::World::getArea(fileName) == nullptr) // if the area doesn't exist.
+		if (!world::World::areaExists(fileName)) // if the area doesn't exist.
 			throw "This area does not exist.\n";
 	}
 	catch (const char * ex) // catches the thrown message exception, and prints it.
@@ -559,16 +631,17 @@ void MSQ_GameplayScene::switchArea(std::string & fileName)
 	areaName = fileName; // saves the new area so that it's set upon initalization of the new game object.
 	spawnPoint = std::stoi(spawn); // saves the spawn point of the player for when they get into the new area.
 
-	pHealth = plyr->getHealth(); // saves the player's current health
-	pHealthMax = plyr->getMaxHealth(); // saves the player's maximum health
-	pMagic = plyr->getMagicPower(); // saves the player's current magic power
-	pMagicMax = plyr->getMagicPowerMax(); // saves the player's maximum magic power
-	
-	for (int i = 0; i < HUD_WEAPONS_ROWS; i++) // saves the 'WIN' number of the weapons the player had when leaving the scene. These will be added to the new player object in the new scene.
-	{
-		if (plyr->getWeapon(i) != nullptr)
-			pWeapons.push_back(plyr->getWeapon(i)->getWIN());
-	}
+	// saves the player's health, magic, and the 'WIN' numbers of their weapons. These will be added to the new player object in the new scene.
+	playerStats = world::Simulation::getPlayerStats(plyr);
+	stepCount = simulation.getStepCount(); // the new area's simulation carries on from this step.
+
+	// the area is kept so that it can be reused if the player comes back. The sprites are put back first so that it's kept between physics steps.
+	simulation.endInterpolation();
+	world::World::releaseArea(sceneArea);
+
+	// a recording has to start with no kept areas, since a playback starts with none.
+	if (startRecording)
+		world::World::clearAreas();
 
 	newScene = GameplayScene::createScene(); // creates the gameplay scene.
 
@@ -584,295 +657,42 @@ void MSQ_GameplayScene::switchArea(std::string & fileName)
 void MSQ_GameplayScene::exitGame()
 {
 	areasVisited.clear(); // removes the 'memory' of visited areas.
+	world::World::clearAreas(); // deletes the areas that were kept.
 
 	// removes static information by resetting it to default values.
-	pHealth = -1;
-	pHealthMax = -1;
-	pMagic = -1;
-	pMagicMax = -1;
-	pWeapons.clear();
+	playerStats = world::PlayerStats();
 
 	spawnPoint = 0;
-}
+	stepCount = 0;
 
-// runs collision tests.
-void MSQ_GameplayScene::collisions()
-{	
-	playerTileCollisions(); // called for player-tile collisions.
-	// enemyTileCollisions(); // collision between the enemies and the tiles. Not completed for the final game.
-	
-	playerEnemyCollisions(); // called for player collisions with enemies.
-	weaponEnemyCollisions(); // called for weapon collisions with enemies.
+	delete recording; // an unfinished recording is thrown away.
+	recording = nullptr;
+	startRecording = false;
 }
 
-// calculates player collision with tiles.
-void MSQ_GameplayScene::playerTileCollisions()
-{
-	entity::Tile * tile = nullptr; // the tile the player has collided with.
-
-	OOP::Primitive * colPrim1; // the primitive from the player that encountered a collision
-	OOP::Primitive * colPrim2; // the primitive from the other entity (i.e. tile) that encounted a collision
-	
-	cocos2d::Vec2 distVec(0.0F, 0.0F); // saves the distance between the two entities on the (x, y) (i.e. the distance between their hit shapes).
-	cocos2d::Vec2 minDistVec(0.0F, 0.0F); // saves the minimum distance between the two entities (i.e. their hit boxes) that would of course not cause a collision.
-	float dist = 0.0F; // the distance between the two entities, which is the 'c' value in the pythagorean theorem.
-	float theta; // the angle between the player and the tile.
-
-	float compAngle = 60.0F; // the angle used to check the player's position relative to the tile, in degrees. This helps determine if the player is on top of the tile, or next to it.
-
-	bool platformBelow = false; // if 'true', then there's a platform below the player.
-
-	if(debug == false)
-		plyr->setAntiGravity(false); // turns off gravity for the collision check. If the player is not on top of a tile, gravity is turned back on.
-	
-	// sets the direction cancels to false for the collision check. These are left off if they should not be changed (i.e. if there's no collision relative to the direction).
-	plyr->cancelUp = false;
-	plyr->cancelDown = false;
-	plyr->cancelLeft = false;
-	plyr->cancelRight = false;;
-
-	for (int i = 0; i < sceneArea->getAreaTiles()->size(); i++)
-	{
-		// checks if the player and the tile are close enough for a collision check (optimization). The valid maximum distance is the screen size / 2 in all directions.
-		if (abs(sceneArea->getAreaTiles()->at(i)->getPosition().x - plyr->getPosition().x) > winSize.width / 1.80F || abs(sceneArea->getAreaTiles()->at(i)->getPosition().y - plyr->getPosition().y) > winSize.height / 1.80F)
-		{
-			sceneArea->getAreaTiles()->at(i)->onScreen = false; // tells the tile it's off screen.
-			continue;
-		}
-		else
-		{
-			sceneArea->getAreaTiles()->at(i)->onScreen = true; // tells the tile it's on screen.
-		}
-
-		if (entity::Entity::collision(plyr, sceneArea->getAreaTiles()->at(i))) // if collision has happened, then related calculations must be done.
-		{
-			tile = sceneArea->getAreaTiles()->at(i); // saves the tile the player has collided with.
-
-			if (!switchingScenes && tile->getTIN() >= 0 && tile->getTIN() <= 4) // if it's a scene exit, then no other checks need to be done. The player is leaving the area.
-			{
-				switchArea(sceneArea->getExit(tile->getTIN())); // gets the tile identification number, which helps get the exit attached to it.
-				return;
-			}
-
-			if (tile->getTIN() >= 800 && tile->getTIN() <= 899) // if it's a weapon tile, the player gets the weapon. This was not used in the final game, but is functional.
-			{
-				entity::Tile::effect(tile, plyr); // checks to see how the player was effected by the collision. This is only used for weapon switching in the final product.
-				break;
-			}
-
-			// gets what primitives collided for the player and the tile.
-			colPrim1 = plyr->collidedPrimitive;
-			colPrim2 = tile->collidedPrimitive;
-
-			distVec = plyr->getPosition() - tile->getPosition(); // calculates the distance along the x and y between the player and the tile.
-			dist = sqrt(pow(distVec.x, 2) + pow(distVec.y, 2)); // gets the distance between the player and the tile, using the pythagoren theorem.
-
-			// gets the minimum distance the two entities can be apart without being within or colliding with one another.
-			if (colPrim1->getId() == 1 && colPrim2->getId() == 1) // if both of the primitives are squares. We only ended up using squares for the final game.
-			{
-				minDistVec.x = ((OOP::PrimitiveSquare *) colPrim1)->m_WIDTH / 2 + ((OOP::PrimitiveSquare *) colPrim2)->m_WIDTH / 2;
-				minDistVec.y = ((OOP::PrimitiveSquare *) colPrim1)->m_HEIGHT / 2 + ((OOP::PrimitiveSquare *) colPrim2)->m_HEIGHT / 2;
-			}
-
-			theta = atanf(distVec.y / distVec.x); // gets the angle between the the player and the tile using TOA (atan theta = opposite/adjacent) 
-
-			// if the absolute angle is less than 45.0F, then the player is next to the tile (i.e. the tile was a wall).
-			if (abs(umath::radiansToDegrees(theta)) < compAngle)
-			{
-				if (distVec.x <= 0.0F) // canceling rightward movement
-				{
-					plyr->cancelRight = true;
-					plyr->setPositionX(tile->getPositionX() - abs(minDistVec.x)); // pushing the player out of the wall.
-				}
-				else if (distVec.x > 0.0F) // canceling leftward movement.
-				{
-					plyr->cancelLeft = true;
-					plyr->setPositionX(tile->getPositionX() + abs(minDistVec.x)); // pushing the player out of the wall.
-				}
-				plyr->zeroVelocityX(); // removing (x) (horizontal) velocity
-
-			}
-			// if the player is at an angle greater than 45.0F, the player is on top or below the platform.
-			else if (abs(umath::radiansToDegrees(theta)) >= compAngle)
-			{
-				if (distVec.y <= 0.0F) // canceling movement downards.
-				{
-					plyr->setPositionY(tile->getPositionY() - abs(minDistVec.y) - 10.0F); // moving the player out of the floor
-
-					if(debug == false) 
-						plyr->setAntiGravity(false); // the player is on top of a platform, so disable gravity.
-				
-				}
-				else if (distVec.y > 0.0F) // cancelling movememt upwards
-				{
-					plyr->cancelDown = true;
-					plyr->setPositionY(tile->getPositionY() + abs(minDistVec.y)); // moving the player out of the cieling
-
-					if(debug == false)
-						plyr->setAntiGravity(true); // gravity back on
-				}
-
-				platformBelow = true; // if the player's on a platform, this becomes true. This is probably not in a good place.
-				plyr->zeroVelocityY();
-			}
-
-			// empties contents for next check.
-			colPrim1 = nullptr;
-			colPrim2 = nullptr;
-			plyr->collidedPrimitive = nullptr;
-			tile->collidedPrimitive = nullptr;
-			tile = nullptr;
-		
-		}
-	}
-
-	// if the player is on a platform, they can now jump.
-	if (platformBelow == true)
-		canJump = true;
-}
-
-// collisions between enemies and tiles
-// This was not completed, and not used in the final build.
-void MSQ_GameplayScene::enemyTileCollisions()
-{
-	OOP::Primitive * colPrim1; // the primitive from the enemy that encountered a collision
-	OOP::Primitive * colPrim2; // the primitive from the tile that caused collision.
-
-	for (entity::Enemy * emy : *sceneEnemies)
-	{
-		for (entity::Tile * tile: *sceneTiles)
-		{
-			if (emy->collision(tile)) // if there is collision.
-			{
-				if (emy->getMoveForceY() != 0.0F) // if the enemy is choosing to move vertically.
-				{
-					emy->moveUp = !emy->moveUp; // makes the enemy move in the opposite direction.
-				}
-				else if (emy->getMoveForceY() == 0.0F) // if the enemy is not moving, and has fallen via gravity.
-				{
-					emy->setAntiGravity(true); // sets gravity to true
-				}
-
-				if (emy->getMoveForceX() != 0.0F) // stop movement right
-				{
-					emy->moveRight = !emy->moveRight;
-				}
-
-			}
-		}
-	}
-}
-
-// calculates player collision with enemies
-void MSQ_GameplayScene::playerEnemyCollisions()
-{
-	float offset = 0.0F;
-
-	if (plyr->getInvincible()) // if the player currently has invincibility frames, then the enemy collisions are ignored.
-		return;
-
-	for each(entity::Enemy * enemy in *sceneArea->getAreaEnemies())
-	{
-		// checks if the enemy is close enough for collision checks (optimization).
-		if (abs(enemy->getPosition().x - plyr->getPosition().x) > 768 || abs(enemy->getPosition().y - plyr->getPosition().y) > 768)
-		{
-			enemy->onScreen = false;
-			continue;
-		}
-		else
-		{
-			enemy->onScreen = true;
-		}
-
-		if (entity::Entity::collision(plyr, enemy)) // checks for collision
-		{
-			// player takes damage
-			plyr->setHealth(plyr->getHealth() - magic::MagicType::damage(enemy->getMagicType(), plyr->getMagicType(), enemy->getAttackPower()));
-			plyr->gotHit();
-
-			break;
-
-		}
-	}
-}
-
-// collision between the player's current weapon and the enemy.
-void MSQ_GameplayScene::weaponEnemyCollisions()
-{
-	entity::Weapon * weapon = plyr->getCurrentWeapon(); // the player's active weapon
-	magic::Magic weaponMagic; // gets the magic type of the weapon.
-	float offset = 0.0F; // saves the offset needed for the mpBar
-
-	entity::Enemy * emy = nullptr; // temporary enemy object.
-
-	if (weapon == nullptr)
-		return;
-
-	// if the player has no magic power, then the weapon's type is switched to 'null' for the collisions.
-	weaponMagic = (plyr->getMagicPower() > 0.0F) ? weapon->getMagicType() : magic::Magic(magic::null);
-
-	for(int i = 0; i < sceneEnemies->size(); i++)
-	{
-		if (sceneEnemies->at(i) == nullptr)
-			continue;
-
-
-		// checks if the nemey is close enough for collision checks.
-		if (abs(sceneEnemies->at(i)->getPosition().x - plyr->getPosition().x) > winSize.width / 1.80F  || abs(sceneEnemies->at(i)->getPosition().y - plyr->getPosition().y) > winSize.height / 1.80F)
-		{
-			sceneEnemies->at(i)->onScreen = false; // enemy not on screen
-			continue;
-		}
-		else
-		{
-			sceneEnemies->at(i)->onScreen = true; // enemy not on screen.
-		}
-
-		// gets collided enemy.
-		emy = sceneEnemies->at(i);
-
-		// so essenially, a problem with the weapon collisions is that they would be based off the weapon's sprite instead of the player's sprite under a normal function call.
-		// as such, a collision body needs to be paired with the player that only contains the weapons at the appropriate spot, hence the function call.
-		if (entity::Entity::collision(plyr, weapon->getOffsetCollisionBodies(weapon->getOwner()->getSprite(), weapon->getCollisionBodies()), sceneEnemies->at(i), sceneEnemies->at(i)->getOffsetCollisionBodies())) // checks for collision.
-		{
-			// if the player has no magic power, then the weapon's attack power is cut in half, and has a type value of 'null'.
-			sceneEnemies->at(i)->setHealth(sceneEnemies->at(i)->getHealth() - 
-				magic::Magic::damage(weaponMagic, emy->getMagicType(), weapon->getDamage() / (plyr->getMagicPower() > 0.0F) ? 1 : 2));
-
-			sceneEnemies->at(i)->gotHit(); // the enemy has been hit
-
-			plyr->addMagicPower(-1 * (weapon->getMagicUsage())); // reduces the player's magic.
-			offset = mpBarRect.getMaxX() * (plyr->getMagicPower() / plyr->getMagicPowerMax()); // calculates the offset needed to reposition the newly sized mp bar properly.
-
-			mpBar[1]->setTextureRect(Rect(0.0F, mpBarRect.getMaxY(), mpBarRect.getMaxX() * (plyr->getMagicPower() / plyr->getMagicPowerMax()), mpBarRect.getMaxY())); // changing the size of the mp bar.
-
-			// This takes the size of the hpBar at full size (hpBarRect.getMaxX()), and then halves it.
-			// It then subtracts the position of hpBar[0] (i.e. the frame doesn't move) by it, and then adds the new size of the health bar divided by '2' to it.
-			// in other words it basically just aligns itself with the left edge of the frame and then moves it over by half of the health bar's current length, since the position is based on its centre.
-			// this is all so the hp bar is where it should be.
-			mpBar[1]->setPositionX(mpBar[0]->getPositionX() - mpBarRect.getMaxX() / 2 + offset / 2);
-
-			break;
-		}
-	}
-
-}
-
-
 // update loop
 void MSQ_GameplayScene::update(float deltaTime)
 {
-	static float playerFallTime = 0.0F; // how long the player has been falling for. This is used to help respawn them when they fall off the edge of the world.
-	const float playerFallTimeMax = 6.5F; // how long the player should fall before getting back to the spawn point.
-
-
 	float d_movespeed = 300.0F; // the movement speed of the player (when debug is on).
 	float offset = 0.0F; // used to help with repositioning HUD assets.
+	std::string exitName = ""; // the exit the player has reached.
 
 	if (switchingScenes) // updates are no longer run if the scene is being switched.
 		return;
 
-	debugMode(); // called to change the settings if debug mode has been turned on/off.
+	world::World::updatePreloads(); // requests the textures of any areas that have finished preloading.
+
+	// starts timing this frame. The phase timers are stopped by hand, since the phases don't line up with blocks of code.
+	profiler.beginFrame();
+	profiler.addTime(framePhase, deltaTime * 1000.0F);
+	OOP::ScopedTimer updateTimer(&profiler, updatePhase);
+	OOP::ScopedTimer inputTimer(&profiler, inputPhase);
+
+	// the sprites were interpolated at the end of the last frame, so they're put back before anything uses their positions.
+	simulation.endInterpolation();
+
+	debugMode();
+	simulation.setDebug(debug); // called to change the settings if debug mode has been turned on/off.
 
 	// if the cancels are true, then the player can't move that given direction.
 	if (plyr->moveUp && !plyr->cancelUp) // moves the player up.
@@ -885,105 +705,39 @@ void MSQ_GameplayScene::update(float deltaTime)
 
 	}
 
-	// triggers the player's idle animation if no other animation should take presedence
-	if (plyr->moveLeft == false && plyr->moveRight == false && plyr->jump == false && plyr->getVelocity() == Vec2(0.0F, 0.0F))
+	// in debug mode, the player moves at a fixed speed. Otherwise, the movement force is added in the physics step, which also chooses the player's animation (see world::Simulation::step()).
+	if (debug)
 	{
-		if (plyr->getCurrentAnimation() != nullptr)
-		{
-			if (plyr->getCurrentAnimation()->getTag() != 2)
-			{
-				plyr->runAction(2);
-			}
-		}
-	}
-
-
-	if (plyr->moveLeft && !plyr->cancelLeft) // moving left
-	{
-		if (plyr->getFlippedSpriteX() == false) // flips the sprite so that it's facing left
-			plyr->setFlippedSpriteX(true);
-
-		if (debug) // if debug is on, then the player moves at a fixed speed.
+		if (plyr->moveLeft && !plyr->cancelLeft) // moving left
 			plyr->setPositionX(plyr->getPositionX() - d_movespeed * deltaTime);
-		else
-			plyr->addForce(plyr->getMoveForceX() * -1, 0.0F);
-
-		if (plyr->getCurrentAnimation()->getTag() != 4) // sets up the variables to trigger the running animation.
-		{
-			plyrAction = true;
-			pAction = 4;
-		}
-
-	}
-	else if (plyr->moveRight && !plyr->cancelRight) // moving right
-	{
-		if (plyr->getFlippedSpriteX() == true) // flips the sprite so that it's facing right (i.e. the default)
-			plyr->setFlippedSpriteX(false);
-
-		if(debug) // if debug is on, then the player moves at a fixed speed.
+		else if (plyr->moveRight && !plyr->cancelRight) // moving right
 			plyr->setPositionX(plyr->getPositionX() + d_movespeed * deltaTime);
-		else // if debug is off, the player is given force to move.
-			plyr->addForce(plyr->getMoveForceX(), 0.0F);
-
-		if (plyr->getCurrentAnimation()->getTag() != 4) // sets up the variables to trigger the running animation.
-		{
-			plyrAction = true;
-			pAction = 4;
-		}
 	}
-	else
-	{
-		if (plyr->getCurrentAnimation()->getTag() != 2) // return to idle animation.
-		{
-			pAction = true;
-			plyr->runAction(2);
-		}
-	}
-	
-	if (plyr->jump && canJump) // if the has decided to jump, and that is allowed.
-	{
-		plyr->setPositionY(plyr->getPositionY() + 10.0F); // this was an attempt to fix the jump issue. It didn't work.
-		plyr->addJumpForce(); // adds the jump force.
 
-		// triggers the proper animation (which only appears for a moment), and resets variables.
-		plyr->jump = false;
-		canJump = false;
-		plyrAction = true;
-		pAction = 5;
+	inputTimer.stop();
 
-		
-	}
-	else if (plyr->jump && !canJump) // if the player can't jump, then the 'jump' variable is set to false again.
+	// runs the physics steps for this frame, which apply the input, and update the player, the area, and the collisions (see world::Simulation).
+	simulation.advance(deltaTime);
+
+	if (simulation.exitReached()) // the player has touched an exit, so the area is switched.
 	{
-		plyr->jump = false;
+		exitName = simulation.getExit();
+		switchArea(exitName);
 	}
 
-	if (plyrAction) // animation should be played
+	// prints out how many draw calls the last frame took, and how many of them were for the tiles.
+	if (debug || REPORT_DRAW_CALLS)
 	{
-		switch (pAction)
-		{
-		case 6: // attack animation (which is triggered in useWeapon()).
+		drawCallTimer += deltaTime;
 
-			plyr->useWeapon();
-			pAction = 0;
-			break;
-
-		default:
-			plyr->runAction(pAction); // starts animation.
-			pAction = 0;
-			break;
+		if (drawCallTimer >= 1.0F)
+		{
+			std::cout << "Draw calls: " << director->getRenderer()->getDrawnBatches() << " (tile batches: " << sceneArea->getTileBatchCount() << ", tile chunks: " << sceneArea->getTileChunkCount() << ")" << std::endl;
+			drawCallTimer = 0.0F;
 		}
-
-		plyrAction = false;
 	}
 
-	// updates the player
-	plyr->update(deltaTime);
-
-	// updates the area the player is currently in. This update also updates the scene tiles, and enemies.
-	sceneArea->update(deltaTime);
-
-	collisions(); // collisions
+	OOP::ScopedTimer hudTimer(&profiler, hudPhase);
 
 	// moves the hp bar, and updates it with the current amount of health the player has.
 	offset = hpBarRect.getMaxX() * (plyr->getHealth() / plyr->getMaxHealth()); // calculates the offset needed to reposition the newly sized hp bar.
@@ -996,6 +750,11 @@ void MSQ_GameplayScene::update(float deltaTime)
 	hpBar[1]->setPositionX(hpBar[0]->getPositionX() - hpBarRect.getMaxX() / 2 + offset / 2);
 	hpBarPos = hpBar[1]->getPosition();
 
+	// moves the mp bar, and updates it with the current amount of magic power the player has. This is the same as the hp bar.
+	offset = mpBarRect.getMaxX() * (plyr->getMagicPower() / plyr->getMagicPowerMax()); // calculates the offset needed to reposition the newly sized mp bar properly.
+	mpBar[1]->setTextureRect(Rect(0.0F, mpBarRect.getMaxY(), mpBarRect.getMaxX() * (plyr->getMagicPower() / plyr->getMagicPowerMax()), mpBarRect.getMaxY())); // changing the size of the mp bar.
+	mpBar[1]->setPositionX(mpBar[0]->getPositionX() - mpBarRect.getMaxX() / 2 + offset / 2);
+
 
 	for (int i = 0; i < HUD_WEAPONS_ROWS; i++) // updates weapons
 	{
@@ -1004,7 +763,7 @@ void MSQ_GameplayScene::update(float deltaTime)
 			if (weaponImages[i] != plyr->getWeapon(i)->getTextureFilePath()) // if the weapon has been changed out.
 			{
 				weaponImages[i] = plyr->getWeapon(i)->getTextureFilePath(); // gets the image path
-				hudWeapons[i][1]->setTexture(weaponImages[i]); // changes the image.
+				OOP::TextureAtlas::setTexture(hudWeapons[i][1], weaponImages[i]); // changes the image.
 				
 				switch (plyr->getWeapon(i)->getMagic_T()) // the background should correspond with the weapon type, so that is also changed.
 				{
@@ -1047,12 +806,17 @@ void MSQ_GameplayScene::update(float deltaTime)
 
 	}
 
+	hudTimer.stop();
+	OOP::ScopedTimer cameraTimer(&profiler, cameraPhase);
+
+	// the time left over is less than a step, so the sprites are drawn that far between the last two steps. The camera follows the interpolated player.
+	simulation.interpolate();
 
 	if (ENABLE_CAMERA) // updates the camera if it's active.
 	{
 		this->getDefaultCamera()->setPosition(plyr->getPosition()); // sets the position of the camera so that it follows the player
 
-		sceneArea->setAllLayerPositions(this->getDefaultCamera()->getPosition()); // makes the backgrounds be directly behind the player. This would've been changed later if we had time for parallax scrolling.
+		sceneArea->updateLayers(this->getDefaultCamera()->getPosition(), director->getWinSize()); // scrolls each layer by its own scroll factor, and streams in the tiles that came into view (see world::ParallaxLayer).
 
 		for (int i = 0; i < HUD_WEAPONS_ROWS; i++) // updates hud weapon positions
 		{
@@ -1071,33 +835,35 @@ void MSQ_GameplayScene::update(float deltaTime)
 			mpBar[i]->setPosition(mpBarPos);
 
 		grid->setPosition(gridOffset + getDefaultCamera()->getPosition()); // moves the grid so that it stays in place with the camera.
+		profilerLabel->setPosition(profilerOffset + getDefaultCamera()->getPosition()); // moves the profiler overlay.
 	}
 
+	cameraTimer.stop();
+
 	if (enable_hud != hud->isVisible()) // if the hud's visibility is wrong, it's set accordingly.
 		hud->setVisible(enable_hud);
 
-	if (plyr->getAntiGravity() == false) // if the player is falling.
-	{
-		playerFallTime += deltaTime; // tracks time since fall began.
-
-		if (playerFallTime >= playerFallTimeMax) // if the player has fallen for long enough, they respawn.
-		{
-			plyr->setPosition(sceneArea->getSpawn(spawnPoint));
-			plyr->addHealth(-20.0F);
-			playerFallTime = 0.0F;
-			plyr->gotHit();
-		}
-	}
-	else
-	{
-		playerFallTime = 0.0F;
-	}
-
-	if (plyr->getHealth() == 0.0F) // the player takes damage if they had to respawn from a long fall. 
+	// the player is sent back to the spawn point if they fall for too long, which is done in the physics step (see world::Simulation::checkFall()).
+	if (simulation.playerDefeated()) // the player has run out of health, so they're sent back to the start with half of their health.
 	{
 		plyr->setHealth(plyr->getMaxHealth() / 2);
 		std::string tempStr = DEFAULT_AREA;
 		switchArea(tempStr);
 	}
 
+	// the frame is done, so its times are recorded.
+	updateTimer.stop();
+	profiler.endFrame();
+
+	// the overlay is only refreshed every so often, since sorting the samples every frame would show up in the profile.
+	if (showProfiler)
+	{
+		profilerTimer += deltaTime;
+
+		if (profilerTimer >= PROFILER_REFRESH)
+		{
+			profilerLabel->setString(profiler.getReport());
+			profilerTimer = 0.0F;
+		}
+	}
 }
@@ -16,9 +16,12 @@ Date: 04/04/2019
 #pragma once
 
 #include "areas/World.h"
+#include "areas/Simulation.h"
 #include "entities/Player.h"
 
 #include "Primitives.h"
+#include "Profiler.h"
+#include "TextureAtlas.h"
 #include "MouseListener.h"
 #include "KeyboardListener.h"
 #include "audio/AudioLibrary.h"
@@ -63,6 +66,9 @@ public:
 	// called to turn on and off some debug functions, i.e. switch debug settings.
 	void debugMode();
 
+	// starts or stops recording the player's input. Starting a recording restarts the current area, so that the recording can be played back from the same point.
+	void toggleRecording();
+
 	// switches from one area to another. The format is as follows: AIN_###_#.
 	// the last digit is needed to know what spawn point to use. It must be greater than or equal to 0, and not exceed 4 (it can be 4 though). So it's just 0-4.
 	// if the string does not have a length of 9 (which is what it should be under all circumstances), an exception is thrown.
@@ -71,23 +77,12 @@ public:
 	// called to exit the game. This handles information that should be removed or changed before the player starts a new game.
 	void exitGame();
 
-	// called to handle collisions between entities.
-	void collisions();
-	
-	
-	void playerTileCollisions(); // player tile collisions
-	void enemyTileCollisions(); // enemy-tile collisions
-	void playerEnemyCollisions(); // player enemy collisions
-	void weaponEnemyCollisions(); // collisions between the player's weapon and the enemies.
-
-
 	// update function for the scene
 	void update(float deltaTime);
 	
 	CREATE_FUNC(MSQ_GameplayScene);
 
 	Size winSize; // the window size. Used for optimizing update loops and collisions.
-	bool canJump = true; // used to check if the player should be allowd to jump or not.
 
 
 private:
@@ -99,6 +94,23 @@ private:
 	const bool ENABLE_MOUSE = true; // turns mouse functionality on/off.
 	const bool ENABLE_KEYBOARD = true; // turns keyboard functionality on/off.
 	const bool ENABLE_CAMERA = true; // enables (or disables) the game camera.
+	const bool REPORT_DRAW_CALLS = false; // if 'true', the amount of draw calls is printed out once a second. This also happens in debug mode.
+
+	float drawCallTimer = 0.0F; // counts up to when the draw calls should be printed out next.
+
+	// times each part of the update (see OOP::Profiler). 'P' toggles the overlay, and 'O' saves the statistics to profile_<area>.csv and profile_<area>.json.
+	OOP::Profiler profiler;
+	unsigned int framePhase = 0; // the time between frames, which includes drawing. This is what should stay under 16.6ms.
+	unsigned int updatePhase = 0; // the whole update function.
+	unsigned int inputPhase = 0; // handling the player's input and animations.
+	unsigned int hudPhase = 0; // updating the hud.
+	unsigned int cameraPhase = 0; // interpolating the sprites and moving the camera.
+
+	static bool showProfiler; // becomes 'true' when the profiler overlay is on. This stays on between areas.
+	Label * profilerLabel = nullptr; // the overlay showing the profiler statistics.
+	Vec2 profilerOffset = Vec2(0.0F, 0.0F); // the position of the overlay relative to the camera.
+	float profilerTimer = 0.0F; // counts up to when the overlay should be refreshed next.
+	const float PROFILER_REFRESH = 0.5F; // how often the overlay is refreshed, in seconds.
 
 	static bool debug; // becomes 'true' when debug mode is turned on.
 	static bool enable_hud; // enables the hud, or disables it.
@@ -123,18 +135,20 @@ private:
 
 
 	entity::Player * plyr; // the object used for the player.
-	bool plyrAction = false; // becomes 'true' when a new animation should be played for the player.
-	int pAction = 0; // saves the action the player is taking.
 	
 	// used for saving information between scenes.
-	static int pHealth; // the player's current health when leaving the scene.
-	static int pHealthMax; // the player's max health when leaving the scene.
-	static int pMagic; // the player's magic amount when leaving the scene.
-	static int pMagicMax; // the player's maximum magic amount when leaving the scene.
-	static std::vector<int> pWeapons; // the player's weapons when leaving the scene.
+	static world::PlayerStats playerStats; // the player's health, magic, and weapons when leaving the scene.
+	static unsigned int stepCount; // the amount of physics steps that have been run when leaving the scene.
+
+	// 'R' starts recording the player's input from the start of the current area, and pressing it again saves the recording to replay_<area>.msqr.
+	// the recording can be played back with the mashadeau_sim program (see the 'sim' folder).
+	static world::InputRecording * recording; // the recording in progress. This is kept between scenes so that a recording can go through several areas.
+	static bool startRecording; // becomes 'true' when a recording should start at the beginning of the next scene.
 
 	std::vector<entity::Tile *> * sceneTiles; // the tiles in the scene, which are gotten from the Area class.
 	std::vector<entity::Enemy *> * sceneEnemies; // the enemies in the scene, which are gotten from the Area class.
+
+	world::Simulation simulation; // runs the physics and collisions for the area and the player.
 	
 	DrawNode * hud; // the drawNode used for making the hud.
 	const int BAR_LEN = 3; // the amount of items in the health bar array (see below)
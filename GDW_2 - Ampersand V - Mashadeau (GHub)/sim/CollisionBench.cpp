@@ -0,0 +1,509 @@
+// times the box, circle, and capsule collision checks against the checks they replaced, using random shapes. Nothing from the game is loaded.
+// usage: collision_bench [rounds]
+//	- each round checks every pair in the set once (4096 pairs). The default is 200 rounds.
+// for each check, the time per pair is printed for the old and new versions, along with how many pairs they disagree on.
+// both versions are also checked against a slow reference that clips the boxes as polygons (in doubles), and the amount of pairs each one gets wrong is printed. The old OBB check is an approximation, so it's expected to get some wrong.
+// the batch checks (see CollisionBatch.h) are also compared with the checks they filter for, using random shapes and shapes lined up on the tile grid. They use SSE2 by default; build with -mavx to check the AVX versions.
+#include "CollisionBatch.h"
+#include "Primitives.h"
+#include "Utilities.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// the amount of shape pairs that are checked each round.
+static const unsigned int PAIR_COUNT = 4096;
+
+// a pair of shapes, along with the rects and angles the old checks take.
+struct ShapePair
+{
+	OOP::WorldShape shape1;
+	OOP::WorldShape shape2;
+
+	cocos2d::Rect rect1; // the rect of the first shape (a circle's rect is the square around it).
+	cocos2d::Rect rect2;
+	float theta1 = 0.0F; // the rotations of the shapes, in radians.
+	float theta2 = 0.0F;
+};
+
+// makes an AABB world shape.
+static OOP::WorldShape makeAabb(const cocos2d::Vec2 & centre, const cocos2d::Vec2 & size, cocos2d::Rect & rect)
+{
+	OOP::WorldShape shape;
+
+	shape.id = 1;
+	shape.source = nullptr;
+	shape.aabb.min = centre - size / 2;
+	shape.aabb.max = centre + size / 2;
+	rect = cocos2d::Rect(shape.aabb.min, cocos2d::Size(size.x, size.y));
+
+	return shape;
+}
+
+// makes an OBB world shape. The sine and cosine are worked out here, the same as OOP::Primitive::getWorldShape().
+static OOP::WorldShape makeObb(const cocos2d::Vec2 & centre, const cocos2d::Vec2 & size, float theta, cocos2d::Rect & rect)
+{
+	OOP::WorldShape shape;
+
+	shape.id = 2;
+	shape.source = nullptr;
+	shape.obb.centre = centre;
+	shape.obb.size = size;
+	shape.obb.theta = theta;
+	shape.obb.cosTheta = cosf(theta);
+	shape.obb.sinTheta = sinf(theta);
+	rect = cocos2d::Rect(centre - size / 2, cocos2d::Size(size.x, size.y));
+
+	return shape;
+}
+
+// makes a circle world shape.
+static OOP::WorldShape makeCircle(const cocos2d::Vec2 & centre, float radius, cocos2d::Rect & rect)
+{
+	OOP::WorldShape shape;
+
+	shape.id = 3;
+	shape.source = nullptr;
+	shape.circle.centre = centre;
+	shape.circle.radius = radius;
+	rect = cocos2d::Rect(centre - cocos2d::Vec2(radius, radius), cocos2d::Size(radius * 2, radius * 2));
+
+	return shape;
+}
+
+// makes a capsule world shape.
+static OOP::WorldShape makeCapsule(const cocos2d::Vec2 & centre, float length, float radius, float theta)
+{
+	OOP::WorldShape shape;
+	cocos2d::Vec2 offset = umath::rotate(cocos2d::Vec2(length / 2, 0.0F), theta); // from the centre to one of the circles.
+
+	shape.id = 5;
+	shape.source = nullptr;
+	shape.capsule.start = centre - offset;
+	shape.capsule.end = centre + offset;
+	shape.capsule.radius = radius;
+
+	return shape;
+}
+
+// a point for the reference checks, which use doubles so that they're more exact than the checks they're compared with.
+struct ReferencePoint
+{
+	double x = 0.0;
+	double y = 0.0;
+};
+
+// the corners of an AABB or OBB world shape, going counter-clockwise.
+static std::vector<ReferencePoint> getCorners(const OOP::WorldShape & shape)
+{
+	std::vector<ReferencePoint> corners(4);
+
+	if (shape.id == 1) // AABB
+	{
+		corners[0].x = shape.aabb.min.x; corners[0].y = shape.aabb.min.y;
+		corners[1].x = shape.aabb.max.x; corners[1].y = shape.aabb.min.y;
+		corners[2].x = shape.aabb.max.x; corners[2].y = shape.aabb.max.y;
+		corners[3].x = shape.aabb.min.x; corners[3].y = shape.aabb.max.y;
+	}
+	else // OBB
+	{
+		const double HALF_X = shape.obb.size.x / 2.0, HALF_Y = shape.obb.size.y / 2.0; // the half size of the box.
+		const double SIGNS[4][2] = { { -1.0, -1.0 }, { 1.0, -1.0 }, { 1.0, 1.0 }, { -1.0, 1.0 } };
+		const double COS = std::cos((double)shape.obb.theta), SIN = std::sin((double)shape.obb.theta);
+
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			corners[i].x = shape.obb.centre.x + SIGNS[i][0] * HALF_X * COS - SIGNS[i][1] * HALF_Y * SIN;
+			corners[i].y = shape.obb.centre.y + SIGNS[i][0] * HALF_X * SIN + SIGNS[i][1] * HALF_Y * COS;
+		}
+	}
+
+	return corners;
+}
+
+// which side of the line from 'a' to 'b' the point is on. This is positive on the left, negative on the right, and 0 on the line.
+static double side(const ReferencePoint & a, const ReferencePoint & b, const ReferencePoint & point)
+{
+	return (b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x);
+}
+
+// clips a polygon to the left side of the line from 'a' to 'b' (Sutherland-Hodgman). Points on the line are kept.
+static std::vector<ReferencePoint> clipPolygon(const std::vector<ReferencePoint> & polygon, const ReferencePoint & a, const ReferencePoint & b)
+{
+	std::vector<ReferencePoint> clipped;
+
+	for (unsigned int i = 0; i < polygon.size(); i++)
+	{
+		const ReferencePoint & current = polygon[i];
+		const ReferencePoint & next = polygon[(i + 1) % polygon.size()];
+		double currentSide = side(a, b, current), nextSide = side(a, b, next);
+
+		if (currentSide >= 0.0)
+			clipped.push_back(current);
+
+		// the edge crosses the line, so the point where it crosses is added.
+		if ((currentSide >= 0.0) != (nextSide >= 0.0))
+		{
+			double t = currentSide / (currentSide - nextSide);
+			ReferencePoint crossing;
+
+			crossing.x = current.x + (next.x - current.x) * t;
+			crossing.y = current.y + (next.y - current.y) * t;
+			clipped.push_back(crossing);
+		}
+	}
+
+	return clipped;
+}
+
+// checks if two convex polygons (going counter-clockwise) overlap by clipping the first to every edge of the second. Anything that's left is in both.
+static bool polygonsOverlap(const std::vector<ReferencePoint> & polygon1, const std::vector<ReferencePoint> & polygon2)
+{
+	std::vector<ReferencePoint> clipped = polygon1;
+
+	for (unsigned int i = 0; i < polygon2.size() && !clipped.empty(); i++)
+		clipped = clipPolygon(clipped, polygon2[i], polygon2[(i + 1) % polygon2.size()]);
+
+	return !clipped.empty();
+}
+
+// the distance from a point to the segment from 'a' to 'b'.
+static double pointSegmentDistance(const ReferencePoint & point, const ReferencePoint & a, const ReferencePoint & b)
+{
+	double dx = b.x - a.x, dy = b.y - a.y;
+	double lengthSq = dx * dx + dy * dy;
+	double t = (lengthSq > 0.0) ? ((point.x - a.x) * dx + (point.y - a.y) * dy) / lengthSq : 0.0; // how far along the segment the closest point is.
+
+	t = std::max(0.0, std::min(1.0, t));
+	return std::hypot(a.x + dx * t - point.x, a.y + dy * t - point.y);
+}
+
+// checks if the segments from 'a1' to 'b1' and 'a2' to 'b2' cross.
+static bool segmentsCross(const ReferencePoint & a1, const ReferencePoint & b1, const ReferencePoint & a2, const ReferencePoint & b2)
+{
+	return (side(a1, b1, a2) >= 0.0) != (side(a1, b1, b2) >= 0.0) && (side(a2, b2, a1) >= 0.0) != (side(a2, b2, b1) >= 0.0);
+}
+
+// the distance between two segments.
+static double segmentSegmentDistance(const ReferencePoint & a1, const ReferencePoint & b1, const ReferencePoint & a2, const ReferencePoint & b2)
+{
+	if (segmentsCross(a1, b1, a2, b2))
+		return 0.0;
+
+	return std::min(std::min(pointSegmentDistance(a1, a2, b2), pointSegmentDistance(b1, a2, b2)), std::min(pointSegmentDistance(a2, a1, b1), pointSegmentDistance(b2, a1, b1)));
+}
+
+// the distance from a segment to a convex polygon (going counter-clockwise). This is 0 if the segment is in the polygon or crosses it.
+static double segmentPolygonDistance(const ReferencePoint & a, const ReferencePoint & b, const std::vector<ReferencePoint> & polygon)
+{
+	bool inside = true; // whether 'a' is in the polygon.
+	double distance = INFINITY;
+
+	for (unsigned int i = 0; i < polygon.size(); i++)
+	{
+		inside = inside && side(polygon[i], polygon[(i + 1) % polygon.size()], a) >= 0.0;
+		distance = std::min(distance, segmentSegmentDistance(a, b, polygon[i], polygon[(i + 1) % polygon.size()]));
+	}
+
+	return inside ? 0.0 : distance;
+}
+
+// turns a cocos2d::Vec2 into a reference point.
+static ReferencePoint toPoint(const cocos2d::Vec2 & vec)
+{
+	ReferencePoint point;
+
+	point.x = vec.x;
+	point.y = vec.y;
+	return point;
+}
+
+// the reference check for a pair. Boxes are clipped against each other as polygons, and circles and capsules are compared to the distance to their centre point or line.
+static bool referenceCheck(const ShapePair & pair)
+{
+	const OOP::WorldShape & shape1 = pair.shape1;
+	const OOP::WorldShape & shape2 = pair.shape2;
+
+	if (shape1.id == 5 && shape2.id == 5) // capsule - capsule
+		return segmentSegmentDistance(toPoint(shape1.capsule.start), toPoint(shape1.capsule.end), toPoint(shape2.capsule.start), toPoint(shape2.capsule.end)) <= (double)shape1.capsule.radius + shape2.capsule.radius;
+	else if (shape1.id == 5) // capsule - box
+		return segmentPolygonDistance(toPoint(shape1.capsule.start), toPoint(shape1.capsule.end), getCorners(shape2)) <= shape1.capsule.radius;
+	else if (shape1.id == 3) // circle - box (a circle is a capsule with no length)
+		return segmentPolygonDistance(toPoint(shape1.circle.centre), toPoint(shape1.circle.centre), getCorners(shape2)) <= shape1.circle.radius;
+	else // box - box
+		return polygonsOverlap(getCorners(shape1), getCorners(shape2));
+}
+
+// times a check over all of the pairs. 'hits' gets how many pairs collided in one round, and each pair's result is saved to 'results'.
+template<typename Check>
+static double timeCheck(const std::vector<ShapePair> & pairs, unsigned int rounds, Check check, std::vector<bool> & results, unsigned int & hits)
+{
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	unsigned int total = 0; // used so that the checks can't be optimized out.
+
+	for (unsigned int round = 0; round < rounds; round++)
+	{
+		for (const ShapePair & pair : pairs)
+			total += check(pair) ? 1 : 0;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+	results.clear();
+	for (const ShapePair & pair : pairs)
+		results.push_back(check(pair));
+
+	hits = total / rounds;
+	return seconds * 1000000000.0 / ((double)rounds * pairs.size());
+}
+
+// times the old and new versions of a check, and prints the results, along with how many pairs each one got wrong compared to referenceCheck(). If 'hasOld' is false, there was no old check.
+template<typename OldCheck, typename NewCheck>
+static void compare(const std::string & name, const std::vector<ShapePair> & pairs, unsigned int rounds, OldCheck oldCheck, NewCheck newCheck, bool hasOld = true)
+{
+	std::vector<bool> oldResults, newResults; // the result of each pair.
+	unsigned int oldHits = 0, newHits = 0; // how many pairs collided.
+	unsigned int differences = 0; // how many pairs the checks disagreed on.
+	unsigned int oldWrong = 0, newWrong = 0; // how many pairs the checks disagreed with the reference on.
+	double oldTime = 0.0, newTime = 0.0; // the time per pair, in nanoseconds.
+	bool reference = false; // the reference result for a pair.
+
+	newTime = timeCheck(pairs, rounds, newCheck, newResults, newHits);
+
+	if (hasOld)
+		oldTime = timeCheck(pairs, rounds, oldCheck, oldResults, oldHits);
+
+	for (unsigned int i = 0; i < pairs.size(); i++)
+	{
+		reference = referenceCheck(pairs[i]);
+		newWrong += (newResults[i] != reference) ? 1 : 0;
+
+		if (hasOld)
+		{
+			oldWrong += (oldResults[i] != reference) ? 1 : 0;
+			differences += (oldResults[i] != newResults[i]) ? 1 : 0;
+		}
+	}
+
+	std::cout.width(18);
+	std::cout << std::left << name;
+
+	if (hasOld)
+		std::cout << "old " << oldTime << " ns (" << oldHits << " hits, " << oldWrong << " wrong)   new " << newTime << " ns (" << newHits << " hits, " << newWrong << " wrong)   "
+			<< differences << " pairs differ" << std::endl;
+	else
+		std::cout << "old (no check)   new " << newTime << " ns (" << newHits << " hits, " << newWrong << " wrong)" << std::endl;
+}
+
+// the shapes used for the batch checks. The 'shape' values go into the batches, and the 'query' values are checked against them.
+struct BatchShapes
+{
+	std::vector<cocos2d::Vec2> boxMins, boxMaxes; // the boxes in the box batch.
+	std::vector<cocos2d::Vec2> circleCentres; // the circles in the circle batch.
+	std::vector<float> circleRadii;
+
+	std::vector<cocos2d::Vec2> queryMins, queryMaxes; // the boxes checked against the box batch.
+	std::vector<cocos2d::Vec2> queryCentres; // the circles checked against both batches.
+	std::vector<float> queryRadii;
+};
+
+/*
+ * checks one kind of batch check against the scalar check it stands in for. The batch checks are prefilters, so they have to hit everything the scalar check hits,
+ * but they can hit more (e.g. touching boxes, which umath::aabbCollision() doesn't count). Every query is checked against every shape twice: once in batches of
+ * umath::BATCH_SIZE, which go through the vector versions, and once in a batch of its own, which goes through the scalar version at the end of each batch check.
+ * the two have to give the same result. The pairs the batch missed (which should be 0), the extra pairs it hit, and the time per pair for both checks are printed.
+*/
+template<typename Batch, typename BatchCheck, typename ScalarCheck>
+static void compareBatch(const std::string & name, unsigned int queries, unsigned int rounds, const Batch & batch, const std::vector<Batch> & singles, BatchCheck batchCheck, ScalarCheck scalarCheck)
+{
+	unsigned int missed = 0; // the pairs the scalar check hit, but the batch didn't.
+	unsigned int extra = 0; // the pairs the batch hit, but the scalar check didn't.
+	unsigned int laneDifferences = 0; // the pairs where the full batches and the batches of one disagreed.
+	unsigned int hits = 0; // how many pairs the scalar check hit.
+	unsigned int total = 0; // used so that the checks can't be optimized out.
+	unsigned int mask = 0; // the result of a batch check.
+	bool lane = false; // the result for a pair in a full batch.
+	bool single = false; // the result for a pair in a batch of one.
+	bool hit = false; // the result of the scalar check.
+
+	for (unsigned int q = 0; q < queries; q++)
+	{
+		for (unsigned int first = 0; first < batch.size(); first += umath::BATCH_SIZE)
+		{
+			mask = batchCheck(q, batch, first);
+
+			for (unsigned int i = first; i < batch.size() && i < first + umath::BATCH_SIZE; i++)
+			{
+				lane = ((mask >> (i - first)) & 1U) != 0;
+				single = (batchCheck(q, singles[i], 0) & 1U) != 0;
+				hit = scalarCheck(q, i);
+
+				hits += hit ? 1 : 0;
+				missed += (hit && !lane) ? 1 : 0;
+				extra += (lane && !hit) ? 1 : 0;
+				laneDifferences += (lane != single) ? 1 : 0;
+			}
+		}
+	}
+
+	// the timings.
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (unsigned int round = 0; round < rounds; round++)
+	{
+		for (unsigned int q = 0; q < queries; q++)
+		{
+			for (unsigned int first = 0; first < batch.size(); first += umath::BATCH_SIZE)
+				total += batchCheck(q, batch, first) & 1U;
+		}
+	}
+
+	double batchTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count() * 1000000000.0 / ((double)rounds * queries * batch.size());
+	start = std::chrono::high_resolution_clock::now();
+
+	for (unsigned int round = 0; round < rounds; round++)
+	{
+		for (unsigned int q = 0; q < queries; q++)
+		{
+			for (unsigned int i = 0; i < batch.size(); i++)
+				total += scalarCheck(q, i) ? 1 : 0;
+		}
+	}
+
+	double scalarTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count() * 1000000000.0 / ((double)rounds * queries * batch.size());
+
+	std::cout.width(30);
+	std::cout << std::left << name << "batch " << batchTime << " ns   scalar " << scalarTime << " ns   (" << hits << " hits, " << extra << " extra, " << total % 2 << ")   "
+		<< missed << " missed, " << laneDifferences << " lanes differ" << std::endl;
+}
+
+// runs all three batch checks on a set of shapes.
+static void compareBatches(const std::string & name, const BatchShapes & shapes, unsigned int rounds)
+{
+	umath::BoxBatch boxes;
+	umath::CircleBatch circles;
+	std::vector<umath::BoxBatch> singleBoxes(shapes.boxMins.size());
+	std::vector<umath::CircleBatch> singleCircles(shapes.circleCentres.size());
+
+	for (unsigned int i = 0; i < shapes.boxMins.size(); i++)
+	{
+		boxes.add(shapes.boxMins[i], shapes.boxMaxes[i]);
+		singleBoxes[i].add(shapes.boxMins[i], shapes.boxMaxes[i]);
+	}
+
+	for (unsigned int i = 0; i < shapes.circleCentres.size(); i++)
+	{
+		circles.add(shapes.circleCentres[i], shapes.circleRadii[i]);
+		singleCircles[i].add(shapes.circleCentres[i], shapes.circleRadii[i]);
+	}
+
+	compareBatch("AABB batch (" + name + ")", (unsigned int)shapes.queryMins.size(), rounds, boxes, singleBoxes,
+		[&](unsigned int q, const umath::BoxBatch & batch, unsigned int first) { return umath::aabbCollisionBatch(shapes.queryMins[q], shapes.queryMaxes[q], batch, first); },
+		[&](unsigned int q, unsigned int i) { return umath::aabbCollision(shapes.queryMins[q], shapes.queryMaxes[q], shapes.boxMins[i], shapes.boxMaxes[i]); });
+
+	compareBatch("Circle - AABB batch (" + name + ")", (unsigned int)shapes.queryCentres.size(), rounds, boxes, singleBoxes,
+		[&](unsigned int q, const umath::BoxBatch & batch, unsigned int first) { return umath::aabbCircleCollisionBatch(shapes.queryCentres[q], shapes.queryRadii[q], batch, first); },
+		[&](unsigned int q, unsigned int i)
+		{
+			return umath::aabbCircleCollision(cocos2d::Rect(shapes.boxMins[i], cocos2d::Size(shapes.boxMaxes[i].x - shapes.boxMins[i].x, shapes.boxMaxes[i].y - shapes.boxMins[i].y)),
+				shapes.queryCentres[q], shapes.queryRadii[q]);
+		});
+
+	compareBatch("Circle batch (" + name + ")", (unsigned int)shapes.queryCentres.size(), rounds, circles, singleCircles,
+		[&](unsigned int q, const umath::CircleBatch & batch, unsigned int first) { return umath::circleCollisionBatch(shapes.queryCentres[q], shapes.queryRadii[q], batch, first); },
+		[&](unsigned int q, unsigned int i) { return umath::circleCollision(shapes.queryCentres[q], shapes.queryRadii[q], shapes.circleCentres[i], shapes.circleRadii[i]); });
+}
+
+int main(int argc, char ** argv)
+{
+	unsigned int rounds = (argc > 1) ? (unsigned int)std::stoul(argv[1]) : 200; // how many times each pair is checked.
+
+	std::mt19937 random(1396); // the same shapes are made every run.
+	std::uniform_real_distribution<float> position(-150.0F, 150.0F);
+	std::uniform_real_distribution<float> size(20.0F, 200.0F);
+	std::uniform_real_distribution<float> angle(0.0F, 6.2831853F);
+
+	std::vector<ShapePair> obbObb(PAIR_COUNT), aabbObb(PAIR_COUNT), circleObb(PAIR_COUNT), capsuleAabb(PAIR_COUNT), capsuleCapsule(PAIR_COUNT);
+
+	for (unsigned int i = 0; i < PAIR_COUNT; i++)
+	{
+		obbObb[i].theta1 = angle(random);
+		obbObb[i].theta2 = angle(random);
+		obbObb[i].shape1 = makeObb(cocos2d::Vec2(position(random), position(random)), cocos2d::Vec2(size(random), size(random)), obbObb[i].theta1, obbObb[i].rect1);
+		obbObb[i].shape2 = makeObb(cocos2d::Vec2(position(random), position(random)), cocos2d::Vec2(size(random), size(random)), obbObb[i].theta2, obbObb[i].rect2);
+
+		aabbObb[i].theta2 = angle(random);
+		aabbObb[i].shape1 = makeAabb(cocos2d::Vec2(position(random), position(random)), cocos2d::Vec2(size(random), size(random)), aabbObb[i].rect1);
+		aabbObb[i].shape2 = makeObb(cocos2d::Vec2(position(random), position(random)), cocos2d::Vec2(size(random), size(random)), aabbObb[i].theta2, aabbObb[i].rect2);
+
+		circleObb[i].theta2 = angle(random);
+		circleObb[i].shape1 = makeCircle(cocos2d::Vec2(position(random), position(random)), size(random) / 2, circleObb[i].rect1);
+		circleObb[i].shape2 = makeObb(cocos2d::Vec2(position(random), position(random)), cocos2d::Vec2(size(random), size(random)), circleObb[i].theta2, circleObb[i].rect2);
+
+		capsuleAabb[i].shape1 = makeCapsule(cocos2d::Vec2(position(random), position(random)), size(random), size(random) / 4, angle(random));
+		capsuleAabb[i].shape2 = makeAabb(cocos2d::Vec2(position(random), position(random)), cocos2d::Vec2(size(random), size(random)), capsuleAabb[i].rect2);
+
+		capsuleCapsule[i].shape1 = makeCapsule(cocos2d::Vec2(position(random), position(random)), size(random), size(random) / 4, angle(random));
+		capsuleCapsule[i].shape2 = makeCapsule(cocos2d::Vec2(position(random), position(random)), size(random), size(random) / 4, angle(random));
+	}
+
+	// the new checks all go through OOP::WorldShape::collision(), which is what the game uses.
+	auto newCheck = [](const ShapePair & pair) { return OOP::WorldShape::collision(pair.shape1, pair.shape2); };
+
+	// the old OBB check, which rotates the corners of both boxes and compares them as axis-aligned boxes.
+	auto oldObbCheck = [](const ShapePair & pair) { return umath::obbCollision(pair.rect1, pair.theta1, pair.rect2, pair.theta2, false); };
+
+	std::cout << "Checking " << PAIR_COUNT << " pairs " << rounds << " times." << std::endl;
+
+	compare("OBB - OBB", obbObb, rounds, oldObbCheck, newCheck);
+	compare("AABB - OBB", aabbObb, rounds, oldObbCheck, newCheck);
+	compare("Circle - OBB", circleObb, rounds, oldObbCheck, newCheck); // the old version treated the circle as the square around it.
+	compare("Capsule - AABB", capsuleAabb, rounds, newCheck, newCheck, false);
+	compare("Capsule - Capsule", capsuleCapsule, rounds, newCheck, newCheck, false);
+
+	// the batch checks. The random shapes never line up exactly, so the grid-aligned shapes are used to check touching shapes, which is what the tiles in an area do.
+	const unsigned int BATCH_SHAPES = 1024; // the shapes in each batch. This is a multiple of 8, so every full batch goes through the vector versions.
+	const unsigned int BATCH_QUERIES = 256; // the shapes checked against each batch.
+
+	BatchShapes randomShapes, gridShapes;
+	std::uniform_int_distribution<int> gridUnit(0, 15); // a position in half tiles (64 px).
+	std::uniform_int_distribution<int> gridSize(1, 4); // a size in half tiles.
+
+	for (unsigned int i = 0; i < BATCH_SHAPES; i++)
+	{
+		randomShapes.boxMins.push_back(cocos2d::Vec2(position(random), position(random)));
+		randomShapes.boxMaxes.push_back(randomShapes.boxMins.back() + cocos2d::Vec2(size(random), size(random)) / 2);
+		randomShapes.circleCentres.push_back(cocos2d::Vec2(position(random), position(random)));
+		randomShapes.circleRadii.push_back(size(random) / 4);
+
+		// the tiles in a 32 x 32 grid, and circles of the same size in the middle of them.
+		gridShapes.boxMins.push_back(cocos2d::Vec2((float)(i % 32), (float)(i / 32)) * 128.0F);
+		gridShapes.boxMaxes.push_back(gridShapes.boxMins.back() + cocos2d::Vec2(128.0F, 128.0F));
+		gridShapes.circleCentres.push_back(gridShapes.boxMins.back() + cocos2d::Vec2(64.0F, 64.0F));
+		gridShapes.circleRadii.push_back(64.0F);
+	}
+
+	for (unsigned int i = 0; i < BATCH_QUERIES; i++)
+	{
+		randomShapes.queryMins.push_back(cocos2d::Vec2(position(random), position(random)));
+		randomShapes.queryMaxes.push_back(randomShapes.queryMins.back() + cocos2d::Vec2(size(random), size(random)) / 2);
+		randomShapes.queryCentres.push_back(cocos2d::Vec2(position(random), position(random)));
+		randomShapes.queryRadii.push_back(size(random) / 4);
+
+		// boxes and circles on the half tile lines, so that they touch the tiles' sides and corners exactly.
+		gridShapes.queryMins.push_back(cocos2d::Vec2((float)gridUnit(random), (float)gridUnit(random)) * 64.0F);
+		gridShapes.queryMaxes.push_back(gridShapes.queryMins.back() + cocos2d::Vec2((float)gridSize(random), (float)gridSize(random)) * 64.0F);
+		gridShapes.queryCentres.push_back(cocos2d::Vec2((float)gridUnit(random), (float)gridUnit(random)) * 64.0F);
+		gridShapes.queryRadii.push_back((float)gridSize(random) * 32.0F);
+	}
+
+	std::cout << std::endl << "Checking " << BATCH_QUERIES << " shapes against batches of " << BATCH_SHAPES << " shapes " << rounds / 10 + 1 << " times." << std::endl;
+
+	compareBatches("random", randomShapes, rounds / 10 + 1);
+	compareBatches("grid", gridShapes, rounds / 10 + 1);
+}
@@ -0,0 +1,290 @@
+// runs the gameplay simulation without a window. This is used to benchmark the physics and collisions, and to check that they haven't changed.
+// usage: mashadeau_sim [area] [steps] [--record <file>] [--replay <file>] [--profile <path>]
+//	- by default, the player spawns at spawn point 0 of the area (AIN_B00), then runs right and jumps every second for the amount of steps (12000).
+//	- --record saves the input used to a recording, which can be played back with --replay.
+//	- --replay plays back a recording made here or in the game, starting where the recording started. The checksum at the end is compared to the one in the recording.
+//	- --profile saves the step statistics to <path>.csv and <path>.json.
+// the areas are read from the game's Resources folder (MSQ_RESOURCES_PATH), and their caches are saved in the build folder (MSQ_WRITABLE_PATH). Both are set by the CMake file.
+// when the player reaches an exit, or is defeated, the next area is loaded the same way the gameplay scene does it. At the end, the time taken, a checksum, and how long each part of a step took are printed.
+// the program returns 0 if everything went well, 1 if something couldn't be loaded or saved, and 2 if a playback didn't end up the same as the recording.
+#include "areas/World.h"
+#include "areas/Simulation.h"
+#include "areas/InputRecording.h"
+#include "entities/Player.h"
+#include "Profiler.h"
+#include "TextureAtlas.h"
+
+#include "platform/CCFileUtils.h"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// the area the player is sent back to when they're defeated (see MSQ_GameplayScene::DEFAULT_AREA).
+static const std::string DEFAULT_AREA = "AIN_B00_0";
+
+// the area being played, and what's needed to run it.
+struct Game
+{
+	cocos2d::Node * root = nullptr; // stands in for the scene. Everything is added to this so that the sprites stay alive.
+	world::Area * area = nullptr; // the area being simulated.
+	entity::Player * plyr = nullptr; // the player.
+	world::Simulation simulation; // runs the physics and collisions.
+	std::string areaName = ""; // the name of the area.
+	unsigned int areasEntered = 0; // how many areas have been loaded.
+	double loadSeconds = 0.0; // the time spent making areas when switching to them. This is the hitch the player would see.
+};
+
+// loads an area, and puts a new player at the spawn point with the values carried over from the last area. This follows MSQ_GameplayScene::switchArea() and MSQ_GameplayScene::initSprites().
+static bool enterArea(Game & game, std::string areaName, int spawnPoint, const world::PlayerStats & playerStats, unsigned int stepCount, OOP::Profiler * profiler)
+{
+	std::chrono::high_resolution_clock::time_point loadStart = std::chrono::high_resolution_clock::now(); // when the area started loading.
+	world::Area * area = nullptr; // the new area.
+
+	if (!world::World::areaExists(areaName))
+	{
+		std::cout << "The area " << areaName << " does not exist." << std::endl;
+		return false;
+	}
+
+	// the old area is kept so that it can be reused, the same way the scene does it.
+	if (game.area != nullptr)
+	{
+		game.simulation.endInterpolation();
+		world::World::releaseArea(game.area);
+	}
+
+	area = world::World::getArea(areaName);
+
+	if (area == nullptr)
+	{
+		std::cout << "The area " << areaName << " could not be loaded." << std::endl;
+		return false;
+	}
+
+	// the old player is deleted before the old area is removed, since the player's sprite is still on it. Its stats have already been passed in.
+	delete game.plyr;
+	game.plyr = nullptr;
+
+	// the old area is removed from the scene, the same way the old scene is replaced in the game.
+	if (game.root != nullptr)
+		game.root->release();
+
+	game.root = cocos2d::Node::create();
+	game.root->retain();
+
+	game.area = area;
+	game.areaName = areaName;
+	game.root->addChild(area->getAsSingleNode());
+
+	game.plyr = new entity::Player();
+	game.plyr->setPosition(area->getSpawn(spawnPoint));
+	game.root->addChild(game.plyr->getSprite());
+	world::Simulation::setPlayerStats(game.plyr, playerStats);
+
+	game.simulation = world::Simulation(area, game.plyr);
+	game.simulation.setViewSize(cocos2d::Size(1920.0F, 1080.0F));
+	game.simulation.setSpawnPoint(spawnPoint);
+	game.simulation.setStepCount(stepCount);
+	game.simulation.setProfiler(profiler);
+
+	game.areasEntered++;
+	game.loadSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - loadStart).count();
+
+	world::World::preloadExits(area); // the areas the player can go to next are read in the background, like in the gameplay scene.
+	return true;
+}
+
+// goes to the area an exit leads to, which is in the format AIN_###_#.
+static bool switchArea(Game & game, const std::string & exit, OOP::Profiler * profiler)
+{
+	world::InputRecording * recording = nullptr; // the recording, which the new simulation keeps adding to.
+	const world::InputRecording * playback = nullptr; // the recording being played back.
+
+	if (exit.length() != 9 || exit[8] < '0' || exit[8] > '4')
+	{
+		std::cout << "The exit " << exit << " is not valid." << std::endl;
+		return false;
+	}
+
+	recording = game.simulation.getRecording();
+	playback = game.simulation.getPlayback();
+
+	if (!enterArea(game, exit.substr(0, 7), exit[8] - '0', world::Simulation::getPlayerStats(game.plyr), game.simulation.getStepCount(), profiler))
+		return false;
+
+	game.simulation.setRecording(recording);
+	game.simulation.setPlayback(playback);
+	return true;
+}
+
+int main(int argc, char ** argv)
+{
+	std::string areaName = "AIN_B00"; // the area to simulate.
+	unsigned int steps = 12000; // the amount of physics steps to run (12000 is 100 seconds of gameplay).
+	std::string recordPath = ""; // where the recording is saved.
+	std::string replayPath = ""; // the recording to play back.
+	std::string profilePath = ""; // where the profile is saved.
+	int positional = 0; // the amount of arguments that weren't options.
+
+	Game game; // the area being played.
+	OOP::Profiler profiler(12000); // times each part of a step. One frame is one step here.
+	world::InputRecording * recording = nullptr; // the recording being made.
+	world::InputRecording * playback = nullptr; // the recording being played back.
+
+	const unsigned int JUMP_STEPS = 120; // how often the player jumps (once a second).
+
+	std::chrono::high_resolution_clock::time_point start; // when the simulation started.
+	double seconds = 0.0; // how long the simulation took.
+	unsigned int firstStep = 0; // the step the simulation started on.
+	uint64_t checksum = 0; // the checksum at the end.
+	int result = 0; // what the program returns.
+
+	cocos2d::FileUtils::getInstance()->addSearchPath(MSQ_RESOURCES_PATH); // where the area files are.
+	cocos2d::FileUtils::getInstance()->setWritablePath(MSQ_WRITABLE_PATH); // where the area caches are saved.
+	OOP::TextureAtlas::loadAtlases(); // the sprites use the atlas rects, like in the game.
+
+	// reads the arguments.
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+			recordPath = argv[++i];
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			replayPath = argv[++i];
+		else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+			profilePath = argv[++i];
+		else
+		{
+			if (positional == 0)
+				areaName = argv[i];
+			else if (positional == 1)
+				steps = (unsigned int)std::stoul(argv[i]);
+
+			positional++;
+		}
+	}
+
+	// a playback starts where the recording started, and runs for as long as the recording did.
+	if (replayPath != "")
+	{
+		playback = world::InputRecording::loadFromFile(replayPath);
+
+		if (playback == nullptr)
+			return 1;
+
+		if (!playback->isFinished())
+		{
+			std::cout << replayPath << ": the recording was never ended, so it can't be checked." << std::endl;
+			return 1;
+		}
+
+		if (!enterArea(game, playback->getArea(), playback->getSpawnPoint(), playback->getPlayerStats(), 0, &profiler))
+			return 1;
+
+		steps = playback->getEndStep();
+		game.simulation.setPlayback(playback);
+	}
+	else if (!enterArea(game, areaName, 0, world::PlayerStats(), 0, &profiler))
+	{
+		return 1;
+	}
+
+	if (recordPath != "")
+	{
+		recording = new world::InputRecording(game.areaName, (playback != nullptr) ? playback->getSpawnPoint() : 0, (playback != nullptr) ? playback->getPlayerStats() : world::PlayerStats());
+		game.simulation.setRecording(recording);
+	}
+
+	firstStep = game.simulation.getStepCount();
+	start = std::chrono::high_resolution_clock::now();
+
+	// one step is run per tick. The autorelease pool is cleared after every tick, like the director does after every frame.
+	while (game.simulation.getStepCount() < steps)
+	{
+		if (playback == nullptr) // the player runs right and jumps every second.
+		{
+			game.simulation.getInput().moveRight = true;
+			game.simulation.getInput().jump = (game.simulation.getStepCount() % JUMP_STEPS == 0);
+		}
+
+		world::World::updatePreloads();
+
+		profiler.beginFrame();
+		game.simulation.advance(world::Simulation::PHYSICS_STEP);
+		profiler.endFrame();
+
+		// the areas are switched the same way the gameplay scene switches them (see MSQ_GameplayScene::update()).
+		if (game.simulation.exitReached())
+		{
+			if (!switchArea(game, game.simulation.getExit(), &profiler))
+				return 1;
+		}
+		else if (game.simulation.playerDefeated())
+		{
+			game.plyr->setHealth(game.plyr->getMaxHealth() / 2);
+
+			if (!switchArea(game, DEFAULT_AREA, &profiler))
+				return 1;
+		}
+
+		cocos2d::PoolManager::getInstance()->getCurrentPool()->clear();
+	}
+
+	seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	checksum = game.simulation.getChecksum();
+
+	std::cout << "Area: " << game.areaName << " (" << game.areasEntered << " areas entered, " << game.loadSeconds * 1000.0 << " ms spent loading them)" << std::endl;
+	std::cout << "Steps: " << game.simulation.getStepCount() - firstStep << " (" << (game.simulation.getStepCount() - firstStep) * world::Simulation::PHYSICS_STEP << " seconds of gameplay)" << std::endl;
+	std::cout << "Time: " << seconds << " seconds (" << (seconds > 0.0 ? (game.simulation.getStepCount() - firstStep) / seconds : 0.0) << " steps per second)" << std::endl;
+	std::cout << "Player: (" << game.plyr->getPositionX() << ", " << game.plyr->getPositionY() << "), health " << game.plyr->getHealth() << std::endl;
+	std::cout << "Enemies: " << game.area->getAreaEnemies()->size() << ", tiles: " << game.area->getAreaTiles()->size() << std::endl;
+	std::cout << "Checksum: " << std::hex << checksum << std::dec << std::endl;
+
+	if (playback != nullptr) // a playback has to end up exactly where the recording did.
+	{
+		if (checksum == playback->getChecksum())
+		{
+			std::cout << "Playback matches the recording." << std::endl;
+		}
+		else
+		{
+			std::cout << "Playback does not match the recording (expected " << std::hex << playback->getChecksum() << std::dec << ")." << std::endl;
+			result = 2;
+		}
+	}
+
+	if (recording != nullptr)
+	{
+		recording->finish(game.simulation.getStepCount(), checksum);
+
+		if (recording->saveToFile(recordPath))
+		{
+			std::cout << "Recording saved to " << recordPath << std::endl;
+		}
+		else
+		{
+			std::cout << "Unable to save the recording to " << recordPath << std::endl;
+			result = 1;
+		}
+	}
+
+	std::cout << std::endl << profiler.getReport();
+
+	if (profilePath != "" && !(profiler.saveCSV(profilePath + ".csv") && profiler.saveJSON(profilePath + ".json")))
+	{
+		std::cout << "Unable to save the profile to " << profilePath << std::endl;
+		result = 1;
+	}
+
+	world::World::clearPreloads(); // waits for any areas still being read.
+	world::World::releaseArea(game.area);
+	delete game.plyr; // the player is deleted while its sprite is still on the root, which also takes its body out of the physics store.
+	game.plyr = nullptr;
+	world::World::clearAreas(); // deletes the kept areas while their nodes are still around.
+	game.root->release();
+	delete recording;
+	delete playback;
+
+	return result;
+}
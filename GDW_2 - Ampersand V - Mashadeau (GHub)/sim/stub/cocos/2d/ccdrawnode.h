@@ -0,0 +1,4 @@
+// stands in for the cocos2d-x header with the same name (see cocos2d.h in the stub folder).
+#pragma once
+
+#include "cocos2d.h"
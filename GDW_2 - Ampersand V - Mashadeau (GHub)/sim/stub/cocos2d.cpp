@@ -0,0 +1,41 @@
+#include "cocos2d.h"
+
+namespace cocos2d
+{
+	const Vec2 Vec2::ZERO(0.0F, 0.0F);
+	const Vec2 Vec2::ONE(1.0F, 1.0F);
+	const Vec2 Vec2::UNIT_X(1.0F, 0.0F);
+	const Vec2 Vec2::UNIT_Y(0.0F, 1.0F);
+	const Vec2 Vec2::ANCHOR_MIDDLE(0.5F, 0.5F);
+
+	const Mat4 Mat4::IDENTITY;
+	const Size Size::ZERO(0.0F, 0.0F);
+	const Rect Rect::ZERO(0.0F, 0.0F, 0.0F, 0.0F);
+
+	const Color3B Color3B::WHITE(255, 255, 255);
+	const Color3B Color3B::YELLOW(255, 255, 0);
+	const Color3B Color3B::BLUE(0, 0, 255);
+	const Color3B Color3B::GREEN(0, 255, 0);
+	const Color3B Color3B::RED(255, 0, 0);
+	const Color3B Color3B::MAGENTA(255, 0, 255);
+	const Color3B Color3B::BLACK(0, 0, 0);
+	const Color3B Color3B::ORANGE(255, 127, 0);
+	const Color3B Color3B::GRAY(166, 166, 166);
+
+	const Color4B Color4B::WHITE(255, 255, 255, 255);
+	const Color4B Color4B::BLACK(0, 0, 0, 255);
+
+	const Color4F Color4F::WHITE(1.0F, 1.0F, 1.0F, 1.0F);
+	const Color4F Color4F::YELLOW(1.0F, 1.0F, 0.0F, 1.0F);
+	const Color4F Color4F::BLUE(0.0F, 0.0F, 1.0F, 1.0F);
+	const Color4F Color4F::GREEN(0.0F, 1.0F, 0.0F, 1.0F);
+	const Color4F Color4F::RED(1.0F, 0.0F, 0.0F, 1.0F);
+	const Color4F Color4F::MAGENTA(1.0F, 0.0F, 1.0F, 1.0F);
+	const Color4F Color4F::BLACK(0.0F, 0.0F, 0.0F, 1.0F);
+	const Color4F Color4F::ORANGE(1.0F, 0.5F, 0.0F, 1.0F);
+	const Color4F Color4F::GRAY(0.65F, 0.65F, 0.65F, 1.0F);
+
+	const BlendFunc BlendFunc::ALPHA_PREMULTIPLIED = { 1, 0x0303 }; // GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+
+	const char * GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP = "ShaderPositionTextureColor_noMVP";
+}
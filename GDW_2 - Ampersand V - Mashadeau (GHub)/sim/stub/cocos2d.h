@@ -0,0 +1,824 @@
+// a small stand-in for the parts of cocos2d-x the gameplay code uses, so that the simulation can be built and run without a window or a GL context.
+// nodes keep their transform, size, visibility, and children like they do in cocos, but nothing is ever drawn and textures are never loaded.
+// only what the gameplay code needs is here. If a new part of cocos gets used by the gameplay code, it has to be added here as well for the 'mashadeau_sim' target.
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#ifdef _MSC_VER
+#include <BaseTsd.h>
+typedef SSIZE_T ssize_t;
+#endif
+
+// the game is built with MSVC, where <cmath> puts the float versions of abs() in the global namespace. The game code relies on this, so they're brought in here too.
+using std::abs;
+
+#define NS_CC_BEGIN namespace cocos2d {
+#define NS_CC_END }
+#define USING_NS_CC using namespace cocos2d
+
+#define CC_DEGREES_TO_RADIANS(__ANGLE__) ((__ANGLE__) * 0.01745329252F)
+#define CC_RADIANS_TO_DEGREES(__ANGLE__) ((__ANGLE__) * 57.29577951F)
+
+#define CREATE_FUNC(__TYPE__) \
+	static __TYPE__ * create() \
+	{ \
+		__TYPE__ * obj = new (std::nothrow) __TYPE__(); \
+		if (obj && obj->init()) { obj->autorelease(); return obj; } \
+		delete obj; \
+		return nullptr; \
+	}
+
+namespace cocos2d
+{
+	typedef unsigned int GLuint;
+	typedef unsigned int GLenum;
+
+	// clamps a value between a minimum and maximum.
+	inline float clampf(float value, float min_inclusive, float max_inclusive)
+	{
+		if (min_inclusive > max_inclusive)
+			std::swap(min_inclusive, max_inclusive);
+
+		return value < min_inclusive ? min_inclusive : value < max_inclusive ? value : max_inclusive;
+	}
+
+	// MATH //
+	class Vec2
+	{
+	public:
+		float x, y;
+
+		Vec2() : x(0.0F), y(0.0F) {}
+		Vec2(float x, float y) : x(x), y(y) {}
+
+		bool isZero() const { return x == 0.0F && y == 0.0F; }
+		void set(float x, float y) { this->x = x; this->y = y; }
+		void setZero() { x = y = 0.0F; }
+
+		float length() const { return sqrtf(x * x + y * y); }
+		float lengthSquared() const { return x * x + y * y; }
+		float getLength() const { return length(); }
+		float getLengthSq() const { return lengthSquared(); }
+		float distance(const Vec2 & v) const { return (*this - v).length(); }
+		float distanceSquared(const Vec2 & v) const { return (*this - v).lengthSquared(); }
+		float getDistance(const Vec2 & v) const { return distance(v); }
+		float dot(const Vec2 & v) const { return x * v.x + y * v.y; }
+		float cross(const Vec2 & v) const { return x * v.y - y * v.x; }
+		float getAngle() const { return atan2f(y, x); }
+
+		void normalize() { float n = length(); if (n > 0.0F) { x /= n; y /= n; } }
+		Vec2 getNormalized() const { Vec2 v(*this); v.normalize(); return v; }
+		Vec2 getPerp() const { return Vec2(-y, x); }
+		Vec2 lerp(const Vec2 & other, float alpha) const { return *this * (1.0F - alpha) + other * alpha; }
+		Vec2 project(const Vec2 & other) const { return other * (dot(other) / other.dot(other)); }
+		Vec2 rotate(const Vec2 & other) const { return Vec2(x * other.x - y * other.y, x * other.y + y * other.x); }
+		bool fuzzyEquals(const Vec2 & b, float var) const { return fabsf(x - b.x) <= var && fabsf(y - b.y) <= var; }
+
+		Vec2 operator+(const Vec2 & v) const { return Vec2(x + v.x, y + v.y); }
+		Vec2 operator-(const Vec2 & v) const { return Vec2(x - v.x, y - v.y); }
+		Vec2 operator-() const { return Vec2(-x, -y); }
+		Vec2 operator*(float s) const { return Vec2(x * s, y * s); }
+		Vec2 operator/(float s) const { return Vec2(x / s, y / s); }
+		Vec2 & operator+=(const Vec2 & v) { x += v.x; y += v.y; return *this; }
+		Vec2 & operator-=(const Vec2 & v) { x -= v.x; y -= v.y; return *this; }
+		Vec2 & operator*=(float s) { x *= s; y *= s; return *this; }
+		Vec2 & operator/=(float s) { x /= s; y /= s; return *this; }
+		bool operator==(const Vec2 & v) const { return x == v.x && y == v.y; }
+		bool operator!=(const Vec2 & v) const { return x != v.x || y != v.y; }
+		bool operator<(const Vec2 & v) const { return (x == v.x) ? y < v.y : x < v.x; }
+		bool operator>(const Vec2 & v) const { return (x == v.x) ? y > v.y : x > v.x; }
+
+		static const Vec2 ZERO;
+		static const Vec2 ONE;
+		static const Vec2 UNIT_X;
+		static const Vec2 UNIT_Y;
+		static const Vec2 ANCHOR_MIDDLE;
+	};
+
+	inline Vec2 operator*(float s, const Vec2 & v) { return v * s; }
+
+	typedef Vec2 Point;
+
+	class Vec3
+	{
+	public:
+		float x, y, z;
+
+		Vec3() : x(0.0F), y(0.0F), z(0.0F) {}
+		Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+		float length() const { return sqrtf(x * x + y * y + z * z); }
+		float dot(const Vec3 & v) const { return x * v.x + y * v.y + z * v.z; }
+
+		Vec3 operator+(const Vec3 & v) const { return Vec3(x + v.x, y + v.y, z + v.z); }
+		Vec3 operator-(const Vec3 & v) const { return Vec3(x - v.x, y - v.y, z - v.z); }
+		Vec3 operator*(float s) const { return Vec3(x * s, y * s, z * s); }
+		bool operator==(const Vec3 & v) const { return x == v.x && y == v.y && z == v.z; }
+	};
+
+	// a column-major 4x4 matrix, like the one in cocos.
+	class Mat4
+	{
+	public:
+		float m[16];
+
+		Mat4() { setIdentity(); }
+
+		void setIdentity() { for (int i = 0; i < 16; i++) m[i] = (i % 5 == 0) ? 1.0F : 0.0F; }
+
+		void transformPoint(Vec3 * point) const
+		{
+			Vec3 p = *point;
+			point->x = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+			point->y = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+			point->z = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14];
+		}
+
+		Mat4 operator*(const Mat4 & other) const
+		{
+			Mat4 result;
+
+			for (int col = 0; col < 4; col++)
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					result.m[col * 4 + row] = 0.0F;
+
+					for (int k = 0; k < 4; k++)
+						result.m[col * 4 + row] += m[k * 4 + row] * other.m[col * 4 + k];
+				}
+			}
+
+			return result;
+		}
+
+		static const Mat4 IDENTITY;
+	};
+
+	class Size
+	{
+	public:
+		float width, height;
+
+		Size() : width(0.0F), height(0.0F) {}
+		Size(float width, float height) : width(width), height(height) {}
+		explicit Size(const Vec2 & point) : width(point.x), height(point.y) {}
+
+		operator Vec2() const { return Vec2(width, height); }
+
+		Size operator+(const Size & s) const { return Size(width + s.width, height + s.height); }
+		Size operator-(const Size & s) const { return Size(width - s.width, height - s.height); }
+		Size operator*(float a) const { return Size(width * a, height * a); }
+		Size operator/(float a) const { return Size(width / a, height / a); }
+		bool equals(const Size & s) const { return width == s.width && height == s.height; }
+
+		static const Size ZERO;
+	};
+
+	class Rect
+	{
+	public:
+		Vec2 origin;
+		Size size;
+
+		Rect() {}
+		Rect(float x, float y, float width, float height) : origin(x, y), size(width, height) {}
+		Rect(const Vec2 & pos, const Size & dimension) : origin(pos), size(dimension) {}
+
+		float getMinX() const { return origin.x; }
+		float getMidX() const { return origin.x + size.width / 2.0F; }
+		float getMaxX() const { return origin.x + size.width; }
+		float getMinY() const { return origin.y; }
+		float getMidY() const { return origin.y + size.height / 2.0F; }
+		float getMaxY() const { return origin.y + size.height; }
+
+		bool equals(const Rect & rect) const { return origin == rect.origin && size.equals(rect.size); }
+		bool containsPoint(const Vec2 & point) const { return point.x >= getMinX() && point.x <= getMaxX() && point.y >= getMinY() && point.y <= getMaxY(); }
+
+		bool intersectsRect(const Rect & rect) const
+		{
+			return !(getMaxX() < rect.getMinX() || rect.getMaxX() < getMinX() || getMaxY() < rect.getMinY() || rect.getMaxY() < getMinY());
+		}
+
+		bool intersectsCircle(const Vec2 & centre, float radius) const
+		{
+			float w = size.width / 2.0F, h = size.height / 2.0F;
+
+			if (fabsf(centre.x - (origin.x + w)) > radius + w || fabsf(centre.y - (origin.y + h)) > radius + h)
+				return false;
+
+			Vec2 distance(fabsf(centre.x - origin.x - w), fabsf(centre.y - origin.y - h));
+
+			if (distance.x <= w || distance.y <= h)
+				return true;
+
+			return (distance.x - w) * (distance.x - w) + (distance.y - h) * (distance.y - h) <= radius * radius;
+		}
+
+		Rect unionWithRect(const Rect & rect) const
+		{
+			float minX = std::min(getMinX(), rect.getMinX()), minY = std::min(getMinY(), rect.getMinY());
+			return Rect(minX, minY, std::max(getMaxX(), rect.getMaxX()) - minX, std::max(getMaxY(), rect.getMaxY()) - minY);
+		}
+
+		static const Rect ZERO;
+	};
+
+	// COLOURS //
+	struct Color3B
+	{
+		unsigned char r, g, b;
+
+		Color3B() : r(0), g(0), b(0) {}
+		Color3B(unsigned char r, unsigned char g, unsigned char b) : r(r), g(g), b(b) {}
+
+		bool operator==(const Color3B & c) const { return r == c.r && g == c.g && b == c.b; }
+		bool operator!=(const Color3B & c) const { return !(*this == c); }
+
+		static const Color3B WHITE, YELLOW, BLUE, GREEN, RED, MAGENTA, BLACK, ORANGE, GRAY;
+	};
+
+	struct Color4B
+	{
+		unsigned char r, g, b, a;
+
+		Color4B() : r(0), g(0), b(0), a(0) {}
+		Color4B(unsigned char r, unsigned char g, unsigned char b, unsigned char a) : r(r), g(g), b(b), a(a) {}
+
+		static const Color4B WHITE, BLACK;
+	};
+
+	struct Color4F
+	{
+		float r, g, b, a;
+
+		Color4F() : r(0.0F), g(0.0F), b(0.0F), a(0.0F) {}
+		Color4F(float r, float g, float b, float a) : r(r), g(g), b(b), a(a) {}
+		explicit Color4F(const Color3B & c) : r(c.r / 255.0F), g(c.g / 255.0F), b(c.b / 255.0F), a(1.0F) {}
+
+		bool operator==(const Color4F & c) const { return r == c.r && g == c.g && b == c.b && a == c.a; }
+		bool operator!=(const Color4F & c) const { return !(*this == c); }
+
+		static const Color4F WHITE, YELLOW, BLUE, GREEN, RED, MAGENTA, BLACK, ORANGE, GRAY;
+	};
+
+	struct Tex2F
+	{
+		float u = 0.0F, v = 0.0F;
+	};
+
+	struct V3F_C4B_T2F
+	{
+		Vec3 vertices;
+		Color4B colors;
+		Tex2F texCoords;
+	};
+
+	struct V3F_C4B_T2F_Quad
+	{
+		V3F_C4B_T2F tl;
+		V3F_C4B_T2F bl;
+		V3F_C4B_T2F tr;
+		V3F_C4B_T2F br;
+	};
+
+	struct BlendFunc
+	{
+		GLenum src;
+		GLenum dst;
+
+		bool operator==(const BlendFunc & b) const { return src == b.src && dst == b.dst; }
+		bool operator!=(const BlendFunc & b) const { return !(*this == b); }
+
+		static const BlendFunc ALPHA_PREMULTIPLIED;
+	};
+
+	// MEMORY //
+	// reference counting. autorelease() puts the object in the current pool, which releases it when the pool is cleared (normally once per frame by the director).
+	class Ref
+	{
+	public:
+		virtual ~Ref() {}
+
+		void retain() { referenceCount++; }
+		void release() { if (--referenceCount == 0) delete this; }
+		Ref * autorelease();
+		unsigned int getReferenceCount() const { return referenceCount; }
+
+	protected:
+		Ref() {}
+
+	private:
+		unsigned int referenceCount = 1;
+	};
+
+	class AutoreleasePool
+	{
+	public:
+		void addObject(Ref * object) { objects.push_back(object); }
+
+		// releases every object in the pool.
+		void clear()
+		{
+			std::vector<Ref *> releasing;
+			releasing.swap(objects);
+
+			for (Ref * object : releasing)
+				object->release();
+		}
+
+	private:
+		std::vector<Ref *> objects;
+	};
+
+	class PoolManager
+	{
+	public:
+		static PoolManager * getInstance() { static PoolManager manager; return &manager; }
+		AutoreleasePool * getCurrentPool() { return &pool; }
+
+	private:
+		AutoreleasePool pool;
+	};
+
+	inline Ref * Ref::autorelease() { PoolManager::getInstance()->getCurrentPool()->addObject(this); return this; }
+
+	// RENDERING //
+	class Texture2D : public Ref
+	{
+	public:
+		Texture2D(const std::string & path, GLuint name) : path(path), name(name) {}
+
+		GLuint getName() const { return name; }
+		const std::string & getPath() const { return path; }
+		int getPixelsWide() const { return 0; }
+		int getPixelsHigh() const { return 0; }
+		unsigned int getBitsPerPixelForFormat() const { return 32; }
+		Size getContentSize() const { return Size::ZERO; }
+
+		// gets the texture for a file. Textures are never loaded, but each file gets one texture object, like in the texture cache.
+		static Texture2D * get(const std::string & path)
+		{
+			static std::map<std::string, Texture2D *> textures;
+			Texture2D *& texture = textures[path];
+
+			if (texture == nullptr)
+				texture = new Texture2D(path, (GLuint)textures.size());
+
+			return texture;
+		}
+
+	private:
+		std::string path;
+		GLuint name;
+	};
+
+	// FILES //
+	// finds files in the search paths, the same way cocos finds them in the Resources folder.
+	class FileUtils
+	{
+	public:
+		static FileUtils * getInstance() { static FileUtils fileUtils; return &fileUtils; }
+
+		void addSearchPath(const std::string & path) { searchPaths.push_back((path == "" || path.back() == '/') ? path : path + "/"); }
+		const std::vector<std::string> & getSearchPaths() const { return searchPaths; }
+
+		// gets the full path of a file. If the file can't be found, an empty string is returned.
+		std::string fullPathForFilename(const std::string & filename) const
+		{
+			if (filename == "")
+				return "";
+
+			if (exists(filename))
+				return filename;
+
+			for (const std::string & path : searchPaths)
+			{
+				if (exists(path + filename))
+					return path + filename;
+			}
+
+			return "";
+		}
+
+		bool isFileExist(const std::string & filename) const { return fullPathForFilename(filename) != ""; }
+
+		// where files made by the game are saved.
+		void setWritablePath(const std::string & path) { writablePath = (path == "" || path.back() == '/') ? path : path + "/"; }
+		std::string getWritablePath() const { return writablePath; }
+
+		std::string getStringFromFile(const std::string & filename) const
+		{
+			std::ifstream file(fullPathForFilename(filename), std::ios::binary);
+			std::ostringstream contents;
+			contents << file.rdbuf();
+			return file ? contents.str() : "";
+		}
+
+	private:
+		static bool exists(const std::string & path) { return (bool)std::ifstream(path); }
+
+		std::vector<std::string> searchPaths;
+		std::string writablePath = "";
+	};
+
+	// there's no GL context, so textures are made right away, and the callback is called straight from addImageAsync().
+	class TextureCache : public Ref
+	{
+	public:
+		Texture2D * addImage(const std::string & path) { return Texture2D::get(path); }
+		void addImageAsync(const std::string & path, const std::function<void(Texture2D *)> & callback) { Texture2D * texture = addImage(path); if (callback) callback(texture); }
+		void removeTexture(Texture2D *) {} // the textures are kept, since they're shared through Texture2D::get().
+	};
+
+	// only the parts of the director that are used outside of the scenes.
+	class Director
+	{
+	public:
+		static Director * getInstance() { static Director director; return &director; }
+		TextureCache * getTextureCache() { return &textureCache; }
+
+	private:
+		TextureCache textureCache;
+	};
+
+	// a rect in a texture, such as an image in an atlas.
+	class SpriteFrame : public Ref
+	{
+	public:
+		SpriteFrame(Texture2D * texture, const Rect & rect) : texture(texture), rect(rect) {}
+
+		Texture2D * getTexture() const { return texture; }
+		const Rect & getRect() const { return rect; }
+
+	private:
+		Texture2D * texture;
+		Rect rect;
+	};
+
+	// reads the frames out of atlas plists. Only the parts of the plist written by tools/pack_atlases.py are read (the frame names, their rects, and the texture's name).
+	class SpriteFrameCache
+	{
+	public:
+		static SpriteFrameCache * getInstance() { static SpriteFrameCache cache; return &cache; }
+
+		void addSpriteFramesWithFile(const std::string & plist)
+		{
+			std::string text = FileUtils::getInstance()->getStringFromFile(plist);
+			std::string folder = (plist.find('/') == std::string::npos) ? "" : plist.substr(0, plist.rfind('/') + 1);
+			std::string texturePath = value(text, text.find("<key>textureFileName</key>"), "<string>", "</string>");
+			size_t pos = text.find("<key>frames</key>");
+			float x = 0.0F, y = 0.0F, w = 0.0F, h = 0.0F;
+
+			if (text == "" || texturePath == "" || pos == std::string::npos)
+				return;
+
+			// each frame is a key, followed by a dictionary with the frame's rect in it.
+			for (pos = text.find("<dict>", pos); (pos = text.find("<key>", pos + 1)) != std::string::npos && pos < text.find("<key>metadata</key>");)
+			{
+				std::string name = value(text, pos, "<key>", "</key>");
+				std::string frame = value(text, text.find("<key>frame</key>", pos), "<string>", "</string>");
+
+				if (sscanf(frame.c_str(), "{{%f,%f},{%f,%f}}", &x, &y, &w, &h) == 4)
+					frames[name] = new SpriteFrame(Texture2D::get(folder + texturePath), Rect(x, y, w, h));
+
+				pos = text.find("</dict>", pos);
+			}
+
+			files.push_back(plist);
+		}
+
+		bool isSpriteFramesWithFileLoaded(const std::string & plist) const { return std::find(files.begin(), files.end(), plist) != files.end(); }
+		SpriteFrame * getSpriteFrameByName(const std::string & name) const { auto it = frames.find(name); return (it != frames.end()) ? it->second : nullptr; }
+
+	private:
+		// gets the text between two tags, starting from 'pos'.
+		static std::string value(const std::string & text, size_t pos, const std::string & open, const std::string & close)
+		{
+			size_t start = (pos == std::string::npos) ? pos : text.find(open, pos);
+			size_t end = (start == std::string::npos) ? start : text.find(close, start);
+			return (end == std::string::npos) ? "" : text.substr(start + open.length(), end - start - open.length());
+		}
+
+		std::map<std::string, SpriteFrame *> frames;
+		std::vector<std::string> files;
+	};
+
+	class GLProgram
+	{
+	public:
+		static const char * SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP;
+	};
+
+	class GLProgramState : public Ref
+	{
+	public:
+		static GLProgramState * getOrCreateWithGLProgramName(const std::string &) { static GLProgramState state; return &state; }
+	};
+
+	class RenderCommand
+	{
+	public:
+		virtual ~RenderCommand() {}
+	};
+
+	class TrianglesCommand : public RenderCommand
+	{
+	public:
+		struct Triangles
+		{
+			V3F_C4B_T2F * verts = nullptr;
+			unsigned short * indices = nullptr;
+			int vertCount = 0;
+			int indexCount = 0;
+		};
+
+		void init(float, GLuint, GLProgramState *, BlendFunc, const Triangles &, const Mat4 &, uint32_t) {}
+	};
+
+	// nothing is drawn, so every command is thrown away.
+	class Renderer
+	{
+	public:
+		void addCommand(RenderCommand *) {}
+		bool checkVisibility(const Mat4 &, const Size &) { return true; }
+		ssize_t getDrawnBatches() const { return 0; }
+		ssize_t getDrawnVertices() const { return 0; }
+	};
+
+	class Action : public Ref {};
+
+	// NODES //
+	class Node : public Ref
+	{
+	public:
+		static Node * create() { Node * node = new (std::nothrow) Node(); node->init(); node->autorelease(); return node; }
+
+		virtual ~Node() { removeAllChildren(); }
+
+		virtual bool init() { return true; }
+		virtual void update(float) {}
+		virtual void draw(Renderer *, const Mat4 &, uint32_t) {}
+
+		// position
+		virtual void setPosition(const Vec2 & position) { _position = position; }
+		virtual void setPosition(float x, float y) { setPosition(Vec2(x, y)); }
+		virtual const Vec2 & getPosition() const { return _position; }
+		virtual void setPositionX(float x) { setPosition(Vec2(x, _position.y)); }
+		virtual float getPositionX() const { return _position.x; }
+		virtual void setPositionY(float y) { setPosition(Vec2(_position.x, y)); }
+		virtual float getPositionY() const { return _position.y; }
+
+		// rotation (in degrees, clockwise) and scale
+		virtual void setRotation(float rotation) { _rotation = rotation; }
+		virtual float getRotation() const { return _rotation; }
+		virtual void setScale(float scale) { _scaleX = _scaleY = scale; }
+		virtual void setScale(float scaleX, float scaleY) { _scaleX = scaleX; _scaleY = scaleY; }
+		virtual float getScale() const { return _scaleX; }
+		virtual void setScaleX(float scaleX) { _scaleX = scaleX; }
+		virtual float getScaleX() const { return _scaleX; }
+		virtual void setScaleY(float scaleY) { _scaleY = scaleY; }
+		virtual float getScaleY() const { return _scaleY; }
+
+		// size and anchour point
+		virtual void setAnchorPoint(const Vec2 & anchorPoint) { _anchorPoint = anchorPoint; }
+		virtual const Vec2 & getAnchorPoint() const { return _anchorPoint; }
+		virtual void setContentSize(const Size & contentSize) { _contentSize = contentSize; }
+		virtual const Size & getContentSize() const { return _contentSize; }
+
+		// the transform from the node's space to its parent's space.
+		virtual const Mat4 & getNodeToParentTransform() const
+		{
+			float radians = CC_DEGREES_TO_RADIANS(_rotation);
+			float c = cosf(radians), s = sinf(radians);
+			Vec2 anchor(_anchorPoint.x * _contentSize.width, _anchorPoint.y * _contentSize.height);
+
+			_transform.setIdentity();
+			_transform.m[0] = c * _scaleX;
+			_transform.m[1] = -s * _scaleX;
+			_transform.m[4] = s * _scaleY;
+			_transform.m[5] = c * _scaleY;
+			_transform.m[12] = _position.x - (_transform.m[0] * anchor.x + _transform.m[4] * anchor.y);
+			_transform.m[13] = _position.y - (_transform.m[1] * anchor.x + _transform.m[5] * anchor.y);
+
+			return _transform;
+		}
+
+		// the node's box in its parent's space.
+		virtual Rect getBoundingBox() const
+		{
+			const Mat4 & transform = getNodeToParentTransform();
+			Vec3 corners[4] = { Vec3(0.0F, 0.0F, 0.0F), Vec3(_contentSize.width, 0.0F, 0.0F), Vec3(0.0F, _contentSize.height, 0.0F), Vec3(_contentSize.width, _contentSize.height, 0.0F) };
+			Vec2 min, max;
+
+			for (int i = 0; i < 4; i++)
+			{
+				transform.transformPoint(&corners[i]);
+				min = (i == 0) ? Vec2(corners[i].x, corners[i].y) : Vec2(std::min(min.x, corners[i].x), std::min(min.y, corners[i].y));
+				max = (i == 0) ? Vec2(corners[i].x, corners[i].y) : Vec2(std::max(max.x, corners[i].x), std::max(max.y, corners[i].y));
+			}
+
+			return Rect(min, Size(max.x - min.x, max.y - min.y));
+		}
+
+		// appearance
+		virtual void setVisible(bool visible) { _visible = visible; }
+		virtual bool isVisible() const { return _visible; }
+		virtual void setOpacity(unsigned char opacity) { _opacity = opacity; }
+		virtual unsigned char getOpacity() const { return _opacity; }
+		virtual void setColor(const Color3B & color) { _color = color; }
+		virtual const Color3B & getColor() const { return _color; }
+		virtual void setCascadeOpacityEnabled(bool) {}
+		virtual void setCameraMask(unsigned short, bool = true) {}
+		virtual void setGlobalZOrder(float globalZOrder) { _globalZOrder = globalZOrder; }
+		virtual float getGlobalZOrder() const { return _globalZOrder; }
+		virtual void setLocalZOrder(int localZOrder) { _localZOrder = localZOrder; }
+		virtual int getLocalZOrder() const { return _localZOrder; }
+
+		// identification
+		virtual void setTag(int tag) { _tag = tag; }
+		virtual int getTag() const { return _tag; }
+		virtual void setName(const std::string & name) { _name = name; }
+		virtual const std::string & getName() const { return _name; }
+
+		// children
+		virtual void addChild(Node * child) { addChild(child, child->_localZOrder); }
+		virtual void addChild(Node * child, int localZOrder) { addChild(child, localZOrder, child->_tag); }
+		virtual void addChild(Node * child, int localZOrder, int tag)
+		{
+			if (child == nullptr || child->_parent != nullptr)
+				return;
+
+			child->retain();
+			child->_parent = this;
+			child->_localZOrder = localZOrder;
+			child->_tag = tag;
+			_children.push_back(child);
+		}
+		virtual void addChild(Node * child, int localZOrder, const std::string & name) { addChild(child, localZOrder, child->_tag); child->_name = name; }
+
+		virtual void removeChild(Node * child, bool = true)
+		{
+			std::vector<Node *>::iterator it = std::find(_children.begin(), _children.end(), child);
+
+			if (it == _children.end())
+				return;
+
+			_children.erase(it);
+			child->_parent = nullptr;
+			child->release();
+		}
+
+		virtual void removeFromParent() { if (_parent != nullptr) _parent->removeChild(this); }
+		virtual void removeFromParentAndCleanup(bool) { removeFromParent(); }
+		virtual void removeAllChildren()
+		{
+			std::vector<Node *> children;
+			children.swap(_children);
+
+			for (Node * child : children)
+			{
+				child->_parent = nullptr;
+				child->release();
+			}
+		}
+		virtual void removeAllChildrenWithCleanup(bool) { removeAllChildren(); }
+
+		virtual std::vector<Node *> & getChildren() { return _children; }
+		virtual const std::vector<Node *> & getChildren() const { return _children; }
+		virtual ssize_t getChildrenCount() const { return _children.size(); }
+		virtual Node * getParent() const { return _parent; }
+		virtual Node * getChildByTag(int tag) const { for (Node * child : _children) if (child->_tag == tag) return child; return nullptr; }
+		virtual Node * getChildByName(const std::string & name) const { for (Node * child : _children) if (child->_name == name) return child; return nullptr; }
+
+		// actions are never run.
+		virtual Action * runAction(Action * action) { return action; }
+		virtual void stopAllActions() {}
+		virtual ssize_t getNumberOfRunningActions() const { return 0; }
+
+		virtual void scheduleUpdate() {}
+		virtual void unscheduleUpdate() {}
+
+		void setGLProgramState(GLProgramState * state) { _glProgramState = state; }
+		GLProgramState * getGLProgramState() const { return _glProgramState; }
+
+	protected:
+		Node() {}
+
+		Vec2 _position;
+		float _rotation = 0.0F;
+		float _scaleX = 1.0F;
+		float _scaleY = 1.0F;
+		Vec2 _anchorPoint;
+		Size _contentSize;
+		mutable Mat4 _transform;
+
+		bool _visible = true;
+		unsigned char _opacity = 255;
+		Color3B _color = Color3B::WHITE;
+		float _globalZOrder = 0.0F;
+		int _localZOrder = 0;
+		int _tag = -1;
+		std::string _name;
+
+		Node * _parent = nullptr;
+		std::vector<Node *> _children;
+		GLProgramState * _glProgramState = nullptr;
+	};
+
+	class Sprite : public Node
+	{
+	public:
+		static Sprite * create() { return make(""); }
+		static Sprite * create(const std::string & filename) { return make(filename); }
+		static Sprite * create(const std::string & filename, const Rect & rect) { Sprite * sprite = make(filename); sprite->setTextureRect(rect); return sprite; }
+		static Sprite * createWithTexture(Texture2D * texture) { Sprite * sprite = make(""); sprite->setTexture(texture); return sprite; }
+
+		virtual void setTexture(const std::string & filename) { _texture = (filename == "") ? nullptr : Texture2D::get(filename); }
+		virtual void setTexture(Texture2D * texture) { _texture = texture; }
+		virtual void setSpriteFrame(SpriteFrame * frame) { setTexture(frame->getTexture()); setTextureRect(frame->getRect()); }
+		virtual Texture2D * getTexture() const { return _texture; }
+
+		// the texture rect sets the size of the sprite, which is what the collisions are based on.
+		virtual void setTextureRect(const Rect & rect) { _rect = rect; setContentSize(rect.size); }
+		virtual const Rect & getTextureRect() const { return _rect; }
+
+		virtual void setFlippedX(bool flippedX) { _flippedX = flippedX; }
+		virtual bool isFlippedX() const { return _flippedX; }
+		virtual void setFlippedY(bool flippedY) { _flippedY = flippedY; }
+		virtual bool isFlippedY() const { return _flippedY; }
+
+		virtual const BlendFunc & getBlendFunc() const { return _blendFunc; }
+		virtual void setBlendFunc(const BlendFunc & blendFunc) { _blendFunc = blendFunc; }
+
+		// the quad of the sprite in its own space. The texture coordinates are left at 0, since the textures aren't loaded.
+		virtual const V3F_C4B_T2F_Quad & getQuad() const
+		{
+			Color4B colour(_color.r, _color.g, _color.b, _opacity);
+
+			_quad.bl.vertices = Vec3(0.0F, 0.0F, 0.0F);
+			_quad.br.vertices = Vec3(_contentSize.width, 0.0F, 0.0F);
+			_quad.tl.vertices = Vec3(0.0F, _contentSize.height, 0.0F);
+			_quad.tr.vertices = Vec3(_contentSize.width, _contentSize.height, 0.0F);
+			_quad.bl.colors = _quad.br.colors = _quad.tl.colors = _quad.tr.colors = colour;
+
+			return _quad;
+		}
+
+	protected:
+		Sprite() { _anchorPoint = Vec2(0.5F, 0.5F); }
+
+		static Sprite * make(const std::string & filename)
+		{
+			Sprite * sprite = new (std::nothrow) Sprite();
+			sprite->setTexture(filename);
+			sprite->autorelease();
+			return sprite;
+		}
+
+		Texture2D * _texture = nullptr;
+		Rect _rect;
+		bool _flippedX = false;
+		bool _flippedY = false;
+		BlendFunc _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
+		mutable V3F_C4B_T2F_Quad _quad;
+	};
+
+	// the shapes are never drawn, so these do nothing.
+	class DrawNode : public Node
+	{
+	public:
+		static DrawNode * create() { DrawNode * node = new (std::nothrow) DrawNode(); node->autorelease(); return node; }
+
+		void drawPoint(const Vec2 &, float, const Color4F &) {}
+		void drawLine(const Vec2 &, const Vec2 &, const Color4F &) {}
+		void drawRect(const Vec2 &, const Vec2 &, const Color4F &) {}
+		void drawRect(const Vec2 &, const Vec2 &, const Vec2 &, const Vec2 &, const Color4F &) {}
+		void drawSolidRect(const Vec2 &, const Vec2 &, const Color4F &) {}
+		void drawCircle(const Vec2 &, float, float, unsigned int, bool, const Color4F &) {}
+		void drawCircle(const Vec2 &, float, float, unsigned int, bool, float, float, const Color4F &) {}
+		void drawSolidCircle(const Vec2 &, float, float, unsigned int, const Color4F &) {}
+		void drawSegment(const Vec2 &, const Vec2 &, float, const Color4F &) {}
+		void drawDot(const Vec2 &, float, const Color4F &) {}
+		void drawPoly(const Vec2 *, unsigned int, bool, const Color4F &) {}
+		void drawPolygon(const Vec2 *, int, const Color4F &, float, const Color4F &) {}
+		void clear() {}
+
+	protected:
+		DrawNode() {}
+	};
+}
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+# converts the old compiled areas (Classes/areas/AIN_*/AIN_###.h and .cpp) into area files (Resources/areas/AIN_###.area).
+# the headers hold the 30 X 52 tile and enemy grids, and the source files hold the name, exits, and spawn points.
+# usage: python3 tools/convert_areas.py [Classes/areas folder] [output folder]
+# the area classes were removed once they were converted, so this has to be run on a checkout from before then to convert them again.
+import os
+import re
+import sys
+
+ROW_MAX = 30 # maximum amount of rows
+COL_MAX = 52 # maximum amount of columns
+VERSION = 1 # the area file format version. This must match world::AreaData::VERSION.
+
+# removes the comments from C++ code, leaving string and character literals alone.
+def strip_comments(text):
+    out = []
+    i = 0
+    while i < len(text):
+        c = text[i]
+        if c in '"\'': # string or character literal
+            j = i + 1
+            while j < len(text) and text[j] != c:
+                j += 2 if text[j] == '\\' else 1
+            out.append(text[i:j + 1])
+            i = j + 1
+        elif text.startswith('//', i):
+            while i < len(text) and text[i] != '\n':
+                i += 1
+        elif text.startswith('/*', i):
+            end = text.find('*/', i + 2)
+            i = len(text) if end == -1 else end + 2
+        else:
+            out.append(c)
+            i += 1
+    return ''.join(out)
+
+# splits a string on the commas that aren't inside brackets or literals.
+def split_top(text):
+    parts, depth, start, i = [], 0, 0, 0
+    while i < len(text):
+        c = text[i]
+        if c in '"\'':
+            j = i + 1
+            while text[j] != c:
+                j += 2 if text[j] == '\\' else 1
+            i = j
+        elif c in '({':
+            depth += 1
+        elif c in ')}':
+            depth -= 1
+        elif c == ',' and depth == 0:
+            parts.append(text[start:i].strip())
+            start = i + 1
+        i += 1
+    if text[start:].strip():
+        parts.append(text[start:].strip())
+    return parts
+
+# returns the text between the bracket at 'start' and its matching closing bracket.
+def bracketed(text, start):
+    depth = 0
+    for i in range(start, len(text)):
+        if text[i] in '({':
+            depth += 1
+        elif text[i] in ')}':
+            depth -= 1
+            if depth == 0:
+                return text[start + 1:i]
+    raise ValueError('unbalanced brackets')
+
+# reads a C++ integer literal. A leading zero means it's octal (e.g. 050 is 40).
+def c_int(token):
+    token = token.strip().rstrip('uUlL')
+    if re.fullmatch(r'0[0-7]+', token):
+        return int(token, 8)
+    return int(token, 0)
+
+def c_float(token):
+    return float(token.strip().rstrip('fF'))
+
+def c_bool(token):
+    return {'true': 1, 'false': 0}.get(token.strip(), None) if token.strip() in ('true', 'false') else int(c_int(token) != 0)
+
+def c_char(token):
+    token = token.strip()
+    if not re.fullmatch(r"'.'", token):
+        raise ValueError('unsupported character literal ' + token)
+    return token[1]
+
+# reads a 'new entity::Tile(...)' or 'new entity::Enemy(...)' grid entry. Missing arguments get the constructor defaults.
+def parse_entry(token, kind):
+    if token in ('nullptr', 'NULL', '0'):
+        return None
+    m = re.fullmatch(r'new\s+entity::' + kind + r'\s*\((.*)\)', token, re.S)
+    if m is None:
+        raise ValueError('unexpected grid entry: ' + token)
+    args = split_top(m.group(1))
+    entry = [c_int(args[0]), 'a', 0, 0, 0, 0, 0] # id, letter, up, down, left, right, offset by sprite size
+    if len(args) > 1:
+        entry[1] = c_char(args[1])
+    for k in range(2, min(len(args), 6)):
+        entry[k] = c_int(args[k])
+    if len(args) > 6:
+        entry[6] = c_bool(args[6])
+    return entry
+
+# reads a grid initializer, returning (row, column, entry) for every spot that isn't empty.
+def parse_grid(text, grid, kind):
+    m = re.search(r'entity::' + kind + r'\s*\*\s*' + grid + r'\s*\[[^]]*\]\s*\[[^]]*\]\s*=\s*', text)
+    if m is None:
+        return []
+    rows = split_top(bracketed(text, m.end()))
+    if len(rows) > ROW_MAX:
+        raise ValueError(grid + ' has too many rows')
+    entries = []
+    for r, row in enumerate(rows):
+        cols = split_top(row.strip()[1:-1])
+        if len(cols) > COL_MAX:
+            raise ValueError(grid + ' row ' + str(r) + ' has too many columns')
+        for c, col in enumerate(cols):
+            entry = parse_entry(col, kind)
+            if entry is not None:
+                entries.append((r, c, entry))
+    return entries
+
+def string_member(text, member):
+    m = re.search(r'\b' + member + r'\s*=\s*"([^"]*)"\s*;', text)
+    return m.group(1) if m else ''
+
+def convert(header_path, source_path):
+    raw_header = open(header_path, encoding='latin-1').read()
+    header = strip_comments(raw_header)
+    source = strip_comments(open(source_path, encoding='latin-1').read())
+
+    lines = []
+    # keeps the description comment at the top of the header (e.g. '//TUTORIAL - SEWER').
+    for line in raw_header.splitlines():
+        if not line.strip().startswith('//'):
+            break
+        lines.append('# ' + line.strip()[2:].strip())
+
+    lines.append('MSQ_AREA ' + str(VERSION))
+    lines.append('name ' + string_member(source, 'name'))
+
+    flip = re.search(r'\bflipY\s*=\s*(true|false)', source)
+    lines.append('flip ' + ('1' if flip and flip.group(1) == 'true' else '0'))
+
+    gravity = re.search(r'setGravity\s*\(([^)]*)\)', source)
+    if gravity:
+        lines.append('gravity ' + repr(c_float(gravity.group(1))))
+
+    for i, member in enumerate(['bg_img1', 'bg_img2', 'bg_img3']):
+        if string_member(header, member):
+            lines.append('background' + str(i + 1) + ' ' + string_member(header, member))
+    if string_member(header, 'fg_img'):
+        lines.append('foreground ' + string_member(header, 'fg_img'))
+
+    for i in range(5):
+        exit_ = string_member(source, 'exit' + str(i))
+        if exit_:
+            lines.append('exit ' + str(i) + ' ' + exit_)
+
+    for i in range(5):
+        m = re.search(r'\bspawn' + str(i) + r'\s*=\s*Vec2\s*\(([^,]*),([^)]*)\)', source)
+        if m:
+            lines.append('spawn ' + str(i) + ' ' + '%g' % c_float(m.group(1)) + ' ' + '%g' % c_float(m.group(2)))
+
+    lines.append('# tile <row> <column> <TIN> <letter> <copies up> <copies down> <copies left> <copies right> <offset by sprite size>')
+    for r, c, e in parse_grid(header, 'tileGrid', 'Tile'):
+        lines.append('tile %d %d %d %s %d %d %d %d %d' % (r, c, e[0], e[1], e[2], e[3], e[4], e[5], e[6]))
+
+    lines.append('# enemy <row> <column> <EIN> <letter> <copies up> <copies down> <copies left> <copies right> <offset by sprite size>')
+    for r, c, e in parse_grid(header, 'enemyGrid', 'Enemy'):
+        lines.append('enemy %d %d %d %s %d %d %d %d %d' % (r, c, e[0], e[1], e[2], e[3], e[4], e[5], e[6]))
+
+    return '\n'.join(lines) + '\n'
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    areas = sys.argv[1] if len(sys.argv) > 1 else os.path.join(root, 'Classes', 'areas')
+    output = sys.argv[2] if len(sys.argv) > 2 else os.path.join(root, 'Resources', 'areas')
+    os.makedirs(output, exist_ok=True)
+
+    for folder in sorted(os.listdir(areas)):
+        if not folder.startswith('AIN_') or not os.path.isdir(os.path.join(areas, folder)):
+            continue
+        for file in sorted(os.listdir(os.path.join(areas, folder))):
+            if not file.endswith('.h'):
+                continue
+            name = file[:-2]
+            text = convert(os.path.join(areas, folder, file), os.path.join(areas, folder, name + '.cpp'))
+            open(os.path.join(output, name + '.area'), 'w', newline='\n').write(text)
+            print(name + ': ' + str(text.count('\ntile ')) + ' tiles, ' + str(text.count('\nenemy ')) + ' enemies')
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+# converts the area backgrounds (Resources/images/backgrounds/*.png) into smaller texture formats, saved next to them as .pvr.ccz files (zlib compressed PVR textures).
+# the game loads the converted file instead of the PNG if there is one (see world::Area::getLayerImage()), so the backgrounds don't have to be decoded to RGBA8888 every time an area is made.
+# opaque backgrounds become RGB565 (half the memory). Backgrounds with transparency become RGBA4444, unless the quality is 'high', which leaves them as RGBA8888.
+# the backgrounds aren't given mipmaps, since they're drawn at their full size, and most of them aren't a power of two.
+# usage: python3 tools/convert_backgrounds.py [--quality low|medium|high] [Resources folder]
+#   low: the colours are cut down to the smaller format as they are. This shows the most banding.
+#   medium: the colours are dithered, which hides most of the banding. This is the default.
+#   high: the same as medium, but backgrounds with transparency keep their full colour depth.
+# this has to be run again whenever one of the backgrounds changes. The memory each background used before and after is printed.
+import os
+import struct
+import sys
+import zlib
+
+from pack_atlases import read_png
+
+BACKGROUND_FOLDER = 'images/backgrounds' # the folder of the backgrounds, inside of the Resources folder.
+EXTENSION = '.pvr.ccz' # the extension of the converted files. This must match world::Area::CONVERTED_LAYER_EXTENSION.
+
+# PVR (version 3) pixel formats. Each one lists its channels, followed by their sizes in bits.
+PVR_VERSION = 0x03525650
+PVR_FORMATS = {
+    'RGB565': struct.unpack('<Q', b'rgb\x00\x05\x06\x05\x00')[0],
+    'RGBA4444': struct.unpack('<Q', b'rgba\x04\x04\x04\x04')[0],
+    'RGBA8888': struct.unpack('<Q', b'rgba\x08\x08\x08\x08')[0],
+}
+BITS_PER_PIXEL = {'RGB565': 16, 'RGBA4444': 16, 'RGBA8888': 32}
+
+# a 4 x 4 ordered dither, which is added to each channel before it's cut down. The values are out of 16.
+BAYER = [[0, 8, 2, 10], [12, 4, 14, 6], [3, 11, 1, 9], [15, 7, 13, 5]]
+
+# cuts a channel down to the given amount of bits. If 'dither' is set (0 to 15), the error is spread out using the dither value.
+def reduce(value, bits, dither):
+    levels = (1 << bits) - 1
+    if dither is None:
+        return (value * levels + 127) // 255
+    return min(levels, (value * levels * 16 + dither * 255) // (255 * 16))
+
+# converts RGBA pixels to the given format, returning the texture data.
+def convert(width, height, pixels, pixel_format, dithered):
+    if pixel_format == 'RGBA8888':
+        return bytes(pixels)
+
+    out = bytearray(width * height * 2)
+    for y in range(height):
+        row = BAYER[y % 4]
+        for x in range(width):
+            i = (y * width + x) * 4
+            dither = row[x % 4] if dithered else None
+            r, g, b, a = pixels[i], pixels[i + 1], pixels[i + 2], pixels[i + 3]
+            if pixel_format == 'RGB565':
+                value = (reduce(r, 5, dither) << 11) | (reduce(g, 6, dither) << 5) | reduce(b, 5, dither)
+            else:
+                value = (reduce(r, 4, dither) << 12) | (reduce(g, 4, dither) << 8) | (reduce(b, 4, dither) << 4) | reduce(a, 4, dither)
+            out[(y * width + x) * 2:(y * width + x) * 2 + 2] = struct.pack('<H', value)
+    return bytes(out)
+
+# saves the texture as a PVR file with a single mipmap level, compressed the way cocos reads .ccz files.
+def write_pvr_ccz(path, width, height, pixel_format, data):
+    header = struct.pack('<IIQIIIIIIIII', PVR_VERSION, 0, PVR_FORMATS[pixel_format], 0, 0, height, width, 1, 1, 1, 1, 0)
+    pvr = header + data
+
+    with open(path, 'wb') as file:
+        file.write(b'CCZ!' + struct.pack('>HHII', 0, 2, 0, len(pvr))) # zlib compression, version 2.
+        file.write(zlib.compress(pvr, 9))
+
+def main():
+    quality = 'medium'
+    args = sys.argv[1:]
+    if '--quality' in args:
+        index = args.index('--quality')
+        quality = args[index + 1] if index + 1 < len(args) else ''
+        del args[index:index + 2]
+    if quality not in ('low', 'medium', 'high'):
+        print('The quality has to be low, medium, or high.')
+        return 1
+
+    resources = args[0] if args else os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Resources')
+    folder = os.path.join(resources, BACKGROUND_FOLDER)
+    before_total, after_total = 0, 0
+
+    for file_name in sorted(os.listdir(folder)):
+        if not file_name.lower().endswith('.png'):
+            continue
+
+        width, height, pixels = read_png(os.path.join(folder, file_name))
+        opaque = all(pixels[i] == 255 for i in range(3, len(pixels), 4))
+
+        if opaque:
+            pixel_format = 'RGB565'
+        else:
+            pixel_format = 'RGBA8888' if quality == 'high' else 'RGBA4444'
+
+        data = convert(width, height, pixels, pixel_format, quality != 'low')
+        write_pvr_ccz(os.path.join(folder, file_name[:-4] + EXTENSION), width, height, pixel_format, data)
+
+        before = width * height * 4 # PNGs are loaded as RGBA8888.
+        after = width * height * BITS_PER_PIXEL[pixel_format] // 8
+        before_total += before
+        after_total += after
+        print('%s: %dx%d, RGBA8888 %d KB -> %s %d KB' % (file_name, width, height, before // 1024, pixel_format, after // 1024))
+
+    print('Total texture memory: %d KB -> %d KB' % (before_total // 1024, after_total // 1024))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
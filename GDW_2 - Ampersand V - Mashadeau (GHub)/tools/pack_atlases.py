@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+# packs the tile, enemy, and weapon images (Resources/images/tiles, enemies, weapons, and items) into texture atlases (Resources/images/atlases/*.png and *.plist).
+# each image is kept whole, since the sprites crop their frames out of it (see OOP::TextureAtlas). The frames are named after the image paths (e.g. images/tiles/TIN_010.png).
+# the plists use the cocos sprite frame format (format 2), so they can be loaded by the sprite frame cache.
+# usage: python3 tools/pack_atlases.py [Resources folder]
+# this has to be run again whenever one of the images changes. Images that are too big for an atlas are left out, and are still loaded on their own.
+import os
+import struct
+import sys
+import zlib
+
+# the atlases, and the folders (in Resources/images) that go into each of them.
+ATLASES = [
+    ('tiles', ['tiles']),
+    ('enemies', ['enemies']),
+    ('weapons', ['weapons', 'items']),
+]
+
+OUTPUT_FOLDER = 'images/atlases' # where the atlases are saved, inside of the Resources folder. This must match OOP::TextureAtlas::ATLAS_FOLDER.
+MAX_SIZE = 2048 # the largest width and height of an atlas. Older devices can't use textures bigger than this.
+PADDING = 2 # the space between images. The edges of each image are copied into it so that filtering doesn't blend in its neighbours.
+
+PNG_SIGNATURE = b'\x89PNG\r\n\x1a\n'
+
+# reads a PNG file, returning its width, height, and its pixels as RGBA bytes (8 bits per channel).
+def read_png(path):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError(path + ' is not a PNG file.')
+
+    pos, idat, palette, alpha = 8, [], None, None
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+
+        if kind == b'IHDR':
+            width, height, depth, colour, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = body
+        elif kind == b'tRNS':
+            alpha = body
+        elif kind == b'IDAT':
+            idat.append(body)
+        elif kind == b'IEND':
+            break
+
+    if interlace != 0:
+        raise ValueError(path + ' is interlaced, which is not supported.')
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[colour]
+    bits = depth * channels # bits per pixel
+    stride = (width * bits + 7) // 8 # bytes per row
+    step = max(1, bits // 8) # the distance to the same byte of the last pixel, for the filters.
+    raw = zlib.decompress(b''.join(idat))
+
+    # undoes the filter on each row.
+    rows, previous = [], bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        row = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+
+        if kind == 1: # sub
+            for i in range(step, stride):
+                row[i] = (row[i] + row[i - step]) & 0xFF
+        elif kind == 2: # up
+            row = bytearray((a + b) & 0xFF for a, b in zip(row, previous))
+        elif kind == 3: # average
+            for i in range(stride):
+                row[i] = (row[i] + ((row[i - step] if i >= step else 0) + previous[i]) // 2) & 0xFF
+        elif kind == 4: # paeth
+            for i in range(stride):
+                a = row[i - step] if i >= step else 0
+                b = previous[i]
+                c = previous[i - step] if i >= step else 0
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                row[i] = (row[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+
+        rows.append(row)
+        previous = row
+
+    # converts the rows to RGBA.
+    pixels = bytearray(width * height * 4)
+    for y, row in enumerate(rows):
+        if depth == 16: # only the high byte of each channel is kept.
+            row = row[0::2]
+        elif depth < 8: # unpacks the samples, and scales them up to 8 bits (palette indices aren't scaled).
+            scale = 1 if colour == 3 else 255 // ((1 << depth) - 1)
+            row = bytearray(((row[i * depth // 8] >> (8 - depth - (i * depth) % 8)) & ((1 << depth) - 1)) * scale for i in range(width))
+
+        out = y * width * 4
+        for x in range(width):
+            if colour == 6:
+                pixels[out:out + 4] = row[x * 4:x * 4 + 4]
+            elif colour == 2:
+                pixels[out:out + 4] = row[x * 3:x * 3 + 3] + b'\xff'
+            elif colour == 4:
+                pixels[out:out + 4] = bytes((row[x * 2], row[x * 2], row[x * 2], row[x * 2 + 1]))
+            elif colour == 0:
+                pixels[out:out + 4] = bytes((row[x], row[x], row[x], 255))
+            else: # palette
+                index = row[x]
+                pixels[out:out + 3] = palette[index * 3:index * 3 + 3]
+                pixels[out + 3] = alpha[index] if alpha is not None and index < len(alpha) else 255
+            out += 4
+
+    return width, height, pixels
+
+# saves RGBA pixels as a PNG file.
+def write_png(path, width, height, pixels):
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body) & 0xFFFFFFFF)
+
+    raw = b''.join(b'\x00' + bytes(pixels[y * width * 4:(y + 1) * width * 4]) for y in range(height))
+
+    with open(path, 'wb') as file:
+        file.write(PNG_SIGNATURE)
+        file.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 6, 0, 0, 0)))
+        file.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        file.write(chunk(b'IEND', b''))
+
+# places the images in rows (tallest first) in an atlas of the given size. Returns the position of each image, or None if they don't fit.
+def pack(images, width, height):
+    positions, x, y, row_height = {}, 0, 0, 0
+    for name, (w, h, _) in sorted(images.items(), key=lambda item: (-item[1][1], -item[1][0], item[0])):
+        if x + w + PADDING > width: # starts a new row.
+            x, y, row_height = 0, y + row_height, 0
+        if x + w + PADDING > width or y + h + PADDING > height:
+            return None
+        positions[name] = (x + PADDING // 2, y + PADDING // 2)
+        x += w + PADDING
+        row_height = max(row_height, h + PADDING)
+    return positions
+
+# finds the smallest power of two atlas that fits all of the images.
+def fit(images):
+    sizes = sorted(((w, h) for w in (2 ** i for i in range(4, 12)) for h in (2 ** i for i in range(4, 12)) if w <= MAX_SIZE and h <= MAX_SIZE), key=lambda s: (s[0] * s[1], s[0]))
+    for width, height in sizes:
+        positions = pack(images, width, height)
+        if positions is not None:
+            return width, height, positions
+    return None
+
+# copies an image into the atlas, and copies its edges into the padding around it.
+def blit(atlas, atlas_width, x, y, w, h, pixels):
+    margin = PADDING // 2
+    for row in range(-margin, h + margin):
+        source_row = min(max(row, 0), h - 1)
+        line = pixels[source_row * w * 4:(source_row + 1) * w * 4]
+        line = line[:4] * margin + line + line[-4:] * margin
+        start = ((y + row) * atlas_width + x - margin) * 4
+        atlas[start:start + len(line)] = line
+
+# writes the plist that describes where each image is in the atlas.
+def write_plist(path, texture, width, height, frames):
+    lines = ['<?xml version="1.0" encoding="UTF-8"?>',
+             '<!DOCTYPE plist PUBLIC "-//Apple//DTD PLIST 1.0//EN" "http://www.apple.com/DTDs/PropertyList-1.0.dtd">',
+             '<plist version="1.0">', '<dict>', '    <key>frames</key>', '    <dict>']
+    for name, (x, y, w, h) in sorted(frames.items()):
+        lines += ['        <key>%s</key>' % name, '        <dict>',
+                  '            <key>frame</key>', '            <string>{{%d,%d},{%d,%d}}</string>' % (x, y, w, h),
+                  '            <key>offset</key>', '            <string>{0,0}</string>',
+                  '            <key>rotated</key>', '            <false/>',
+                  '            <key>sourceColorRect</key>', '            <string>{{0,0},{%d,%d}}</string>' % (w, h),
+                  '            <key>sourceSize</key>', '            <string>{%d,%d}</string>' % (w, h),
+                  '        </dict>']
+    lines += ['    </dict>', '    <key>metadata</key>', '    <dict>',
+              '        <key>format</key>', '        <integer>2</integer>',
+              '        <key>realTextureFileName</key>', '        <string>%s</string>' % texture,
+              '        <key>size</key>', '        <string>{%d,%d}</string>' % (width, height),
+              '        <key>textureFileName</key>', '        <string>%s</string>' % texture,
+              '    </dict>', '</dict>', '</plist>', '']
+
+    with open(path, 'w', newline='\n') as file:
+        file.write('\n'.join(lines))
+
+def main():
+    resources = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Resources')
+    output = os.path.join(resources, OUTPUT_FOLDER)
+    os.makedirs(output, exist_ok=True)
+
+    for atlas_name, folders in ATLASES:
+        images = {}
+        for folder in folders:
+            for file_name in sorted(os.listdir(os.path.join(resources, 'images', folder))):
+                if not file_name.lower().endswith('.png'):
+                    continue
+                name = 'images/%s/%s' % (folder, file_name) # the name the game uses for the image.
+                w, h, pixels = read_png(os.path.join(resources, name))
+                if w + PADDING > MAX_SIZE or h + PADDING > MAX_SIZE:
+                    print('%s: %s is %dx%d, which is too big for an atlas. It will be loaded on its own.' % (atlas_name, name, w, h))
+                    continue
+                images[name] = (w, h, pixels)
+
+        result = fit(images)
+        if result is None:
+            print('%s: the images do not fit in a %dx%d atlas.' % (atlas_name, MAX_SIZE, MAX_SIZE))
+            return 1
+
+        width, height, positions = result
+        atlas = bytearray(width * height * 4)
+        frames = {}
+        for name, (x, y) in positions.items():
+            w, h, pixels = images[name]
+            blit(atlas, width, x, y, w, h, pixels)
+            frames[name] = (x, y, w, h)
+
+        write_png(os.path.join(output, atlas_name + '.png'), width, height, atlas)
+        write_plist(os.path.join(output, atlas_name + '.plist'), atlas_name + '.png', width, height, frames)
+        print('%s: packed %d images into a %dx%d atlas.' % (atlas_name, len(frames), width, height))
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# splits the area backgrounds (Resources/images/backgrounds/*.png) into tiles, so that only the part of a background that's in view has to be loaded (see world::ParallaxLayer).
+# each background gets a folder of tiles (images/backgrounds/tiles/<name>_<column>_<row>.pvr.ccz), and a tile set file (images/backgrounds/tiles/<name>.layer) that says how it was split.
+# row 0 is the bottom of the image, and the tiles on the right and top edges are cut down to the size of the image instead of being padded out.
+# the tiles are converted the same way as tools/convert_backgrounds.py converts whole backgrounds, so the same qualities can be used.
+# usage: python3 tools/split_backgrounds.py [--quality low|medium|high] [--tile-size <pixels>] [Resources folder]
+# this has to be run again whenever one of the backgrounds changes. If a background's tiles are deleted, the game goes back to loading it whole.
+import os
+import sys
+
+from convert_backgrounds import BACKGROUND_FOLDER, BITS_PER_PIXEL, EXTENSION, convert, write_pvr_ccz
+from pack_atlases import read_png
+
+TILE_FOLDER = 'tiles' # the folder of the tiles, inside of the background folder. This must match world::ParallaxLayer::TILE_FOLDER.
+TILE_SET_EXTENSION = '.layer' # the extension of the tile set files. This must match world::ParallaxLayer::TILE_SET_EXTENSION.
+TILE_SET_VERSION = 1 # the version of the tile set files. This must match world::ParallaxLayer::TILE_SET_VERSION.
+TILE_SIZE = 512 # the default width and height of the tiles. Powers of two work on every device.
+
+# copies part of an image's pixels. 'top' is counted from the top of the image, the way the rows are stored.
+def crop(width, pixels, left, top, w, h):
+    out = bytearray(w * h * 4)
+    for y in range(h):
+        start = ((top + y) * width + left) * 4
+        out[y * w * 4:(y + 1) * w * 4] = pixels[start:start + w * 4]
+    return out
+
+def main():
+    quality, tile_size = 'medium', TILE_SIZE
+    args = sys.argv[1:]
+    if '--quality' in args:
+        index = args.index('--quality')
+        quality = args[index + 1] if index + 1 < len(args) else ''
+        del args[index:index + 2]
+    if '--tile-size' in args:
+        index = args.index('--tile-size')
+        tile_size = int(args[index + 1]) if index + 1 < len(args) and args[index + 1].isdigit() else 0
+        del args[index:index + 2]
+    if quality not in ('low', 'medium', 'high'):
+        print('The quality has to be low, medium, or high.')
+        return 1
+    if tile_size <= 0:
+        print('The tile size has to be a number above 0.')
+        return 1
+
+    resources = args[0] if args else os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Resources')
+    folder = os.path.join(resources, BACKGROUND_FOLDER)
+    output = os.path.join(folder, TILE_FOLDER)
+    os.makedirs(output, exist_ok=True)
+
+    for file_name in sorted(os.listdir(folder)):
+        if not file_name.lower().endswith('.png'):
+            continue
+
+        name = file_name[:-4]
+        width, height, pixels = read_png(os.path.join(folder, file_name))
+        columns = (width + tile_size - 1) // tile_size
+        rows = (height + tile_size - 1) // tile_size
+        largest = 0 # the memory of the largest tile, which is what scrolling across the image costs for each tile in view.
+
+        # removes the tiles from the last time the image was split, in case it was split differently.
+        for old in os.listdir(output):
+            if old.startswith(name + '_') and old.endswith(EXTENSION):
+                os.remove(os.path.join(output, old))
+
+        for row in range(rows):
+            for column in range(columns):
+                left = column * tile_size
+                w = min(tile_size, width - left)
+                h = min(tile_size, height - row * tile_size)
+                top = height - row * tile_size - h # the rows are counted from the bottom.
+                tile = crop(width, pixels, left, top, w, h)
+
+                opaque = all(tile[i] == 255 for i in range(3, len(tile), 4))
+                if opaque:
+                    pixel_format = 'RGB565'
+                else:
+                    pixel_format = 'RGBA8888' if quality == 'high' else 'RGBA4444'
+
+                write_pvr_ccz(os.path.join(output, '%s_%d_%d%s' % (name, column, row, EXTENSION)), w, h, pixel_format, convert(w, h, tile, pixel_format, quality != 'low'))
+                largest = max(largest, w * h * BITS_PER_PIXEL[pixel_format] // 8)
+
+        with open(os.path.join(output, name + TILE_SET_EXTENSION), 'w', newline='\n') as file:
+            file.write('# made by tools/split_backgrounds.py from %s/%s\n' % (BACKGROUND_FOLDER, file_name))
+            file.write('MSQ_LAYER %d\n' % TILE_SET_VERSION)
+            file.write('size %d %d\n' % (width, height))
+            file.write('tile %d %d\n' % (tile_size, tile_size))
+            file.write('grid %d %d\n' % (columns, rows))
+            file.write('extension %s\n' % EXTENSION)
+
+        print('%s: %dx%d, split into %d x %d tiles of %dx%d (up to %d KB each)' % (file_name, width, height, columns, rows, tile_size, tile_size, largest // 1024))
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())